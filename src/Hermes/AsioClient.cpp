@@ -18,6 +18,8 @@ limitations under the License.
 #include "Network.h"
 
 #include "AsioSocket.h"
+#include "HostResolver.h"
+#include "ReconnectBackoff.h"
 
 #include <HermesData.hpp>
 #include "IService.h"
@@ -33,10 +35,13 @@ namespace Hermes
     struct ClientSocket : IClientSocket
     {
         AsioSocket m_socket;
+        ReconnectBackoff m_backoff;
+        TimerWheel::Timer m_retryTimer{[this]() { AsyncConnect_(); }};
 
         ClientSocket(unsigned sessionId, const NetworkConfiguration& configuration, 
             IAsioService& asioService) :
-            m_socket(sessionId, configuration, asioService)
+            m_socket(sessionId, configuration, asioService),
+            m_backoff(configuration)
         {}
 
         ~ClientSocket()
@@ -75,6 +80,7 @@ namespace Hermes
 
         void Close() override 
         { 
+            m_retryTimer.Cancel();
             m_socket.Close(); 
         }
 
@@ -94,37 +100,77 @@ namespace Hermes
                 return;
             }
 
+            ++m_socket.m_connectionInfo.m_connectAttempts;
             m_socket.m_service.Log(m_socket.m_sessionId, "AsyncConnect_ to host=", 
-                m_socket.m_configuration.m_hostName, " on port=", m_socket.m_configuration.m_port);
+                m_socket.m_configuration.m_hostName, " on port=", m_socket.m_configuration.m_port,
+                ", attempt ", m_socket.m_connectionInfo.m_connectAttempts);
 
-            asio::ip::tcp::resolver resolver(m_socket.m_asioService);
+            if (IsUnixDomain(m_socket.m_configuration))
+                return ConnectUnixDomain_();
 
-            boost::system::error_code ec;
-            auto resolveResults = resolver.resolve(asio::ip::tcp::v4(), m_socket.m_configuration.m_hostName, "", ec);
+            AsyncResolve(m_socket.m_service, m_socket.m_configuration.m_hostName,
+                [spThis = shared_from_this()](const boost::system::error_code& ec, const ResolvedHost& resolvedHost)
+            {
+                if (spThis->m_socket.Closed())
+                    return;
+
+                spThis->OnResolved_(ec, resolvedHost);
+            });
+        }
+
+        void OnResolved_(const boost::system::error_code& ec, const ResolvedHost& resolvedHost)
+        {
             if (ec)
             {
                 m_socket.Alarm(ec, "Unable to resolve ", m_socket.m_configuration.m_hostName);
                 RetryLater_();
                 return;
             }
-                
-            auto itEndpoint = resolveResults.cbegin();
-            asio::ip::tcp::endpoint endpoint(*itEndpoint);
+
+            asio::ip::tcp::endpoint endpoint(resolvedHost.m_endpoint);
             endpoint.port(m_socket.m_configuration.m_port);
 
             m_socket.m_connectionInfo.m_address = endpoint.address().to_string();
             m_socket.m_connectionInfo.m_port = endpoint.port();
-            m_socket.m_connectionInfo.m_hostName = itEndpoint->host_name();
+            m_socket.m_connectionInfo.m_hostName = resolvedHost.m_hostName;
+            Connect_(endpoint);
+        }
+
+        void ConnectUnixDomain_()
+        {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+            auto path = UnixDomainSocketPath(m_socket.m_configuration.m_port);
+            m_socket.m_connectionInfo.m_address = path;
+            m_socket.m_connectionInfo.m_port = m_socket.m_configuration.m_port;
+            m_socket.m_connectionInfo.m_hostName = m_socket.m_configuration.m_hostName;
+            Connect_(asio::local::stream_protocol::endpoint(path));
+#else
+            m_socket.Alarm(asio::error::operation_not_supported, "Unix domain sockets");
+#endif
+        }
+
+        void Connect_(const StreamProtocol::endpoint& endpoint)
+        {
+            if (!m_socket.m_socket.is_open())
+            {
+                // opened here rather than by async_connect, so that the buffer sizes are in place before connecting
+                boost::system::error_code ecOpen;
+                m_socket.m_socket.open(endpoint.protocol(), ecOpen);
+                if (!ecOpen)
+                {
+                    m_socket.SetBufferSizes();
+                }
+            }
 
             m_socket.m_service.Log(m_socket.m_sessionId, "Connecting to ", m_socket.m_connectionInfo, " ...");
             m_socket.m_socket.async_connect(endpoint, 
-                [spThis = shared_from_this()](const boost::system::error_code& ec)
+                m_socket.m_service.Bind([spThis = shared_from_this()](const boost::system::error_code& ec)
             {
                 if (spThis->m_socket.Closed())
                     return;
 
                 spThis->OnConnected_(ec);
-            });
+            }));
         }
 
         void OnConnected_(const boost::system::error_code& ec)
@@ -144,6 +190,7 @@ namespace Hermes
                 return;
             }
 
+            m_socket.ApplySocketOptions();
             m_socket.m_service.Inform(m_socket.m_sessionId, "OnConnected ", m_socket.m_connectionInfo);
             m_socket.m_pCallback->OnConnected(m_socket.m_connectionInfo);
             m_socket.StartReceiving();
@@ -154,22 +201,14 @@ namespace Hermes
             if (m_socket.Closed())
                 return;
 
-            m_socket.m_timer.expires_after(Hermes::GetSeconds(m_socket.m_configuration.m_retryDelayInSeconds));
-            m_socket.m_timer.async_wait([spThis = shared_from_this()](const boost::system::error_code& ec)
-            {
-                if (spThis->m_socket.Closed())
-                    return;
-
-                if (ec) // we were canccelled
-                    return;
-
-                spThis->AsyncConnect_();
-            });
+            auto waitTime = m_backoff.NextWaitTimeInSeconds();
+            m_socket.m_service.Log(m_socket.m_sessionId, "Retrying in ", waitTime, " seconds");
+            m_socket.m_service.GetTimerWheel().Schedule(m_retryTimer, waitTime);
         }
     };
 }
 
-std::unique_ptr<Hermes::IClientSocket> Hermes::CreateClientSocket(unsigned sessionId,
+std::unique_ptr<Hermes::IClientSocket> Hermes::CreateAsioClientSocket(unsigned sessionId,
     const NetworkConfiguration& configuration, IAsioService& asioService)
 {
     return std::make_unique<ClientSocket>(sessionId, configuration, asioService);
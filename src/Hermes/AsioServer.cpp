@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "stdafx.h"
 #include "AsioSocket.h"
+#include "HostResolver.h"
 #include "IService.h"
 #include "MessageSerialization.h"
 #include "StringBuilder.h"
@@ -25,6 +26,7 @@ limitations under the License.
 
 #include <boost/asio.hpp>
 
+#include <cstdio>
 #include <mutex>
 
 namespace asio = boost::asio;
@@ -66,12 +68,12 @@ namespace Hermes
         {
             m_spSocket->m_wpOwner = std::move(wpOwner);
             m_spSocket->m_pCallback = &callback;
-            asio::post(m_spSocket->m_asioService, [spSocket = m_spSocket]()
+            asio::post(m_spSocket->m_socket.get_executor(), m_spSocket->m_service.Bind([spSocket = m_spSocket]()
             {
                 if (spSocket->Closed())
                     return;
                 spSocket->m_pCallback->OnConnected(spSocket->m_connectionInfo);
-            });
+            }));
             m_spSocket->StartReceiving();
         }
 
@@ -89,12 +91,13 @@ namespace Hermes
     struct AcceptorResources
     {
         asio::system_timer m_timer;
-        asio::ip::tcp::acceptor m_acceptor;
+        asio::basic_socket_acceptor<StreamProtocol> m_acceptor;
+        std::string m_socketPath; // the unix domain socket file bound by m_acceptor, if any
         bool m_closed = false;
 
-        AcceptorResources(asio::io_context& asioService) :
-            m_timer(asioService),
-            m_acceptor(asioService)
+        AcceptorResources(const asio::any_io_executor& executor) :
+            m_timer(executor),
+            m_acceptor(executor)
         {}
     };
 
@@ -102,10 +105,9 @@ namespace Hermes
     {
         unsigned m_sessionId = 1U;
         IAsioService& m_service;
-        asio::io_context& m_asioService{m_service.GetUnderlyingService()};
         Optional<NetworkConfiguration> m_optionalConfiguration;
         IAcceptorCallback& m_callback;
-        std::shared_ptr<AcceptorResources> m_spResources{std::make_shared<AcceptorResources>(m_asioService)};
+        std::shared_ptr<AcceptorResources> m_spResources{std::make_shared<AcceptorResources>(m_service.GetExecutor())};
 
         AsioAcceptor(IAsioService& asioService, IAcceptorCallback& callback) :
             m_service(asioService),
@@ -128,15 +130,14 @@ namespace Hermes
             m_optionalConfiguration = configuration;
             boost::system::error_code ecDummy;
             m_spResources->m_acceptor.cancel(ecDummy);
-            m_spResources->m_acceptor.close(ecDummy);
+            CloseAcceptor_();
             Listen_();
         }
 
         void StopListening() override
         {
             m_optionalConfiguration.reset();
-            boost::system::error_code ecDummy;
-            m_spResources->m_acceptor.close(ecDummy);
+            CloseAcceptor_();
         }
 
         // internals
@@ -154,23 +155,59 @@ namespace Hermes
             m_service.Log(m_sessionId, "Listen_ on ", configuration.m_hostName,
                 ", port=", configuration.m_port);
 
-            if (!m_optionalConfiguration->m_hostName.empty())
+            if (!m_optionalConfiguration->m_hostName.empty() && !IsUnixDomain(configuration))
             {
-                asio::ip::tcp::resolver resolver(m_asioService);               
-                boost::system::error_code ec;
-                resolver.resolve(asio::ip::tcp::v4(), configuration.m_hostName, "", ec);
-                if (ec)
+                // only to find out whether the allowed host can be resolved at all
+                AsyncResolve(m_service, configuration.m_hostName,
+                    [this, configuration, spResources = m_spResources](const boost::system::error_code& ec, const ResolvedHost&)
                 {
-                    Alarm(ec, "Unable to resolve ", configuration.m_hostName);
+                    if (spResources->m_closed || !m_optionalConfiguration || *m_optionalConfiguration != configuration)
+                        return;
+
+                    if (ec)
+                    {
+                        Alarm(ec, "Unable to resolve ", configuration.m_hostName);
+                        RetryLater_();
+                        return;
+                    }
+                    Bind_();
+                });
+                return;
+            }
+            Bind_();
+        }
+
+        void Bind_()
+        {
+            auto& configuration = *m_optionalConfiguration;
+            StreamProtocol::endpoint endpoint = asio::ip::tcp::endpoint(asio::ip::tcp::v4(), configuration.m_port);
+            std::string socketPath;
+            if (IsUnixDomain(configuration))
+            {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+                socketPath = UnixDomainSocketPath(configuration.m_port);
+                asio::local::stream_protocol::endpoint localEndpoint(socketPath);
+                auto ec = ProbeUnixDomainSocket_(localEndpoint);
+                if (!ec || ec == asio::error::would_block || ec == asio::error::try_again)
+                {
+                    Alarm(asio::error::address_in_use, "Another listener is on ", socketPath);
                     RetryLater_();
                     return;
                 }
+                if (ec == asio::error::connection_refused)
+                {
+                    // a socket file left behind by a listener that is gone, it would keep us from binding
+                    std::remove(socketPath.c_str());
+                }
+                endpoint = localEndpoint;
+#else
+                Alarm(asio::error::operation_not_supported, "Unix domain sockets");
+                return;
+#endif
             }
 
-            asio::ip::tcp::endpoint endpoint(asio::ip::tcp::v4(), configuration.m_port);
-
             boost::system::error_code ec;
-            m_spResources->m_acceptor.open(asio::ip::tcp::v4(), ec);
+            m_spResources->m_acceptor.open(endpoint.protocol(), ec);
             if (ec)
             {
                 Alarm(ec, "Unable to open accept port ", configuration.m_port);
@@ -187,6 +224,13 @@ namespace Hermes
             //    return;
             //}
 
+            SetBufferSizes(m_spResources->m_acceptor, configuration.m_socketOptions, ec);
+            if (ec)
+            {
+                Alarm(ec, "Unable to set the socket buffer sizes on accept port ", configuration.m_port);
+                ec.clear();
+            }
+
             m_spResources->m_acceptor.bind(endpoint, ec);
             if (ec)
             {
@@ -194,6 +238,7 @@ namespace Hermes
                 RetryLater_();
                 return;
             }
+            m_spResources->m_socketPath = std::move(socketPath);
 
             m_spResources->m_acceptor.listen(asio::socket_base::max_listen_connections, ec);
             if (ec)
@@ -220,16 +265,17 @@ namespace Hermes
                 ", port=", configuration.m_port);
 
             auto spSocket = std::make_shared<AsioSocket>(m_sessionId, configuration, m_service);
+            spSocket->m_wpOwner = spSocket; // until connected to a session, see ServerSocket::Connect()
             spSocket->m_connectionInfo.m_port = configuration.m_port;
             auto& asioSocket = spSocket->m_socket;
             m_spResources->m_acceptor.async_accept(asioSocket,
-                [this, spSocket = std::move(spSocket), spResources = m_spResources](const boost::system::error_code& ec) mutable
+                m_service.Bind([this, spSocket = std::move(spSocket), spResources = m_spResources](const boost::system::error_code& ec) mutable
             {
                 if (spResources->m_closed)
                     return;
 
                 OnAccepted_(std::move(spSocket), ec);
-            });
+            }));
         }
 
         void OnAccepted_(AsioSocketSp&& spSocket, const boost::system::error_code& ec)
@@ -257,73 +303,119 @@ namespace Hermes
                     ESeverity::eINFO, "ConfigurationChanged");
                 const std::string& xmlString = Serialize(notification);
                 spSocket->Send(xmlString);
+                spSocket->Close();
                 AsyncAccept_();
                 return;
             }
-            auto& configuration = *m_optionalConfiguration;
-            
-            asio::ip::tcp::resolver resolver(m_asioService);
-            boost::system::error_code ecResolve;
-            const auto& endpoint = spSocket->m_socket.remote_endpoint();
-            const auto& remoteAddress = endpoint.address();
-            spSocket->m_connectionInfo.m_address = remoteAddress.to_string();
-
-            // try and resolve the remote address to a name:
-            auto resolveResults = resolver.resolve(endpoint, ecResolve);
-            if (ec)
-            {
-                spSocket->Alarm(ec, "Unable to resolve ip address ", endpoint);
-            }
-            else
+            spSocket->ApplySocketOptions();
+            if (IsUnixDomain(spSocket->m_configuration))
             {
-                auto itResolved = resolveResults.cbegin();
-                spSocket->m_connectionInfo.m_hostName = itResolved->host_name();
+                // the peer is on this host, and only the permissions of the socket file tell who may connect
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+                spSocket->m_connectionInfo.m_address = UnixDomainSocketPath(spSocket->m_configuration.m_port);
+#endif
+                spSocket->m_service.Inform(spSocket->m_sessionId, "OnAccepted ", spSocket->m_connectionInfo);
+                return OnAllowed_(std::move(spSocket));
             }
 
-            spSocket->m_service.Inform(spSocket->m_sessionId, "OnAccepted ", spSocket->m_connectionInfo);
+            const auto& endpoint = ToTcpEndpoint(spSocket->m_socket.remote_endpoint());
+            spSocket->m_connectionInfo.m_address = endpoint.address().to_string();
 
-            if (!configuration.m_hostName.empty())
+            // try and resolve the remote address to a name:
+            auto spResolver = std::make_shared<asio::ip::tcp::resolver>(m_service.GetExecutor());
+            spResolver->async_resolve(endpoint, m_service.Bind([this, spResolver, spSocket = std::move(spSocket), spResources = m_spResources](
+                const boost::system::error_code& ec, const asio::ip::tcp::resolver::results_type& results) mutable
             {
-                auto results = resolver.resolve(asio::ip::tcp::v4(), configuration.m_hostName, "", ecResolve);
-                if (ecResolve)
-                {
-                    spSocket->Alarm(ec, "Unable to resolve ", configuration.m_hostName);
-                    NotificationData notification(ENotificationCode::eCONFIGURATION_ERROR, ESeverity::eERROR,
-                        "Connection only allowed from a hostname which cannot be resolved: " + configuration.m_hostName);
-                    const std::string& xmlString = Serialize(notification);
-                    spSocket->Send(xmlString);
-                    spSocket->Close();
-                    RetryLater_();
+                if (spResources->m_closed || Outdated_(*spSocket))
                     return;
-                }
 
-                auto itAllowedEndpoint = results.cbegin();
-                const auto& allowedEndpoint = itAllowedEndpoint->endpoint();
-                const auto& allowedAddress = allowedEndpoint.address();
-                if (remoteAddress != allowedAddress)
+                if (ec || results.empty())
                 {
-                    std::ostringstream oss;
-                    oss << "Remote host does not match allowed host " << configuration.m_hostName
-                        << ",\nAllowed resolved hostname=" << itAllowedEndpoint->host_name()
-                        << ",\nAllowed address=" << allowedAddress.to_string()
-                        << ",\nRemote resolved hostname=" << spSocket->m_connectionInfo.m_hostName
-                        << ",\nRemote address=" << spSocket->m_connectionInfo.m_address;
-                    const std::string& text = oss.str();
-                    m_service.Warn(m_sessionId, text);
-
-                    NotificationData notification(ENotificationCode::eCONFIGURATION_ERROR, ESeverity::eWARNING, text);
-                    const std::string& xmlString = Serialize(notification);
-                    spSocket->Send(xmlString);
-                    spSocket->Close();
-                    AsyncAccept_();
-                    return;
+                    spSocket->Alarm(ec ? ec : asio::error::host_not_found, "Unable to resolve ip address ", spSocket->m_connectionInfo.m_address);
+                }
+                else
+                {
+                    spSocket->m_connectionInfo.m_hostName = results.cbegin()->host_name();
                 }
+                OnRemoteResolved_(std::move(spSocket));
+            }));
+        }
+
+        void OnRemoteResolved_(AsioSocketSp&& spSocket)
+        {
+            spSocket->m_service.Inform(spSocket->m_sessionId, "OnAccepted ", spSocket->m_connectionInfo);
+
+            const auto& configuration = *m_optionalConfiguration;
+            if (configuration.m_hostName.empty())
+                return OnAllowed_(std::move(spSocket));
+
+            AsyncResolve(m_service, configuration.m_hostName, [this, spSocket, spResources = m_spResources](
+                const boost::system::error_code& ec, const ResolvedHost& allowedHost) mutable
+            {
+                if (spResources->m_closed || Outdated_(*spSocket))
+                    return;
+
+                OnAllowedHostResolved_(std::move(spSocket), ec, allowedHost);
+            });
+        }
+
+        void OnAllowedHostResolved_(AsioSocketSp&& spSocket, const boost::system::error_code& ec, const ResolvedHost& allowedHost)
+        {
+            const auto& configuration = *m_optionalConfiguration;
+            if (ec)
+            {
+                spSocket->Alarm(ec, "Unable to resolve ", configuration.m_hostName);
+                NotificationData notification(ENotificationCode::eCONFIGURATION_ERROR, ESeverity::eERROR,
+                    "Connection only allowed from a hostname which cannot be resolved: " + configuration.m_hostName);
+                const std::string& xmlString = Serialize(notification);
+                spSocket->Send(xmlString);
+                spSocket->Close();
+                RetryLater_();
+                return;
+            }
+
+            const auto& allowedAddress = allowedHost.m_endpoint.address();
+            if (spSocket->m_connectionInfo.m_address != allowedAddress.to_string())
+            {
+                std::ostringstream oss;
+                oss << "Remote host does not match allowed host " << configuration.m_hostName
+                    << ",\nAllowed resolved hostname=" << allowedHost.m_hostName
+                    << ",\nAllowed address=" << allowedAddress.to_string()
+                    << ",\nRemote resolved hostname=" << spSocket->m_connectionInfo.m_hostName
+                    << ",\nRemote address=" << spSocket->m_connectionInfo.m_address;
+                const std::string& text = oss.str();
+                m_service.Warn(m_sessionId, text);
+
+                NotificationData notification(ENotificationCode::eCONFIGURATION_ERROR, ESeverity::eWARNING, text);
+                const std::string& xmlString = Serialize(notification);
+                spSocket->Send(xmlString);
+                spSocket->Close();
+                AsyncAccept_();
+                return;
             }
+            OnAllowed_(std::move(spSocket));
+        }
 
+        void OnAllowed_(AsioSocketSp&& spSocket)
+        {
             m_callback.OnAccepted(std::make_unique<ServerSocket>(std::move(spSocket)));
             AsyncAccept_();
         }
 
+        // whether the configuration has changed while resolving; then the acceptor is already listening anew
+        bool Outdated_(AsioSocket& socket)
+        {
+            if (m_optionalConfiguration && socket.m_configuration == *m_optionalConfiguration)
+                return false;
+
+            m_service.Warn(socket.m_sessionId, "Configuration of accepted socket no longer matches the current configuration");
+            NotificationData notification(ENotificationCode::eCONNECTION_RESET_BECAUSE_OF_CHANGED_CONFIGURATION,
+                ESeverity::eINFO, "ConfigurationChanged");
+            socket.Send(Serialize(notification));
+            socket.Close();
+            return true;
+        }
+
         void RetryLater_()
         {
             if (m_spResources->m_closed)
@@ -334,12 +426,10 @@ namespace Hermes
 
             auto& configuration = *m_optionalConfiguration;
 
-            boost::system::error_code ecDummy;
-            m_spResources->m_acceptor.close(ecDummy);
+            CloseAcceptor_();
 
-            
             m_spResources->m_timer.expires_after(Hermes::GetSeconds(configuration.m_retryDelayInSeconds));
-            m_spResources->m_timer.async_wait([this, spResources = m_spResources](const boost::system::error_code& ec)
+            m_spResources->m_timer.async_wait(m_service.Bind([this, spResources = m_spResources](const boost::system::error_code& ec)
             {
                 if (spResources->m_closed)
                     return;
@@ -348,7 +438,7 @@ namespace Hermes
                     return;
 
                 Listen_();
-            });
+            }));
         }
 
         void Close_()
@@ -359,8 +449,7 @@ namespace Hermes
             m_spResources->m_closed = true;
             m_service.Log(m_sessionId, "Close Acceptor");
 
-            boost::system::error_code ecDummy;
-            m_spResources->m_acceptor.close(ecDummy);
+            CloseAcceptor_();
             try
             {
                 m_spResources->m_timer.cancel();
@@ -368,6 +457,37 @@ namespace Hermes
             catch (const boost::system::system_error&) {}
         }
 
+        void CloseAcceptor_()
+        {
+            boost::system::error_code ecDummy;
+            m_spResources->m_acceptor.close(ecDummy);
+            if (!m_spResources->m_socketPath.empty())
+            {
+                // nobody listens on it any more
+                std::remove(m_spResources->m_socketPath.c_str());
+                m_spResources->m_socketPath.clear();
+            }
+        }
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        // connects to the socket file without blocking, to tell a listener alive (no error, or would_block with its
+        // backlog full) from a file left behind (connection_refused) and from no file at all
+        boost::system::error_code ProbeUnixDomainSocket_(const asio::local::stream_protocol::endpoint& endpoint)
+        {
+            boost::system::error_code ec;
+            asio::local::stream_protocol::socket probe(m_service.GetExecutor());
+            probe.open(endpoint.protocol(), ec);
+            if (ec)
+                return ec;
+            probe.native_non_blocking(true, ec);
+            if (ec)
+                return ec;
+            if (::connect(probe.native_handle(), endpoint.data(), static_cast<socklen_t>(endpoint.size())) != 0)
+                return boost::system::error_code(errno, boost::system::system_category());
+            return{};
+        }
+#endif
+
         template<class... Ts>
         Error Alarm(const boost::system::error_code& ec, const Ts&... trace)
         {
@@ -376,7 +496,7 @@ namespace Hermes
 
     };
 }
-std::unique_ptr<Hermes::IAcceptor> Hermes::CreateAcceptor(IAsioService& asioService, IAcceptorCallback& callback)
+std::unique_ptr<Hermes::IAcceptor> Hermes::CreateAsioAcceptor(IAsioService& asioService, IAcceptorCallback& callback)
 {
     return std::make_unique<AsioAcceptor>(asioService, callback);
 }
@@ -29,7 +29,12 @@ limitations under the License.
 #include <boost/asio.hpp>
 #include "boost_win32_patch.hpp"
 
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace asio = boost::asio;
 
@@ -49,33 +54,128 @@ namespace Hermes
         service.Inform(sessionId, trace..., ": ", ec.message(), '(', ec.value(), ')');
     }
 
-    struct AsioSocket
+    // TCP or, with ETransport::eUNIX_DOMAIN, AF_UNIX stream sockets
+    using StreamProtocol = asio::generic::stream_protocol;
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    // The path of the unix domain socket a downstream listens on for the given port, in the temp directory.
+    // Upstream and downstream may well run as different users, so it is not per user unless TMPDIR makes it so;
+    // a listener takes the file over only from a listener that is gone, see AsioAcceptor::Bind_().
+    inline std::string UnixDomainSocketPath(uint16_t port)
+    {
+        const char* pTempDirectory = std::getenv("TMPDIR");
+        return BuildString(pTempDirectory && *pTempDirectory ? pTempDirectory : "/tmp", "/hermes-", port, ".sock");
+    }
+#endif
+
+    inline bool IsUnixDomain(const NetworkConfiguration& configuration)
+    {
+        return configuration.m_socketOptions.m_transport == ETransport::eUNIX_DOMAIN;
+    }
+
+    inline bool IsTcp(const NetworkConfiguration& configuration)
+    {
+        return !IsUnixDomain(configuration);
+    }
+
+    // the remote address of an accepted TCP socket
+    inline asio::ip::tcp::endpoint ToTcpEndpoint(const StreamProtocol::endpoint& endpoint)
     {
+        asio::ip::tcp::endpoint tcpEndpoint;
+        if (endpoint.size() <= tcpEndpoint.capacity())
+        {
+            std::memcpy(tcpEndpoint.data(), endpoint.data(), endpoint.size());
+            tcpEndpoint.resize(endpoint.size());
+        }
+        return tcpEndpoint;
+    }
+
+    // an integer option at the TCP level which asio does not provide
+    template<int cNAME>
+    class TcpOption
+    {
+    public:
+        explicit TcpOption(int value) : m_value(value) {}
+
+        template<class ProtocolT> int level(const ProtocolT&) const { return IPPROTO_TCP; }
+        template<class ProtocolT> int name(const ProtocolT&) const { return cNAME; }
+        template<class ProtocolT> const int* data(const ProtocolT&) const { return &m_value; }
+        template<class ProtocolT> std::size_t size(const ProtocolT&) const { return sizeof(m_value); }
+
+    private:
+        int m_value;
+    };
+
+    // The buffer sizes go before connecting or listening, so that the window scale agreed on fits them.
+    // Accepted sockets take them over from the acceptor.
+    template<class SocketT>
+    void SetBufferSizes(SocketT& socket, const SocketOptions& options, boost::system::error_code& ec)
+    {
+        if (options.m_sendBufferSize)
+        {
+            socket.set_option(asio::socket_base::send_buffer_size(static_cast<int>(options.m_sendBufferSize)), ec);
+            if (ec)
+                return;
+        }
+        if (options.m_receiveBufferSize)
+        {
+            socket.set_option(asio::socket_base::receive_buffer_size(static_cast<int>(options.m_receiveBufferSize)), ec);
+        }
+    }
+
+    // With ETransport::eIO_URING, the connected socket receives and sends on the io_uring of the service, if there is one.
+    struct AsioSocket : IIoUringCallback
+    {
+        // the receive window starts small and grows while the peer keeps filling it, up to the maximum message size
+        static const std::size_t cMIN_RECEIVE_SIZE = 1024U;
+        // how long a closed socket keeps on sending what was queued before, see Close()
+        static constexpr double cLINGER_SECONDS = 5.0;
+
         unsigned m_sessionId;
         std::weak_ptr<void> m_wpOwner;
         IAsioService& m_service;
-        std::array<char, 1024> m_receivedData;
-        asio::io_context& m_asioService{m_service.GetUnderlyingService()};
-        asio::ip::tcp::socket m_socket{m_asioService};
-        asio::system_timer m_timer{m_asioService};
+        std::size_t m_receiveSize{cMIN_RECEIVE_SIZE};
+        StringSpan m_receivedData; // storage provided by ISocketCallback::ReceiveBuffer
+        StreamProtocol::socket m_socket{m_service.GetExecutor()};
+        TimerWheel::Timer m_checkAliveTimer{[this]() { OnCheckAliveDue_(); }};
+        std::chrono::steady_clock::time_point m_lastSentAt;
         ISocketCallback* m_pCallback{nullptr};
         NetworkConfiguration m_configuration;
         ConnectionInfo m_connectionInfo;
         bool m_closed{false};
 
+        // outbound messages are queued while a write is in flight and then written in one gather-write:
+        std::vector<std::string> m_sendQueue;
+        std::vector<std::string> m_sending;
+        std::vector<asio::const_buffer> m_sendBuffers;
+        std::size_t m_writtenOfFirst{0U}; // the part of m_sendQueue.front() written right away by Send()
+        std::size_t m_queuedBytes{0U}; // queued and in flight
+        bool m_writing{false};
+        bool m_aboveHighWaterMark{false};
+        IoUringConnectionSp m_spIoUringConnection;
+
+        // closed, but the socket itself stays open until the queue is sent or the linger timer is due:
+        bool m_lingering{false};
+        std::shared_ptr<AsioSocket> m_spLingering; // nothing else may keep the socket alive meanwhile
+        TimerWheel::Timer m_lingerTimer{[this]() { OnLingerDue_(); }};
+
         explicit AsioSocket(unsigned sessionId,
             const NetworkConfiguration& configuration, IAsioService& service) :
             m_sessionId(sessionId),
             m_service(service),
             m_configuration(configuration)
-        {}
+        {
+            m_service.Register(*this);
+        }
 
         AsioSocket(const AsioSocket&) = delete;
         AsioSocket& operator=(const AsioSocket&) = delete;
 
         ~AsioSocket()
         {
-            Close_();
+            Close_(false);
+            Shutdown_(); // if closed before
+            m_service.Unregister(*this);
         }
 
         std::shared_ptr<AsioSocket> shared_from_this() { return std::shared_ptr<AsioSocket>(m_wpOwner.lock(), this); }
@@ -83,6 +183,18 @@ namespace Hermes
         void StartReceiving()
         {
             assert(m_pCallback);
+            if (m_configuration.m_socketOptions.m_transport == ETransport::eIO_URING && !m_closed)
+            {
+                if (auto* pIoUring = m_service.GetIoUring())
+                {
+                    m_spIoUringConnection = pIoUring->Attach(static_cast<int>(m_socket.native_handle()), *this);
+                    if (!m_writing)
+                    {
+                        SendOnIoUring_();
+                    }
+                    return;
+                }
+            }
             AsyncReceive_();
         }
 
@@ -91,18 +203,104 @@ namespace Hermes
             if (m_closed)
                 return m_service.Log(m_sessionId, "Already closed on Send: ", message);
 
+            // the messages are traced as sent once they are handed over to the socket as a whole
+            if (m_spIoUringConnection && !m_writing)
+            {
+                m_queuedBytes += message.size();
+                CheckHighWaterMark_();
+                m_spIoUringConnection->Send(std::string(message.data(), message.size()));
+                return;
+            }
+
+            std::size_t written = 0U;
+            if (!m_writing)
+            {
+                // try to get rid of the message right away, without blocking:
+                boost::system::error_code ec;
+                if (!m_socket.non_blocking())
+                {
+                    m_socket.non_blocking(true, ec);
+                }
+                written = m_socket.write_some(asio::buffer(message.data(), message.size()), ec);
+                if (ec && ec != asio::error::would_block && ec != asio::error::try_again)
+                    return DisconnectOnError_(ec, "Cannot write ", message);
+
+                if (written == message.size())
+                {
+                    m_service.Trace(ETraceType::eSENT, m_sessionId, message);
+                    return NoteSent_();
+                }
+                m_writtenOfFirst = written; // the queue is empty unless writing
+            }
+
+            m_sendQueue.emplace_back(message.data(), message.size());
+            m_queuedBytes += message.size() - written;
+            CheckHighWaterMark_();
+            if (!m_writing)
+            {
+                AsyncWrite_();
+            }
+        }
+
+        void SetBufferSizes()
+        {
             boost::system::error_code ec;
-            asio::write(m_socket, asio::buffer(message.data(), message.size()), ec);
+            Hermes::SetBufferSizes(m_socket, m_configuration.m_socketOptions, ec);
             if (ec)
-                return DisconnectOnError_(ec, "Cannot write ", message);
+            {
+                Alarm(ec, "Unable to set the socket buffer sizes");
+            }
+        }
 
-            m_service.Trace(ETraceType::eSENT, m_sessionId, message);
-            RestartCheckAliveTimer_();
+        // the options which take effect once connected
+        void ApplySocketOptions()
+        {
+            const auto& options = m_configuration.m_socketOptions;
+            if (!IsTcp(m_configuration))
+                return;
+
+            if (options.m_noDelay)
+            {
+                SetOption_(asio::ip::tcp::no_delay(true), "TCP_NODELAY");
+            }
+            if (options.m_keepAlive)
+            {
+                SetOption_(asio::socket_base::keep_alive(true), "SO_KEEPALIVE");
+#if defined(TCP_KEEPIDLE)
+                if (options.m_keepAliveIdleInSeconds)
+                {
+                    SetOption_(TcpOption<TCP_KEEPIDLE>(static_cast<int>(options.m_keepAliveIdleInSeconds)), "TCP_KEEPIDLE");
+                }
+#elif defined(TCP_KEEPALIVE)
+                if (options.m_keepAliveIdleInSeconds)
+                {
+                    SetOption_(TcpOption<TCP_KEEPALIVE>(static_cast<int>(options.m_keepAliveIdleInSeconds)), "TCP_KEEPALIVE");
+                }
+#endif
+#if defined(TCP_KEEPINTVL)
+                if (options.m_keepAliveIntervalInSeconds)
+                {
+                    SetOption_(TcpOption<TCP_KEEPINTVL>(static_cast<int>(options.m_keepAliveIntervalInSeconds)), "TCP_KEEPINTVL");
+                }
+#endif
+            }
+            SetQuickAck_();
         }
 
+        // No more callbacks, and no more sends; the messages sent before still go out, unless the service is stopped.
         void Close() 
         { 
-            Close_(); 
+            Close_(true); 
+        }
+
+        // Closes right away, without sending what is still queued. Returns what kept a lingering socket alive,
+        // for the caller to release once it is done with the socket.
+        std::shared_ptr<void> Abort()
+        {
+            Close_(false);
+            std::shared_ptr<void> spLingering = std::move(m_spLingering);
+            Shutdown_();
+            return spLingering;
         }
 
         bool Closed() const 
@@ -123,19 +321,48 @@ namespace Hermes
             return Error{};
         }
 
+        // implementation of IIoUringCallback:
+        void OnIoUringReceived(StringView data) override
+        {
+            m_service.Trace(ETraceType::eRECEIVED, m_sessionId, data);
+            if (m_closed)
+                return;
+
+            auto spThis = shared_from_this(); // the callback may close and release the socket
+            SetQuickAck_();
+            StringSpan buffer = m_pCallback->ReceiveBuffer(data.size());
+            std::memcpy(buffer.data(), data.data(), data.size());
+            m_pCallback->OnReceived(StringSpan(buffer.data(), data.size()));
+        }
+
+        void OnIoUringSent(StringView message) override
+        {
+            m_service.Trace(ETraceType::eSENT, m_sessionId, message);
+            m_queuedBytes -= message.size();
+            CheckHighWaterMark_();
+            NoteSent_();
+            ShutdownOnceSent_();
+        }
+
+        void OnIoUringError(const boost::system::error_code& ec) override
+        {
+            auto spThis = shared_from_this();
+            DisconnectOnError_(ec, "OnIoUring");
+        }
+
     private:
 
         template<class... Ts>
         void DisconnectOnError_(const boost::system::error_code& ec, const Ts&... trace)
         {
             if (m_closed)
-                return;
+                return Shutdown_(); // whatever is left of the queue is lost
             
             // consider closed connections not to be an error:
             bool isError = (asio::error::eof != ec) && (asio::error::connection_reset != ec);
             auto error = isError ? Alarm(ec, trace...) : Info(ec, trace...);
 
-            auto* pCallback = Close_();
+            auto* pCallback = Close_(false);
             if (!pCallback)
                 return;
 
@@ -143,27 +370,63 @@ namespace Hermes
             pCallback->OnDisconnected(error);
         }
 
-        ISocketCallback* Close_()
+        ISocketCallback* Close_(bool linger)
         {
             if (m_closed)
                 return nullptr;
             m_closed = true;
-            m_service.Log(m_sessionId, "Close socket");
+            m_checkAliveTimer.Cancel();
 
-            boost::system::error_code ecDummy;
-            m_socket.shutdown(asio::socket_base::shutdown_both, ecDummy);
-            m_socket.close(ecDummy);
-            try
+            // neither a stopped service nor a socket whose owner is gone can send anything any more
+            if (linger && m_queuedBytes && m_socket.is_open() && !m_service.Stopped() && !m_wpOwner.expired())
             {
-                m_timer.cancel();
+                m_service.Log(m_sessionId, "Close socket once the ", m_queuedBytes, " bytes queued are sent");
+                m_lingering = true;
+                m_spLingering = shared_from_this();
+                m_service.GetTimerWheel().Schedule(m_lingerTimer, cLINGER_SECONDS);
+            }
+            else
+            {
+                m_service.Log(m_sessionId, "Close socket");
+                Shutdown_();
             }
-            catch (const boost::system::system_error&) {}
 
             auto* pCallback = m_pCallback;
             m_pCallback = nullptr;
             return pCallback;
         }
 
+        // may release the last reference to the socket, so nothing must be done with it afterwards
+        void Shutdown_()
+        {
+            auto spLingering = std::move(m_spLingering);
+            m_lingering = false;
+            m_lingerTimer.Cancel();
+            if (m_spIoUringConnection)
+            {
+                m_spIoUringConnection->Detach();
+                m_spIoUringConnection.reset();
+            }
+            boost::system::error_code ecDummy;
+            m_socket.shutdown(asio::socket_base::shutdown_both, ecDummy);
+            m_socket.close(ecDummy);
+        }
+
+        void ShutdownOnceSent_()
+        {
+            if (m_lingering && !m_queuedBytes)
+            {
+                m_service.Log(m_sessionId, "Queue sent, close socket");
+                Shutdown_();
+            }
+        }
+
+        void OnLingerDue_()
+        {
+            m_service.Warn(m_sessionId, "Close socket with ", m_queuedBytes, " bytes still queued after ", cLINGER_SECONDS, " seconds");
+            Shutdown_();
+        }
+
         //================ internally used methods, must all be called from the asio service thread =====================
         void AsyncReceive_()
         {
@@ -171,15 +434,16 @@ namespace Hermes
                 return;
 
             m_service.Log(m_sessionId, "async_receive");
-            m_socket.async_receive(asio::buffer(m_receivedData), [spThis = shared_from_this()](const boost::system::error_code& ec, std::size_t size)
+            m_receivedData = m_pCallback->ReceiveBuffer(m_receiveSize);
+            m_socket.async_receive(asio::buffer(m_receivedData.data(), m_receivedData.size()), m_service.Bind([spThis = shared_from_this()](const boost::system::error_code& ec, std::size_t size)
             {
                 spThis->OnReceive_(ec, size);
-            });
+            }));
         }
 
         void OnReceive_(const boost::system::error_code& ec, std::size_t size)
         {
-            StringSpan data(&m_receivedData.front(), size);
+            StringSpan data(m_receivedData.data(), size);
 
             if (size)
             {
@@ -202,11 +466,125 @@ namespace Hermes
                 return;
             }
 
+            SetQuickAck_();
+            AdaptReceiveSize_(size);
             m_pCallback->OnReceived(data);
             AsyncReceive_();
         }
 
-        void RestartCheckAliveTimer_()
+        template<class OptionT>
+        void SetOption_(const OptionT& option, const char* name)
+        {
+            boost::system::error_code ec;
+            m_socket.set_option(option, ec);
+            if (ec)
+            {
+                m_service.Warn(m_sessionId, "Unable to set socket option ", name, ": ", ec.message());
+            }
+        }
+
+        // Linux falls back to delayed acknowledgements by itself, so TCP_QUICKACK is set anew after each receive
+        void SetQuickAck_()
+        {
+#if defined(TCP_QUICKACK)
+            if (m_configuration.m_socketOptions.m_quickAck && IsTcp(m_configuration))
+            {
+                SetOption_(TcpOption<TCP_QUICKACK>(1), "TCP_QUICKACK");
+            }
+#endif
+        }
+
+        void AdaptReceiveSize_(std::size_t size)
+        {
+            if (size == m_receiveSize && m_receiveSize < cMAX_MESSAGE_SIZE)
+            {
+                m_receiveSize *= 2U;
+            }
+            else if (size < m_receiveSize / 4U && m_receiveSize > cMIN_RECEIVE_SIZE)
+            {
+                m_receiveSize /= 2U;
+            }
+        }
+
+        void AsyncWrite_()
+        {
+            m_sending.swap(m_sendQueue);
+            m_sendBuffers.clear();
+            for (const auto& message : m_sending)
+            {
+                m_sendBuffers.emplace_back(message.data(), message.size());
+            }
+            m_sendBuffers.front() += m_writtenOfFirst;
+            m_writtenOfFirst = 0U;
+
+            m_writing = true;
+            asio::async_write(m_socket, m_sendBuffers, m_service.Bind([spThis = shared_from_this()](const boost::system::error_code& ec, std::size_t size)
+            {
+                spThis->OnWritten_(ec, size);
+            }));
+        }
+
+        void OnWritten_(const boost::system::error_code& ec, std::size_t size)
+        {
+            m_writing = false;
+            if (m_closed && !m_lingering)
+                return;
+
+            if (ec)
+                return DisconnectOnError_(ec, "Cannot write");
+
+            for (const auto& message : m_sending)
+            {
+                m_service.Trace(ETraceType::eSENT, m_sessionId, message);
+            }
+            m_sending.clear();
+            m_queuedBytes -= size;
+            CheckHighWaterMark_();
+            NoteSent_();
+
+            if (m_spIoUringConnection)
+            {
+                SendOnIoUring_();
+            }
+            else if (!m_sendQueue.empty())
+            {
+                return AsyncWrite_();
+            }
+            ShutdownOnceSent_();
+        }
+
+        // what was queued for asio before the io_uring took over
+        void SendOnIoUring_()
+        {
+            for (auto& message : m_sendQueue)
+            {
+                m_spIoUringConnection->Send(std::move(message));
+            }
+            m_sendQueue.clear();
+        }
+
+        void CheckHighWaterMark_()
+        {
+            const std::size_t highWaterMark = m_configuration.m_sendQueueHighWaterMark;
+            if (!highWaterMark)
+                return;
+
+            if (!m_aboveHighWaterMark && m_queuedBytes > highWaterMark)
+            {
+                m_aboveHighWaterMark = true;
+                m_service.Warn(m_sessionId, "Peer does not keep up, bytes queued for sending=", m_queuedBytes,
+                    ", high water mark=", highWaterMark);
+            }
+            else if (m_aboveHighWaterMark && m_queuedBytes <= highWaterMark / 2U)
+            {
+                m_aboveHighWaterMark = false;
+                m_service.Inform(m_sessionId, "Peer caught up, bytes queued for sending=", m_queuedBytes);
+            }
+        }
+
+        // The check alive goes out m_checkAlivePeriodInSeconds after the last message sent. Rather than restarting
+        // a timer with every message, the time is noted and only looked at when the timer is due.
+        void NoteSent_()
         {
             if (m_closed)
                 return;
@@ -214,20 +592,22 @@ namespace Hermes
             if (!m_configuration.m_checkAlivePeriodInSeconds)
                 return;
 
-            m_timer.expires_after(Hermes::GetSeconds(m_configuration.m_checkAlivePeriodInSeconds));
-            m_timer.async_wait([spThis = shared_from_this()](const boost::system::error_code& ec)
+            m_lastSentAt = std::chrono::steady_clock::now();
+            if (!m_checkAliveTimer.Scheduled())
             {
-                spThis->OnCheckAliveTrigger_(ec);
-            });
+                m_service.GetTimerWheel().Schedule(m_checkAliveTimer, m_configuration.m_checkAlivePeriodInSeconds);
+            }
         }
 
-        void OnCheckAliveTrigger_(const boost::system::error_code& ec)
+        void OnCheckAliveDue_()
         {
             if (m_closed)
                 return;
 
-            if (ec) // cancelled or whatever
-                return;
+            std::chrono::duration<double> idle = std::chrono::steady_clock::now() - m_lastSentAt;
+            double left = m_configuration.m_checkAlivePeriodInSeconds - idle.count();
+            if (left > 0.0)
+                return m_service.GetTimerWheel().Schedule(m_checkAliveTimer, left);
 
             Send(Serialize(CheckAliveData()));
         }
@@ -0,0 +1,230 @@
+#include "stdafx.h"
+
+#include "BackgroundTrace.h"
+
+#include "TimestampFormatter.h"
+
+#include <charconv>
+#include <cstdio>
+
+namespace Hermes
+{
+    namespace
+    {
+        // records bigger than that are dropped, so that one huge payload cannot crowd out all the others
+        constexpr std::size_t cMAX_RECORD_SHARE = 4U;
+        // how long the background thread sleeps when it has missed the wake-up of a producer
+        constexpr std::chrono::milliseconds cIDLE_PERIOD{10};
+
+        template<class T>
+        T Read_(const char*& p)
+        {
+            T value;
+            std::memcpy(&value, p, sizeof(value));
+            p += sizeof(value);
+            return value;
+        }
+
+        template<class T>
+        void Append_(std::string& text, T value)
+        {
+            char buffer[32];
+            text.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+        }
+
+        // as std::ostream does it by default
+        void Append_(std::string& text, double value)
+        {
+            char buffer[32];
+            text.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, 6).ptr);
+        }
+
+        std::string FileName_(const std::string& path, unsigned index)
+        {
+            return index ? path + '.' + std::to_string(index) : path;
+        }
+    }
+
+    BackgroundTrace::BackgroundTrace(const BackgroundTraceSettings& settings, ITraceCallback& callback) :
+        m_settings(settings),
+        m_callback(callback),
+        m_ring(settings.m_bufferSize)
+    {
+        if (m_settings.m_optionalFilePath)
+        {
+            m_file.open(*m_settings.m_optionalFilePath, std::ios::binary | std::ios::app);
+            m_fileSize = m_file ? static_cast<std::uint64_t>(m_file.tellp()) : 0U;
+            if (!m_file)
+            {
+                m_callback.OnTrace(0U, ETraceType::eERROR, BuildString("Cannot open trace file ", *m_settings.m_optionalFilePath,
+                    ", tracing to the callback instead"));
+            }
+        }
+        m_thread = std::thread([this]() { Run_(); });
+    }
+
+    BackgroundTrace::~BackgroundTrace()
+    {
+        m_stop.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_wakeUp.notify_one();
+        }
+        m_thread.join();
+    }
+
+    void BackgroundTrace::Push_(ETraceType type, unsigned sessionId, std::string& record)
+    {
+        record.append((8U - record.size() % 8U) % 8U, '\0');
+        if (record.size() > m_ring.Capacity() / cMAX_RECORD_SHARE)
+        {
+            m_droppedCount.fetch_add(1U, std::memory_order_relaxed);
+            return;
+        }
+
+        auto size = static_cast<std::uint32_t>(record.size());
+        auto time = static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        char* pHeader = &record[0];
+        std::memcpy(pHeader, &size, sizeof(size));
+        std::memcpy(pHeader + 4, &sessionId, sizeof(sessionId));
+        std::memcpy(pHeader + 8, &time, sizeof(time));
+        pHeader[16] = static_cast<char>(type);
+
+        while (m_pushing.test_and_set(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+        bool pushed = m_ring.TryPush(record.data(), record.size());
+        m_pushing.clear(std::memory_order_release);
+
+        if (!pushed)
+        {
+            m_droppedCount.fetch_add(1U, std::memory_order_relaxed);
+            return;
+        }
+        if (m_consumerWaiting.load(std::memory_order_relaxed) && m_consumerWaiting.exchange(false))
+        {
+            // without taking the mutex, so the wake-up may be missed; then the background thread wakes up by itself
+            m_wakeUp.notify_one();
+        }
+    }
+
+    void BackgroundTrace::Run_()
+    {
+        for (;;)
+        {
+            bool stop = m_stop.load(std::memory_order_acquire);
+            while (const char* pRecord = m_ring.Peek())
+            {
+                Deliver_(pRecord);
+                m_ring.Pop(Read_<std::uint32_t>(pRecord));
+            }
+
+            std::uint64_t droppedCount = m_droppedCount.load(std::memory_order_relaxed);
+            if (droppedCount != m_reportedDroppedCount)
+            {
+                auto text = BuildString("Background trace buffer full, dropped ", droppedCount - m_reportedDroppedCount, " traces");
+                m_reportedDroppedCount = droppedCount;
+                if (m_file.is_open())
+                {
+                    Write_(ETraceType::eWARNING, 0U, std::chrono::system_clock::now(), text);
+                }
+                else
+                {
+                    m_callback.OnTrace(0U, ETraceType::eWARNING, text);
+                }
+            }
+            if (m_file.is_open())
+            {
+                m_file.flush();
+            }
+            if (stop)
+                return;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_consumerWaiting.store(true);
+            if (!m_ring.Peek() && !m_stop.load(std::memory_order_acquire))
+            {
+                m_wakeUp.wait_for(lock, cIDLE_PERIOD);
+            }
+            m_consumerWaiting.store(false);
+        }
+    }
+
+    void BackgroundTrace::Deliver_(const char* pRecord)
+    {
+        const char* p = pRecord;
+        const char* pEnd = p + Read_<std::uint32_t>(p);
+        auto sessionId = Read_<std::uint32_t>(p);
+        auto time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(Read_<std::int64_t>(p))));
+        auto type = static_cast<ETraceType>(*p);
+        p = pRecord + cHEADER_SIZE;
+
+        m_text.clear();
+        while (p < pEnd && *p != '\0')
+        {
+            switch (static_cast<EArgument>(*p++))
+            {
+            case EArgument::eTEXT:
+            {
+                auto size = Read_<std::uint32_t>(p);
+                m_text.append(p, size);
+                p += size;
+                break;
+            }
+            case EArgument::eSIGNED:
+                Append_(m_text, Read_<std::int64_t>(p));
+                break;
+            case EArgument::eUNSIGNED:
+                Append_(m_text, Read_<std::uint64_t>(p));
+                break;
+            case EArgument::eDOUBLE:
+                Append_(m_text, Read_<double>(p));
+                break;
+            case EArgument::eCHAR:
+                m_text += *p++;
+                break;
+            }
+        }
+
+        if (m_file.is_open())
+        {
+            Write_(type, sessionId, time, m_text);
+        }
+        else
+        {
+            m_callback.OnTrace(sessionId, type, m_text);
+        }
+    }
+
+    void BackgroundTrace::Write_(ETraceType type, unsigned sessionId, std::chrono::system_clock::time_point time, StringView text)
+    {
+        auto timestamp = TimestampFormatter::Local().Format(time);
+        m_file.write(timestamp.data(), static_cast<std::streamsize>(timestamp.size()));
+        m_file << ' ' << type << ' ' << sessionId << ": ";
+        m_file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        m_file << '\n';
+        m_fileSize = static_cast<std::uint64_t>(m_file.tellp());
+        if (m_settings.m_maxFileSize && m_fileSize >= m_settings.m_maxFileSize)
+        {
+            RotateFile_();
+        }
+    }
+
+    // trace, trace.1, trace.2, ... from the newest to the oldest
+    void BackgroundTrace::RotateFile_()
+    {
+        const std::string& path = *m_settings.m_optionalFilePath;
+        m_file.close();
+        unsigned oldFileCount = m_settings.m_maxFileCount ? m_settings.m_maxFileCount - 1U : 0U;
+        std::remove(FileName_(path, oldFileCount).c_str());
+        for (unsigned index = oldFileCount; index > 0U; --index)
+        {
+            std::rename(FileName_(path, index - 1U).c_str(), FileName_(path, index).c_str());
+        }
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        m_fileSize = 0U;
+    }
+}
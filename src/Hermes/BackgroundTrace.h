@@ -0,0 +1,200 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include <HermesData.hpp>
+#include <HermesDataConversion.hpp>
+#include <HermesStringView.hpp>
+
+#include "StringBuilder.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace Hermes
+{
+    // A ring of bytes for one producing and one consuming thread, holding records whose sizes are multiples of 8.
+    // A record never wraps around the end; the space left there is skipped with a padding mark.
+    class TraceRing
+    {
+    public:
+        // rounded up to a power of 2
+        explicit TraceRing(std::size_t capacity)
+        {
+            while (m_capacity < capacity && m_capacity < cMAX_CAPACITY)
+            {
+                m_capacity <<= 1U;
+            }
+            m_upData = std::make_unique<char[]>(m_capacity);
+        }
+        TraceRing(const TraceRing&) = delete;
+        TraceRing& operator=(const TraceRing&) = delete;
+
+        std::size_t Capacity() const { return m_capacity; }
+
+        // producer side, false if there is no room
+        bool TryPush(const char* pRecord, std::size_t size)
+        {
+            std::uint64_t head = m_head.load(std::memory_order_relaxed);
+            std::uint64_t tail = m_tail.load(std::memory_order_acquire);
+            std::size_t offset = static_cast<std::size_t>(head & (m_capacity - 1U));
+            std::size_t skipped = m_capacity - offset < size ? m_capacity - offset : 0U;
+            if (m_capacity - static_cast<std::size_t>(head - tail) < skipped + size)
+                return false;
+
+            if (skipped)
+            {
+                std::uint32_t mark = static_cast<std::uint32_t>(skipped) | cPADDING;
+                std::memcpy(m_upData.get() + offset, &mark, sizeof(mark));
+                offset = 0U;
+            }
+            std::memcpy(m_upData.get() + offset, pRecord, size);
+            m_head.store(head + skipped + size, std::memory_order_release);
+            return true;
+        }
+
+        // consumer side, the oldest record (which starts with its size as uint32_t) or nullptr; valid until Pop()
+        const char* Peek()
+        {
+            std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                if (tail == m_head.load(std::memory_order_acquire))
+                    return nullptr;
+
+                const char* pRecord = m_upData.get() + (tail & (m_capacity - 1U));
+                std::uint32_t mark;
+                std::memcpy(&mark, pRecord, sizeof(mark));
+                if (!(mark & cPADDING))
+                    return pRecord;
+                tail += mark & ~cPADDING;
+                m_tail.store(tail, std::memory_order_release);
+            }
+        }
+
+        void Pop(std::size_t size)
+        {
+            m_tail.store(m_tail.load(std::memory_order_relaxed) + size, std::memory_order_release);
+        }
+
+    private:
+        static constexpr std::size_t cMAX_CAPACITY = std::size_t(1U) << 30U;
+        static constexpr std::uint32_t cPADDING = 0x80000000U;
+
+        std::size_t m_capacity = 4096U;
+        std::unique_ptr<char[]> m_upData;
+        alignas(64) std::atomic<std::uint64_t> m_head{0U}; // written by the producer
+        alignas(64) std::atomic<std::uint64_t> m_tail{0U}; // written by the consumer
+    };
+
+    // Takes the traces of a service as compact binary records: session id, type, time and the parameters,
+    // with numbers and text stored as they are. Only parameters of other types are formatted right away.
+    // A background thread turns the records into text and passes them on to the trace callback or writes them to a file.
+    // When the ring is full, records are dropped and counted rather than waiting.
+    class BackgroundTrace
+    {
+    public:
+        BackgroundTrace(const BackgroundTraceSettings&, ITraceCallback&);
+        BackgroundTrace(const BackgroundTrace&) = delete;
+        BackgroundTrace& operator=(const BackgroundTrace&) = delete;
+        ~BackgroundTrace(); // passes on the records left
+
+        // may be called from any thread; the calls of the io thread do not contend with each other
+        template<class... Ts>
+        void Record(ETraceType type, unsigned sessionId, const Ts&... params)
+        {
+            static thread_local std::string tRecord;
+            tRecord.assign(cHEADER_SIZE, '\0');
+            (Encode_(tRecord, params), ...);
+            Push_(type, sessionId, tRecord);
+        }
+
+        std::uint64_t DroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+    private:
+        // a zero byte ends the arguments, which leaves the padding of the record as it is
+        enum class EArgument : char
+        {
+            eTEXT = 1, eSIGNED, eUNSIGNED, eDOUBLE, eCHAR
+        };
+
+        // size, session id, time in nanoseconds since the epoch, type
+        static constexpr std::size_t cHEADER_SIZE = 24U;
+
+        template<class T>
+        static void Encode_(std::string& record, const T& value)
+        {
+            if constexpr (std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value)
+            {
+                record += static_cast<char>(EArgument::eCHAR);
+                record += static_cast<char>(value);
+            }
+            else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value)
+            {
+                EncodeNumber_(record, EArgument::eSIGNED, static_cast<std::int64_t>(value));
+            }
+            else if constexpr (std::is_integral<T>::value)
+            {
+                EncodeNumber_(record, EArgument::eUNSIGNED, static_cast<std::uint64_t>(value));
+            }
+            else if constexpr (std::is_floating_point<T>::value)
+            {
+                EncodeNumber_(record, EArgument::eDOUBLE, static_cast<double>(value));
+            }
+            else if constexpr (std::is_convertible<const T&, StringView>::value)
+            {
+                EncodeText_(record, StringView(value));
+            }
+            else
+            {
+                EncodeText_(record, BuildString(value));
+            }
+        }
+
+        template<class T>
+        static void EncodeNumber_(std::string& record, EArgument argument, T value)
+        {
+            record += static_cast<char>(argument);
+            record.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        static void EncodeText_(std::string& record, StringView text)
+        {
+            auto size = static_cast<std::uint32_t>(text.size());
+            record += static_cast<char>(EArgument::eTEXT);
+            record.append(reinterpret_cast<const char*>(&size), sizeof(size));
+            record.append(text.data(), text.size());
+        }
+
+        void Push_(ETraceType, unsigned sessionId, std::string& record);
+        void Run_();
+        void Deliver_(const char* pRecord);
+        void Write_(ETraceType, unsigned sessionId, std::chrono::system_clock::time_point, StringView text);
+        void RotateFile_();
+
+        BackgroundTraceSettings m_settings;
+        ITraceCallback& m_callback;
+        TraceRing m_ring;
+        std::atomic_flag m_pushing = ATOMIC_FLAG_INIT; // serializes the rare producers besides the io thread
+        std::atomic<std::uint64_t> m_droppedCount{0U};
+        std::uint64_t m_reportedDroppedCount = 0U;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wakeUp;
+        std::atomic<bool> m_consumerWaiting{false};
+        std::atomic<bool> m_stop{false};
+
+        std::ofstream m_file;
+        std::uint64_t m_fileSize = 0U;
+        std::string m_text;
+        std::thread m_thread;
+    };
+}
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "MessageFields.h"
+#include "NumericCodec.h"
+
 #include <HermesStringView.hpp>
 #include <HermesData.hpp>
 
 #include <pugixml.hpp>
 
-#include <iomanip>
+#include <array>
 
 namespace Hermes
 {
@@ -14,162 +17,126 @@ namespace Hermes
 
     template<> struct PugiSerializer<std::string> 
     {
-        using AsAttributeTag = int;
-
-        static void WriteAttribute(pugi::xml_attribute attr, const std::string& value) 
-        { 
-            attr.set_value(value.c_str()); 
-        }
         static void ReadAttribute(pugi::xml_attribute attr, Error&, std::string& value)
         {
             value = attr.as_string();
         }
     };
 
-    template<> struct PugiSerializer<int>
+    // int, unsigned int, unsigned short and double
+    template<class T> struct PugiSerializer<T, std::enable_if_t<std::is_arithmetic<T>::value>>
     {
-        using AsAttributeTag = int;
-
-        static void WriteAttribute(pugi::xml_attribute attr, int value)
-        {
-            attr.set_value(value);
-        }
-        static void ReadAttribute(pugi::xml_attribute attr, Error&, int& value)
+        static void ReadAttribute(pugi::xml_attribute attr, Error& error, T& value)
         {
-            value = attr.as_int();
+            if (!NumericCodec::Parse(attr.value(), value))
+            {
+                error = NumericCodec::MalformedNumberError(attr.name(), attr.value());
+            }
         }
     };
 
-    template<> struct PugiSerializer<unsigned int>
+    template<class E> struct PugiSerializer<E, std::enable_if_t<std::is_enum<E>::value>>
     {
-        using AsAttributeTag = int;
-
-        static void WriteAttribute(pugi::xml_attribute attr, unsigned int value)
+        static void ReadAttribute(pugi::xml_attribute attr, Error& error, E& value)
         {
-            attr.set_value(value);
-        }
-        static void ReadAttribute(pugi::xml_attribute attr, Error&, unsigned int& value)
-        {
-            value = attr.as_uint();
+            int i = 0;
+            if (!NumericCodec::Parse(attr.value(), i))
+            {
+                error = NumericCodec::MalformedNumberError(attr.name(), attr.value());
+                return;
+            }
+            if (0 <= i && i < static_cast<int>(size(E())))
+            {
+                value = static_cast<E>(i);
+                return;
+            }
+            value = E{}; // all our enums (must!) have a sensible default value
         }
     };
 
-    template<> struct PugiSerializer<unsigned short>
-    {
-        using AsAttributeTag = int;
+    template<class T>
+    void DeserializeFields(pugi::xml_node parent, Error& error, T& data);
 
-        static void WriteAttribute(pugi::xml_attribute attr, unsigned short value)
+    template<class T>
+    void DeserializeFieldElement_(pugi::xml_node element, Error& error, T& value)
+    {
+        if constexpr (IsList<T>::value)
         {
-            attr.set_value(value);
+            for (const auto& node : element.children(ListTraits<T>::cITEM))
+            {
+                value.emplace_back();
+                DeserializeFields(node, error, value.back());
+            }
         }
-        static void ReadAttribute(pugi::xml_attribute attr, Error&, unsigned short& value)
+        else
         {
-            value = static_cast<unsigned short>(attr.as_int());
+            DeserializeFields(element, error, value);
         }
-    };
+    }
 
-    template<> struct PugiSerializer<double>
+    template<class T, std::size_t I, std::size_t N>
+    void DeserializeField_(const std::array<pugi::xml_attribute, N>& attributes, const std::array<pugi::xml_node, N>& elements,
+        Error& error, T& data)
     {
-        using AsAttributeTag = int;
-
-        static void WriteAttribute(pugi::xml_attribute attr, double value)
+        using Traits = FieldTraits<T, I>;
+        if constexpr (Traits::cATTRIBUTE)
         {
-            // Standard states that we should have 3 trailing decimals
-            std::stringstream stream;
-            stream << std::fixed << std::setprecision(3) << value;
-            attr.set_value(stream.str().c_str());
+            if (attributes[I])
+                return PugiSerializer<typename Traits::Value>::ReadAttribute(attributes[I], error, Traits::Emplace(data));
+            if (Traits::IsRequired())
+            {
+                error = {EErrorCode::ePEER_ERROR, std::string("missing attribute ") + Traits::cFIELD.m_name};
+            }
         }
-        static void ReadAttribute(pugi::xml_attribute attr, Error&, double& value)
+        else
         {
-            value = attr.as_double();
+            if (elements[I])
+                return DeserializeFieldElement_(elements[I], error, Traits::Emplace(data));
+            if (Traits::IsRequired())
+            {
+                error = {EErrorCode::ePEER_ERROR, std::string("missing element ") + Traits::cFIELD.m_name};
+            }
         }
-    };
+    }
 
-    template<class E> struct PugiSerializer<E, std::enable_if_t<std::is_enum<E>::value>>
+    template<class T, std::size_t... Is>
+    void DeserializeFields_(pugi::xml_node parent, Error& error, T& data, std::index_sequence<Is...>)
     {
-        using AsAttributeTag = int;
+        constexpr std::size_t cSIZE = sizeof...(Is);
+        std::array<pugi::xml_attribute, cSIZE> attributes;
+        std::array<pugi::xml_node, cSIZE> elements;
 
-        static void WriteAttribute(pugi::xml_attribute attr, E value)
+        for (const auto& attribute : parent.attributes())
         {
-            attr.set_value(static_cast<int>(value));
+            std::size_t index = FieldIndex<T>::Find(attribute.name());
+            if (index != FieldIndex<T>::cNONE && !attributes[index])
+            {
+                attributes[index] = attribute;
+            }
         }
-        static void ReadAttribute(pugi::xml_attribute attr, Error&, E& value)
+
+        if constexpr ((false || ... || !FieldTraits<T, Is>::cATTRIBUTE))
         {
-            int i  = attr.as_int();
-            if (0 <= i && i < static_cast<int>(size(E())))
+            for (const auto& node : parent.children())
             {
-                value = static_cast<E>(i);
-                return;
+                std::size_t index = FieldIndex<T>::Find(node.name());
+                if (index != FieldIndex<T>::cNONE && !elements[index])
+                {
+                    elements[index] = node;
+                }
             }
-            value = E{}; // all our enums (must!) have a sensible default value
         }
-    };
 
-    
-    void Serialize(pugi::xml_node parent, const char* name, const std::string& value)
-    {
-        PugiSerializer<std::string>::WriteAttribute(parent.append_attribute(name), value);
+        (DeserializeField_<T, Is>(attributes, elements, error, data), ...);
     }
 
+    // Reads all fields of an element in one pass over its attributes and, if needed, one over its children:
+    // each is routed through the FieldIndex of T. As with xml_node::attribute() and child(), the first attribute or child
+    // of a given name counts, and the fields are read (and checked for presence) in the order of Fields<T>.
     template<class T>
-    void Serialize(pugi::xml_node parent, const char* name, T value, typename PugiSerializer<T>::AsAttributeTag = 0)
+    void DeserializeFields(pugi::xml_node parent, Error& error, T& data)
     {
-        PugiSerializer<T>::WriteAttribute(parent.append_attribute(name), value);
-    }
-
-    template<class T>
-    void Serialize(pugi::xml_node parent, const char* name, const T& value, typename PugiSerializer<T>::AsElementTag = 0)
-    {
-        PugiSerializer<T>::WriteElement(parent.append_child(name), value);
-    }
-
-    template<class T>
-    void Serialize(pugi::xml_node parent, const char* name, const Optional<T>& value)
-    {
-        if (!value)
-            return;
-
-        Serialize(parent, name, *value);
-    }
-
-    template<class T>
-    void Deserialize(pugi::xml_node parent, const char* name, Error& error, T& value, typename PugiSerializer<T>::AsAttributeTag = 0)
-    {
-        auto attribute = parent.attribute(name);
-        if (attribute)
-            return PugiSerializer<T>::ReadAttribute(attribute, error, value);
-
-        error = {EErrorCode::ePEER_ERROR, std::string("missing attribute ") + name};
-    }
-
-    template<class T>
-    void Deserialize(pugi::xml_node parent, const char* name, Error& error, T& value, typename PugiSerializer<T>::AsElementTag = 0)
-    {
-        auto element = parent.child(name);
-        if (element)
-            return PugiSerializer<T>::ReadElement(element, error, value);
-
-        error = {EErrorCode::ePEER_ERROR, std::string("missing element ") + name};
-    }
-
-    template<class T>
-    void Deserialize(pugi::xml_node parent, const char* name, Error& error, Optional<T>& value, typename PugiSerializer<T>::AsAttributeTag = 0)
-    {
-        auto attribute = parent.attribute(name);
-        if (!attribute)
-            return;
-
-        PugiSerializer<T>::ReadAttribute(attribute, error, *value.emplace());
-    }
-
-    template<class T>
-    void Deserialize(pugi::xml_node parent, const char* name, Error& error, Optional<T>& value, typename PugiSerializer<T>::AsElementTag = 0)
-    {
-        auto element = parent.child(name);
-        if (!element)
-            return;
-
-        PugiSerializer<T>::ReadElement(element, error, *value.emplace());
+        DeserializeFields_(parent, error, data, std::make_index_sequence<FieldCount<T>()>());
     }
 
 }
@@ -58,7 +58,7 @@ namespace
         ErrorCallback m_errorCallback;
 
         static const std::size_t cCHUNK_SIZE = 4096;
-        std::array<char, cCHUNK_SIZE> m_receivedData;
+        StringSpan m_receivedData; // storage provided by m_dispatcher
 
         bool m_receiving = false;
 
@@ -76,20 +76,20 @@ namespace
             m_notificationCallback(notificationCallback),
             m_errorCallback(errorCallback)
         {
-            m_dispatcher.Add<CurrentConfigurationData>([this](const auto& data) -> Error
-            {
-                m_receiving = false;
-                const Converter2C<CurrentConfigurationData> converter (data);
-                m_configurationCallback(0U, converter.CPointer());
-                return{};
+        }
 
-            });
-            m_dispatcher.Add<NotificationData>([this](const auto& data) -> Error
-            {
-                const Converter2C<NotificationData> converter(data);
-                m_notificationCallback(0U, converter.CPointer());
-                return{};
-            });
+        // called through m_dispatcher:
+        void On(const CurrentConfigurationData& data)
+        {
+            m_receiving = false;
+            const Converter2C<CurrentConfigurationData> converter(data);
+            m_configurationCallback(0U, converter.CPointer());
+        }
+
+        void On(const NotificationData& data)
+        {
+            const Converter2C<NotificationData> converter(data);
+            m_notificationCallback(0U, converter.CPointer());
         }
 
         template<class... Ts>
@@ -178,7 +178,8 @@ namespace
 
             while (m_receiving)
             {
-                m_socket.async_receive(asio::buffer(m_receivedData), [this](const boost::system::error_code ecReceive, std::size_t size)
+                m_receivedData = m_dispatcher.ReceiveBuffer(cCHUNK_SIZE);
+                m_socket.async_receive(asio::buffer(m_receivedData.data(), m_receivedData.size()), [this](const boost::system::error_code ecReceive, std::size_t size)
                 {
                     OnAsyncReceive_(ecReceive, size);
                 });
@@ -202,9 +203,9 @@ namespace
                 return GenerateError(EErrorCode::eNETWORK_ERROR, "asio::async_receive: ", ecReceive.message());
             }
 
-            m_service.Trace(ETraceType::eRECEIVED, 0U, StringView{&m_receivedData[0], size});
+            m_service.Trace(ETraceType::eRECEIVED, 0U, StringView{m_receivedData.data(), size});
 
-            if (auto error = m_dispatcher.Dispatch(StringSpan{&m_receivedData[0], size}))
+            if (auto error = m_dispatcher.Dispatch<ConfigurationClientMessageTypes>(StringSpan{m_receivedData.data(), size}, *this))
             {
                 m_receiving = false;
                 m_service.Alarm(0U, EErrorCode::ePEER_ERROR, error.m_text);
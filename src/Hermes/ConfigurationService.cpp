@@ -58,7 +58,8 @@ using namespace Hermes::Implementation;
 
 struct HermesConfigurationService : IAcceptorCallback, IConfigurationServiceSessionCallback
 {
-    Service m_service;
+    std::shared_ptr<Service> m_spService;
+    Service& m_service{*m_spService};
     ConfigurationServiceSettings m_settings;;
 
     // we only hold on to the accepting session
@@ -75,8 +76,8 @@ struct HermesConfigurationService : IAcceptorCallback, IConfigurationServiceSess
 
     bool m_enabled{false};
 
-    HermesConfigurationService(const HermesConfigurationServiceCallbacks& callbacks) :
-        m_service(callbacks.m_traceCallback),
+    HermesConfigurationService(HermesServicePool* pPool, const HermesConfigurationServiceCallbacks& callbacks) :
+        m_spService(std::make_shared<Service>(pPool, callbacks.m_traceCallback)),
         m_connectedCallback(callbacks.m_connectedCallback),
         m_setConfigurationCallback(callbacks.m_setConfigurationCallback),
         m_getConfigurationCallback(callbacks.m_getConfigurationCallback),
@@ -201,7 +202,12 @@ struct HermesConfigurationService : IAcceptorCallback, IConfigurationServiceSess
 
 HermesConfigurationService* CreateHermesConfigurationService(const HermesConfigurationServiceCallbacks* pCallbacks)
 {
-    return new HermesConfigurationService(*pCallbacks);
+    return new HermesConfigurationService(nullptr, *pCallbacks);
+}
+
+HermesConfigurationService* CreateHermesConfigurationServiceOnPool(HermesServicePool* pPool, const HermesConfigurationServiceCallbacks* pCallbacks)
+{
+    return new HermesConfigurationService(pPool, *pCallbacks);
 }
 
 void RunHermesConfigurationService(HermesConfigurationService* pConfigurationService)
@@ -233,6 +239,17 @@ void EnableHermesConfigurationService(HermesConfigurationService* pConfiguration
     });
 }
 
+void SetHermesConfigurationServiceTraceFilter(HermesConfigurationService* pConfigurationService, const HermesTraceFilter* pFilter)
+{
+    pConfigurationService->m_service.SetTraceFilter(ToCpp(*pFilter));
+}
+
+void SetHermesConfigurationServiceBackgroundTrace(HermesConfigurationService* pConfigurationService, const HermesBackgroundTraceSettings* pSettings)
+{
+    pConfigurationService->m_service.Log(0U, "SetHermesConfigurationServiceBackgroundTrace");
+    pConfigurationService->m_service.StartBackgroundTrace(ToCpp(*pSettings));
+}
+
 void SignalHermesCurrentConfiguration(HermesConfigurationService* pConfigurationService, uint32_t sessionId, 
     const HermesCurrentConfigurationData* pConfiguration)
 {
@@ -289,6 +306,5 @@ void DeleteHermesConfigurationService(HermesConfigurationService* pConfiguration
 {
     pConfigurationService->m_service.Log(0U, "DeleteHermesConfigurationService");
 
-    pConfigurationService->m_service.Stop();
-    delete pConfigurationService;
+    Service::Delete(pConfigurationService);
 }
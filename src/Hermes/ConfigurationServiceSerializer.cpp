@@ -40,8 +40,6 @@ namespace Hermes
                 m_service(service),
                 m_socket(socket)
             {
-                m_dispatcher.Add<GetConfigurationData>([this](const auto& data) { m_pCallback->On(data); });
-                m_dispatcher.Add<SetConfigurationData>([this](const auto& data) { m_pCallback->On(data); });
             }
 
             // ISocketCallback
@@ -51,9 +49,14 @@ namespace Hermes
                 m_pCallback->OnSocketConnected(connectionInfo);
             }
 
+            StringSpan ReceiveBuffer(std::size_t size) override
+            {
+                return m_dispatcher.ReceiveBuffer(size);
+            }
+
             void OnReceived(StringSpan xmlData) override
             {
-                auto error = m_dispatcher.Dispatch(xmlData);
+                auto error = m_dispatcher.Dispatch<ConfigurationServiceMessageTypes>(xmlData, *m_pCallback);
                 if (!error)
                     return;
 
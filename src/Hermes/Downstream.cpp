@@ -151,7 +151,8 @@ struct DownstreamCallbackHolder : CallbackHolder<IDownstreamCallback, Downstream
 struct HermesDownstream : IAcceptorCallback, ISessionCallback
 {
     unsigned m_laneId = 0U;
-    Service m_service;
+    std::shared_ptr<Service> m_spService;
+    Service& m_service{*m_spService};
     DownstreamSettings m_settings;
 
     std::unique_ptr<Session> m_upSession;
@@ -161,9 +162,9 @@ struct HermesDownstream : IAcceptorCallback, ISessionCallback
 
     bool m_enabled{false};
 
-    HermesDownstream(unsigned laneId, DownstreamCallbackHolder&& callbacks) :
+    HermesDownstream(HermesServicePool* pPool, unsigned laneId, DownstreamCallbackHolder&& callbacks) :
         m_laneId(laneId),
-        m_service(*callbacks),
+        m_spService(std::make_shared<Service>(pPool, *callbacks)),
         m_callbacks{ callbacks }
     {
         m_service.Inform(0U, "Created");
@@ -194,6 +195,8 @@ struct HermesDownstream : IAcceptorCallback, ISessionCallback
         networkConfiguration.m_port = m_settings.m_port;
         networkConfiguration.m_checkAlivePeriodInSeconds = m_settings.m_checkAlivePeriodInSeconds;
         networkConfiguration.m_retryDelayInSeconds = m_settings.m_reconnectWaitTimeInSeconds;
+        networkConfiguration.m_sendQueueHighWaterMark = m_settings.m_sendQueueHighWaterMark;
+        networkConfiguration.m_socketOptions = m_settings.m_socketOptions;
         
         m_upAcceptor->StartListening(networkConfiguration);
     }
@@ -432,7 +435,70 @@ struct HermesDownstream : IAcceptorCallback, ISessionCallback
 #ifdef HERMES_CPP_ABI
 HermesDownstream* Hermes::CreateHermesDownstream(uint32_t laneId, IDownstreamCallback& callback)
 {
-    return new HermesDownstream(laneId, DownstreamCallbackHolder{ callback });
+    return new HermesDownstream(nullptr, laneId, DownstreamCallbackHolder{ callback });
+}
+
+HermesDownstream* Hermes::CreateHermesDownstream(HermesServicePool* pPool, uint32_t laneId, IDownstreamCallback& callback)
+{
+    return new HermesDownstream(pPool, laneId, DownstreamCallbackHolder{ callback });
+}
+
+namespace
+{
+    template<class DataT>
+    void PostSignal_(HermesDownstream* pDownstream, unsigned sessionId, DataT&& data)
+    {
+        pDownstream->m_service.Log(sessionId, "SignalHermesDownstream ", SerializationTraits<DataT>::cTAG_VIEW);
+        pDownstream->m_service.Post([pDownstream, sessionId, data = std::move(data)]()
+        {
+            pDownstream->Signal(sessionId, data, Serialize(data));
+        });
+    }
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, ServiceDescriptionData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, BoardAvailableData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, RevokeBoardAvailableData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, TransportFinishedData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, BoardForecastData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, SendBoardInfoData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, NotificationData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, CheckAliveData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesDownstream(HermesDownstream* pDownstream, unsigned sessionId, CommandData&& data)
+{
+    PostSignal_(pDownstream, sessionId, std::move(data));
 }
 #else
 #error "HERMES_CPP_ABI should always be defined for building Hermes library"
@@ -440,7 +506,12 @@ HermesDownstream* Hermes::CreateHermesDownstream(uint32_t laneId, IDownstreamCal
 
 HermesDownstream* CreateHermesDownstream(uint32_t laneId, const HermesDownstreamCallbacks* pCallbacks)
 {
-    return new HermesDownstream(laneId, DownstreamCallbackHolder{ *pCallbacks });
+    return new HermesDownstream(nullptr, laneId, DownstreamCallbackHolder{ *pCallbacks });
+}
+
+HermesDownstream* CreateHermesDownstreamOnPool(HermesServicePool* pPool, uint32_t laneId, const HermesDownstreamCallbacks* pCallbacks)
+{
+    return new HermesDownstream(pPool, laneId, DownstreamCallbackHolder{ *pCallbacks });
 }
 
 void RunHermesDownstream(HermesDownstream* pDownstream)
@@ -463,6 +534,17 @@ void EnableHermesDownstream(HermesDownstream* pDownstream, const HermesDownstrea
     });
 }
 
+void SetHermesDownstreamTraceFilter(HermesDownstream* pDownstream, const HermesTraceFilter* pFilter)
+{
+    pDownstream->m_service.SetTraceFilter(ToCpp(*pFilter));
+}
+
+void SetHermesDownstreamBackgroundTrace(HermesDownstream* pDownstream, const HermesBackgroundTraceSettings* pSettings)
+{
+    pDownstream->m_service.Log(0U, "SetHermesDownstreamBackgroundTrace");
+    pDownstream->m_service.StartBackgroundTrace(ToCpp(*pSettings));
+}
+
 void PostHermesDownstream(HermesDownstream* pDownstream, HermesVoidCallback voidCallback)
 {
     pDownstream->m_service.Log(0U, "PostHermesDownstream");
@@ -564,6 +646,28 @@ void ResetHermesDownstream(HermesDownstream* pDownstream, const HermesNotificati
     });
 }
 
+namespace
+{
+    // the messages SignalHermesDownstreamRawXml() recognizes, anything else is sent as a notification
+    using RawXmlMessageTypes = MessageTypes<ServiceDescriptionData, BoardAvailableData, RevokeBoardAvailableData,
+        TransportFinishedData, BoardForecastData, SendBoardInfoData, NotificationData, CheckAliveData>;
+
+    struct RawXmlHandler
+    {
+        HermesDownstream* m_pDownstream;
+        unsigned m_sessionId;
+        StringView m_rawXml;
+        bool m_wasDispatched = false;
+
+        template<class DataT>
+        void On(const DataT& data)
+        {
+            m_wasDispatched = true;
+            m_pDownstream->Signal(m_sessionId, data, m_rawXml);
+        }
+    };
+}
+
 void SignalHermesDownstreamRawXml(HermesDownstream* pDownstream, uint32_t sessionId, HermesStringView rawXml)
 {
     pDownstream->m_service.Log(sessionId, "SignalHermesDownstreamRawXml");
@@ -572,18 +676,9 @@ void SignalHermesDownstreamRawXml(HermesDownstream* pDownstream, uint32_t sessio
         MessageDispatcher dispatcher{sessionId, pDownstream->m_service};
         auto parseData = xmlData;
 
-        bool wasDispatched = false;
-        dispatcher.Add<ServiceDescriptionData>([&](const auto& data) { wasDispatched = true; pDownstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<BoardAvailableData>([&](const auto& data) { wasDispatched = true; pDownstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<RevokeBoardAvailableData>([&](const auto& data) { wasDispatched = true; pDownstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<TransportFinishedData>([&](const auto& data) { wasDispatched = true; pDownstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<BoardForecastData>([&](const auto& data) { wasDispatched = true; pDownstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<SendBoardInfoData>([&](const auto& data) { wasDispatched = true; pDownstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<NotificationData>([&](const auto& data) { wasDispatched = true; pDownstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<CheckAliveData>([&](const auto& data) { wasDispatched = true; pDownstream->Signal(sessionId, data, xmlData); });
-        
-        dispatcher.Dispatch(parseData);
-        if (wasDispatched)
+        RawXmlHandler handler{pDownstream, sessionId, xmlData};
+        dispatcher.Dispatch<RawXmlMessageTypes>(parseData, handler);
+        if (handler.m_wasDispatched)
             return;
 
         pDownstream->Signal(sessionId, NotificationData{}, xmlData);
@@ -627,6 +722,5 @@ void DeleteHermesDownstream(HermesDownstream* pDownstream)
         return;
 
     pDownstream->m_service.Log(0U, "DeleteHermesDownstream");
-    pDownstream->m_service.Stop();
-    delete pDownstream;
+    Service::Delete(pDownstream);
 }
@@ -33,22 +33,14 @@ namespace Hermes
                 IAsioService& m_service;
                 IServerSocket& m_socket;
                 ISerializerCallback* m_pCallback = nullptr;
-                MessageDispatcher m_dispatcher{ m_sessionId, m_service };
+                MessageDispatcher m_dispatcher;
 
-                Serializer(unsigned sessionId, IAsioService& service, IServerSocket& socket) :
+                Serializer(unsigned sessionId, IAsioService& service, IServerSocket& socket, EXmlParserMode parserMode) :
                     m_sessionId(sessionId),
                     m_service(service),
-                    m_socket(socket)
+                    m_socket(socket),
+                    m_dispatcher(sessionId, service, parserMode)
                 {
-                    m_dispatcher.Add<ServiceDescriptionData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<CheckAliveData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<NotificationData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<CommandData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<MachineReadyData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<RevokeMachineReadyData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<StartTransportData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<StopTransportData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<QueryBoardInfoData>([this](const auto& data) { m_pCallback->On(data); });
                 }
 
                 // ISocketCallback
@@ -57,9 +49,14 @@ namespace Hermes
                     m_pCallback->OnSocketConnected(connectionInfo);
                 }
 
+                StringSpan ReceiveBuffer(std::size_t size) override
+                {
+                    return m_dispatcher.ReceiveBuffer(size);
+                }
+
                 void OnReceived(StringSpan xmlData) override
                 {
-                    auto error = m_dispatcher.Dispatch(xmlData);
+                    auto error = m_dispatcher.Dispatch<DownstreamMessageTypes>(xmlData, *m_pCallback);
                     if (!error)
                         return;
 
@@ -98,9 +95,9 @@ namespace Hermes
                     m_socket.Send(message);
                 }
             };
-            std::unique_ptr<ISerializer> CreateSerializer(unsigned sessionId, IAsioService& service, IServerSocket& socket)
+            std::unique_ptr<ISerializer> CreateSerializer(unsigned sessionId, IAsioService& service, IServerSocket& socket, EXmlParserMode parserMode)
             {
-                return std::make_unique<Serializer>(sessionId, service, socket);
+                return std::make_unique<Serializer>(sessionId, service, socket, parserMode);
             }
         }
     }
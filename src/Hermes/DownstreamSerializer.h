@@ -59,7 +59,7 @@ namespace Hermes
                 ~ISerializerCallback() = default;
             };
 
-            std::unique_ptr<ISerializer> CreateSerializer(unsigned sessionId, IAsioService&, IServerSocket&);
+            std::unique_ptr<ISerializer> CreateSerializer(unsigned sessionId, IAsioService&, IServerSocket&, EXmlParserMode);
         }
     }
 }
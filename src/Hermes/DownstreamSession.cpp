@@ -125,7 +125,7 @@ namespace Hermes
             {
                 auto sessionId = upSocket->SessionId();
                 m_spImpl = std::make_shared<Impl>(std::move(upSocket), service, configuration);
-                m_spImpl->m_upSerializer = CreateSerializer(sessionId, service, *m_spImpl->m_upSocket);
+                m_spImpl->m_upSerializer = CreateSerializer(sessionId, service, *m_spImpl->m_upSocket, configuration.m_xmlParserMode);
                 m_spImpl->m_upStateMachine = CreateStateMachine(sessionId, service, *m_spImpl->m_upSerializer, configuration.m_checkState);
             }
 
@@ -0,0 +1,112 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include "IService.h"
+
+#include <boost/asio.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Hermes
+{
+    // the IPv4 address a host name resolves to (as endpoint with port 0) and the name the resolver reports for it
+    struct ResolvedHost
+    {
+        boost::asio::ip::tcp::endpoint m_endpoint;
+        std::string m_hostName;
+    };
+
+    // The host names resolved lately, shared by all services, so that reconnecting sessions do not ask the DNS server each time.
+    // asio does not tell the time to live of the DNS records, so an entry is kept for cTIME_TO_LIVE at most.
+    class ResolveCache
+    {
+    public:
+        using Clock = std::function<std::chrono::steady_clock::time_point()>;
+
+        static constexpr std::chrono::seconds cTIME_TO_LIVE{30};
+
+        explicit ResolveCache(Clock clock = &std::chrono::steady_clock::now) :
+            m_clock(std::move(clock))
+        {}
+
+        ResolveCache(const ResolveCache&) = delete;
+        ResolveCache& operator=(const ResolveCache&) = delete;
+
+        static ResolveCache& Shared()
+        {
+            static ResolveCache sCache;
+            return sCache;
+        }
+
+        bool Find(const std::string& hostName, ResolvedHost& resolvedHost) const
+        {
+            auto now = m_clock();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto itEntry = m_entries.find(hostName);
+            if (itEntry == m_entries.end() || now >= itEntry->second.m_expiry)
+                return false;
+            resolvedHost = itEntry->second.m_resolvedHost;
+            return true;
+        }
+
+        void Insert(const std::string& hostName, const ResolvedHost& resolvedHost)
+        {
+            auto now = m_clock();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // the expired entries go with the next one, so the cache only holds the names asked for lately
+            for (auto itEntry = m_entries.begin(); itEntry != m_entries.end();)
+            {
+                itEntry = now >= itEntry->second.m_expiry ? m_entries.erase(itEntry) : std::next(itEntry);
+            }
+            m_entries[hostName] = Entry{resolvedHost, now + cTIME_TO_LIVE};
+        }
+
+    private:
+        struct Entry
+        {
+            ResolvedHost m_resolvedHost;
+            std::chrono::steady_clock::time_point m_expiry;
+        };
+
+        Clock m_clock;
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, Entry> m_entries;
+    };
+
+    using ResolveHandler = std::function<void(const boost::system::error_code&, const ResolvedHost&)>;
+
+    // Resolves hostName without blocking the service. A literal IPv4 address or a cached name is passed on to the handler
+    // right away, otherwise the handler is called on the executor of the service, unless the service is stopped meanwhile.
+    inline void AsyncResolve(IAsioService& service, const std::string& hostName, ResolveHandler&& handler)
+    {
+        namespace asio = boost::asio;
+
+        boost::system::error_code ecAddress;
+        auto address = asio::ip::make_address_v4(hostName, ecAddress);
+        if (!ecAddress)
+            return handler(boost::system::error_code(), ResolvedHost{asio::ip::tcp::endpoint(address, 0U), hostName});
+
+        ResolvedHost resolvedHost;
+        if (ResolveCache::Shared().Find(hostName, resolvedHost))
+            return handler(boost::system::error_code(), resolvedHost);
+
+        auto spResolver = std::make_shared<asio::ip::tcp::resolver>(service.GetExecutor());
+        spResolver->async_resolve(asio::ip::tcp::v4(), hostName, "", service.Bind(
+            [spResolver, hostName, handler = std::move(handler)](const boost::system::error_code& ec,
+                const asio::ip::tcp::resolver::results_type& results)
+        {
+            if (ec || results.empty())
+                return handler(ec ? ec : asio::error::host_not_found, ResolvedHost());
+
+            const auto& entry = *results.cbegin();
+            ResolvedHost resolvedHost{asio::ip::tcp::endpoint(entry.endpoint().address(), 0U), entry.host_name()};
+            ResolveCache::Shared().Insert(hostName, resolvedHost);
+            handler(ec, resolvedHost);
+        }));
+    }
+}
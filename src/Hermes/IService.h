@@ -20,37 +20,89 @@ limitations under the License.
 #include <HermesData.hpp>
 #include <HermesStringView.hpp>
 
+#include "BackgroundTrace.h"
+#include "IoUring.h"
 #include "StringBuilder.h"
+#include "TimerWheel.h"
 
+#include <exception>
 #include <functional>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include <boost/asio.hpp>
 
 namespace Hermes
 {
+    struct IAsioService;
+    struct AsioSocket;
+
+    // A handler of a service, which is dropped once the service is stopped.
+    // With a service pool, it also keeps the service alive until it is gone, see Service,
+    // and reports an exception escaping from it, e.g. from a callback, as an error of the service
+    // instead of letting it end a thread shared with other services.
+    template<class F>
+    struct ServiceHandler
+    {
+        IAsioService* m_pService;
+        std::shared_ptr<void> m_spKeepAlive;
+        F m_f;
+
+        template<class... Ts>
+        void operator()(Ts&&... args);
+    };
+
     struct IAsioService
     {
         virtual void Post(std::function<void()>&&) = 0;
         virtual void Trace(ETraceType, unsigned sessionId, StringView trace) = 0;
-        virtual boost::asio::io_context& GetUnderlyingService() = 0;
+        // whether traces of that type reach the trace callback; may be called from any thread
+        virtual bool IsTraced(ETraceType) const = 0;
+        // if set, traces are recorded for it instead of being formatted and passed on right away
+        virtual BackgroundTrace* GetBackgroundTrace() = 0;
+        // for the I/O objects of the service; with a service pool a strand, so that the handlers of one service never run concurrently
+        virtual boost::asio::any_io_executor GetExecutor() = 0;
+        // for the timers of the I/O objects of the service, to be used on its executor only
+        virtual TimerWheel& GetTimerWheel() = 0;
+        // for the sockets with ETransport::eIO_URING, to be used on its executor only; nullptr where not supported
+        virtual IoUring* GetIoUring() = 0;
+        virtual bool Stopped() const = 0;
+        // with a service pool, the service outlives its owner as long as a handler is pending
+        virtual std::shared_ptr<void> KeepAlive() = 0;
+        // the sockets still open when the owner is deleted are closed by the service, see Service::Delete
+        virtual void Register(AsioSocket&) = 0;
+        virtual void Unregister(AsioSocket&) = 0;
+
+        template<class F>
+        ServiceHandler<std::decay_t<F>> Bind(F&& f)
+        {
+            return{this, KeepAlive(), std::forward<F>(f)};
+        }
 
+        // the parameters are only formatted if the trace is passed on
         template<class... Ts>
         void Log(unsigned sessionId, const Ts&... params)
         {
-            Trace(ETraceType::eDEBUG, sessionId, BuildString(params...));
+            if (!IsTraced(ETraceType::eDEBUG))
+                return;
+            Trace_(ETraceType::eDEBUG, sessionId, params...);
         }
 
         template<class... Ts>
         void Inform(unsigned sessionId, const Ts&... params)
         {
-            Trace(ETraceType::eINFO, sessionId, BuildString(params...));
+            if (!IsTraced(ETraceType::eINFO))
+                return;
+            Trace_(ETraceType::eINFO, sessionId, params...);
         }
 
         template<class... Ts>
         void Warn(unsigned sessionId, const Ts&... params)
         {
-            Trace(ETraceType::eWARNING, sessionId, BuildString(params...));
+            if (!IsTraced(ETraceType::eWARNING))
+                return;
+            Trace_(ETraceType::eWARNING, sessionId, params...);
         }
 
         template<class... Ts>
@@ -61,14 +113,43 @@ namespace Hermes
             return error;
         }
 
+        template<class... Ts>
+        void Trace_(ETraceType type, unsigned sessionId, const Ts&... params)
+        {
+            if (auto pBackgroundTrace = GetBackgroundTrace())
+                return pBackgroundTrace->Record(type, sessionId, params...);
+            Trace(type, sessionId, BuildString(params...));
+        }
+
 
         virtual ~IAsioService() = default;
     };
     using IAsioServiceSp = std::shared_ptr<IAsioService>;
-}
 
-struct HermesService
-{
-    Hermes::IAsioServiceSp m_spService;
-};
+    template<class F>
+    template<class... Ts>
+    void ServiceHandler<F>::operator()(Ts&&... args)
+    {
+        if (m_pService->Stopped())
+            return;
+        if (!m_spKeepAlive)
+        {
+            m_f(std::forward<Ts>(args)...); // propagates out of Run(), as ever
+            return;
+        }
+
+        try
+        {
+            m_f(std::forward<Ts>(args)...);
+        }
+        catch (const std::exception& ex)
+        {
+            m_pService->Trace(ETraceType::eERROR, 0U, BuildString("Exception in handler: ", ex.what()));
+        }
+        catch (...)
+        {
+            m_pService->Trace(ETraceType::eERROR, 0U, "Unknown exception in handler");
+        }
+    }
+}
 
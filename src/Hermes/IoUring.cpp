@@ -0,0 +1,572 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#include "stdafx.h"
+
+#include "IoUring.h"
+
+#include "IService.h"
+#include "StringBuilder.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+
+#if defined(IORING_RECV_MULTISHOT)
+
+#include <boost/asio.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+
+namespace asio = boost::asio;
+
+namespace Hermes
+{
+    namespace
+    {
+        const unsigned cENTRY_COUNT = 256U;
+        const unsigned cBUFFER_COUNT = 256U; // a power of 2
+        const std::size_t cBUFFER_SIZE = 4096U;
+        const std::uint16_t cBUFFER_GROUP = 0U;
+        // the longest chain of linked sends, so that a chain always fits into one submission
+        const std::size_t cMAX_CHAIN_LENGTH = 32U;
+        // in the low byte of the user data, the connection id goes above
+        const std::uint64_t cRECEIVE = 1U;
+        const std::uint64_t cSEND = 2U;
+
+        int Setup_(unsigned entries, io_uring_params& params)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        }
+
+        int Enter_(int ringFd, unsigned toSubmit, unsigned flags)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, 0U, flags, nullptr, 0U));
+        }
+
+        int Register_(int ringFd, unsigned opcode, void* pArg, unsigned argCount)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, pArg, argCount));
+        }
+
+        // multishot receives came with Linux 6.0, and there is no probing for them
+        bool KernelAtLeast_(int major, int minor)
+        {
+            utsname name;
+            if (::uname(&name))
+                return false;
+            int kernelMajor = 0;
+            int kernelMinor = 0;
+            if (std::sscanf(name.release, "%d.%d", &kernelMajor, &kernelMinor) != 2)
+                return false;
+            return kernelMajor > major || (kernelMajor == major && kernelMinor >= minor);
+        }
+    }
+
+    struct IoUring::Impl
+    {
+        IAsioService& m_service;
+        int m_ringFd = -1;
+        void* m_pRing = MAP_FAILED;
+        std::size_t m_ringSize = 0U;
+        void* m_pSqes = MAP_FAILED;
+        std::size_t m_sqesSize = 0U;
+        void* m_pBufferRing = MAP_FAILED;
+        std::size_t m_bufferRingSize = cBUFFER_COUNT * sizeof(io_uring_buf);
+        std::vector<char> m_buffers;
+
+        // within the mappings:
+        unsigned* m_pSqHead = nullptr;
+        unsigned* m_pSqTail = nullptr;
+        unsigned* m_pSqFlags = nullptr;
+        unsigned* m_pSqArray = nullptr;
+        unsigned m_sqMask = 0U;
+        unsigned m_sqEntryCount = 0U;
+        unsigned* m_pCqHead = nullptr;
+        unsigned* m_pCqTail = nullptr;
+        unsigned m_cqMask = 0U;
+        io_uring_cqe* m_pCqes = nullptr;
+        io_uring_buf* m_pBuffers = nullptr;
+
+        unsigned m_sqeTail = 0U; // ahead of *m_pSqTail by the entries not yet submitted
+        std::uint16_t m_bufferTail = 0U;
+        std::unique_ptr<asio::posix::stream_descriptor> m_upEventDescriptor;
+        std::uint64_t m_eventCount = 0U;
+
+        std::unordered_map<std::uint64_t, IoUringConnectionSp> m_connections;
+        std::vector<IoUringConnectionSp> m_toSubmit;
+        std::uint64_t m_nextId = 1U;
+        bool m_submitPosted = false;
+        std::shared_ptr<int> m_spAlive{std::make_shared<int>(0)}; // for what is posted to the service
+
+        explicit Impl(IAsioService& service) :
+            m_service(service)
+        {}
+
+        ~Impl()
+        {
+            // closing the ring cancels whatever is still in flight
+            m_upEventDescriptor.reset();
+            if (m_ringFd >= 0)
+            {
+                ::close(m_ringFd);
+            }
+            if (m_pBufferRing != MAP_FAILED)
+            {
+                ::munmap(m_pBufferRing, m_bufferRingSize);
+            }
+            if (m_pSqes != MAP_FAILED)
+            {
+                ::munmap(m_pSqes, m_sqesSize);
+            }
+            if (m_pRing != MAP_FAILED)
+            {
+                ::munmap(m_pRing, m_ringSize);
+            }
+        }
+
+        bool Init(std::string& error)
+        {
+            io_uring_params params{};
+            m_ringFd = Setup_(cENTRY_COUNT, params);
+            if (m_ringFd < 0)
+                return Failed_(error, "io_uring_setup");
+            if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_NODROP))
+            {
+                error = "io_uring without IORING_FEAT_SINGLE_MMAP and IORING_FEAT_NODROP";
+                return false;
+            }
+
+            m_ringSize = std::max<std::size_t>(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+            m_pRing = ::mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+            if (m_pRing == MAP_FAILED)
+                return Failed_(error, "mmap of the io_uring");
+            m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            m_pSqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES);
+            if (m_pSqes == MAP_FAILED)
+                return Failed_(error, "mmap of the io_uring entries");
+
+            char* pRing = static_cast<char*>(m_pRing);
+            m_pSqHead = reinterpret_cast<unsigned*>(pRing + params.sq_off.head);
+            m_pSqTail = reinterpret_cast<unsigned*>(pRing + params.sq_off.tail);
+            m_pSqFlags = reinterpret_cast<unsigned*>(pRing + params.sq_off.flags);
+            m_pSqArray = reinterpret_cast<unsigned*>(pRing + params.sq_off.array);
+            m_sqMask = *reinterpret_cast<unsigned*>(pRing + params.sq_off.ring_mask);
+            m_sqEntryCount = params.sq_entries;
+            m_pCqHead = reinterpret_cast<unsigned*>(pRing + params.cq_off.head);
+            m_pCqTail = reinterpret_cast<unsigned*>(pRing + params.cq_off.tail);
+            m_cqMask = *reinterpret_cast<unsigned*>(pRing + params.cq_off.ring_mask);
+            m_pCqes = reinterpret_cast<io_uring_cqe*>(pRing + params.cq_off.cqes);
+            m_sqeTail = *m_pSqTail;
+
+            std::vector<char> probeStorage(sizeof(io_uring_probe) + 256U * sizeof(io_uring_probe_op));
+            auto* pProbe = reinterpret_cast<io_uring_probe*>(probeStorage.data());
+            if (Register_(m_ringFd, IORING_REGISTER_PROBE, pProbe, 256U) < 0)
+                return Failed_(error, "IORING_REGISTER_PROBE");
+            for (unsigned opcode : {IORING_OP_RECV, IORING_OP_SEND})
+            {
+                if (opcode > pProbe->last_op || !(pProbe->ops[opcode].flags & IO_URING_OP_SUPPORTED))
+                {
+                    error = BuildString("io_uring without operation ", opcode);
+                    return false;
+                }
+            }
+
+            m_pBufferRing = ::mmap(nullptr, m_bufferRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (m_pBufferRing == MAP_FAILED)
+                return Failed_(error, "mmap of the buffer ring");
+            io_uring_buf_reg bufferRing{};
+            bufferRing.ring_addr = reinterpret_cast<std::uint64_t>(m_pBufferRing);
+            bufferRing.ring_entries = cBUFFER_COUNT;
+            bufferRing.bgid = cBUFFER_GROUP;
+            if (Register_(m_ringFd, IORING_REGISTER_PBUF_RING, &bufferRing, 1U) < 0)
+                return Failed_(error, "IORING_REGISTER_PBUF_RING");
+            m_pBuffers = static_cast<io_uring_buf*>(m_pBufferRing);
+            m_buffers.resize(cBUFFER_COUNT * cBUFFER_SIZE);
+            for (unsigned bufferId = 0U; bufferId < cBUFFER_COUNT; ++bufferId)
+            {
+                AddBuffer_(static_cast<std::uint16_t>(bufferId));
+            }
+            PublishBuffers_();
+
+            // the completions are signalled through an eventfd, which the reactor of asio can wait for
+            int eventFd = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (eventFd < 0)
+                return Failed_(error, "eventfd");
+            m_upEventDescriptor = std::make_unique<asio::posix::stream_descriptor>(m_service.GetExecutor(), eventFd);
+            if (Register_(m_ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1U) < 0)
+                return Failed_(error, "IORING_REGISTER_EVENTFD");
+            WaitForCompletions_();
+            return true;
+        }
+
+        IoUringConnectionSp Attach(IoUring& ioUring, int socket, IIoUringCallback& callback)
+        {
+            auto spConnection = std::make_shared<IoUringConnection>();
+            spConnection->m_pIoUring = &ioUring;
+            spConnection->m_id = m_nextId++;
+            spConnection->m_socket = socket;
+            spConnection->m_pCallback = &callback;
+            m_connections.emplace(spConnection->m_id, spConnection);
+            Schedule_(*spConnection);
+            return spConnection;
+        }
+
+        void Send(IoUringConnection& connection, std::string&& message)
+        {
+            if (!connection.m_pCallback)
+                return;
+            connection.m_sendQueue.emplace_back(std::move(message));
+            if (!connection.m_sendsInFlight)
+            {
+                Schedule_(connection);
+            }
+        }
+
+        void Detach(IoUringConnection& connection)
+        {
+            connection.m_pCallback = nullptr;
+            connection.m_sendQueue.clear();
+            // submitted right away, before the socket is closed and its descriptor possibly taken by another one
+            Submit_();
+            Release_(connection);
+        }
+
+    private:
+        bool Failed_(std::string& error, const char* what)
+        {
+            error = BuildString(what, ": ", std::strerror(errno));
+            return false;
+        }
+
+        void AddBuffer_(std::uint16_t bufferId)
+        {
+            // not touching resv, which in the first entry is the tail of the ring
+            io_uring_buf& buffer = m_pBuffers[m_bufferTail & (cBUFFER_COUNT - 1U)];
+            buffer.addr = reinterpret_cast<std::uint64_t>(&m_buffers[bufferId * cBUFFER_SIZE]);
+            buffer.len = static_cast<std::uint32_t>(cBUFFER_SIZE);
+            buffer.bid = bufferId;
+            ++m_bufferTail;
+        }
+
+        void PublishBuffers_()
+        {
+            __atomic_store_n(&m_pBuffers[0].resv, m_bufferTail, __ATOMIC_RELEASE);
+        }
+
+        unsigned FreeEntries_() const
+        {
+            return m_sqEntryCount - (m_sqeTail - __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE));
+        }
+
+        io_uring_sqe& NextEntry_()
+        {
+            unsigned index = m_sqeTail & m_sqMask;
+            m_pSqArray[index] = index;
+            ++m_sqeTail;
+            auto& sqe = static_cast<io_uring_sqe*>(m_pSqes)[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            return sqe;
+        }
+
+        // submitted once the handler running is done, together with whatever else it has to submit
+        void Schedule_(IoUringConnection& connection)
+        {
+            if (!connection.m_toSubmit)
+            {
+                connection.m_toSubmit = true;
+                m_toSubmit.emplace_back(m_connections.at(connection.m_id));
+            }
+            if (m_submitPosted)
+                return;
+
+            m_submitPosted = true;
+            m_service.Post([this, wpAlive = std::weak_ptr<int>(m_spAlive)]()
+            {
+                if (wpAlive.expired())
+                    return;
+                m_submitPosted = false;
+                std::vector<IoUringConnectionSp> toSubmit;
+                toSubmit.swap(m_toSubmit);
+                for (auto& spConnection : toSubmit)
+                {
+                    Prepare_(*spConnection);
+                }
+                Submit_();
+            });
+        }
+
+        void Prepare_(IoUringConnection& connection)
+        {
+            connection.m_toSubmit = false;
+            if (!connection.m_pCallback)
+                return;
+
+            if (!connection.m_receiving)
+            {
+                if (!FreeEntries_())
+                {
+                    Submit_();
+                }
+                auto& sqe = NextEntry_();
+                sqe.opcode = IORING_OP_RECV;
+                sqe.fd = connection.m_socket;
+                sqe.ioprio = IORING_RECV_MULTISHOT;
+                sqe.flags = IOSQE_BUFFER_SELECT;
+                sqe.buf_group = cBUFFER_GROUP;
+                sqe.user_data = connection.m_id << 8U | cRECEIVE;
+                connection.m_receiving = true;
+            }
+
+            if (connection.m_sendsInFlight || connection.m_sendQueue.empty())
+                return;
+
+            // m_sending must not change until the kernel is done with it
+            std::size_t chainLength = std::min(connection.m_sendQueue.size(), cMAX_CHAIN_LENGTH);
+            connection.m_sending.clear();
+            connection.m_sending.reserve(chainLength);
+            std::move(connection.m_sendQueue.begin(), connection.m_sendQueue.begin() + chainLength, std::back_inserter(connection.m_sending));
+            connection.m_sendQueue.erase(connection.m_sendQueue.begin(), connection.m_sendQueue.begin() + chainLength);
+            if (FreeEntries_() < chainLength)
+            {
+                Submit_();
+            }
+            for (std::size_t i = 0U; i < chainLength; ++i)
+            {
+                const auto& message = connection.m_sending[i];
+                auto& sqe = NextEntry_();
+                sqe.opcode = IORING_OP_SEND;
+                sqe.fd = connection.m_socket;
+                sqe.addr = reinterpret_cast<std::uint64_t>(message.data());
+                sqe.len = static_cast<std::uint32_t>(message.size());
+                sqe.msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+                sqe.flags = i + 1U < chainLength ? IOSQE_IO_LINK : 0U;
+                sqe.user_data = connection.m_id << 8U | cSEND;
+            }
+            // the rest of the queue goes once this chain is done
+            connection.m_sendsInFlight = chainLength;
+        }
+
+        void Submit_()
+        {
+            unsigned toSubmit = m_sqeTail - __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE);
+            if (!toSubmit)
+                return;
+
+            __atomic_store_n(m_pSqTail, m_sqeTail, __ATOMIC_RELEASE);
+            if (Enter_(m_ringFd, toSubmit, 0U) < 0 && errno != EAGAIN && errno != EBUSY)
+            {
+                m_service.Warn(0U, "io_uring_enter: ", std::strerror(errno));
+            }
+        }
+
+        void WaitForCompletions_()
+        {
+            m_upEventDescriptor->async_read_some(asio::buffer(&m_eventCount, sizeof(m_eventCount)),
+                m_service.Bind([this](const boost::system::error_code& ec, std::size_t)
+            {
+                if (ec)
+                {
+                    if (ec != asio::error::operation_aborted)
+                    {
+                        m_service.Warn(0U, "Waiting for io_uring completions: ", ec.message());
+                    }
+                    return;
+                }
+                Reap_();
+                WaitForCompletions_();
+            }));
+        }
+
+        void Reap_()
+        {
+            for (;;)
+            {
+                unsigned head = *m_pCqHead;
+                unsigned tail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+                if (head == tail)
+                {
+                    // the completions which did not fit are kept by the kernel until asked for
+                    if (!(__atomic_load_n(m_pSqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW))
+                        return;
+                    Enter_(m_ringFd, 0U, IORING_ENTER_GETEVENTS);
+                    continue;
+                }
+                for (; head != tail; ++head)
+                {
+                    io_uring_cqe cqe = m_pCqes[head & m_cqMask];
+                    __atomic_store_n(m_pCqHead, head + 1U, __ATOMIC_RELEASE);
+                    Complete_(cqe);
+                }
+            }
+        }
+
+        void Complete_(const io_uring_cqe& cqe)
+        {
+            auto itConnection = m_connections.find(cqe.user_data >> 8U);
+            if (itConnection == m_connections.end())
+                return;
+
+            IoUringConnectionSp spConnection = itConnection->second;
+            auto& connection = *spConnection;
+            if ((cqe.user_data & 0xFFU) == cRECEIVE)
+            {
+                if (!(cqe.flags & IORING_CQE_F_MORE))
+                {
+                    connection.m_receiving = false;
+                }
+                if (cqe.flags & IORING_CQE_F_BUFFER)
+                {
+                    auto bufferId = static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                    if (cqe.res > 0 && connection.m_pCallback)
+                    {
+                        connection.m_pCallback->OnIoUringReceived(StringView(&m_buffers[bufferId * cBUFFER_SIZE],
+                            static_cast<std::size_t>(cqe.res)));
+                    }
+                    AddBuffer_(bufferId);
+                    PublishBuffers_();
+                }
+                else if (cqe.res == 0)
+                {
+                    Fail_(connection, asio::error::eof);
+                }
+                else if (cqe.res < 0 && cqe.res != -ENOBUFS)
+                {
+                    // -ENOBUFS: all the buffers are taken for the moment, the receive starts anew
+                    Fail_(connection, boost::system::error_code(-cqe.res, boost::system::system_category()));
+                }
+            }
+            else
+            {
+                // the sends of a chain complete in order
+                const auto& message = connection.m_sending[connection.m_sending.size() - connection.m_sendsInFlight];
+                --connection.m_sendsInFlight;
+                if (cqe.res < 0)
+                {
+                    // the sends linked to a failed one are cancelled
+                    if (cqe.res != -ECANCELED)
+                    {
+                        Fail_(connection, boost::system::error_code(-cqe.res, boost::system::system_category()));
+                    }
+                }
+                else if (static_cast<std::size_t>(cqe.res) != message.size())
+                {
+                    Fail_(connection, asio::error::broken_pipe);
+                }
+                else if (connection.m_pCallback)
+                {
+                    connection.m_pCallback->OnIoUringSent(message);
+                }
+                if (!connection.m_sendsInFlight)
+                {
+                    connection.m_sending.clear();
+                }
+            }
+
+            if (connection.m_pCallback && !connection.m_toSubmit
+                && (!connection.m_receiving || (!connection.m_sendsInFlight && !connection.m_sendQueue.empty())))
+            {
+                Schedule_(connection);
+            }
+            Release_(connection);
+        }
+
+        void Fail_(IoUringConnection& connection, const boost::system::error_code& ec)
+        {
+            auto* pCallback = connection.m_pCallback;
+            connection.m_pCallback = nullptr;
+            connection.m_sendQueue.clear();
+            if (pCallback)
+            {
+                pCallback->OnIoUringError(ec);
+            }
+        }
+
+        // the connection goes once detached and nothing is in flight any more
+        void Release_(IoUringConnection& connection)
+        {
+            if (connection.m_pCallback || connection.m_receiving || connection.m_sendsInFlight)
+                return;
+            m_connections.erase(connection.m_id);
+        }
+    };
+
+    std::unique_ptr<IoUring> IoUring::Create(IAsioService& service, std::string& error)
+    {
+        if (!KernelAtLeast_(6, 0))
+        {
+            error = "multishot receives need Linux 6.0 or later";
+            return nullptr;
+        }
+
+        auto upImpl = std::make_unique<Impl>(service);
+        if (!upImpl->Init(error))
+            return nullptr;
+        return std::unique_ptr<IoUring>(new IoUring(std::move(upImpl)));
+    }
+
+    IoUring::IoUring(std::unique_ptr<Impl>&& upImpl) :
+        m_upImpl(std::move(upImpl))
+    {}
+
+    IoUring::~IoUring() = default;
+
+    IoUringConnectionSp IoUring::Attach(int socket, IIoUringCallback& callback)
+    {
+        return m_upImpl->Attach(*this, socket, callback);
+    }
+
+    void IoUringConnection::Send(std::string&& message)
+    {
+        m_pIoUring->m_upImpl->Send(*this, std::move(message));
+    }
+
+    void IoUringConnection::Detach()
+    {
+        m_pIoUring->m_upImpl->Detach(*this);
+    }
+}
+
+#else
+
+namespace Hermes
+{
+    struct IoUring::Impl
+    {};
+
+    std::unique_ptr<IoUring> IoUring::Create(IAsioService&, std::string& error)
+    {
+        error = "io_uring is only available on Linux";
+        return nullptr;
+    }
+
+    IoUring::IoUring(std::unique_ptr<Impl>&& upImpl) :
+        m_upImpl(std::move(upImpl))
+    {}
+
+    IoUring::~IoUring() = default;
+
+    IoUringConnectionSp IoUring::Attach(int, IIoUringCallback&)
+    {
+        return nullptr;
+    }
+
+    void IoUringConnection::Send(std::string&&)
+    {}
+
+    void IoUringConnection::Detach()
+    {}
+}
+
+#endif
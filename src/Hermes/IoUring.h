@@ -0,0 +1,82 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include <HermesStringView.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Hermes
+{
+    struct IAsioService;
+
+    // what an io_uring connection reports, on the executor of the service
+    struct IIoUringCallback
+    {
+        // the data is only valid during the call
+        virtual void OnIoUringReceived(StringView data) = 0;
+        // a message has gone out as a whole, likewise only valid during the call
+        virtual void OnIoUringSent(StringView message) = 0;
+        // the last callback, also when the peer has closed the connection (eof)
+        virtual void OnIoUringError(const boost::system::error_code&) = 0;
+
+    protected:
+        ~IIoUringCallback() {}
+    };
+
+    class IoUring;
+
+    // A connected socket on the io_uring of a service. The sends of a connection are linked, so that they go out in order,
+    // and a new chain starts once the one before has completed. The socket itself stays with its owner.
+    class IoUringConnection
+    {
+    public:
+        void Send(std::string&& message);
+        // no more callbacks; the owner then shuts down the socket, which ends the receive in flight
+        void Detach();
+
+    private:
+        friend class IoUring;
+
+        IoUring* m_pIoUring = nullptr;
+        std::uint64_t m_id = 0U;
+        int m_socket = -1;
+        IIoUringCallback* m_pCallback = nullptr;
+        std::vector<std::string> m_sendQueue;
+        std::vector<std::string> m_sending; // until the kernel is done with them
+        std::size_t m_sendsInFlight = 0U;
+        bool m_receiving = false;
+        bool m_toSubmit = false;
+    };
+    using IoUringConnectionSp = std::shared_ptr<IoUringConnection>;
+
+    // The io_uring of a service, whose sockets receive with a multishot receive each into the buffers of a shared
+    // buffer ring, so that an idle socket does not hold any. Its submissions are gathered until the handler running
+    // is done, and its completions are reaped when an eventfd signals them on the executor of the service.
+    // Linux only, as the kernel must support io_uring with provided buffer rings and multishot receives (6.0 and later).
+    class IoUring
+    {
+    public:
+        // nullptr, with the reason in error, where not supported
+        static std::unique_ptr<IoUring> Create(IAsioService&, std::string& error);
+
+        ~IoUring();
+
+        IoUring(const IoUring&) = delete;
+        IoUring& operator=(const IoUring&) = delete;
+
+        IoUringConnectionSp Attach(int socket, IIoUringCallback&);
+
+    private:
+        friend class IoUringConnection;
+        struct Impl;
+
+        explicit IoUring(std::unique_ptr<Impl>&&);
+
+        std::unique_ptr<Impl> m_upImpl;
+    };
+}
@@ -2,56 +2,11 @@
 
 #include "MessageDispatcher.h"
 
-namespace
-{
-    const std::string cHERMES = "Hermes";
-    const std::size_t cHERMES_SIZE = 6U;
-    const std::string cHERMES_END_TAG = "</Hermes";
-}
+#include <cassert>
+#include <cstring>
 
 namespace Hermes
 {
-    StringSpan TakeMessage_(StringSpan& buffer)
-    {
-        // find "<Hermes" removing everything that is encountered until then:
-        for (;;)
-        {
-            std::size_t startIndex = buffer.find('<');
-            if (startIndex == std::string::npos)
-            {
-                buffer = StringSpan{};
-                return{};
-            }
-            if (startIndex != 0)
-            {
-                buffer = StringSpan{buffer.data() + startIndex, buffer.size() - startIndex};
-            }
-
-            if (buffer.size() < 1U + cHERMES_SIZE)
-                return{};
-
-            if (buffer.compare(1U, cHERMES_SIZE, cHERMES) == 0)
-                break;
-
-            buffer = buffer.substr(1U);
-        }
-
-        // find the ending "</Hermes"
-        std::size_t endTagIndex = buffer.find(cHERMES_END_TAG);
-        if (endTagIndex == std::string::npos)
-            return{};
-
-        // ... and the final '>'
-        std::size_t endIndex = buffer.find('>', endTagIndex + cHERMES_END_TAG.size());
-        if (endIndex == std::string::npos)
-            return{};
-
-        auto msgBuffer = buffer.substr(0U, endIndex + 1);
-        buffer = buffer.substr(endIndex + 1);
-
-        return msgBuffer;
-    }
-
     Error ParseXmlMessage_(StringSpan message, pugi::xml_document* pDoc, pugi::xml_node* pNode)
     {
         auto parseResult = pDoc->load_buffer_inplace(message.data(), message.size(), pugi::parse_default, pugi::encoding_utf8);
@@ -66,55 +21,114 @@ namespace Hermes
         return{};
     }
 
-    void MessageDispatcher::Add(StringView tag, Callback&& callback)
+    StringSpan MessageDispatcher::ReceiveBuffer(std::size_t size)
     {
-        m_map.emplace(tag, std::move(callback));
+        if (m_buffer.size() < m_size + size)
+        {
+            m_buffer.resize(m_size + size);
+        }
+        return{&m_buffer[m_size], size};
     }
 
-    Error MessageDispatcher::Dispatch(StringSpan xmlData)
+    Error MessageDispatcher::Dispatch_(StringSpan xmlData, const MessageTable& table, void* pHandler)
     {
-        if (!m_buffer.empty())
+        bool inBuffer = false;
+        if (m_size < m_buffer.size() && xmlData.data() == &m_buffer[m_size])
         {
+            // received straight into our storage, see ReceiveBuffer()
+            assert(m_size + xmlData.size() <= m_buffer.size());
+            m_size += xmlData.size();
+            xmlData = StringSpan{&m_buffer[0], m_size};
+            inBuffer = true;
+        }
+        else if (m_size)
+        {
+            m_buffer.resize(m_size);
             m_buffer.append(xmlData.data(), xmlData.size());
-            xmlData = m_buffer;
+            m_size = m_buffer.size();
+            xmlData = StringSpan{&m_buffer[0], m_size};
+            inBuffer = true;
         }
 
-        for (StringSpan xmlMessage = TakeMessage_(xmlData); !xmlMessage.empty(); xmlMessage = TakeMessage_(xmlData))
+        // the limit holds for complete messages as well as for pending data, however the data comes in:
+        for (StringSpan xmlMessage = m_framer.TakeMessage(xmlData); !xmlMessage.empty(); xmlMessage = m_framer.TakeMessage(xmlData))
         {
-            pugi::xml_document xmlDocument;
+            if (xmlMessage.size() > cMAX_MESSAGE_SIZE)
+                return{EErrorCode::ePEER_ERROR, ": Maximum message size exceeded"};
+
+            if (m_parserMode == EXmlParserMode::eSTREAMING)
+            {
+                if (auto error = DispatchStreaming_(xmlMessage, table, pHandler))
+                    return error;
+                continue;
+            }
+
+            // the previous message is done with, load_buffer_inplace() resets m_document:
             pugi::xml_node dataNode;
-            if (auto error = ParseXmlMessage_(xmlMessage, &xmlDocument, &dataNode))
+            if (auto error = ParseXmlMessage_(xmlMessage, &m_document, &dataNode))
                 return error;
 
             StringView tag = dataNode.name();
-            auto itFound = m_map.find(tag.data());
-            if (itFound == m_map.end())
+            const MessageEntry* pEntry = table.Find(tag);
+            if (!pEntry)
             {
                 m_service.Warn(m_sessionId, "Unexpected message ", tag);
                 continue;
             }
-            if (auto error = (itFound->second)(dataNode))
+            if (auto error = pEntry->m_function(pHandler, dataNode, m_service, m_sessionId))
                 return error;
         }
 
         if (xmlData.size() > cMAX_MESSAGE_SIZE)
             return{EErrorCode::ePEER_ERROR, ": Maximum message size exceeded"};
 
-        // do the housekeeping for the buffer and the view into it:
+        // do the housekeeping for the buffer and the view into it, keeping the storage for the next receive:
         if (xmlData.empty())
         {
-            m_buffer.clear();
+            m_size = 0U;
         }
-        else if (m_buffer.empty())
+        else if (!inBuffer)
         {
-            m_buffer.assign(xmlData.data(), xmlData.size());
+            m_size = 0U;
+            ReceiveBuffer(xmlData.size());
+            std::memcpy(&m_buffer[0], xmlData.data(), xmlData.size());
+            m_size = xmlData.size();
         }
         else // view and buffer overlap
         {
-            m_buffer.erase(0U, xmlData.data() - m_buffer.data());
+            std::memmove(&m_buffer[0], xmlData.data(), xmlData.size());
+            m_size = xmlData.size();
         }
         return{};
     }
 
-}
+    Error MessageDispatcher::DispatchStreaming_(StringSpan xmlMessage, const MessageTable& table, void* pHandler)
+    {
+        m_reader.Reset(xmlMessage);
+        auto token = m_reader.Next(); // the envelope
+        if (token == XmlReader::EToken::eSTART_ELEMENT)
+        {
+            token = m_reader.Next();
+        }
+        // as with pugixml, text in front of the message element takes its place:
+        bool text = m_reader.SkippedText();
+        if (token != XmlReader::EToken::eSTART_ELEMENT && !text)
+        {
+            if (auto error = m_reader.Finish())
+                return error;
+            return Error{EErrorCode::eCLIENT_ERROR, std::string("Missing message type node")};
+        }
 
+        StringView tag = text ? StringView{} : m_reader.Name();
+        const MessageEntry* pEntry = text ? nullptr : table.Find(tag);
+        if (!pEntry)
+        {
+            if (auto error = m_reader.Finish())
+                return error;
+            m_service.Warn(m_sessionId, "Unexpected message ", tag);
+            return{};
+        }
+        return pEntry->m_streamingFunction(pHandler, m_reader, m_service, m_sessionId);
+    }
+
+}
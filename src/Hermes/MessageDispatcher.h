@@ -1,13 +1,13 @@
 #pragma once
 
 #include "IService.h"
-#include "MessageSerialization.h"
+#include "MessageFramer.h"
+#include "MessageRegistry.h"
 #include "StringSpan.h"
+#include "XmlReader.h"
 
 #include <pugixml.hpp>
 
-#include <functional>
-#include <map>
 
 namespace Hermes
 {
@@ -17,7 +17,9 @@ namespace Hermes
     {
     public:
 
-        explicit MessageDispatcher(unsigned sessionId, IAsioService& asioService) :
+        explicit MessageDispatcher(unsigned sessionId, IAsioService& asioService,
+            EXmlParserMode parserMode = EXmlParserMode::eDOM) :
+            m_parserMode(parserMode),
             m_sessionId(sessionId),
             m_service(asioService)
         {}
@@ -27,31 +29,34 @@ namespace Hermes
 
         ~MessageDispatcher() = default;
 
-        using Callback = std::function<Error(pugi::xml_node)>;
+        // Hands out writable storage at the end of the reassembly buffer, so that a socket can receive
+        // directly into it. Passing the received part of this span to Dispatch() avoids any copy.
+        StringSpan ReceiveBuffer(std::size_t size);
 
-        void Add(StringView tag, Callback&& callback);
-        Error Dispatch(StringSpan input);
+        // calls handler.On(data) for each complete message among MessagesT, see MessageRegistry.h
+        template<class MessagesT, class HandlerT>
+        Error Dispatch(StringSpan input, HandlerT& handler)
+        {
+            return Dispatch_(input, MessageTable::Of<MessagesT, HandlerT>(), &handler);
+        }
 
-        template<class DataT, class CallbackT>
-        void Add(CallbackT&& callback)
+        // drops an incomplete message left over from previous calls to Dispatch(), but keeps the storage
+        void Reset()
         {
-            Add(SerializationTraits<DataT>::cTAG_VIEW,
-                [this, callback = std::forward<CallbackT>(callback)](pugi::xml_node xmlNode)->Error
-            {
-                DataT data;
-                auto error = Deserialize(xmlNode, data);
-                if (error)
-                    return error;
-                m_service.Log(m_sessionId, SerializationTraits<DataT>::cTAG_VIEW, ':', data);
-                callback(data);
-                return{};
-            });
+            m_size = 0U;
+            m_framer.Reset();
         }
 
     private:
+        Error Dispatch_(StringSpan input, const MessageTable&, void* pHandler);
+        Error DispatchStreaming_(StringSpan xmlMessage, const MessageTable&, void* pHandler);
 
+        EXmlParserMode m_parserMode;
         std::string m_buffer;
-        std::map<std::string, std::function<Error(pugi::xml_node)>, std::less<>> m_map;
+        std::size_t m_size = 0U; // the valid part of m_buffer, the rest is receive storage
+        MessageFramer m_framer; // resumes where the previous Dispatch() stopped scanning m_buffer
+        pugi::xml_document m_document; // reused for every message, which is parsed in place in m_buffer
+        XmlReader m_reader; // used instead of m_document with EXmlParserMode::eSTREAMING
         unsigned m_sessionId;
         IAsioService& m_service;
     };
@@ -0,0 +1,716 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include <HermesStringView.hpp>
+#include <HermesData.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Hermes
+{
+    // Describes how the members of the Hermes data types map onto xml, so that readers can be written once
+    // for all the types: every entry names an attribute (for plain values) or a child element (for structures),
+    // in the order the standard lists them. Optional<> members are optional, all others are required,
+    // unless the field comes with OptionalTraits of its own.
+    template<class T>
+    struct OptionalTraits;
+
+    template<class T, class MemberT, class TraitsT = OptionalTraits<MemberT>>
+    struct Field
+    {
+        using Traits = TraitsT;
+        const char* m_name;
+        MemberT T::* m_pMember;
+    };
+
+    template<class T, class MemberT>
+    constexpr Field<T, MemberT> MakeField(const char* name, MemberT T::* pMember)
+    {
+        return{name, pMember};
+    }
+
+    template<class T>
+    struct Fields;
+
+    // Lists are elements with one child element per item.
+    template<class T>
+    struct ListTraits;
+
+    template<> struct ListTraits<SubBoards>
+    {
+        static constexpr const char* cITEM = "SB";
+        static constexpr bool cOPTIONAL = true; // SubBoards are special in that they are optional vectors
+    };
+
+    template<> struct ListTraits<UpstreamConfigurations>
+    {
+        static constexpr const char* cITEM = "UpstreamConfiguration";
+        static constexpr bool cOPTIONAL = false;
+    };
+
+    template<> struct ListTraits<DownstreamConfigurations>
+    {
+        static constexpr const char* cITEM = "DownstreamConfiguration";
+        static constexpr bool cOPTIONAL = false;
+    };
+
+    template<class T>
+    struct OptionalTraits
+    {
+        using Value = T;
+        static constexpr bool cOPTIONAL = false;
+        static T& Emplace(T& value) { return value; }
+        static const T* Get(const T& value) { return &value; }
+    };
+
+    template<class T>
+    struct OptionalTraits<Optional<T>>
+    {
+        using Value = T;
+        static constexpr bool cOPTIONAL = true;
+        static T& Emplace(Optional<T>& value) { return *value.emplace(); }
+        static const T* Get(const Optional<T>& value) { return value ? &*value : nullptr; }
+    };
+
+    template<class T, class = void>
+    struct IsList : std::false_type {};
+    template<class T>
+    struct IsList<T, decltype(void(ListTraits<T>::cITEM))> : std::true_type {};
+
+    template<class T, class = void>
+    struct HasFields : std::false_type {};
+    template<class T>
+    struct HasFields<T, decltype(void(Fields<T>::cFIELDS))> : std::true_type {};
+
+    template<class T>
+    constexpr std::size_t FieldCount()
+    {
+        return std::tuple_size<std::remove_const_t<decltype(Fields<T>::cFIELDS)>>::value;
+    }
+
+    // the xml kind of field I of T
+    template<class T, std::size_t I>
+    struct FieldTraits
+    {
+        static constexpr const auto& cFIELD = std::get<I>(Fields<T>::cFIELDS);
+        using Optionality = typename std::decay_t<decltype(cFIELD)>::Traits;
+        using Value = typename Optionality::Value;
+
+        static constexpr bool cLIST = IsList<Value>::value;
+        static constexpr bool cATTRIBUTE = !cLIST && !HasFields<Value>::value;
+        static constexpr bool IsRequired()
+        {
+            if constexpr (cLIST)
+                return !ListTraits<Value>::cOPTIONAL;
+            else
+                return !Optionality::cOPTIONAL;
+        }
+
+        // the value to read into, an Optional<> gets one
+        static Value& Emplace(T& data) { return Optionality::Emplace(data.*cFIELD.m_pMember); }
+        // the value to write, if any
+        static const Value* Get(const T& data) { return Optionality::Get(data.*cFIELD.m_pMember); }
+    };
+
+    // Finds the field for an attribute or element name with one hash and one string comparison:
+    // the hash is perfect on the field names of T, thanks to a seed that is searched at compile time.
+    constexpr std::uint32_t HashFieldName(const char* name, std::size_t size, std::uint32_t seed)
+    {
+        std::uint32_t hash = 2166136261U ^ seed; // FNV-1a, with a final mix, as only the low bits are used
+        for (std::size_t i = 0U; i < size; ++i)
+        {
+            hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619U;
+        }
+        hash ^= hash >> 15U;
+        hash *= 0x2c1b3c6dU;
+        return hash ^ (hash >> 12U);
+    }
+
+    template<std::size_t N>
+    struct FieldNameTable
+    {
+        static constexpr std::size_t SlotCount()
+        {
+            std::size_t slots = 1U;
+            while (slots < 4U * N)
+            {
+                slots *= 2U;
+            }
+            return slots;
+        }
+        static constexpr std::size_t cSLOTS = SlotCount();
+        static constexpr std::uint8_t cEMPTY = 0xFFU;
+        static_assert(N < cEMPTY, "field indices are stored as bytes");
+
+        std::uint32_t m_seed;
+        std::uint8_t m_slots[cSLOTS];
+    };
+
+    template<std::size_t N>
+    constexpr FieldNameTable<N> MakeFieldNameTable(const std::array<const char*, N>& names)
+    {
+        using Table = FieldNameTable<N>;
+        for (std::uint32_t seed = 0U;; ++seed)
+        {
+            Table table{seed, {}};
+            for (auto& slot : table.m_slots)
+            {
+                slot = Table::cEMPTY;
+            }
+            bool collision = false;
+            for (std::size_t i = 0U; i < N && !collision; ++i)
+            {
+                std::size_t size = 0U;
+                while (names[i][size])
+                {
+                    ++size;
+                }
+                auto& slot = table.m_slots[HashFieldName(names[i], size, seed) & (Table::cSLOTS - 1U)];
+                collision = slot != Table::cEMPTY;
+                slot = static_cast<std::uint8_t>(i);
+            }
+            if (!collision)
+                return table;
+        }
+    }
+
+    template<class T, std::size_t... Is>
+    constexpr std::array<const char*, sizeof...(Is)> FieldNames(std::index_sequence<Is...>)
+    {
+        return{{std::get<Is>(Fields<T>::cFIELDS).m_name...}};
+    }
+
+    template<class T>
+    struct FieldIndex
+    {
+        static constexpr std::size_t cNONE = static_cast<std::size_t>(-1);
+
+        // for zero terminated names
+        static std::size_t Find(const char* name)
+        {
+            return Find(StringView{name, std::strlen(name)});
+        }
+
+        static std::size_t Find(StringView name)
+        {
+            std::uint32_t hash = HashFieldName(name.data(), name.size(), cTABLE.m_seed);
+            return Check_(cTABLE.m_slots[hash & (Table::cSLOTS - 1U)], name.data(), name.size());
+        }
+
+    private:
+        using Table = FieldNameTable<FieldCount<T>()>;
+        static constexpr auto cNAMES = FieldNames<T>(std::make_index_sequence<FieldCount<T>()>());
+        static constexpr Table cTABLE = MakeFieldNameTable(cNAMES);
+
+        static std::size_t Check_(std::uint8_t index, const char* name, std::size_t size)
+        {
+            if (index == Table::cEMPTY)
+                return cNONE;
+            const char* fieldName = cNAMES[index];
+            if (std::strncmp(fieldName, name, size) != 0 || fieldName[size] != '\0')
+                return cNONE;
+            return index;
+        }
+    };
+
+    template<> struct Fields<SubBoard>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("Pos", &SubBoard::m_pos),
+            MakeField("Bc", &SubBoard::m_optionalBc),
+            MakeField("St", &SubBoard::m_st));
+    };
+
+    template<> struct Fields<FeatureBoardForecast>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureCheckAliveResponse>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureQueryBoardInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureSendBoardInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureCommand>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<SupportedFeatures>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("FeatureBoardForecast", &SupportedFeatures::m_optionalFeatureBoardForecast),
+            MakeField("FeatureCheckAliveResponse", &SupportedFeatures::m_optionalFeatureCheckAliveResponse),
+            MakeField("FeatureQueryBoardInfo", &SupportedFeatures::m_optionalFeatureQueryBoardInfo),
+            MakeField("FeatureSendBoardInfo", &SupportedFeatures::m_optionalFeatureSendBoardInfo),
+            MakeField("FeatureCommand", &SupportedFeatures::m_optionalFeatureCommand));
+    };
+
+    template<> struct Fields<UpstreamConfiguration>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("UpstreamLaneId", &UpstreamConfiguration::m_upstreamLaneId),
+            MakeField("UpstreamInterfaceId", &UpstreamConfiguration::m_optionalUpstreamInterfaceId),
+            MakeField("HostAddress", &UpstreamConfiguration::m_hostAddress),
+            MakeField("Port", &UpstreamConfiguration::m_port));
+    };
+
+    template<> struct Fields<DownstreamConfiguration>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("DownstreamLaneId", &DownstreamConfiguration::m_downstreamLaneId),
+            MakeField("DownstreamInterfaceId", &DownstreamConfiguration::m_optionalDownstreamInterfaceId),
+            MakeField("ClientAddress", &DownstreamConfiguration::m_optionalClientAddress),
+            MakeField("Port", &DownstreamConfiguration::m_port));
+    };
+
+    template<> struct Fields<FeatureConfiguration>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureBoardTracking>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureQueryWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureSendWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureReplyWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureQueryHermesCapabilities>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<FeatureSendHermesCapabilities>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<SupervisoryFeatures>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("FeatureConfiguration", &SupervisoryFeatures::m_optionalFeatureConfiguration),
+            MakeField("FeatureCheckAliveResponse", &SupervisoryFeatures::m_optionalFeatureCheckAliveResponse),
+            MakeField("FeatureBoardTracking", &SupervisoryFeatures::m_optionalFeatureBoardTracking),
+            MakeField("FeatureQueryWorkOrderInfo", &SupervisoryFeatures::m_optionalFeatureQueryWorkOrderInfo),
+            MakeField("FeatureSendWorkOrderInfo", &SupervisoryFeatures::m_optionalFeatureSendWorkOrderInfo),
+            MakeField("FeatureReplyWorkOrderInfo", &SupervisoryFeatures::m_optionalFeatureReplyWorkOrderInfo),
+            MakeField("FeatureQueryHermesCapabilities", &SupervisoryFeatures::m_optionalFeatureQueryHermesCapabilities),
+            MakeField("FeatureSendHermesCapabilities", &SupervisoryFeatures::m_optionalFeatureSendHermesCapabilities));
+    };
+
+    template<> struct Fields<MessageCheckAliveResponse>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MessageBoardForecast>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MessageQueryBoardInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MessageSendBoardInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MessageBoardArrived>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MessageBoardDeparted>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MessageQueryWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MessageReplyWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MessageCommand>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<OptionalMessages>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("MessageCheckAliveResponse", &OptionalMessages::m_optionalMessageCheckAliveResponse),
+            MakeField("MessageBoardForecast", &OptionalMessages::m_optionalMessageBoardForecast),
+            MakeField("MessageQueryBoardInfo", &OptionalMessages::m_optionalMessageQueryBoardInfo),
+            MakeField("MessageSendBoardInfo", &OptionalMessages::m_optionalMessageSendBoardInfo),
+            MakeField("MessageBoardArrived", &OptionalMessages::m_optionalMessageBoardArrived),
+            MakeField("MessageBoardDeparted", &OptionalMessages::m_optionalMessageBoardDeparted),
+            MakeField("MessageQueryWorkOrderInfo", &OptionalMessages::m_optionalMessageQueryWorkOrderInfo),
+            MakeField("MessageReplyWorkOrderInfo", &OptionalMessages::m_optionalMessageReplyWorkOrderInfo),
+            MakeField("MessageCommand", &OptionalMessages::m_optionalMessageCommand));
+    };
+
+    template<> struct Fields<Attributes>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("ProductTypeId", &Attributes::m_productTypeId),
+            MakeField("TopBarcode", &Attributes::m_topBarcode),
+            MakeField("BottomBarcode", &Attributes::m_bottomBarcode),
+            MakeField("Length", &Attributes::m_length),
+            MakeField("Width", &Attributes::m_width),
+            MakeField("Thickness", &Attributes::m_thickness),
+            MakeField("ConveyorSpeed", &Attributes::m_conveyorSpeed),
+            MakeField("TopClearanceHeight", &Attributes::m_topClearanceHeight),
+            MakeField("BottomClearanceHeight", &Attributes::m_bottomClearanceHeight),
+            MakeField("Weight", &Attributes::m_weight),
+            MakeField("WorkOrderId", &Attributes::m_workOrderId),
+            MakeField("BatchId", &Attributes::m_batchId),
+            MakeField("Route", &Attributes::m_route),
+            MakeField("Action", &Attributes::m_action),
+            MakeField("SubBoards", &Attributes::m_subBoards));
+    };
+
+    template<> struct Fields<ServiceDescriptionData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("LaneId", &ServiceDescriptionData::m_laneId),
+            MakeField("MachineId", &ServiceDescriptionData::m_machineId),
+            MakeField("InterfaceId", &ServiceDescriptionData::m_optionalInterfaceId),
+            MakeField("Version", &ServiceDescriptionData::m_version),
+            MakeField("SupportedFeatures", &ServiceDescriptionData::m_supportedFeatures));
+    };
+
+    template<> struct Fields<BoardAvailableData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("BoardId", &BoardAvailableData::m_boardId),
+            MakeField("BoardIdCreatedBy", &BoardAvailableData::m_boardIdCreatedBy),
+            MakeField("FailedBoard", &BoardAvailableData::m_failedBoard),
+            MakeField("ProductTypeId", &BoardAvailableData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &BoardAvailableData::m_flippedBoard),
+            MakeField("TopBarcode", &BoardAvailableData::m_optionalTopBarcode),
+            MakeField("BottomBarcode", &BoardAvailableData::m_optionalBottomBarcode),
+            MakeField("Length", &BoardAvailableData::m_optionalLengthInMM),
+            MakeField("Width", &BoardAvailableData::m_optionalWidthInMM),
+            MakeField("Thickness", &BoardAvailableData::m_optionalThicknessInMM),
+            MakeField("ConveyorSpeed", &BoardAvailableData::m_optionalConveyorSpeedInMMPerSecs),
+            MakeField("TopClearanceHeight", &BoardAvailableData::m_optionalTopClearanceHeightInMM),
+            MakeField("BottomClearanceHeight", &BoardAvailableData::m_optionalBottomClearanceHeightInMM),
+            MakeField("Weight", &BoardAvailableData::m_optionalWeightInGrams),
+            MakeField("WorkOrderId", &BoardAvailableData::m_optionalWorkOrderId),
+            MakeField("BatchId", &BoardAvailableData::m_optionalBatchId),
+            MakeField("Route", &BoardAvailableData::m_optionalRoute),
+            MakeField("Action", &BoardAvailableData::m_optionalAction),
+            MakeField("SubBoards", &BoardAvailableData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<RevokeBoardAvailableData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<MachineReadyData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("FailedBoard", &MachineReadyData::m_failedBoard),
+            MakeField("ForecastId", &MachineReadyData::m_optionalForecastId),
+            MakeField("BoardId", &MachineReadyData::m_optionalBoardId),
+            MakeField("ProductTypeId", &MachineReadyData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &MachineReadyData::m_optionalFlippedBoard),
+            MakeField("TopBarcode", &MachineReadyData::m_optionalTopBarcode),
+            MakeField("BottomBarcode", &MachineReadyData::m_optionalBottomBarcode),
+            MakeField("Length", &MachineReadyData::m_optionalLengthInMM),
+            MakeField("Width", &MachineReadyData::m_optionalWidthInMM),
+            MakeField("Thickness", &MachineReadyData::m_optionalThicknessInMM),
+            MakeField("ConveyorSpeed", &MachineReadyData::m_optionalConveyorSpeedInMMPerSecs),
+            MakeField("TopClearanceHeight", &MachineReadyData::m_optionalTopClearanceHeightInMM),
+            MakeField("BottomClearanceHeight", &MachineReadyData::m_optionalBottomClearanceHeightInMM),
+            MakeField("Weight", &MachineReadyData::m_optionalWeightInGrams),
+            MakeField("WorkOrderId", &MachineReadyData::m_optionalWorkOrderId),
+            MakeField("BatchId", &MachineReadyData::m_optionalBatchId));
+    };
+
+    template<> struct Fields<RevokeMachineReadyData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<StartTransportData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("BoardId", &StartTransportData::m_boardId),
+            MakeField("ConveyorSpeed", &StartTransportData::m_optionalConveyorSpeedInMMPerSecs));
+    };
+
+    template<> struct Fields<StopTransportData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("TransferState", &StopTransportData::m_transferState),
+            MakeField("BoardId", &StopTransportData::m_boardId));
+    };
+
+    template<> struct Fields<TransportFinishedData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("TransferState", &TransportFinishedData::m_transferState),
+            MakeField("BoardId", &TransportFinishedData::m_boardId));
+    };
+
+    template<> struct Fields<NotificationData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("NotificationCode", &NotificationData::m_notificationCode),
+            MakeField("Severity", &NotificationData::m_severity),
+            MakeField("Description", &NotificationData::m_description));
+    };
+
+    template<> struct Fields<CheckAliveData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("Type", &CheckAliveData::m_optionalType),
+            MakeField("Id", &CheckAliveData::m_optionalId));
+    };
+
+    template<> struct Fields<SetConfigurationData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("MachineId", &SetConfigurationData::m_machineId),
+            MakeField("SupervisorySystemPort", &SetConfigurationData::m_optionalSupervisorySystemPort),
+            MakeField("UpstreamConfigurations", &SetConfigurationData::m_upstreamConfigurations),
+            MakeField("DownstreamConfigurations", &SetConfigurationData::m_downstreamConfigurations));
+    };
+
+    template<> struct Fields<GetConfigurationData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<CurrentConfigurationData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("MachineId", &CurrentConfigurationData::m_optionalMachineId),
+            MakeField("SupervisorySystemPort", &CurrentConfigurationData::m_optionalSupervisorySystemPort),
+            MakeField("UpstreamConfigurations", &CurrentConfigurationData::m_upstreamConfigurations),
+            MakeField("DownstreamConfigurations", &CurrentConfigurationData::m_downstreamConfigurations));
+    };
+
+    template<> struct Fields<BoardForecastData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("ForecastId", &BoardForecastData::m_optionalForecastId),
+            MakeField("TimeUntilAvailable", &BoardForecastData::m_optionalTimeUntilAvailableInSeconds),
+            MakeField("BoardId", &BoardForecastData::m_optionalBoardId),
+            MakeField("BoardIdCreatedBy", &BoardForecastData::m_optionalBoardIdCreatedBy),
+            MakeField("FailedBoard", &BoardForecastData::m_failedBoard),
+            MakeField("ProductTypeId", &BoardForecastData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &BoardForecastData::m_flippedBoard),
+            MakeField("TopBarcode", &BoardForecastData::m_optionalTopBarcode),
+            MakeField("BottomBarcode", &BoardForecastData::m_optionalBottomBarcode),
+            MakeField("Length", &BoardForecastData::m_optionalLengthInMM),
+            MakeField("Width", &BoardForecastData::m_optionalWidthInMM),
+            MakeField("Thickness", &BoardForecastData::m_optionalThicknessInMM),
+            MakeField("ConveyorSpeed", &BoardForecastData::m_optionalConveyorSpeedInMMPerSecs),
+            MakeField("TopClearanceHeight", &BoardForecastData::m_optionalTopClearanceHeightInMM),
+            MakeField("BottomClearanceHeight", &BoardForecastData::m_optionalBottomClearanceHeightInMM),
+            MakeField("Weight", &BoardForecastData::m_optionalWeightInGrams),
+            MakeField("WorkOrderId", &BoardForecastData::m_optionalWorkOrderId),
+            MakeField("BatchId", &BoardForecastData::m_optionalBatchId));
+    };
+
+    template<> struct Fields<QueryBoardInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("TopBarcode", &QueryBoardInfoData::m_optionalTopBarcode),
+            MakeField("BottomBarcode", &QueryBoardInfoData::m_optionalBottomBarcode));
+    };
+
+    template<> struct Fields<SendBoardInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("BoardId", &SendBoardInfoData::m_optionalBoardId),
+            MakeField("BoardIdCreatedBy", &SendBoardInfoData::m_optionalBoardIdCreatedBy),
+            MakeField("FailedBoard", &SendBoardInfoData::m_optionalFailedBoard),
+            MakeField("ProductTypeId", &SendBoardInfoData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &SendBoardInfoData::m_optionalFlippedBoard),
+            MakeField("TopBarcode", &SendBoardInfoData::m_optionalTopBarcode),
+            MakeField("BottomBarcode", &SendBoardInfoData::m_optionalBottomBarcode),
+            MakeField("Length", &SendBoardInfoData::m_optionalLengthInMM),
+            MakeField("Width", &SendBoardInfoData::m_optionalWidthInMM),
+            MakeField("Thickness", &SendBoardInfoData::m_optionalThicknessInMM),
+            MakeField("ConveyorSpeed", &SendBoardInfoData::m_optionalConveyorSpeedInMMPerSecs),
+            MakeField("TopClearanceHeight", &SendBoardInfoData::m_optionalTopClearanceHeightInMM),
+            MakeField("BottomClearanceHeight", &SendBoardInfoData::m_optionalBottomClearanceHeightInMM),
+            MakeField("Weight", &SendBoardInfoData::m_optionalWeightInGrams),
+            MakeField("WorkOrderId", &SendBoardInfoData::m_optionalWorkOrderId),
+            MakeField("BatchId", &SendBoardInfoData::m_optionalBatchId),
+            MakeField("Route", &SendBoardInfoData::m_optionalRoute),
+            MakeField("Action", &SendBoardInfoData::m_optionalAction),
+            MakeField("SubBoards", &SendBoardInfoData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<SupervisoryServiceDescriptionData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("SystemId", &SupervisoryServiceDescriptionData::m_systemId),
+            MakeField("Version", &SupervisoryServiceDescriptionData::m_version),
+            MakeField("SupportedFeatures", &SupervisoryServiceDescriptionData::m_supportedFeatures));
+    };
+
+    template<> struct Fields<BoardArrivedData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("MachineId", &BoardArrivedData::m_machineId),
+            MakeField("UpstreamLaneId", &BoardArrivedData::m_upstreamLaneId),
+            MakeField("UpstreamInterfaceId", &BoardArrivedData::m_optionalUpstreamInterfaceId),
+            MakeField("MagazineId", &BoardArrivedData::m_optionalMagazineId),
+            MakeField("SlotId", &BoardArrivedData::m_optionalSlotId),
+            MakeField("BoardTransfer", &BoardArrivedData::m_boardTransfer),
+            MakeField("BoardId", &BoardArrivedData::m_boardId),
+            MakeField("BoardIdCreatedBy", &BoardArrivedData::m_boardIdCreatedBy),
+            MakeField("FailedBoard", &BoardArrivedData::m_failedBoard),
+            MakeField("ProductTypeId", &BoardArrivedData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &BoardArrivedData::m_flippedBoard),
+            MakeField("TopBarcode", &BoardArrivedData::m_optionalTopBarcode),
+            MakeField("BottomBarcode", &BoardArrivedData::m_optionalBottomBarcode),
+            MakeField("Length", &BoardArrivedData::m_optionalLengthInMM),
+            MakeField("Width", &BoardArrivedData::m_optionalWidthInMM),
+            MakeField("Thickness", &BoardArrivedData::m_optionalThicknessInMM),
+            MakeField("ConveyorSpeed", &BoardArrivedData::m_optionalConveyorSpeedInMMPerSecs),
+            MakeField("TopClearanceHeight", &BoardArrivedData::m_optionalTopClearanceHeightInMM),
+            MakeField("BottomClearanceHeight", &BoardArrivedData::m_optionalBottomClearanceHeightInMM),
+            MakeField("Weight", &BoardArrivedData::m_optionalWeightInGrams),
+            MakeField("WorkOrderId", &BoardArrivedData::m_optionalWorkOrderId),
+            MakeField("BatchId", &BoardArrivedData::m_optionalBatchId),
+            MakeField("Route", &BoardArrivedData::m_optionalRoute),
+            MakeField("Action", &BoardArrivedData::m_optionalAction),
+            MakeField("SubBoards", &BoardArrivedData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<BoardDepartedData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("MachineId", &BoardDepartedData::m_machineId),
+            MakeField("DownstreamLaneId", &BoardDepartedData::m_downstreamLaneId),
+            MakeField("DownstreamInterfaceId", &BoardDepartedData::m_optionalDownstreamInterfaceId),
+            MakeField("MagazineId", &BoardDepartedData::m_optionalMagazineId),
+            MakeField("SlotId", &BoardDepartedData::m_optionalSlotId),
+            MakeField("BoardTransfer", &BoardDepartedData::m_boardTransfer),
+            MakeField("BoardId", &BoardDepartedData::m_boardId),
+            MakeField("BoardIdCreatedBy", &BoardDepartedData::m_boardIdCreatedBy),
+            MakeField("FailedBoard", &BoardDepartedData::m_failedBoard),
+            MakeField("ProductTypeId", &BoardDepartedData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &BoardDepartedData::m_flippedBoard),
+            MakeField("TopBarcode", &BoardDepartedData::m_optionalTopBarcode),
+            MakeField("BottomBarcode", &BoardDepartedData::m_optionalBottomBarcode),
+            MakeField("Length", &BoardDepartedData::m_optionalLengthInMM),
+            MakeField("Width", &BoardDepartedData::m_optionalWidthInMM),
+            MakeField("Thickness", &BoardDepartedData::m_optionalThicknessInMM),
+            MakeField("ConveyorSpeed", &BoardDepartedData::m_optionalConveyorSpeedInMMPerSecs),
+            MakeField("TopClearanceHeight", &BoardDepartedData::m_optionalTopClearanceHeightInMM),
+            MakeField("BottomClearanceHeight", &BoardDepartedData::m_optionalBottomClearanceHeightInMM),
+            MakeField("Weight", &BoardDepartedData::m_optionalWeightInGrams),
+            MakeField("WorkOrderId", &BoardDepartedData::m_optionalWorkOrderId),
+            MakeField("BatchId", &BoardDepartedData::m_optionalBatchId),
+            MakeField("Route", &BoardDepartedData::m_optionalRoute),
+            MakeField("Action", &BoardDepartedData::m_optionalAction),
+            MakeField("SubBoards", &BoardDepartedData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<QueryWorkOrderInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("QueryId", &QueryWorkOrderInfoData::m_optionalQueryId),
+            MakeField("MachineId", &QueryWorkOrderInfoData::m_machineId),
+            MakeField("MagazineId", &QueryWorkOrderInfoData::m_optionalMagazineId),
+            MakeField("SlotId", &QueryWorkOrderInfoData::m_optionalSlotId),
+            MakeField("Barcode", &QueryWorkOrderInfoData::m_optionalBarcode),
+            MakeField("WorkOrderId", &QueryWorkOrderInfoData::m_optionalWorkOrderId),
+            MakeField("BatchId", &QueryWorkOrderInfoData::m_optionalBatchId));
+    };
+
+    template<> struct Fields<SendWorkOrderInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("QueryId", &SendWorkOrderInfoData::m_optionalQueryId),
+            MakeField("WorkOrderId", &SendWorkOrderInfoData::m_optionalWorkOrderId),
+            MakeField("BatchId", &SendWorkOrderInfoData::m_optionalBatchId),
+            MakeField("BoardId", &SendWorkOrderInfoData::m_optionalBoardId),
+            MakeField("BoardIdCreatedBy", &SendWorkOrderInfoData::m_optionalBoardIdCreatedBy),
+            MakeField("FailedBoard", &SendWorkOrderInfoData::m_optionalFailedBoard),
+            MakeField("ProductTypeId", &SendWorkOrderInfoData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &SendWorkOrderInfoData::m_optionalFlippedBoard),
+            MakeField("TopBarcode", &SendWorkOrderInfoData::m_optionalTopBarcode),
+            MakeField("BottomBarcode", &SendWorkOrderInfoData::m_optionalBottomBarcode),
+            MakeField("Length", &SendWorkOrderInfoData::m_optionalLengthInMM),
+            MakeField("Width", &SendWorkOrderInfoData::m_optionalWidthInMM),
+            MakeField("Thickness", &SendWorkOrderInfoData::m_optionalThicknessInMM),
+            MakeField("ConveyorSpeed", &SendWorkOrderInfoData::m_optionalConveyorSpeedInMMPerSecs),
+            MakeField("TopClearanceHeight", &SendWorkOrderInfoData::m_optionalTopClearanceHeightInMM),
+            MakeField("BottomClearanceHeight", &SendWorkOrderInfoData::m_optionalBottomClearanceHeightInMM),
+            MakeField("Weight", &SendWorkOrderInfoData::m_optionalWeightInGrams),
+            MakeField("Route", &SendWorkOrderInfoData::m_optionalRoute),
+            MakeField("SubBoards", &SendWorkOrderInfoData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<ReplyWorkOrderInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("WorkOrderId", &ReplyWorkOrderInfoData::m_workOrderId),
+            MakeField("BatchId", &ReplyWorkOrderInfoData::m_optionalBatchId),
+            MakeField("Status", &ReplyWorkOrderInfoData::m_status));
+    };
+
+    template<> struct Fields<CommandData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("Command", &CommandData::m_command));
+    };
+
+    template<> struct Fields<QueryHermesCapabilitiesData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<SendHermesCapabilitiesData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("OptionalMessages", &SendHermesCapabilitiesData::m_optionalMessages),
+            MakeField("Attributes", &SendHermesCapabilitiesData::m_attributes));
+    };
+}
@@ -0,0 +1,567 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include "MessageFields.h"
+
+#include <HermesData.h>
+
+namespace Hermes
+{
+    // The Fields<> of MessageFields.h for the C structs of HermesData.h, so that these can be written without
+    // converting them to C++ first. Optional values are the m_optional... strings without m_pData and the
+    // m_pOptional... pointers that are null, see MakeOptionalField(). The other strings and structs are required
+    // and written as the conversion to C++ would: empty if without m_pData, with default values if null.
+    template<class T>
+    struct OptionalTraits<const T*>
+    {
+        using Value = T;
+        static constexpr bool cOPTIONAL = false;
+        static const T* Get(const T* pValue)
+        {
+            static const T cDEFAULT{};
+            return pValue ? pValue : &cDEFAULT;
+        }
+    };
+
+    template<class T>
+    struct COptionalTraits;
+
+    template<class T>
+    struct COptionalTraits<const T*>
+    {
+        using Value = T;
+        static constexpr bool cOPTIONAL = true;
+        static const T* Get(const T* pValue) { return pValue; }
+    };
+
+    template<>
+    struct COptionalTraits<HermesStringView>
+    {
+        using Value = HermesStringView;
+        static constexpr bool cOPTIONAL = true;
+        static const HermesStringView* Get(const HermesStringView& value) { return value.m_pData ? &value : nullptr; }
+    };
+
+    template<class T, class MemberT>
+    constexpr Field<T, MemberT, COptionalTraits<MemberT>> MakeOptionalField(const char* name, MemberT T::* pMember)
+    {
+        return{name, pMember};
+    }
+
+    template<> struct ListTraits<HermesSubBoards>
+    {
+        using Item = HermesSubBoard;
+        static constexpr const char* cITEM = "SB";
+        static constexpr bool cOPTIONAL = true;
+    };
+
+    template<> struct ListTraits<HermesUpstreamConfigurations>
+    {
+        using Item = HermesUpstreamConfiguration;
+        static constexpr const char* cITEM = "UpstreamConfiguration";
+        static constexpr bool cOPTIONAL = false;
+    };
+
+    template<> struct ListTraits<HermesDownstreamConfigurations>
+    {
+        using Item = HermesDownstreamConfiguration;
+        static constexpr const char* cITEM = "DownstreamConfiguration";
+        static constexpr bool cOPTIONAL = false;
+    };
+
+    template<> struct Fields<HermesSubBoard>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("Pos", &HermesSubBoard::m_pos),
+            MakeOptionalField("Bc", &HermesSubBoard::m_optionalBc),
+            MakeField("St", &HermesSubBoard::m_st));
+    };
+
+    template<> struct Fields<HermesFeatureBoardForecast>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureCheckAliveResponse>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureQueryBoardInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureSendBoardInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureCommand>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesSupportedFeatures>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("FeatureBoardForecast", &HermesSupportedFeatures::m_pOptionalFeatureBoardForecast),
+            MakeOptionalField("FeatureCheckAliveResponse", &HermesSupportedFeatures::m_pOptionalFeatureCheckAliveResponse),
+            MakeOptionalField("FeatureQueryBoardInfo", &HermesSupportedFeatures::m_pOptionalFeatureQueryBoardInfo),
+            MakeOptionalField("FeatureSendBoardInfo", &HermesSupportedFeatures::m_pOptionalFeatureSendBoardInfo),
+            MakeOptionalField("FeatureCommand", &HermesSupportedFeatures::m_pOptionalFeatureCommand));
+    };
+
+    template<> struct Fields<HermesUpstreamConfiguration>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("UpstreamLaneId", &HermesUpstreamConfiguration::m_upstreamLaneId),
+            MakeOptionalField("UpstreamInterfaceId", &HermesUpstreamConfiguration::m_optionalUpstreamInterfaceId),
+            MakeField("HostAddress", &HermesUpstreamConfiguration::m_hostAddress),
+            MakeField("Port", &HermesUpstreamConfiguration::m_port));
+    };
+
+    template<> struct Fields<HermesDownstreamConfiguration>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("DownstreamLaneId", &HermesDownstreamConfiguration::m_downstreamLaneId),
+            MakeOptionalField("DownstreamInterfaceId", &HermesDownstreamConfiguration::m_optionalDownstreamInterfaceId),
+            MakeOptionalField("ClientAddress", &HermesDownstreamConfiguration::m_optionalClientAddress),
+            MakeField("Port", &HermesDownstreamConfiguration::m_port));
+    };
+
+    template<> struct Fields<HermesFeatureConfiguration>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureBoardTracking>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureQueryWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureSendWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureReplyWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureQueryHermesCapabilities>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesFeatureSendHermesCapabilities>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesSupervisoryFeatures>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("FeatureConfiguration", &HermesSupervisoryFeatures::m_pOptionalFeatureConfiguration),
+            MakeOptionalField("FeatureCheckAliveResponse", &HermesSupervisoryFeatures::m_pOptionalFeatureCheckAliveResponse),
+            MakeOptionalField("FeatureBoardTracking", &HermesSupervisoryFeatures::m_pOptionalFeatureBoardTracking),
+            MakeOptionalField("FeatureQueryWorkOrderInfo", &HermesSupervisoryFeatures::m_pOptionalFeatureQueryWorkOrderInfo),
+            MakeOptionalField("FeatureSendWorkOrderInfo", &HermesSupervisoryFeatures::m_pOptionalFeatureSendWorkOrderInfo),
+            MakeOptionalField("FeatureReplyWorkOrderInfo", &HermesSupervisoryFeatures::m_pOptionalFeatureReplyWorkOrderInfo),
+            MakeOptionalField("FeatureQueryHermesCapabilities", &HermesSupervisoryFeatures::m_pOptionalFeatureQueryHermesCapabilities),
+            MakeOptionalField("FeatureSendHermesCapabilities", &HermesSupervisoryFeatures::m_pOptionalFeatureSendHermesCapabilities));
+    };
+
+    template<> struct Fields<HermesMessageCheckAliveResponse>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMessageBoardForecast>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMessageQueryBoardInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMessageSendBoardInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMessageBoardArrived>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMessageBoardDeparted>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMessageQueryWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMessageReplyWorkOrderInfo>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMessageCommand>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesOptionalMessages>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("MessageCheckAliveResponse", &HermesOptionalMessages::m_pOptionalMessageCheckAliveResponse),
+            MakeOptionalField("MessageBoardForecast", &HermesOptionalMessages::m_pOptionalMessageBoardForecast),
+            MakeOptionalField("MessageQueryBoardInfo", &HermesOptionalMessages::m_pOptionalMessageQueryBoardInfo),
+            MakeOptionalField("MessageSendBoardInfo", &HermesOptionalMessages::m_pOptionalMessageSendBoardInfo),
+            MakeOptionalField("MessageBoardArrived", &HermesOptionalMessages::m_pOptionalMessageBoardArrived),
+            MakeOptionalField("MessageBoardDeparted", &HermesOptionalMessages::m_pOptionalMessageBoardDeparted),
+            MakeOptionalField("MessageQueryWorkOrderInfo", &HermesOptionalMessages::m_pOptionalMessageQueryWorkOrderInfo),
+            MakeOptionalField("MessageReplyWorkOrderInfo", &HermesOptionalMessages::m_pOptionalMessageReplyWorkOrderInfo),
+            MakeOptionalField("MessageCommand", &HermesOptionalMessages::m_pOptionalMessageCommand));
+    };
+
+    template<> struct Fields<HermesAttributes>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("ProductTypeId", &HermesAttributes::m_productTypeId),
+            MakeField("TopBarcode", &HermesAttributes::m_topBarcode),
+            MakeField("BottomBarcode", &HermesAttributes::m_bottomBarcode),
+            MakeField("Length", &HermesAttributes::m_length),
+            MakeField("Width", &HermesAttributes::m_width),
+            MakeField("Thickness", &HermesAttributes::m_thickness),
+            MakeField("ConveyorSpeed", &HermesAttributes::m_conveyorSpeed),
+            MakeField("TopClearanceHeight", &HermesAttributes::m_topClearanceHeight),
+            MakeField("BottomClearanceHeight", &HermesAttributes::m_bottomClearanceHeight),
+            MakeField("Weight", &HermesAttributes::m_weight),
+            MakeField("WorkOrderId", &HermesAttributes::m_workOrderId),
+            MakeField("BatchId", &HermesAttributes::m_batchId),
+            MakeField("Route", &HermesAttributes::m_route),
+            MakeField("Action", &HermesAttributes::m_action),
+            MakeField("SubBoards", &HermesAttributes::m_subBoards));
+    };
+
+    template<> struct Fields<HermesServiceDescriptionData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("LaneId", &HermesServiceDescriptionData::m_laneId),
+            MakeField("MachineId", &HermesServiceDescriptionData::m_machineId),
+            MakeOptionalField("InterfaceId", &HermesServiceDescriptionData::m_optionalInterfaceId),
+            MakeField("Version", &HermesServiceDescriptionData::m_version),
+            MakeField("SupportedFeatures", &HermesServiceDescriptionData::m_pSupportedFeatures));
+    };
+
+    template<> struct Fields<HermesBoardAvailableData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("BoardId", &HermesBoardAvailableData::m_boardId),
+            MakeField("BoardIdCreatedBy", &HermesBoardAvailableData::m_boardIdCreatedBy),
+            MakeField("FailedBoard", &HermesBoardAvailableData::m_failedBoard),
+            MakeOptionalField("ProductTypeId", &HermesBoardAvailableData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &HermesBoardAvailableData::m_flippedBoard),
+            MakeOptionalField("TopBarcode", &HermesBoardAvailableData::m_optionalTopBarcode),
+            MakeOptionalField("BottomBarcode", &HermesBoardAvailableData::m_optionalBottomBarcode),
+            MakeOptionalField("Length", &HermesBoardAvailableData::m_pOptionalLengthInMM),
+            MakeOptionalField("Width", &HermesBoardAvailableData::m_pOptionalWidthInMM),
+            MakeOptionalField("Thickness", &HermesBoardAvailableData::m_pOptionalThicknessInMM),
+            MakeOptionalField("ConveyorSpeed", &HermesBoardAvailableData::m_pOptionalConveyorSpeedInMMPerSecs),
+            MakeOptionalField("TopClearanceHeight", &HermesBoardAvailableData::m_pOptionalTopClearanceHeightInMM),
+            MakeOptionalField("BottomClearanceHeight", &HermesBoardAvailableData::m_pOptionalBottomClearanceHeightInMM),
+            MakeOptionalField("Weight", &HermesBoardAvailableData::m_pOptionalWeightInGrams),
+            MakeOptionalField("WorkOrderId", &HermesBoardAvailableData::m_optionalWorkOrderId),
+            MakeOptionalField("BatchId", &HermesBoardAvailableData::m_optionalBatchId),
+            MakeOptionalField("Route", &HermesBoardAvailableData::m_pOptionalRoute),
+            MakeOptionalField("Action", &HermesBoardAvailableData::m_pOptionalAction),
+            MakeField("SubBoards", &HermesBoardAvailableData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<HermesRevokeBoardAvailableData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesMachineReadyData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("FailedBoard", &HermesMachineReadyData::m_failedBoard),
+            MakeOptionalField("ForecastId", &HermesMachineReadyData::m_optionalForecastId),
+            MakeOptionalField("BoardId", &HermesMachineReadyData::m_optionalBoardId),
+            MakeOptionalField("ProductTypeId", &HermesMachineReadyData::m_optionalProductTypeId),
+            MakeOptionalField("FlippedBoard", &HermesMachineReadyData::m_pOptionalFlippedBoard),
+            MakeOptionalField("TopBarcode", &HermesMachineReadyData::m_optionalTopBarcode),
+            MakeOptionalField("BottomBarcode", &HermesMachineReadyData::m_optionalBottomBarcode),
+            MakeOptionalField("Length", &HermesMachineReadyData::m_pOptionalLengthInMM),
+            MakeOptionalField("Width", &HermesMachineReadyData::m_pOptionalWidthInMM),
+            MakeOptionalField("Thickness", &HermesMachineReadyData::m_pOptionalThicknessInMM),
+            MakeOptionalField("ConveyorSpeed", &HermesMachineReadyData::m_pOptionalConveyorSpeedInMMPerSecs),
+            MakeOptionalField("TopClearanceHeight", &HermesMachineReadyData::m_pOptionalTopClearanceHeightInMM),
+            MakeOptionalField("BottomClearanceHeight", &HermesMachineReadyData::m_pOptionalBottomClearanceHeightInMM),
+            MakeOptionalField("Weight", &HermesMachineReadyData::m_pOptionalWeightInGrams),
+            MakeOptionalField("WorkOrderId", &HermesMachineReadyData::m_optionalWorkOrderId),
+            MakeOptionalField("BatchId", &HermesMachineReadyData::m_optionalBatchId));
+    };
+
+    template<> struct Fields<HermesRevokeMachineReadyData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesStartTransportData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("BoardId", &HermesStartTransportData::m_boardId),
+            MakeOptionalField("ConveyorSpeed", &HermesStartTransportData::m_pOptionalConveyorSpeedInMMPerSecs));
+    };
+
+    template<> struct Fields<HermesStopTransportData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("TransferState", &HermesStopTransportData::m_transferState),
+            MakeField("BoardId", &HermesStopTransportData::m_boardId));
+    };
+
+    template<> struct Fields<HermesTransportFinishedData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("TransferState", &HermesTransportFinishedData::m_transferState),
+            MakeField("BoardId", &HermesTransportFinishedData::m_boardId));
+    };
+
+    template<> struct Fields<HermesNotificationData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("NotificationCode", &HermesNotificationData::m_notificationCode),
+            MakeField("Severity", &HermesNotificationData::m_severity),
+            MakeField("Description", &HermesNotificationData::m_description));
+    };
+
+    template<> struct Fields<HermesCheckAliveData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("Type", &HermesCheckAliveData::m_pOptionalType),
+            MakeOptionalField("Id", &HermesCheckAliveData::m_optionalId));
+    };
+
+    template<> struct Fields<HermesSetConfigurationData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("MachineId", &HermesSetConfigurationData::m_machineId),
+            MakeOptionalField("SupervisorySystemPort", &HermesSetConfigurationData::m_pOptionalSupervisorySystemPort),
+            MakeField("UpstreamConfigurations", &HermesSetConfigurationData::m_upstreamConfigurations),
+            MakeField("DownstreamConfigurations", &HermesSetConfigurationData::m_downstreamConfigurations));
+    };
+
+    template<> struct Fields<HermesGetConfigurationData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesCurrentConfigurationData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("MachineId", &HermesCurrentConfigurationData::m_optionalMachineId),
+            MakeOptionalField("SupervisorySystemPort", &HermesCurrentConfigurationData::m_pOptionalSupervisorySystemPort),
+            MakeField("UpstreamConfigurations", &HermesCurrentConfigurationData::m_upstreamConfigurations),
+            MakeField("DownstreamConfigurations", &HermesCurrentConfigurationData::m_downstreamConfigurations));
+    };
+
+    template<> struct Fields<HermesBoardForecastData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("ForecastId", &HermesBoardForecastData::m_optionalForecastId),
+            MakeOptionalField("TimeUntilAvailable", &HermesBoardForecastData::m_pOptionalTimeUntilAvailableInSeconds),
+            MakeOptionalField("BoardId", &HermesBoardForecastData::m_optionalBoardId),
+            MakeOptionalField("BoardIdCreatedBy", &HermesBoardForecastData::m_optionalBoardIdCreatedBy),
+            MakeField("FailedBoard", &HermesBoardForecastData::m_failedBoard),
+            MakeOptionalField("ProductTypeId", &HermesBoardForecastData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &HermesBoardForecastData::m_flippedBoard),
+            MakeOptionalField("TopBarcode", &HermesBoardForecastData::m_optionalTopBarcode),
+            MakeOptionalField("BottomBarcode", &HermesBoardForecastData::m_optionalBottomBarcode),
+            MakeOptionalField("Length", &HermesBoardForecastData::m_pOptionalLengthInMM),
+            MakeOptionalField("Width", &HermesBoardForecastData::m_pOptionalWidthInMM),
+            MakeOptionalField("Thickness", &HermesBoardForecastData::m_pOptionalThicknessInMM),
+            MakeOptionalField("ConveyorSpeed", &HermesBoardForecastData::m_pOptionalConveyorSpeedInMMPerSecs),
+            MakeOptionalField("TopClearanceHeight", &HermesBoardForecastData::m_pOptionalTopClearanceHeightInMM),
+            MakeOptionalField("BottomClearanceHeight", &HermesBoardForecastData::m_pOptionalBottomClearanceHeightInMM),
+            MakeOptionalField("Weight", &HermesBoardForecastData::m_pOptionalWeightInGrams),
+            MakeOptionalField("WorkOrderId", &HermesBoardForecastData::m_optionalWorkOrderId),
+            MakeOptionalField("BatchId", &HermesBoardForecastData::m_optionalBatchId));
+    };
+
+    template<> struct Fields<HermesQueryBoardInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("TopBarcode", &HermesQueryBoardInfoData::m_optionalTopBarcode),
+            MakeOptionalField("BottomBarcode", &HermesQueryBoardInfoData::m_optionalBottomBarcode));
+    };
+
+    template<> struct Fields<HermesSendBoardInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("BoardId", &HermesSendBoardInfoData::m_optionalBoardId),
+            MakeOptionalField("BoardIdCreatedBy", &HermesSendBoardInfoData::m_optionalBoardIdCreatedBy),
+            MakeOptionalField("FailedBoard", &HermesSendBoardInfoData::m_pOptionalFailedBoard),
+            MakeOptionalField("ProductTypeId", &HermesSendBoardInfoData::m_optionalProductTypeId),
+            MakeOptionalField("FlippedBoard", &HermesSendBoardInfoData::m_pOptionalFlippedBoard),
+            MakeOptionalField("TopBarcode", &HermesSendBoardInfoData::m_optionalTopBarcode),
+            MakeOptionalField("BottomBarcode", &HermesSendBoardInfoData::m_optionalBottomBarcode),
+            MakeOptionalField("Length", &HermesSendBoardInfoData::m_pOptionalLengthInMM),
+            MakeOptionalField("Width", &HermesSendBoardInfoData::m_pOptionalWidthInMM),
+            MakeOptionalField("Thickness", &HermesSendBoardInfoData::m_pOptionalThicknessInMM),
+            MakeOptionalField("ConveyorSpeed", &HermesSendBoardInfoData::m_pOptionalConveyorSpeedInMMPerSecs),
+            MakeOptionalField("TopClearanceHeight", &HermesSendBoardInfoData::m_pOptionalTopClearanceHeightInMM),
+            MakeOptionalField("BottomClearanceHeight", &HermesSendBoardInfoData::m_pOptionalBottomClearanceHeightInMM),
+            MakeOptionalField("Weight", &HermesSendBoardInfoData::m_pOptionalWeightInGrams),
+            MakeOptionalField("WorkOrderId", &HermesSendBoardInfoData::m_optionalWorkOrderId),
+            MakeOptionalField("BatchId", &HermesSendBoardInfoData::m_optionalBatchId),
+            MakeOptionalField("Route", &HermesSendBoardInfoData::m_pOptionalRoute),
+            MakeOptionalField("Action", &HermesSendBoardInfoData::m_pOptionalAction),
+            MakeField("SubBoards", &HermesSendBoardInfoData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<HermesSupervisoryServiceDescriptionData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("SystemId", &HermesSupervisoryServiceDescriptionData::m_systemId),
+            MakeField("Version", &HermesSupervisoryServiceDescriptionData::m_version),
+            MakeField("SupportedFeatures", &HermesSupervisoryServiceDescriptionData::m_pSupportedFeatures));
+    };
+
+    template<> struct Fields<HermesBoardArrivedData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("MachineId", &HermesBoardArrivedData::m_machineId),
+            MakeField("UpstreamLaneId", &HermesBoardArrivedData::m_upstreamLaneId),
+            MakeOptionalField("UpstreamInterfaceId", &HermesBoardArrivedData::m_optionalUpstreamInterfaceId),
+            MakeOptionalField("MagazineId", &HermesBoardArrivedData::m_optionalMagazineId),
+            MakeOptionalField("SlotId", &HermesBoardArrivedData::m_pOptionalSlotId),
+            MakeField("BoardTransfer", &HermesBoardArrivedData::m_boardTransfer),
+            MakeField("BoardId", &HermesBoardArrivedData::m_boardId),
+            MakeField("BoardIdCreatedBy", &HermesBoardArrivedData::m_boardIdCreatedBy),
+            MakeField("FailedBoard", &HermesBoardArrivedData::m_failedBoard),
+            MakeOptionalField("ProductTypeId", &HermesBoardArrivedData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &HermesBoardArrivedData::m_flippedBoard),
+            MakeOptionalField("TopBarcode", &HermesBoardArrivedData::m_optionalTopBarcode),
+            MakeOptionalField("BottomBarcode", &HermesBoardArrivedData::m_optionalBottomBarcode),
+            MakeOptionalField("Length", &HermesBoardArrivedData::m_pOptionalLengthInMM),
+            MakeOptionalField("Width", &HermesBoardArrivedData::m_pOptionalWidthInMM),
+            MakeOptionalField("Thickness", &HermesBoardArrivedData::m_pOptionalThicknessInMM),
+            MakeOptionalField("ConveyorSpeed", &HermesBoardArrivedData::m_pOptionalConveyorSpeedInMMPerSecs),
+            MakeOptionalField("TopClearanceHeight", &HermesBoardArrivedData::m_pOptionalTopClearanceHeightInMM),
+            MakeOptionalField("BottomClearanceHeight", &HermesBoardArrivedData::m_pOptionalBottomClearanceHeightInMM),
+            MakeOptionalField("Weight", &HermesBoardArrivedData::m_pOptionalWeightInGrams),
+            MakeOptionalField("WorkOrderId", &HermesBoardArrivedData::m_optionalWorkOrderId),
+            MakeOptionalField("BatchId", &HermesBoardArrivedData::m_optionalBatchId),
+            MakeOptionalField("Route", &HermesBoardArrivedData::m_pOptionalRoute),
+            MakeOptionalField("Action", &HermesBoardArrivedData::m_pOptionalAction),
+            MakeField("SubBoards", &HermesBoardArrivedData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<HermesBoardDepartedData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("MachineId", &HermesBoardDepartedData::m_machineId),
+            MakeField("DownstreamLaneId", &HermesBoardDepartedData::m_downstreamLaneId),
+            MakeOptionalField("DownstreamInterfaceId", &HermesBoardDepartedData::m_optionalDownstreamInterfaceId),
+            MakeOptionalField("MagazineId", &HermesBoardDepartedData::m_optionalMagazineId),
+            MakeOptionalField("SlotId", &HermesBoardDepartedData::m_pOptionalSlotId),
+            MakeField("BoardTransfer", &HermesBoardDepartedData::m_boardTransfer),
+            MakeField("BoardId", &HermesBoardDepartedData::m_boardId),
+            MakeField("BoardIdCreatedBy", &HermesBoardDepartedData::m_boardIdCreatedBy),
+            MakeField("FailedBoard", &HermesBoardDepartedData::m_failedBoard),
+            MakeOptionalField("ProductTypeId", &HermesBoardDepartedData::m_optionalProductTypeId),
+            MakeField("FlippedBoard", &HermesBoardDepartedData::m_flippedBoard),
+            MakeOptionalField("TopBarcode", &HermesBoardDepartedData::m_optionalTopBarcode),
+            MakeOptionalField("BottomBarcode", &HermesBoardDepartedData::m_optionalBottomBarcode),
+            MakeOptionalField("Length", &HermesBoardDepartedData::m_pOptionalLengthInMM),
+            MakeOptionalField("Width", &HermesBoardDepartedData::m_pOptionalWidthInMM),
+            MakeOptionalField("Thickness", &HermesBoardDepartedData::m_pOptionalThicknessInMM),
+            MakeOptionalField("ConveyorSpeed", &HermesBoardDepartedData::m_pOptionalConveyorSpeedInMMPerSecs),
+            MakeOptionalField("TopClearanceHeight", &HermesBoardDepartedData::m_pOptionalTopClearanceHeightInMM),
+            MakeOptionalField("BottomClearanceHeight", &HermesBoardDepartedData::m_pOptionalBottomClearanceHeightInMM),
+            MakeOptionalField("Weight", &HermesBoardDepartedData::m_pOptionalWeightInGrams),
+            MakeOptionalField("WorkOrderId", &HermesBoardDepartedData::m_optionalWorkOrderId),
+            MakeOptionalField("BatchId", &HermesBoardDepartedData::m_optionalBatchId),
+            MakeOptionalField("Route", &HermesBoardDepartedData::m_pOptionalRoute),
+            MakeOptionalField("Action", &HermesBoardDepartedData::m_pOptionalAction),
+            MakeField("SubBoards", &HermesBoardDepartedData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<HermesQueryWorkOrderInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("QueryId", &HermesQueryWorkOrderInfoData::m_optionalQueryId),
+            MakeField("MachineId", &HermesQueryWorkOrderInfoData::m_machineId),
+            MakeOptionalField("MagazineId", &HermesQueryWorkOrderInfoData::m_optionalMagazineId),
+            MakeOptionalField("SlotId", &HermesQueryWorkOrderInfoData::m_pOptionalSlotId),
+            MakeOptionalField("Barcode", &HermesQueryWorkOrderInfoData::m_optionalBarcode),
+            MakeOptionalField("WorkOrderId", &HermesQueryWorkOrderInfoData::m_optionalWorkOrderId),
+            MakeOptionalField("BatchId", &HermesQueryWorkOrderInfoData::m_optionalBatchId));
+    };
+
+    template<> struct Fields<HermesSendWorkOrderInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("QueryId", &HermesSendWorkOrderInfoData::m_optionalQueryId),
+            MakeOptionalField("WorkOrderId", &HermesSendWorkOrderInfoData::m_optionalWorkOrderId),
+            MakeOptionalField("BatchId", &HermesSendWorkOrderInfoData::m_optionalBatchId),
+            MakeOptionalField("BoardId", &HermesSendWorkOrderInfoData::m_optionalBoardId),
+            MakeOptionalField("BoardIdCreatedBy", &HermesSendWorkOrderInfoData::m_optionalBoardIdCreatedBy),
+            MakeOptionalField("FailedBoard", &HermesSendWorkOrderInfoData::m_pOptionalFailedBoard),
+            MakeOptionalField("ProductTypeId", &HermesSendWorkOrderInfoData::m_optionalProductTypeId),
+            MakeOptionalField("FlippedBoard", &HermesSendWorkOrderInfoData::m_pOptionalFlippedBoard),
+            MakeOptionalField("TopBarcode", &HermesSendWorkOrderInfoData::m_optionalTopBarcode),
+            MakeOptionalField("BottomBarcode", &HermesSendWorkOrderInfoData::m_optionalBottomBarcode),
+            MakeOptionalField("Length", &HermesSendWorkOrderInfoData::m_pOptionalLengthInMM),
+            MakeOptionalField("Width", &HermesSendWorkOrderInfoData::m_pOptionalWidthInMM),
+            MakeOptionalField("Thickness", &HermesSendWorkOrderInfoData::m_pOptionalThicknessInMM),
+            MakeOptionalField("ConveyorSpeed", &HermesSendWorkOrderInfoData::m_pOptionalConveyorSpeedInMMPerSecs),
+            MakeOptionalField("TopClearanceHeight", &HermesSendWorkOrderInfoData::m_pOptionalTopClearanceHeightInMM),
+            MakeOptionalField("BottomClearanceHeight", &HermesSendWorkOrderInfoData::m_pOptionalBottomClearanceHeightInMM),
+            MakeOptionalField("Weight", &HermesSendWorkOrderInfoData::m_pOptionalWeightInGrams),
+            MakeOptionalField("Route", &HermesSendWorkOrderInfoData::m_pOptionalRoute),
+            MakeField("SubBoards", &HermesSendWorkOrderInfoData::m_optionalSubBoards));
+    };
+
+    template<> struct Fields<HermesReplyWorkOrderInfoData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("WorkOrderId", &HermesReplyWorkOrderInfoData::m_workOrderId),
+            MakeOptionalField("BatchId", &HermesReplyWorkOrderInfoData::m_optionalBatchId),
+            MakeField("Status", &HermesReplyWorkOrderInfoData::m_status));
+    };
+
+    template<> struct Fields<HermesCommandData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeField("Command", &HermesCommandData::m_command));
+    };
+
+    template<> struct Fields<HermesQueryHermesCapabilitiesData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple();
+    };
+
+    template<> struct Fields<HermesSendHermesCapabilitiesData>
+    {
+        static constexpr auto cFIELDS = std::make_tuple(
+            MakeOptionalField("OptionalMessages", &HermesSendHermesCapabilitiesData::m_pOptionalMessages),
+            MakeField("Attributes", &HermesSendHermesCapabilitiesData::m_pAttributes));
+    };
+}
@@ -0,0 +1,105 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include "StringSearch.h"
+#include "StringSpan.h"
+
+#include <algorithm>
+
+namespace Hermes
+{
+    // Cuts complete <Hermes ...>...</Hermes> messages out of a byte stream that arrives in arbitrary chunks.
+    // The framer remembers how far it has looked, so that for a message arriving in many chunks, every byte is scanned
+    // only once instead of rescanning the whole pending data after each receive.
+    // Offsets are relative to the front of the pending data: when TakeMessage() returns empty, the next call must pass
+    // the very same remaining data, possibly extended at its end (it may have moved in memory, though).
+    class MessageFramer
+    {
+    public:
+        // Removes everything up to and including the next complete message from the front of buffer
+        // and returns that message. Returns an empty span, if there is no complete message yet.
+        StringSpan TakeMessage(StringSpan& buffer)
+        {
+            if (m_state == EState::eSEEK_START)
+            {
+                if (!SeekStart_(buffer))
+                    return{};
+                m_state = EState::eSEEK_END_TAG;
+                m_scanned = 1U + cHERMES_SIZE;
+            }
+
+            if (m_state == EState::eSEEK_END_TAG)
+            {
+                std::size_t index = Search::FindString(buffer.data() + m_scanned, buffer.size() - m_scanned,
+                    cHERMES_END_TAG, cHERMES_END_TAG_SIZE);
+                if (index == Search::cNPOS)
+                {
+                    // the end tag might straddle the end of the data, so rescan its last few bytes next time:
+                    m_scanned = std::max(m_scanned, buffer.size() - std::min(buffer.size(), cHERMES_END_TAG_SIZE - 1U));
+                    return{};
+                }
+                m_state = EState::eSEEK_END;
+                m_scanned += index + cHERMES_END_TAG_SIZE;
+            }
+
+            std::size_t index = Search::FindChar(buffer.data() + m_scanned, buffer.size() - m_scanned, '>');
+            if (index == Search::cNPOS)
+            {
+                m_scanned = buffer.size();
+                return{};
+            }
+
+            std::size_t messageSize = m_scanned + index + 1U;
+            auto message = buffer.substr(0U, messageSize);
+            buffer = buffer.substr(messageSize);
+            Reset();
+            return message;
+        }
+
+        // forget a partially seen message, eg. when the pending data is discarded
+        void Reset()
+        {
+            m_state = EState::eSEEK_START;
+            m_scanned = 0U;
+        }
+
+    private:
+        static constexpr const char* cHERMES = "Hermes";
+        static constexpr std::size_t cHERMES_SIZE = 6U;
+        static constexpr const char* cHERMES_END_TAG = "</Hermes";
+        static constexpr std::size_t cHERMES_END_TAG_SIZE = 8U;
+
+        enum class EState
+        {
+            eSEEK_START,
+            eSEEK_END_TAG,
+            eSEEK_END
+        };
+
+        // find "<Hermes" removing everything that is encountered until then
+        static bool SeekStart_(StringSpan& buffer)
+        {
+            for (;;)
+            {
+                std::size_t startIndex = Search::FindChar(buffer.data(), buffer.size(), '<');
+                if (startIndex == Search::cNPOS)
+                {
+                    buffer = StringSpan{};
+                    return false;
+                }
+                buffer = buffer.substr(startIndex);
+
+                if (buffer.size() < 1U + cHERMES_SIZE)
+                    return false;
+
+                if (std::memcmp(buffer.data() + 1U, cHERMES, cHERMES_SIZE) == 0)
+                    return true;
+
+                buffer = buffer.substr(1U);
+            }
+        }
+
+        EState m_state = EState::eSEEK_START;
+        std::size_t m_scanned = 0U; // where to continue scanning in the current state
+    };
+}
@@ -0,0 +1,210 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include "IService.h"
+#include "MessageSerialization.h"
+#include "XmlReader.h"
+
+#include <HermesData.hpp>
+
+#include <pugixml.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Hermes
+{
+    // The messages a role receives, as a list of data types with SerializationTraits, e.g.
+    //     using UpstreamMessages = MessageTypes<ServiceDescriptionData, BoardAvailableData, ...>;
+    // A handler for them has an On(const DataT&) for each, returning void or Error.
+    // The data is passed as an rvalue, so an On(DataT&&) may take it over.
+    template<class... DataTs>
+    struct MessageTypes
+    {
+        static constexpr std::size_t cCOUNT = sizeof...(DataTs);
+    };
+
+    // FNV-1a, seeded, with a final mix so that the low bits depend on all of the tag
+    constexpr std::uint32_t MessageTagHash(StringView tag, std::uint32_t seed)
+    {
+        std::uint32_t hash = 2166136261U ^ seed;
+        for (std::size_t i = 0U; i < tag.size(); ++i)
+        {
+            hash ^= static_cast<unsigned char>(tag.data()[i]);
+            hash *= 16777619U;
+        }
+        hash ^= hash >> 16U;
+        hash *= 0x85EBCA6BU;
+        hash ^= hash >> 13U;
+        return hash;
+    }
+
+    // What the handler gets called through, with the handler passed as void*
+    struct MessageEntry
+    {
+        using Function = Error(*)(void* pHandler, pugi::xml_node, IAsioService&, unsigned sessionId);
+        using StreamingFunction = Error(*)(void* pHandler, XmlReader&, IAsioService&, unsigned sessionId);
+
+        StringView m_tag;
+        Function m_function = nullptr;
+        StreamingFunction m_streamingFunction = nullptr;
+    };
+
+    // A perfect hash of the tags of a message type list onto a table of functions, all set up at compile time
+    class MessageTable
+    {
+    public:
+        template<class MessagesT, class HandlerT>
+        static const MessageTable& Of();
+
+        constexpr MessageTable(const MessageEntry* pEntries, std::uint32_t mask, std::uint32_t seed) :
+            m_pEntries(pEntries),
+            m_mask(mask),
+            m_seed(seed)
+        {}
+
+        // nullptr if the tag is not among the messages
+        const MessageEntry* Find(StringView tag) const
+        {
+            const auto& entry = m_pEntries[MessageTagHash(tag, m_seed) & m_mask];
+            if (!entry.m_function || entry.m_tag.size() != tag.size()
+                || std::memcmp(entry.m_tag.data(), tag.data(), tag.size()) != 0)
+                return nullptr;
+            return &entry;
+        }
+
+    private:
+        const MessageEntry* m_pEntries;
+        std::uint32_t m_mask;
+        std::uint32_t m_seed;
+    };
+
+    namespace Registry
+    {
+        template<class HandlerT, class DataT>
+        Error Call_(HandlerT& handler, DataT&& data)
+        {
+            if constexpr (std::is_same<decltype(handler.On(std::move(data))), Error>::value)
+            {
+                return handler.On(std::move(data));
+            }
+            else
+            {
+                handler.On(std::move(data));
+                return{};
+            }
+        }
+
+        template<class HandlerT, class DataT>
+        Error Dispatch_(void* pHandler, pugi::xml_node xmlNode, IAsioService& service, unsigned sessionId)
+        {
+            DataT data;
+            auto error = Deserialize(xmlNode, data);
+            if (error)
+                return error;
+            service.Log(sessionId, SerializationTraits<DataT>::cTAG_VIEW, ':', data);
+            return Call_(*static_cast<HandlerT*>(pHandler), std::move(data));
+        }
+
+        template<class HandlerT, class DataT>
+        Error DispatchStreaming_(void* pHandler, XmlReader& reader, IAsioService& service, unsigned sessionId)
+        {
+            DataT data;
+            auto error = Deserialize(reader, data);
+            // as with pugixml, a malformed message is reported in favour of missing data:
+            if (auto parseError = reader.Finish())
+                return parseError;
+            if (error)
+                return error;
+            service.Log(sessionId, SerializationTraits<DataT>::cTAG_VIEW, ':', data);
+            return Call_(*static_cast<HandlerT*>(pHandler), std::move(data));
+        }
+
+        // a table of at least twice the number of tags, so that a seed without collisions is quickly found
+        constexpr std::uint32_t TableSize_(std::size_t count)
+        {
+            std::uint32_t size = 1U;
+            while (size < 2U * count)
+            {
+                size *= 2U;
+            }
+            return size;
+        }
+
+        template<class... DataTs>
+        constexpr bool CollisionFree_(std::uint32_t seed, std::uint32_t mask)
+        {
+            constexpr std::size_t cCOUNT = sizeof...(DataTs);
+            const StringView tags[cCOUNT] = {SerializationTraits<DataTs>::cTAG_VIEW...};
+            for (std::size_t i = 0U; i < cCOUNT; ++i)
+            {
+                for (std::size_t j = i + 1U; j < cCOUNT; ++j)
+                {
+                    if ((MessageTagHash(tags[i], seed) & mask) == (MessageTagHash(tags[j], seed) & mask))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr std::uint32_t cNO_SEED = ~0U;
+
+        template<class... DataTs>
+        constexpr std::uint32_t Seed_(std::uint32_t mask)
+        {
+            for (std::uint32_t seed = 0U; seed < 1000U; ++seed)
+            {
+                if (CollisionFree_<DataTs...>(seed, mask))
+                    return seed;
+            }
+            return cNO_SEED;
+        }
+
+        template<class MessagesT, class HandlerT>
+        struct Table;
+
+        template<class... DataTs, class HandlerT>
+        struct Table<MessageTypes<DataTs...>, HandlerT>
+        {
+            static_assert(sizeof...(DataTs) > 0U, "no messages");
+
+            static constexpr std::uint32_t cSIZE = TableSize_(sizeof...(DataTs));
+            static constexpr std::uint32_t cMASK = cSIZE - 1U;
+            static constexpr std::uint32_t cSEED = Seed_<DataTs...>(cMASK);
+            static_assert(cSEED != cNO_SEED, "no perfect hash for these tags, duplicates?");
+
+            static constexpr std::array<MessageEntry, cSIZE> Entries_()
+            {
+                std::array<MessageEntry, cSIZE> entries{};
+                ((entries[MessageTagHash(SerializationTraits<DataTs>::cTAG_VIEW, cSEED) & cMASK] =
+                    MessageEntry{SerializationTraits<DataTs>::cTAG_VIEW, &Dispatch_<HandlerT, DataTs>, &DispatchStreaming_<HandlerT, DataTs>}), ...);
+                return entries;
+            }
+
+            static constexpr std::array<MessageEntry, cSIZE> cENTRIES = Entries_();
+            static constexpr MessageTable cTABLE{cENTRIES.data(), cMASK, cSEED};
+        };
+    }
+
+    template<class MessagesT, class HandlerT>
+    const MessageTable& MessageTable::Of()
+    {
+        return Registry::Table<MessagesT, HandlerT>::cTABLE;
+    }
+
+    // the messages each role receives:
+    using DownstreamMessageTypes = MessageTypes<ServiceDescriptionData, CheckAliveData, NotificationData, CommandData,
+        MachineReadyData, RevokeMachineReadyData, StartTransportData, StopTransportData, QueryBoardInfoData>;
+    using UpstreamMessageTypes = MessageTypes<ServiceDescriptionData, CheckAliveData, NotificationData, CommandData,
+        BoardAvailableData, RevokeBoardAvailableData, TransportFinishedData, BoardForecastData, SendBoardInfoData>;
+    using VerticalServiceMessageTypes = MessageTypes<SupervisoryServiceDescriptionData, CheckAliveData, NotificationData,
+        GetConfigurationData, SetConfigurationData, SendWorkOrderInfoData, QueryHermesCapabilitiesData>;
+    using VerticalClientMessageTypes = MessageTypes<SupervisoryServiceDescriptionData, CheckAliveData, NotificationData,
+        CurrentConfigurationData, BoardArrivedData, BoardDepartedData, QueryWorkOrderInfoData, ReplyWorkOrderInfoData,
+        SendHermesCapabilitiesData>;
+    using ConfigurationServiceMessageTypes = MessageTypes<GetConfigurationData, SetConfigurationData>;
+    using ConfigurationClientMessageTypes = MessageTypes<CurrentConfigurationData, NotificationData>;
+}
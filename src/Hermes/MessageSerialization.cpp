@@ -3,873 +3,297 @@
 #include "MessageSerialization.h"
 
 #include "BasicPugiSerialization.h"
+#include "MessageFields.h"
+#include "MessageFieldsC.h"
 #include "SenderEnvelope.h"
 
-#include <chrono>
-#include <time.h>
-#include <iomanip>
-
-namespace Hermes
+// Writing the messages straight into a string, driven by the Fields<> tables.
+// Attributes come first, as in any xml element, then the child elements, each in the order of Fields<>.
+namespace
 {
-    template<> struct PugiSerializer<SubBoard>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node parent, const SubBoard& data)
-        {
-            Serialize(parent, "Pos", data.m_pos);
-            Serialize(parent, "Bc", data.m_optionalBc);
-            Serialize(parent, "St", data.m_st);
-        }
-
-        static void ReadElement(pugi::xml_node parent, Error& error, SubBoard& data)
-        {
-            Deserialize(parent, "Pos", error, data.m_pos);
-            Deserialize(parent, "Bc", error, data.m_optionalBc);
-            Deserialize(parent, "St", error, data.m_st);
-        }
-    };
+    using namespace Hermes;
 
-    // SubBoards are special in that they are optional vectors
-    void Serialize(pugi::xml_node parent, const char* name, const SubBoards& subBoards)
+    void WriteValue_(XmlWriter& writer, const char* name, const std::string& value)
     {
-        if (subBoards.empty())
-            return;
-
-        auto subBoardsNode = parent.append_child(name);
-
-        for (const auto& item : subBoards)
-        {
-            Serialize(subBoardsNode, "SB", item);
-        }
+        writer.Attribute(name, value);
     }
 
-    void Deserialize(pugi::xml_node parent, const char* name, Error& error, SubBoards& subBoards)
+    void WriteValue_(XmlWriter& writer, const char* name, int value)
     {
-        const auto subBoardsNode = parent.child(name);
-        if (!subBoardsNode)
-            return;
-
-        for (const auto& node : subBoardsNode.children("SB"))
-        {
-            subBoards.emplace_back();
-            PugiSerializer<SubBoard>::ReadElement(node, error, subBoards.back());
-        }
+        writer.Attribute(name, value);
     }
 
-    template<> struct PugiSerializer<FeatureBoardForecast>
+    void WriteValue_(XmlWriter& writer, const char* name, unsigned value)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureBoardForecast&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureBoardForecast&) {}
-    };
+        writer.Attribute(name, value);
+    }
 
-    template<> struct PugiSerializer<FeatureCheckAliveResponse>
+    void WriteValue_(XmlWriter& writer, const char* name, unsigned short value)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureCheckAliveResponse&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureCheckAliveResponse&) {}
-    };
+        writer.Attribute(name, static_cast<int>(value));
+    }
 
-    template<> struct PugiSerializer<FeatureQueryBoardInfo>
+    void WriteValue_(XmlWriter& writer, const char* name, double value)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureQueryBoardInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureQueryBoardInfo&) {}
-    };
+        writer.Attribute(name, value);
+    }
 
-    template<> struct PugiSerializer<FeatureSendBoardInfo>
+    void WriteValue_(XmlWriter& writer, const char* name, HermesStringView value)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureSendBoardInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureSendBoardInfo&) {}
-    };
+        writer.Attribute(name, StringView{value.m_pData, value.m_size});
+    }
 
-    template<> struct PugiSerializer<FeatureCommand>
+    template<class E>
+    std::enable_if_t<std::is_enum<E>::value> WriteValue_(XmlWriter& writer, const char* name, E value)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureCommand&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureCommand&) {}
-    };
+        writer.Attribute(name, static_cast<int>(value));
+    }
 
-    template<> struct PugiSerializer<SupportedFeatures>
+    // the items of a C list, as references like those of a std::vector
+    template<class T>
+    class CItems_
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node parent, const SupportedFeatures& data)
+    public:
+        class Iterator
         {
-            Serialize(parent, "FeatureBoardForecast", data.m_optionalFeatureBoardForecast);
-            Serialize(parent, "FeatureCheckAliveResponse", data.m_optionalFeatureCheckAliveResponse);
-            Serialize(parent, "FeatureQueryBoardInfo", data.m_optionalFeatureQueryBoardInfo);
-            Serialize(parent, "FeatureSendBoardInfo", data.m_optionalFeatureSendBoardInfo);
-            Serialize(parent, "FeatureCommand", data.m_optionalFeatureCommand);
-        }
+        public:
+            explicit Iterator(const T* const* p) : m_p(p) {}
+            const T& operator*() const { return **m_p; }
+            Iterator& operator++() { ++m_p; return *this; }
+            bool operator!=(const Iterator& rhs) const { return m_p != rhs.m_p; }
 
-        static void ReadElement(pugi::xml_node parent, Error& error, SupportedFeatures& data)
-        {
-            Deserialize(parent, "FeatureBoardForecast", error, data.m_optionalFeatureBoardForecast);
-            Deserialize(parent, "FeatureCheckAliveResponse", error, data.m_optionalFeatureCheckAliveResponse);
-            Deserialize(parent, "FeatureQueryBoardInfo", error, data.m_optionalFeatureQueryBoardInfo);
-            Deserialize(parent, "FeatureSendBoardInfo", error, data.m_optionalFeatureSendBoardInfo);
-            Deserialize(parent, "FeatureCommand", error, data.m_optionalFeatureCommand);
-        }
-    };
+        private:
+            const T* const* m_p;
+        };
 
-    template<> struct PugiSerializer<UpstreamConfiguration>
-    {
-        using AsElementTag = int;
+        CItems_(const T* const* pItems, std::size_t size) : m_begin(pItems), m_end(pItems + size) {}
 
-        static void WriteElement(pugi::xml_node parent, const UpstreamConfiguration& data) 
-        {
-            Serialize(parent, "UpstreamLaneId", data.m_upstreamLaneId);
-            Serialize(parent, "UpstreamInterfaceId", data.m_optionalUpstreamInterfaceId);
-            Serialize(parent, "HostAddress", data.m_hostAddress);
-            Serialize(parent, "Port", data.m_port);
-        }
+        Iterator begin() const { return m_begin; }
+        Iterator end() const { return m_end; }
+        bool empty() const { return !(m_begin != m_end); }
 
-        static void ReadElement(pugi::xml_node parent, Error& error, UpstreamConfiguration& data) 
-        {
-            Deserialize(parent, "UpstreamLaneId", error, data.m_upstreamLaneId);
-            Deserialize(parent, "UpstreamInterfaceId", error, data.m_optionalUpstreamInterfaceId);
-            Deserialize(parent, "HostAddress", error, data.m_hostAddress);
-            Deserialize(parent, "Port", error, data.m_port);
-        }
+    private:
+        Iterator m_begin;
+        Iterator m_end;
     };
 
-    template<> struct PugiSerializer<DownstreamConfiguration>
+    template<class T>
+    const std::vector<T>& Items_(const std::vector<T>& list)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node parent, const DownstreamConfiguration& data)
-        {
-            Serialize(parent, "DownstreamLaneId", data.m_downstreamLaneId);
-            Serialize(parent, "DownstreamInterfaceId", data.m_optionalDownstreamInterfaceId);
-            Serialize(parent, "ClientAddress", data.m_optionalClientAddress);
-            Serialize(parent, "Port", data.m_port);
-        }
+        return list;
+    }
 
-        static void ReadElement(pugi::xml_node parent, Error& error, DownstreamConfiguration& data)
-        {
-            Deserialize(parent, "DownstreamLaneId", error, data.m_downstreamLaneId);
-            Deserialize(parent, "DownstreamInterfaceId", error, data.m_optionalDownstreamInterfaceId);
-            Deserialize(parent, "ClientAddress", error, data.m_optionalClientAddress);
-            Deserialize(parent, "Port", error, data.m_port);
-        }
-    };
+    template<class CListT>
+    CItems_<typename ListTraits<CListT>::Item> Items_(const CListT& list)
+    {
+        return{list.m_pData, list.m_size};
+    }
 
-    template<> struct PugiSerializer<UpstreamConfigurations>
+    template<class ListT>
+    constexpr bool IsSubBoards_()
     {
-        using AsElementTag = int;
+        return std::is_same<ListT, SubBoards>::value || std::is_same<ListT, HermesSubBoards>::value;
+    }
 
-        static void WriteElement(pugi::xml_node parent, const UpstreamConfigurations& data)
-        {
-            for (const auto& item : data)
-            {
-                Serialize(parent, "UpstreamConfiguration", item);
-            }
-        }
-        static void ReadElement(pugi::xml_node parent, Error& error, UpstreamConfigurations& data)
+    template<class T>
+    void WriteFields_(XmlWriter&, const T&, bool withSubBoards);
+
+    template<std::size_t I, class T>
+    void WriteAttributeField_(XmlWriter& writer, const T& data)
+    {
+        using Traits = FieldTraits<T, I>;
+        if constexpr (Traits::cATTRIBUTE)
         {
-            for (const auto& node : parent.children("UpstreamConfiguration"))
+            if (const auto* pValue = Traits::Get(data))
             {
-                data.emplace_back();
-                PugiSerializer<UpstreamConfiguration>::ReadElement(node, error, data.back());
+                WriteValue_(writer, Traits::cFIELD.m_name, *pValue);
             }
         }
-    };
+    }
 
-    template<> struct PugiSerializer<DownstreamConfigurations>
+    template<std::size_t I, class T>
+    void WriteElementField_(XmlWriter& writer, const T& data, bool withSubBoards)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node parent, const DownstreamConfigurations& data)
+        using Traits = FieldTraits<T, I>;
+        if constexpr (!Traits::cATTRIBUTE)
         {
-            for (const auto& item : data)
+            const auto* pValue = Traits::Get(data);
+            if (!pValue)
+                return;
+
+            if constexpr (Traits::cLIST)
             {
-                Serialize(parent, "DownstreamConfiguration", item);
+                using List = typename Traits::Value;
+                const auto& items = Items_(*pValue);
+                // optional lists are left out when empty, and SubBoards when the message would get too long
+                if ((ListTraits<List>::cOPTIONAL && items.empty()) || (IsSubBoards_<List>() && !withSubBoards))
+                    return;
+                writer.StartElement(Traits::cFIELD.m_name);
+                for (const auto& item : items)
+                {
+                    writer.StartElement(ListTraits<List>::cITEM);
+                    WriteFields_(writer, item, withSubBoards);
+                    writer.EndElement();
+                }
+                writer.EndElement();
             }
-        }
-        static void ReadElement(pugi::xml_node parent, Error& error, DownstreamConfigurations& data)
-        {
-            for (const auto& node : parent.children("DownstreamConfiguration"))
+            else
             {
-                data.emplace_back();
-                PugiSerializer<DownstreamConfiguration>::ReadElement(node, error, data.back());
+                writer.StartElement(Traits::cFIELD.m_name);
+                WriteFields_(writer, *pValue, withSubBoards);
+                writer.EndElement();
             }
         }
-    };
-
-    template<> struct PugiSerializer<FeatureConfiguration>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureConfiguration&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureConfiguration&) {}
-    };
-
-    template<> struct PugiSerializer<FeatureBoardTracking>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureBoardTracking&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureBoardTracking&) {}
-    };
-
-    template<> struct PugiSerializer<FeatureQueryWorkOrderInfo>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureQueryWorkOrderInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureQueryWorkOrderInfo&) {}
-    };
-
-    template<> struct PugiSerializer<FeatureSendWorkOrderInfo>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureSendWorkOrderInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureSendWorkOrderInfo&) {}
-    };
-
-    template<> struct PugiSerializer<FeatureReplyWorkOrderInfo>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureReplyWorkOrderInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureReplyWorkOrderInfo&) {}
-    };
-
-    template<> struct PugiSerializer<FeatureQueryHermesCapabilities>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureQueryHermesCapabilities&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureQueryHermesCapabilities&) {}
-    };
-
-    template<> struct PugiSerializer<FeatureSendHermesCapabilities>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const FeatureSendHermesCapabilities&) {}
-        static void ReadElement(pugi::xml_node, Error&, FeatureSendHermesCapabilities&) {}
-    };
-
-    template<> struct PugiSerializer<SupervisoryFeatures>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node parent, const SupervisoryFeatures& data)
-        {
-            Serialize(parent, "FeatureConfiguration", data.m_optionalFeatureConfiguration);
-            Serialize(parent, "FeatureCheckAliveResponse", data.m_optionalFeatureCheckAliveResponse);
-            Serialize(parent, "FeatureBoardTracking", data.m_optionalFeatureBoardTracking);
-            Serialize(parent, "FeatureQueryWorkOrderInfo", data.m_optionalFeatureQueryWorkOrderInfo);
-            Serialize(parent, "FeatureSendWorkOrderInfo", data.m_optionalFeatureSendWorkOrderInfo);
-            Serialize(parent, "FeatureReplyWorkOrderInfo", data.m_optionalFeatureReplyWorkOrderInfo);
-            Serialize(parent, "FeatureQueryHermesCapabilities", data.m_optionalFeatureQueryHermesCapabilities);
-            Serialize(parent, "FeatureSendHermesCapabilities", data.m_optionalFeatureSendHermesCapabilities);
-        }
-
-        static void ReadElement(pugi::xml_node parent, Error& error, SupervisoryFeatures& data)
-        {
-            Deserialize(parent, "FeatureConfiguration", error, data.m_optionalFeatureConfiguration);
-            Deserialize(parent, "FeatureCheckAliveResponse", error, data.m_optionalFeatureCheckAliveResponse);
-            Deserialize(parent, "FeatureBoardTracking", error, data.m_optionalFeatureBoardTracking);
-            Deserialize(parent, "FeatureQueryWorkOrderInfo", error, data.m_optionalFeatureQueryWorkOrderInfo);
-            Deserialize(parent, "FeatureSendWorkOrderInfo", error, data.m_optionalFeatureSendWorkOrderInfo);
-            Deserialize(parent, "FeatureReplyWorkOrderInfo", error, data.m_optionalFeatureReplyWorkOrderInfo);
-            Deserialize(parent, "FeatureQueryHermesCapabilities", error, data.m_optionalFeatureQueryHermesCapabilities);
-            Deserialize(parent, "FeatureSendHermesCapabilities", error, data.m_optionalFeatureSendHermesCapabilities);
-        }
-    };
-
-    template<> struct PugiSerializer<MessageCheckAliveResponse>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageCheckAliveResponse&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageCheckAliveResponse&) {}
-    };
-
-    template<> struct PugiSerializer<MessageBoardForecast>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageBoardForecast&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageBoardForecast&) {}
-    };
-
-    template<> struct PugiSerializer<MessageQueryBoardInfo>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageQueryBoardInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageQueryBoardInfo&) {}
-    };
-
-    template<> struct PugiSerializer<MessageSendBoardInfo>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageSendBoardInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageSendBoardInfo&) {}
-    };
-    template<> struct PugiSerializer<MessageBoardArrived>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageBoardArrived&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageBoardArrived&) {}
-    };
-
-    template<> struct PugiSerializer<MessageBoardDeparted>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageBoardDeparted&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageBoardDeparted&) {}
-    };
-
-    template<> struct PugiSerializer<MessageQueryWorkOrderInfo>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageQueryWorkOrderInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageQueryWorkOrderInfo&) {}
-    };
-
-    template<> struct PugiSerializer<MessageReplyWorkOrderInfo>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageReplyWorkOrderInfo&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageReplyWorkOrderInfo&) {}
-    };
-
-    template<> struct PugiSerializer<MessageCommand>
-    {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node, const MessageCommand&) {}
-        static void ReadElement(pugi::xml_node, Error&, MessageCommand&) {}
-    };
+    }
 
-    template<> struct PugiSerializer<OptionalMessages>
+    template<class T, std::size_t... Is>
+    void WriteFields_(XmlWriter& writer, const T& data, bool withSubBoards, std::index_sequence<Is...>)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node parent, const OptionalMessages& data)
-        {
-            Serialize(parent, "MessageCheckAliveResponse", data.m_optionalMessageCheckAliveResponse);
-            Serialize(parent, "MessageBoardForecast", data.m_optionalMessageBoardForecast);
-            Serialize(parent, "MessageQueryBoardInfo", data.m_optionalMessageQueryBoardInfo);
-            Serialize(parent, "MessageSendBoardInfo", data.m_optionalMessageSendBoardInfo);
-            Serialize(parent, "MessageBoardArrived", data.m_optionalMessageBoardArrived);
-            Serialize(parent, "MessageBoardDeparted", data.m_optionalMessageBoardDeparted);
-            Serialize(parent, "MessageQueryWorkOrderInfo", data.m_optionalMessageQueryWorkOrderInfo);
-            Serialize(parent, "MessageReplyWorkOrderInfo", data.m_optionalMessageReplyWorkOrderInfo);
-            Serialize(parent, "MessageCommand", data.m_optionalMessageCommand);
-        }
-
-        static void ReadElement(pugi::xml_node parent, Error& error, OptionalMessages& data)
-        {
-            Deserialize(parent, "MessageCheckAliveResponse", error, data.m_optionalMessageCheckAliveResponse);
-            Deserialize(parent, "MessageBoardForecast", error, data.m_optionalMessageBoardForecast);
-            Deserialize(parent, "MessageQueryBoardInfo", error, data.m_optionalMessageQueryBoardInfo);
-            Deserialize(parent, "MessageSendBoardInfo", error, data.m_optionalMessageSendBoardInfo);
-            Deserialize(parent, "MessageBoardArrived", error, data.m_optionalMessageBoardArrived);
-            Deserialize(parent, "MessageBoardDeparted", error, data.m_optionalMessageBoardDeparted);
-            Deserialize(parent, "MessageQueryWorkOrderInfo", error, data.m_optionalMessageQueryWorkOrderInfo);
-            Deserialize(parent, "MessageReplyWorkOrderInfo", error, data.m_optionalMessageReplyWorkOrderInfo);
-            Deserialize(parent, "MessageCommand", error, data.m_optionalMessageCommand);
-        }
-    };
+        (WriteAttributeField_<Is>(writer, data), ...);
+        (WriteElementField_<Is>(writer, data, withSubBoards), ...);
+    }
 
-    template<> struct PugiSerializer<Attributes>
+    template<class T>
+    void WriteFields_(XmlWriter& writer, const T& data, bool withSubBoards)
     {
-        using AsElementTag = int;
-
-        static void WriteElement(pugi::xml_node parent, const Attributes& data)
-        {
-            Serialize(parent, "ProductTypeId", data.m_productTypeId);
-            Serialize(parent, "TopBarcode", data.m_topBarcode);
-            Serialize(parent, "BottomBarcode", data.m_bottomBarcode);
-            Serialize(parent, "Length", data.m_length);
-            Serialize(parent, "Width", data.m_width);
-            Serialize(parent, "Thickness", data.m_thickness);
-            Serialize(parent, "ConveyorSpeed", data.m_conveyorSpeed);
-            Serialize(parent, "TopClearanceHeight", data.m_topClearanceHeight);
-            Serialize(parent, "BottomClearanceHeight", data.m_bottomClearanceHeight);
-            Serialize(parent, "Weight", data.m_weight);
-            Serialize(parent, "WorkOrderId", data.m_workOrderId);
-            Serialize(parent, "BatchId", data.m_batchId);
-            Serialize(parent, "Route", data.m_route);
-            Serialize(parent, "Action", data.m_action);
-            Serialize(parent, "SubBoards", data.m_subBoards);
-        }
-
-        static void ReadElement(pugi::xml_node parent, Error& error, Attributes& data)
-        {
-            Deserialize(parent, "ProductTypeId", error, data.m_productTypeId);
-            Deserialize(parent, "TopBarcode", error, data.m_topBarcode);
-            Deserialize(parent, "BottomBarcode", error, data.m_bottomBarcode);
-            Deserialize(parent, "Length", error, data.m_length);
-            Deserialize(parent, "Width", error, data.m_width);
-            Deserialize(parent, "Thickness", error, data.m_thickness);
-            Deserialize(parent, "ConveyorSpeed", error, data.m_conveyorSpeed);
-            Deserialize(parent, "TopClearanceHeight", error, data.m_topClearanceHeight);
-            Deserialize(parent, "BottomClearanceHeight", error, data.m_bottomClearanceHeight);
-            Deserialize(parent, "Weight", error, data.m_weight);
-            Deserialize(parent, "WorkOrderId", error, data.m_workOrderId);
-            Deserialize(parent, "BatchId", error, data.m_batchId);
-            Deserialize(parent, "Route", error, data.m_route);
-            Deserialize(parent, "Action", error, data.m_action);
-            Deserialize(parent, "SubBoards", error, data.m_subBoards);
-        }
-    };
-}
-
-std::string Hermes::Serialize(const ServiceDescriptionData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<ServiceDescriptionData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "LaneId", data.m_laneId);
-    Serialize(envelope.DataNode(), "MachineId", data.m_machineId);
-    Serialize(envelope.DataNode(), "InterfaceId", data.m_optionalInterfaceId);
-    Serialize(envelope.DataNode(), "Version", data.m_version);
-    Serialize(envelope.DataNode(), "SupportedFeatures", data.m_supportedFeatures);
-    return envelope.ToXmlString();
-}
-
+        WriteFields_(writer, data, withSubBoards, std::make_index_sequence<FieldCount<T>()>());
+    }
 
-std::string Serialize_(const Hermes::BoardAvailableData& data, bool includeSubBoards)
-{
-    using namespace Hermes;
-    SenderEnvelope envelope(Hermes::SerializationTraits<BoardAvailableData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "BoardId", data.m_boardId);
-    Serialize(envelope.DataNode(), "BoardIdCreatedBy", data.m_boardIdCreatedBy);
-    Serialize(envelope.DataNode(), "FailedBoard", data.m_failedBoard);
-    Serialize(envelope.DataNode(), "ProductTypeId", data.m_optionalProductTypeId);
-    Serialize(envelope.DataNode(), "FlippedBoard", data.m_flippedBoard);
-    Serialize(envelope.DataNode(), "TopBarcode", data.m_optionalTopBarcode);
-    Serialize(envelope.DataNode(), "BottomBarcode", data.m_optionalBottomBarcode);
-    Serialize(envelope.DataNode(), "Length", data.m_optionalLengthInMM);
-    Serialize(envelope.DataNode(), "Width", data.m_optionalWidthInMM);
-    Serialize(envelope.DataNode(), "Thickness", data.m_optionalThicknessInMM);
-    Serialize(envelope.DataNode(), "ConveyorSpeed", data.m_optionalConveyorSpeedInMMPerSecs);
-    Serialize(envelope.DataNode(), "TopClearanceHeight", data.m_optionalTopClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "BottomClearanceHeight", data.m_optionalBottomClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "Weight", data.m_optionalWeightInGrams);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_optionalWorkOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    Serialize(envelope.DataNode(), "Route", data.m_optionalRoute);
-    Serialize(envelope.DataNode(), "Action", data.m_optionalAction);
-    if (includeSubBoards)
+    template<class T, std::size_t... Is>
+    constexpr bool HasSubBoards_(std::index_sequence<Is...>)
     {
-        Serialize(envelope.DataNode(), "SubBoards", data.m_optionalSubBoards);
+        return (false || ... || IsSubBoards_<typename FieldTraits<T, Is>::Value>());
     }
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const BoardAvailableData& data)
-{
-    auto str{ Serialize_(data, true) };
-    if (str.size() <= cMAX_MESSAGE_SIZE)
-        return str;
-
-    return Serialize_(data, false);
-}
-
-std::string Hermes::Serialize(const RevokeBoardAvailableData&)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<RevokeBoardAvailableData>::cTAG_VIEW);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const MachineReadyData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<MachineReadyData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "FailedBoard", data.m_failedBoard);
-    Serialize(envelope.DataNode(), "ForecastId", data.m_optionalForecastId);
-    Serialize(envelope.DataNode(), "BoardId", data.m_optionalBoardId);
-    Serialize(envelope.DataNode(), "ProductTypeId", data.m_optionalProductTypeId);
-    Serialize(envelope.DataNode(), "FlippedBoard", data.m_optionalFlippedBoard);
-    Serialize(envelope.DataNode(), "TopBarcode", data.m_optionalTopBarcode);
-    Serialize(envelope.DataNode(), "BottomBarcode", data.m_optionalBottomBarcode);
-    Serialize(envelope.DataNode(), "Length", data.m_optionalLengthInMM);
-    Serialize(envelope.DataNode(), "Width", data.m_optionalWidthInMM);
-    Serialize(envelope.DataNode(), "Thickness", data.m_optionalThicknessInMM);
-    Serialize(envelope.DataNode(), "ConveyorSpeed", data.m_optionalConveyorSpeedInMMPerSecs);
-    Serialize(envelope.DataNode(), "TopClearanceHeight", data.m_optionalTopClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "BottomClearanceHeight", data.m_optionalBottomClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "Weight", data.m_optionalWeightInGrams);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_optionalWorkOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const RevokeMachineReadyData&)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<RevokeMachineReadyData>::cTAG_VIEW);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const StartTransportData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<StartTransportData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "BoardId", data.m_boardId);
-    Serialize(envelope.DataNode(), "ConveyorSpeed", data.m_optionalConveyorSpeedInMMPerSecs);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const TransportFinishedData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<TransportFinishedData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "TransferState", data.m_transferState);
-    Serialize(envelope.DataNode(), "BoardId", data.m_boardId);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const StopTransportData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<StopTransportData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "TransferState", data.m_transferState);
-    Serialize(envelope.DataNode(), "BoardId", data.m_boardId);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const NotificationData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<NotificationData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "NotificationCode", data.m_notificationCode);
-    Serialize(envelope.DataNode(), "Severity", data.m_severity);
-    Serialize(envelope.DataNode(), "Description", data.m_description);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const CheckAliveData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<CheckAliveData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "Type", data.m_optionalType);
-    Serialize(envelope.DataNode(), "Id", data.m_optionalId);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const GetConfigurationData&)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<GetConfigurationData>::cTAG_VIEW);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const SetConfigurationData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<SetConfigurationData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "MachineId", data.m_machineId);
-    Serialize(envelope.DataNode(), "SupervisorySystemPort", data.m_optionalSupervisorySystemPort);
-    Serialize(envelope.DataNode(), "UpstreamConfigurations", data.m_upstreamConfigurations);
-    Serialize(envelope.DataNode(), "DownstreamConfigurations", data.m_downstreamConfigurations);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const CurrentConfigurationData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<CurrentConfigurationData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "MachineId", data.m_optionalMachineId);
-    Serialize(envelope.DataNode(), "SupervisorySystemPort", data.m_optionalSupervisorySystemPort);
-    Serialize(envelope.DataNode(), "UpstreamConfigurations", data.m_upstreamConfigurations);
-    Serialize(envelope.DataNode(), "DownstreamConfigurations", data.m_downstreamConfigurations);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const BoardForecastData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<BoardForecastData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "ForecastId", data.m_optionalForecastId);
-    Serialize(envelope.DataNode(), "TimeUntilAvailable", data.m_optionalTimeUntilAvailableInSeconds);    
-    Serialize(envelope.DataNode(), "BoardId", data.m_optionalBoardId);
-    Serialize(envelope.DataNode(), "BoardIdCreatedBy", data.m_optionalBoardIdCreatedBy);
-    Serialize(envelope.DataNode(), "FailedBoard", data.m_failedBoard);
-    Serialize(envelope.DataNode(), "ProductTypeId", data.m_optionalProductTypeId);
-    Serialize(envelope.DataNode(), "FlippedBoard", data.m_flippedBoard);
-    Serialize(envelope.DataNode(), "TopBarcode", data.m_optionalTopBarcode);
-    Serialize(envelope.DataNode(), "BottomBarcode", data.m_optionalBottomBarcode);
-    Serialize(envelope.DataNode(), "Length", data.m_optionalLengthInMM);
-    Serialize(envelope.DataNode(), "Width", data.m_optionalWidthInMM);
-    Serialize(envelope.DataNode(), "Thickness", data.m_optionalThicknessInMM);
-    Serialize(envelope.DataNode(), "ConveyorSpeed", data.m_optionalConveyorSpeedInMMPerSecs);
-    Serialize(envelope.DataNode(), "TopClearanceHeight", data.m_optionalTopClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "BottomClearanceHeight", data.m_optionalBottomClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "Weight", data.m_optionalWeightInGrams);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_optionalWorkOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const QueryBoardInfoData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<QueryBoardInfoData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "TopBarcode", data.m_optionalTopBarcode);
-    Serialize(envelope.DataNode(), "BottomBarcode", data.m_optionalBottomBarcode);
-    return envelope.ToXmlString();
-}
-
-std::string Serialize_(const Hermes::SendBoardInfoData& data, bool includeSubBoards)
-{
-    using namespace Hermes;
 
-    SenderEnvelope envelope(Hermes::SerializationTraits<SendBoardInfoData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "BoardId", data.m_optionalBoardId);
-    Serialize(envelope.DataNode(), "BoardIdCreatedBy", data.m_optionalBoardIdCreatedBy);
-    Serialize(envelope.DataNode(), "FailedBoard", data.m_optionalFailedBoard);
-    Serialize(envelope.DataNode(), "ProductTypeId", data.m_optionalProductTypeId);
-    Serialize(envelope.DataNode(), "FlippedBoard", data.m_optionalFlippedBoard);
-    Serialize(envelope.DataNode(), "TopBarcode", data.m_optionalTopBarcode);
-    Serialize(envelope.DataNode(), "BottomBarcode", data.m_optionalBottomBarcode);
-    Serialize(envelope.DataNode(), "Length", data.m_optionalLengthInMM);
-    Serialize(envelope.DataNode(), "Width", data.m_optionalWidthInMM);
-    Serialize(envelope.DataNode(), "Thickness", data.m_optionalThicknessInMM);
-    Serialize(envelope.DataNode(), "ConveyorSpeed", data.m_optionalConveyorSpeedInMMPerSecs);
-    Serialize(envelope.DataNode(), "TopClearanceHeight", data.m_optionalTopClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "BottomClearanceHeight", data.m_optionalBottomClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "Weight", data.m_optionalWeightInGrams);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_optionalWorkOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    Serialize(envelope.DataNode(), "Route", data.m_optionalRoute);
-    Serialize(envelope.DataNode(), "Action", data.m_optionalAction);
-    if (includeSubBoards)
+    template<class DataT>
+    void WriteMessage_(const DataT& data, StringView tag, std::string& xml, EXmlFormat format, bool withSubBoards)
     {
-        Serialize(envelope.DataNode(), "SubBoards", data.m_optionalSubBoards);
+        SenderEnvelope envelope(xml, tag, format);
+        WriteFields_(envelope.DataWriter(), data, withSubBoards);
+        envelope.Finish();
     }
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const SendBoardInfoData& data)
-{
-    auto str{ Serialize_(data, true) };
-    if (str.size() <= cMAX_MESSAGE_SIZE)
-        return str;
-
-    return Serialize_(data, false);
-}
-
-std::string Hermes::Serialize(const SupervisoryServiceDescriptionData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<SupervisoryServiceDescriptionData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "SystemId", data.m_systemId);
-    Serialize(envelope.DataNode(), "Version", data.m_version);
-    Serialize(envelope.DataNode(), "SupportedFeatures", data.m_supportedFeatures);
-    return envelope.ToXmlString();
-}
 
-std::string Serialize_(const Hermes::BoardArrivedData& data, bool includeSubBoards)
-{
-    using namespace Hermes;
-    SenderEnvelope envelope(Hermes::SerializationTraits<BoardArrivedData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "MachineId", data.m_machineId);
-    Serialize(envelope.DataNode(), "UpstreamLaneId", data.m_upstreamLaneId);
-    Serialize(envelope.DataNode(), "UpstreamInterfaceId", data.m_optionalUpstreamInterfaceId);
-    Serialize(envelope.DataNode(), "MagazineId", data.m_optionalMagazineId);
-    Serialize(envelope.DataNode(), "SlotId", data.m_optionalSlotId);
-    Serialize(envelope.DataNode(), "BoardTransfer", data.m_boardTransfer);
-    Serialize(envelope.DataNode(), "BoardId", data.m_boardId);
-    Serialize(envelope.DataNode(), "BoardIdCreatedBy", data.m_boardIdCreatedBy);
-    Serialize(envelope.DataNode(), "FailedBoard", data.m_failedBoard);
-    Serialize(envelope.DataNode(), "ProductTypeId", data.m_optionalProductTypeId);
-    Serialize(envelope.DataNode(), "FlippedBoard", data.m_flippedBoard);
-    Serialize(envelope.DataNode(), "TopBarcode", data.m_optionalTopBarcode);
-    Serialize(envelope.DataNode(), "BottomBarcode", data.m_optionalBottomBarcode);
-    Serialize(envelope.DataNode(), "Length", data.m_optionalLengthInMM);
-    Serialize(envelope.DataNode(), "Width", data.m_optionalWidthInMM);
-    Serialize(envelope.DataNode(), "Thickness", data.m_optionalThicknessInMM);
-    Serialize(envelope.DataNode(), "ConveyorSpeed", data.m_optionalConveyorSpeedInMMPerSecs);
-    Serialize(envelope.DataNode(), "TopClearanceHeight", data.m_optionalTopClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "BottomClearanceHeight", data.m_optionalBottomClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "Weight", data.m_optionalWeightInGrams);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_optionalWorkOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    Serialize(envelope.DataNode(), "Route", data.m_optionalRoute);
-    Serialize(envelope.DataNode(), "Action", data.m_optionalAction);
-    if (includeSubBoards)
+    // the C structs have their tag from the C++ type, DataT being C++ or C
+    template<class CppT, class DataT>
+    void SerializeMessageAs_(const DataT& data, std::string& xml, EXmlFormat format)
     {
-        Serialize(envelope.DataNode(), "SubBoards", data.m_optionalSubBoards);
+        constexpr StringView cTAG = SerializationTraits<CppT>::cTAG_VIEW;
+        WriteMessage_(data, cTAG, xml, format, true);
+        if constexpr (HasSubBoards_<DataT>(std::make_index_sequence<FieldCount<DataT>()>()))
+        {
+            // the sub boards are informational, so they are what gets dropped if the message is too long
+            if (xml.size() > cMAX_MESSAGE_SIZE)
+            {
+                WriteMessage_(data, cTAG, xml, format, false);
+            }
+        }
     }
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const BoardArrivedData& data)
-{
-    auto str{ Serialize_(data, true) };
-    if (str.size() <= cMAX_MESSAGE_SIZE)
-        return str;
-
-    return Serialize_(data, false);
-}
 
-std::string Serialize_(const Hermes::BoardDepartedData& data, bool includeSubBoards)
-{
-    using namespace Hermes;
-    SenderEnvelope envelope(Hermes::SerializationTraits<BoardDepartedData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "MachineId", data.m_machineId);
-    Serialize(envelope.DataNode(), "DownstreamLaneId", data.m_downstreamLaneId);
-    Serialize(envelope.DataNode(), "DownstreamInterfaceId", data.m_optionalDownstreamInterfaceId);
-    Serialize(envelope.DataNode(), "MagazineId", data.m_optionalMagazineId);
-    Serialize(envelope.DataNode(), "SlotId", data.m_optionalSlotId);
-    Serialize(envelope.DataNode(), "BoardTransfer", data.m_boardTransfer);
-    Serialize(envelope.DataNode(), "BoardId", data.m_boardId);
-    Serialize(envelope.DataNode(), "BoardIdCreatedBy", data.m_boardIdCreatedBy);
-    Serialize(envelope.DataNode(), "FailedBoard", data.m_failedBoard);
-    Serialize(envelope.DataNode(), "ProductTypeId", data.m_optionalProductTypeId);
-    Serialize(envelope.DataNode(), "FlippedBoard", data.m_flippedBoard);
-    Serialize(envelope.DataNode(), "TopBarcode", data.m_optionalTopBarcode);
-    Serialize(envelope.DataNode(), "BottomBarcode", data.m_optionalBottomBarcode);
-    Serialize(envelope.DataNode(), "Length", data.m_optionalLengthInMM);
-    Serialize(envelope.DataNode(), "Width", data.m_optionalWidthInMM);
-    Serialize(envelope.DataNode(), "Thickness", data.m_optionalThicknessInMM);
-    Serialize(envelope.DataNode(), "ConveyorSpeed", data.m_optionalConveyorSpeedInMMPerSecs);
-    Serialize(envelope.DataNode(), "TopClearanceHeight", data.m_optionalTopClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "BottomClearanceHeight", data.m_optionalBottomClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "Weight", data.m_optionalWeightInGrams);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_optionalWorkOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    Serialize(envelope.DataNode(), "Route", data.m_optionalRoute);
-    Serialize(envelope.DataNode(), "Action", data.m_optionalAction);
-    if (includeSubBoards)
+    template<class DataT>
+    void SerializeMessage_(const DataT& data, std::string& xml, EXmlFormat format)
     {
-        Serialize(envelope.DataNode(), "SubBoards", data.m_optionalSubBoards);
+        SerializeMessageAs_<DataT>(data, xml, format);
     }
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const BoardDepartedData& data)
-{
-    auto str{ Serialize_(data, true) };
-    if (str.size() <= cMAX_MESSAGE_SIZE)
-        return str;
 
-    return Serialize_(data, false);
-}
-
-std::string Hermes::Serialize(const QueryWorkOrderInfoData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<QueryWorkOrderInfoData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "QueryId", data.m_optionalQueryId);
-    Serialize(envelope.DataNode(), "MachineId", data.m_machineId);
-    Serialize(envelope.DataNode(), "MagazineId", data.m_optionalMagazineId);
-    Serialize(envelope.DataNode(), "SlotId", data.m_optionalSlotId);
-    Serialize(envelope.DataNode(), "Barcode", data.m_optionalBarcode);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_optionalWorkOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    return envelope.ToXmlString();
-}
-
-std::string Serialize_(const Hermes::SendWorkOrderInfoData& data, bool includeSubBoards)
-{
-    using namespace Hermes;
-    SenderEnvelope envelope(Hermes::SerializationTraits<SendWorkOrderInfoData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "QueryId", data.m_optionalQueryId);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_optionalWorkOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    Serialize(envelope.DataNode(), "BoardId", data.m_optionalBoardId);
-    Serialize(envelope.DataNode(), "BoardIdCreatedBy", data.m_optionalBoardIdCreatedBy);
-    Serialize(envelope.DataNode(), "FailedBoard", data.m_optionalFailedBoard);
-    Serialize(envelope.DataNode(), "ProductTypeId", data.m_optionalProductTypeId);
-    Serialize(envelope.DataNode(), "FlippedBoard", data.m_optionalFlippedBoard);
-    Serialize(envelope.DataNode(), "TopBarcode", data.m_optionalTopBarcode);
-    Serialize(envelope.DataNode(), "BottomBarcode", data.m_optionalBottomBarcode);
-    Serialize(envelope.DataNode(), "Length", data.m_optionalLengthInMM);
-    Serialize(envelope.DataNode(), "Width", data.m_optionalWidthInMM);
-    Serialize(envelope.DataNode(), "Thickness", data.m_optionalThicknessInMM);
-    Serialize(envelope.DataNode(), "ConveyorSpeed", data.m_optionalConveyorSpeedInMMPerSecs);
-    Serialize(envelope.DataNode(), "TopClearanceHeight", data.m_optionalTopClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "BottomClearanceHeight", data.m_optionalBottomClearanceHeightInMM);
-    Serialize(envelope.DataNode(), "Weight", data.m_optionalWeightInGrams);
-    Serialize(envelope.DataNode(), "Route", data.m_optionalRoute);
-    if (includeSubBoards)
+    template<class DataT>
+    std::string SerializeMessage_(const DataT& data)
     {
-        Serialize(envelope.DataNode(), "SubBoards", data.m_optionalSubBoards);
+        std::string xml;
+        xml.reserve(512U);
+        SerializeMessage_(data, xml, EXmlFormat::eINDENTED);
+        return xml;
     }
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const SendWorkOrderInfoData& data)
-{
-    auto str{ Serialize_(data, true) };
-    if (str.size() <= cMAX_MESSAGE_SIZE)
-        return str;
-
-    return Serialize_(data, false);
-}
-
-std::string Hermes::Serialize(const ReplyWorkOrderInfoData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<ReplyWorkOrderInfoData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "WorkOrderId", data.m_workOrderId);
-    Serialize(envelope.DataNode(), "BatchId", data.m_optionalBatchId);
-    Serialize(envelope.DataNode(), "Status", data.m_status);
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const QueryHermesCapabilitiesData&)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<QueryHermesCapabilitiesData>::cTAG_VIEW);
-
-    return envelope.ToXmlString();
-}
-
-std::string Hermes::Serialize(const SendHermesCapabilitiesData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<SendHermesCapabilitiesData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "OptionalMessages", data.m_optionalMessages);
-    Serialize(envelope.DataNode(), "Attributes", data.m_attributes);
-
-    return envelope.ToXmlString();
 }
 
-std::string Hermes::Serialize(const CommandData& data)
-{
-    SenderEnvelope envelope(Hermes::SerializationTraits<CommandData>::cTAG_VIEW);
-    Serialize(envelope.DataNode(), "Command", data.m_command);
-    return envelope.ToXmlString();
-}
+std::string Hermes::Serialize(const ServiceDescriptionData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const BoardAvailableData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const RevokeBoardAvailableData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const MachineReadyData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const RevokeMachineReadyData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const StartTransportData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const TransportFinishedData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const StopTransportData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const NotificationData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const CheckAliveData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const GetConfigurationData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const SetConfigurationData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const CurrentConfigurationData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const BoardForecastData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const QueryBoardInfoData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const SendBoardInfoData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const SupervisoryServiceDescriptionData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const BoardArrivedData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const BoardDepartedData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const QueryWorkOrderInfoData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const SendWorkOrderInfoData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const ReplyWorkOrderInfoData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const QueryHermesCapabilitiesData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const SendHermesCapabilitiesData& data) { return SerializeMessage_(data); }
+std::string Hermes::Serialize(const CommandData& data) { return SerializeMessage_(data); }
+
+void Hermes::Serialize(const ServiceDescriptionData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const BoardAvailableData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const RevokeBoardAvailableData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const MachineReadyData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const RevokeMachineReadyData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const StartTransportData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const TransportFinishedData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const StopTransportData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const NotificationData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const CheckAliveData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const GetConfigurationData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const SetConfigurationData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const CurrentConfigurationData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const BoardForecastData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const QueryBoardInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const SendBoardInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const SupervisoryServiceDescriptionData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const BoardArrivedData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const BoardDepartedData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const QueryWorkOrderInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const SendWorkOrderInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const ReplyWorkOrderInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const QueryHermesCapabilitiesData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const SendHermesCapabilitiesData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+void Hermes::Serialize(const CommandData& data, std::string& xml, EXmlFormat format) { SerializeMessage_(data, xml, format); }
+
+void Hermes::Serialize(const HermesServiceDescriptionData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<ServiceDescriptionData>(data, xml, format); }
+void Hermes::Serialize(const HermesBoardAvailableData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<BoardAvailableData>(data, xml, format); }
+void Hermes::Serialize(const HermesRevokeBoardAvailableData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<RevokeBoardAvailableData>(data, xml, format); }
+void Hermes::Serialize(const HermesMachineReadyData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<MachineReadyData>(data, xml, format); }
+void Hermes::Serialize(const HermesRevokeMachineReadyData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<RevokeMachineReadyData>(data, xml, format); }
+void Hermes::Serialize(const HermesStartTransportData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<StartTransportData>(data, xml, format); }
+void Hermes::Serialize(const HermesTransportFinishedData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<TransportFinishedData>(data, xml, format); }
+void Hermes::Serialize(const HermesStopTransportData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<StopTransportData>(data, xml, format); }
+void Hermes::Serialize(const HermesNotificationData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<NotificationData>(data, xml, format); }
+void Hermes::Serialize(const HermesCheckAliveData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<CheckAliveData>(data, xml, format); }
+void Hermes::Serialize(const HermesGetConfigurationData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<GetConfigurationData>(data, xml, format); }
+void Hermes::Serialize(const HermesSetConfigurationData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<SetConfigurationData>(data, xml, format); }
+void Hermes::Serialize(const HermesCurrentConfigurationData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<CurrentConfigurationData>(data, xml, format); }
+void Hermes::Serialize(const HermesBoardForecastData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<BoardForecastData>(data, xml, format); }
+void Hermes::Serialize(const HermesQueryBoardInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<QueryBoardInfoData>(data, xml, format); }
+void Hermes::Serialize(const HermesSendBoardInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<SendBoardInfoData>(data, xml, format); }
+void Hermes::Serialize(const HermesSupervisoryServiceDescriptionData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<SupervisoryServiceDescriptionData>(data, xml, format); }
+void Hermes::Serialize(const HermesBoardArrivedData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<BoardArrivedData>(data, xml, format); }
+void Hermes::Serialize(const HermesBoardDepartedData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<BoardDepartedData>(data, xml, format); }
+void Hermes::Serialize(const HermesQueryWorkOrderInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<QueryWorkOrderInfoData>(data, xml, format); }
+void Hermes::Serialize(const HermesSendWorkOrderInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<SendWorkOrderInfoData>(data, xml, format); }
+void Hermes::Serialize(const HermesReplyWorkOrderInfoData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<ReplyWorkOrderInfoData>(data, xml, format); }
+void Hermes::Serialize(const HermesQueryHermesCapabilitiesData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<QueryHermesCapabilitiesData>(data, xml, format); }
+void Hermes::Serialize(const HermesSendHermesCapabilitiesData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<SendHermesCapabilitiesData>(data, xml, format); }
+void Hermes::Serialize(const HermesCommandData& data, std::string& xml, EXmlFormat format) { SerializeMessageAs_<CommandData>(data, xml, format); }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, ServiceDescriptionData& data)
 {
     Error error;
-    Deserialize(xmlNode, "LaneId", error, data.m_laneId);
-    Deserialize(xmlNode, "MachineId", error, data.m_machineId);
-    Deserialize(xmlNode, "InterfaceId", error, data.m_optionalInterfaceId);
-    Deserialize(xmlNode, "Version", error, data.m_version);
-    Deserialize(xmlNode, "SupportedFeatures", error, data.m_supportedFeatures);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, BoardAvailableData& data)
 {
     Error error;
-    Deserialize(xmlNode, "BoardId", error, data.m_boardId);
-    Deserialize(xmlNode, "BoardIdCreatedBy", error, data.m_boardIdCreatedBy);
-    Deserialize(xmlNode, "FailedBoard", error, data.m_failedBoard);
-    Deserialize(xmlNode, "ProductTypeId", error, data.m_optionalProductTypeId);
-    Deserialize(xmlNode, "FlippedBoard", error, data.m_flippedBoard);
-    Deserialize(xmlNode, "TopBarcode", error, data.m_optionalTopBarcode);
-    Deserialize(xmlNode, "BottomBarcode", error, data.m_optionalBottomBarcode);
-    Deserialize(xmlNode, "Length", error, data.m_optionalLengthInMM);
-    Deserialize(xmlNode, "Width", error, data.m_optionalWidthInMM);
-    Deserialize(xmlNode, "Thickness", error, data.m_optionalThicknessInMM);
-    Deserialize(xmlNode, "ConveyorSpeed", error, data.m_optionalConveyorSpeedInMMPerSecs);
-    Deserialize(xmlNode, "TopClearanceHeight", error, data.m_optionalTopClearanceHeightInMM);
-    Deserialize(xmlNode, "BottomClearanceHeight", error, data.m_optionalBottomClearanceHeightInMM);
-    Deserialize(xmlNode, "Weight", error, data.m_optionalWeightInGrams);
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_optionalWorkOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
-    Deserialize(xmlNode, "Route", error, data.m_optionalRoute);
-    Deserialize(xmlNode, "Action", error, data.m_optionalAction);
-    Deserialize(xmlNode, "SubBoards", error, data.m_optionalSubBoards);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
@@ -882,22 +306,7 @@ Hermes::Error Hermes::Deserialize(pugi::xml_node, RevokeBoardAvailableData&)
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, MachineReadyData& data)
 {
     Error error;
-    Deserialize(xmlNode, "FailedBoard", error, data.m_failedBoard);
-    Deserialize(xmlNode, "ForecastId", error, data.m_optionalForecastId);
-    Deserialize(xmlNode, "BoardId", error, data.m_optionalBoardId);
-    Deserialize(xmlNode, "ProductTypeId", error, data.m_optionalProductTypeId);
-    Deserialize(xmlNode, "FlippedBoard", error, data.m_optionalFlippedBoard);
-    Deserialize(xmlNode, "TopBarcode", error, data.m_optionalTopBarcode);
-    Deserialize(xmlNode, "BottomBarcode", error, data.m_optionalBottomBarcode);
-    Deserialize(xmlNode, "Length", error, data.m_optionalLengthInMM);
-    Deserialize(xmlNode, "Width", error, data.m_optionalWidthInMM);
-    Deserialize(xmlNode, "Thickness", error, data.m_optionalThicknessInMM);
-    Deserialize(xmlNode, "ConveyorSpeed", error, data.m_optionalConveyorSpeedInMMPerSecs);
-    Deserialize(xmlNode, "TopClearanceHeight", error, data.m_optionalTopClearanceHeightInMM);
-    Deserialize(xmlNode, "BottomClearanceHeight", error, data.m_optionalBottomClearanceHeightInMM);
-    Deserialize(xmlNode, "Weight", error, data.m_optionalWeightInGrams);
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_optionalWorkOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
@@ -910,51 +319,42 @@ Hermes::Error Hermes::Deserialize(pugi::xml_node, RevokeMachineReadyData&)
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, StartTransportData& data)
 {
     Error error;
-    Deserialize(xmlNode, "BoardId", error, data.m_boardId);
-    Deserialize(xmlNode, "ConveyorSpeed", error, data.m_optionalConveyorSpeedInMMPerSecs);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, StopTransportData& data)
 {
     Error error;
-    Deserialize(xmlNode, "TransferState", error, data.m_transferState);
-    Deserialize(xmlNode, "BoardId", error, data.m_boardId);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, TransportFinishedData& data)
 {
     Error error;
-    Deserialize(xmlNode, "TransferState", error, data.m_transferState);
-    Deserialize(xmlNode, "BoardId", error, data.m_boardId);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, NotificationData& data)
 {
     Error error;
-    Deserialize(xmlNode, "NotificationCode", error, data.m_notificationCode);
-    Deserialize(xmlNode, "Severity", error, data.m_severity);
-    Deserialize(xmlNode, "Description", error, data.m_description);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, CheckAliveData& data)
 {
     Error error;
-    Deserialize(xmlNode, "Type", error, data.m_optionalType);
-    Deserialize(xmlNode, "Id", error, data.m_optionalId);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, SetConfigurationData& data)
 {
     Error error;
-    Deserialize(xmlNode, "MachineId", error, data.m_machineId);
-    Deserialize(xmlNode, "SupervisorySystemPort", error, data.m_optionalSupervisorySystemPort);
-    Deserialize(xmlNode, "UpstreamConfigurations", error, data.m_upstreamConfigurations);
-    Deserialize(xmlNode, "DownstreamConfigurations", error, data.m_downstreamConfigurations);
+    DeserializeFields(xmlNode, error, data);
     return{};
 }
 
@@ -967,192 +367,77 @@ Hermes::Error Hermes::Deserialize(pugi::xml_node, GetConfigurationData&)
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, CurrentConfigurationData& data)
 {
     Error error;
-    Deserialize(xmlNode, "MachineId", error, data.m_optionalMachineId);
-    Deserialize(xmlNode, "SupervisorySystemPort", error, data.m_optionalSupervisorySystemPort);
-    Deserialize(xmlNode, "UpstreamConfigurations", error, data.m_upstreamConfigurations);
-    Deserialize(xmlNode, "DownstreamConfigurations", error, data.m_downstreamConfigurations);
+    DeserializeFields(xmlNode, error, data);
     return{};
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, BoardForecastData& data)
 {
     Error error;
-    Deserialize(xmlNode, "ForecastId", error, data.m_optionalForecastId);
-    Deserialize(xmlNode, "TimeUntilAvailable", error, data.m_optionalTimeUntilAvailableInSeconds);
-    Deserialize(xmlNode, "BoardId", error, data.m_optionalBoardId);
-    Deserialize(xmlNode, "BoardIdCreatedBy", error, data.m_optionalBoardIdCreatedBy);
-    Deserialize(xmlNode, "FailedBoard", error, data.m_failedBoard);
-    Deserialize(xmlNode, "ProductTypeId", error, data.m_optionalProductTypeId);
-    Deserialize(xmlNode, "FlippedBoard", error, data.m_flippedBoard);
-    Deserialize(xmlNode, "TopBarcode", error, data.m_optionalTopBarcode);
-    Deserialize(xmlNode, "BottomBarcode", error, data.m_optionalBottomBarcode);
-    Deserialize(xmlNode, "Length", error, data.m_optionalLengthInMM);
-    Deserialize(xmlNode, "Width", error, data.m_optionalWidthInMM);
-    Deserialize(xmlNode, "Thickness", error, data.m_optionalThicknessInMM);
-    Deserialize(xmlNode, "ConveyorSpeed", error, data.m_optionalConveyorSpeedInMMPerSecs);
-    Deserialize(xmlNode, "TopClearanceHeight", error, data.m_optionalTopClearanceHeightInMM);
-    Deserialize(xmlNode, "BottomClearanceHeight", error, data.m_optionalBottomClearanceHeightInMM);
-    Deserialize(xmlNode, "Weight", error, data.m_optionalWeightInGrams);
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_optionalWorkOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, QueryBoardInfoData& data)
 {
     Error error;
-    Deserialize(xmlNode, "TopBarcode", error, data.m_optionalTopBarcode);
-    Deserialize(xmlNode, "BottomBarcode", error, data.m_optionalBottomBarcode);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, SendBoardInfoData& data)
 {
     Error error;
-    Deserialize(xmlNode, "BoardId", error, data.m_optionalBoardId);
-    Deserialize(xmlNode, "BoardIdCreatedBy", error, data.m_optionalBoardIdCreatedBy);
-    Deserialize(xmlNode, "FailedBoard", error, data.m_optionalFailedBoard);
-    Deserialize(xmlNode, "ProductTypeId", error, data.m_optionalProductTypeId);
-    Deserialize(xmlNode, "FlippedBoard", error, data.m_optionalFlippedBoard);
-    Deserialize(xmlNode, "TopBarcode", error, data.m_optionalTopBarcode);
-    Deserialize(xmlNode, "BottomBarcode", error, data.m_optionalBottomBarcode);
-    Deserialize(xmlNode, "Length", error, data.m_optionalLengthInMM);
-    Deserialize(xmlNode, "Width", error, data.m_optionalWidthInMM);
-    Deserialize(xmlNode, "Thickness", error, data.m_optionalThicknessInMM);
-    Deserialize(xmlNode, "ConveyorSpeed", error, data.m_optionalConveyorSpeedInMMPerSecs);
-    Deserialize(xmlNode, "TopClearanceHeight", error, data.m_optionalTopClearanceHeightInMM);
-    Deserialize(xmlNode, "BottomClearanceHeight", error, data.m_optionalBottomClearanceHeightInMM);
-    Deserialize(xmlNode, "Weight", error, data.m_optionalWeightInGrams);
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_optionalWorkOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
-    Deserialize(xmlNode, "Route", error, data.m_optionalRoute);
-    Deserialize(xmlNode, "Action", error, data.m_optionalAction);
-    Deserialize(xmlNode, "SubBoards", error, data.m_optionalSubBoards);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, SupervisoryServiceDescriptionData& data)
 {
     Error error;
-    Deserialize(xmlNode, "SystemId", error, data.m_systemId);
-    Deserialize(xmlNode, "Version", error, data.m_version);
-    Deserialize(xmlNode, "SupportedFeatures", error, data.m_supportedFeatures);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, BoardArrivedData& data)
 {
     Error error;
-    Deserialize(xmlNode, "MachineId", error, data.m_machineId);
-    Deserialize(xmlNode, "UpstreamLaneId", error, data.m_upstreamLaneId);
-    Deserialize(xmlNode, "UpstreamInterfaceId", error, data.m_optionalUpstreamInterfaceId);
-    Deserialize(xmlNode, "MagazineId", error, data.m_optionalMagazineId);
-    Deserialize(xmlNode, "SlotId", error, data.m_optionalSlotId);
-    Deserialize(xmlNode, "BoardTransfer", error, data.m_boardTransfer);
-    Deserialize(xmlNode, "BoardId", error, data.m_boardId);
-    Deserialize(xmlNode, "BoardIdCreatedBy", error, data.m_boardIdCreatedBy);
-    Deserialize(xmlNode, "FailedBoard", error, data.m_failedBoard);
-    Deserialize(xmlNode, "ProductTypeId", error, data.m_optionalProductTypeId);
-    Deserialize(xmlNode, "FlippedBoard", error, data.m_flippedBoard);
-    Deserialize(xmlNode, "TopBarcode", error, data.m_optionalTopBarcode);
-    Deserialize(xmlNode, "BottomBarcode", error, data.m_optionalBottomBarcode);
-    Deserialize(xmlNode, "Length", error, data.m_optionalLengthInMM);
-    Deserialize(xmlNode, "Width", error, data.m_optionalWidthInMM);
-    Deserialize(xmlNode, "Thickness", error, data.m_optionalThicknessInMM);
-    Deserialize(xmlNode, "ConveyorSpeed", error, data.m_optionalConveyorSpeedInMMPerSecs);
-    Deserialize(xmlNode, "TopClearanceHeight", error, data.m_optionalTopClearanceHeightInMM);
-    Deserialize(xmlNode, "BottomClearanceHeight", error, data.m_optionalBottomClearanceHeightInMM);
-    Deserialize(xmlNode, "Weight", error, data.m_optionalWeightInGrams);
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_optionalWorkOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
-    Deserialize(xmlNode, "Route", error, data.m_optionalRoute);
-    Deserialize(xmlNode, "Action", error, data.m_optionalAction);
-    Deserialize(xmlNode, "SubBoards", error, data.m_optionalSubBoards);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, BoardDepartedData& data)
 {
     Error error;
-    Deserialize(xmlNode, "MachineId", error, data.m_machineId);
-    Deserialize(xmlNode, "DownstreamLaneId", error, data.m_downstreamLaneId);
-    Deserialize(xmlNode, "DownstreamInterfaceId", error, data.m_optionalDownstreamInterfaceId);
-    Deserialize(xmlNode, "MagazineId", error, data.m_optionalMagazineId);
-    Deserialize(xmlNode, "SlotId", error, data.m_optionalSlotId);
-    Deserialize(xmlNode, "BoardTransfer", error, data.m_boardTransfer);
-    Deserialize(xmlNode, "BoardId", error, data.m_boardId);
-    Deserialize(xmlNode, "BoardIdCreatedBy", error, data.m_boardIdCreatedBy);
-    Deserialize(xmlNode, "FailedBoard", error, data.m_failedBoard);
-    Deserialize(xmlNode, "ProductTypeId", error, data.m_optionalProductTypeId);
-    Deserialize(xmlNode, "FlippedBoard", error, data.m_flippedBoard);
-    Deserialize(xmlNode, "TopBarcode", error, data.m_optionalTopBarcode);
-    Deserialize(xmlNode, "BottomBarcode", error, data.m_optionalBottomBarcode);
-    Deserialize(xmlNode, "Length", error, data.m_optionalLengthInMM);
-    Deserialize(xmlNode, "Width", error, data.m_optionalWidthInMM);
-    Deserialize(xmlNode, "Thickness", error, data.m_optionalThicknessInMM);
-    Deserialize(xmlNode, "ConveyorSpeed", error, data.m_optionalConveyorSpeedInMMPerSecs);
-    Deserialize(xmlNode, "TopClearanceHeight", error, data.m_optionalTopClearanceHeightInMM);
-    Deserialize(xmlNode, "BottomClearanceHeight", error, data.m_optionalBottomClearanceHeightInMM);
-    Deserialize(xmlNode, "Weight", error, data.m_optionalWeightInGrams);
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_optionalWorkOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
-    Deserialize(xmlNode, "Route", error, data.m_optionalRoute);
-    Deserialize(xmlNode, "Action", error, data.m_optionalAction);
-    Deserialize(xmlNode, "SubBoards", error, data.m_optionalSubBoards);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, QueryWorkOrderInfoData& data)
 {
     Error error;
-    Deserialize(xmlNode, "QueryId", error, data.m_optionalQueryId);
-    Deserialize(xmlNode, "MachineId", error, data.m_machineId);
-    Deserialize(xmlNode, "MagazineId", error, data.m_optionalMagazineId);
-    Deserialize(xmlNode, "SlotId", error, data.m_optionalSlotId);
-    Deserialize(xmlNode, "Barcode", error, data.m_optionalBarcode);
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_optionalWorkOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, SendWorkOrderInfoData& data)
 {
     Error error;
-    Deserialize(xmlNode, "QueryId", error, data.m_optionalQueryId);
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_optionalWorkOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
-    Deserialize(xmlNode, "BoardId", error, data.m_optionalBoardId);
-    Deserialize(xmlNode, "BoardIdCreatedBy", error, data.m_optionalBoardIdCreatedBy);
-    Deserialize(xmlNode, "FailedBoard", error, data.m_optionalFailedBoard);
-    Deserialize(xmlNode, "ProductTypeId", error, data.m_optionalProductTypeId);
-    Deserialize(xmlNode, "FlippedBoard", error, data.m_optionalFlippedBoard);
-    Deserialize(xmlNode, "TopBarcode", error, data.m_optionalTopBarcode);
-    Deserialize(xmlNode, "BottomBarcode", error, data.m_optionalBottomBarcode);
-    Deserialize(xmlNode, "Length", error, data.m_optionalLengthInMM);
-    Deserialize(xmlNode, "Width", error, data.m_optionalWidthInMM);
-    Deserialize(xmlNode, "Thickness", error, data.m_optionalThicknessInMM);
-    Deserialize(xmlNode, "ConveyorSpeed", error, data.m_optionalConveyorSpeedInMMPerSecs);
-    Deserialize(xmlNode, "TopClearanceHeight", error, data.m_optionalTopClearanceHeightInMM);
-    Deserialize(xmlNode, "BottomClearanceHeight", error, data.m_optionalBottomClearanceHeightInMM);
-    Deserialize(xmlNode, "Weight", error, data.m_optionalWeightInGrams);
-    Deserialize(xmlNode, "Route", error, data.m_optionalRoute);
-    Deserialize(xmlNode, "SubBoards", error, data.m_optionalSubBoards);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, ReplyWorkOrderInfoData& data)
 {
     Error error;
-    Deserialize(xmlNode, "WorkOrderId", error, data.m_workOrderId);
-    Deserialize(xmlNode, "BatchId", error, data.m_optionalBatchId);
-    Deserialize(xmlNode, "Status", error, data.m_status);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, CommandData& data)
 {
     Error error;
-    Deserialize(xmlNode, "Command", error, data.m_command);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
 
@@ -1164,7 +449,6 @@ Hermes::Error Hermes::Deserialize(pugi::xml_node /*xmlNode*/, QueryHermesCapabil
 Hermes::Error Hermes::Deserialize(pugi::xml_node xmlNode, SendHermesCapabilitiesData& data)
 {
     Error error;
-    Deserialize(xmlNode, "OptionalMessages", error, data.m_optionalMessages);
-    Deserialize(xmlNode, "Attributes", error, data.m_attributes);
+    DeserializeFields(xmlNode, error, data);
     return error;
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "XmlWriter.h"
+
+#include <HermesData.h>
 #include <HermesData.hpp>
 
 #include <pugixml.hpp>
@@ -9,6 +12,8 @@
 
 namespace Hermes
 {
+    class XmlReader;
+
     template<class> struct SerializationTraits;
 
     template<> struct SerializationTraits<ServiceDescriptionData>
@@ -211,6 +216,7 @@ namespace Hermes
         static constexpr StringView cTAG_VIEW = StringView{ cTAG, sizeof(cTAG) - 1U };
     };
     
+    // the messages as sent, in EXmlFormat::eINDENTED
     std::string Serialize(const ServiceDescriptionData&);
     std::string Serialize(const BoardAvailableData&);
     std::string Serialize(const RevokeBoardAvailableData&);
@@ -237,6 +243,60 @@ namespace Hermes
     std::string Serialize(const SendHermesCapabilitiesData&);
     std::string Serialize(const CommandData&);
 
+    // the same into a buffer owned by the caller, whose capacity gets reused
+    void Serialize(const ServiceDescriptionData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const BoardAvailableData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const RevokeBoardAvailableData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const MachineReadyData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const RevokeMachineReadyData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const StartTransportData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const TransportFinishedData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const StopTransportData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const NotificationData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const CheckAliveData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const GetConfigurationData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const SetConfigurationData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const CurrentConfigurationData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const BoardForecastData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const QueryBoardInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const SendBoardInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const SupervisoryServiceDescriptionData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const BoardArrivedData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const BoardDepartedData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const QueryWorkOrderInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const SendWorkOrderInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const ReplyWorkOrderInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const QueryHermesCapabilitiesData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const SendHermesCapabilitiesData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const CommandData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+
+    // the same straight from the C structs, see MessageFieldsC.h
+    void Serialize(const HermesServiceDescriptionData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesBoardAvailableData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesRevokeBoardAvailableData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesMachineReadyData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesRevokeMachineReadyData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesStartTransportData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesTransportFinishedData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesStopTransportData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesNotificationData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesCheckAliveData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesGetConfigurationData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesSetConfigurationData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesCurrentConfigurationData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesBoardForecastData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesQueryBoardInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesSendBoardInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesSupervisoryServiceDescriptionData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesBoardArrivedData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesBoardDepartedData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesQueryWorkOrderInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesSendWorkOrderInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesReplyWorkOrderInfoData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesQueryHermesCapabilitiesData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesSendHermesCapabilitiesData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+    void Serialize(const HermesCommandData&, std::string& xml, EXmlFormat = EXmlFormat::eINDENTED);
+
     Error Deserialize(pugi::xml_node, ServiceDescriptionData&);
     Error Deserialize(pugi::xml_node, BoardAvailableData&);
     Error Deserialize(pugi::xml_node, RevokeBoardAvailableData&);
@@ -263,4 +323,31 @@ namespace Hermes
     Error Deserialize(pugi::xml_node, SendHermesCapabilitiesData&);
     Error Deserialize(pugi::xml_node, CommandData&);
 
+    // the same for reading the message element that the XmlReader has just started, see XmlReader.h
+    Error Deserialize(XmlReader&, ServiceDescriptionData&);
+    Error Deserialize(XmlReader&, BoardAvailableData&);
+    Error Deserialize(XmlReader&, RevokeBoardAvailableData&);
+    Error Deserialize(XmlReader&, MachineReadyData&);
+    Error Deserialize(XmlReader&, RevokeMachineReadyData&);
+    Error Deserialize(XmlReader&, StartTransportData&);
+    Error Deserialize(XmlReader&, TransportFinishedData&);
+    Error Deserialize(XmlReader&, StopTransportData&);
+    Error Deserialize(XmlReader&, NotificationData&);
+    Error Deserialize(XmlReader&, CheckAliveData&);
+    Error Deserialize(XmlReader&, GetConfigurationData&);
+    Error Deserialize(XmlReader&, SetConfigurationData&);
+    Error Deserialize(XmlReader&, CurrentConfigurationData&);
+    Error Deserialize(XmlReader&, BoardForecastData&);
+    Error Deserialize(XmlReader&, QueryBoardInfoData&);
+    Error Deserialize(XmlReader&, SendBoardInfoData&);
+    Error Deserialize(XmlReader&, SupervisoryServiceDescriptionData&);
+    Error Deserialize(XmlReader&, BoardArrivedData&);
+    Error Deserialize(XmlReader&, BoardDepartedData&);
+    Error Deserialize(XmlReader&, QueryWorkOrderInfoData&);
+    Error Deserialize(XmlReader&, SendWorkOrderInfoData&);
+    Error Deserialize(XmlReader&, ReplyWorkOrderInfoData&);
+    Error Deserialize(XmlReader&, QueryHermesCapabilitiesData&);
+    Error Deserialize(XmlReader&, SendHermesCapabilitiesData&);
+    Error Deserialize(XmlReader&, CommandData&);
+
 }
@@ -17,6 +17,7 @@ limitations under the License.
 // Copyright (c) ASM Assembly Systems GmbH & Co. KG
 #pragma once
 
+#include <HermesData.hpp>
 #include <HermesStringView.hpp>
 #include "StringSpan.h"
 
@@ -51,6 +52,8 @@ namespace Hermes
     struct ISocketCallback
     {
         virtual void OnConnected(const ConnectionInfo&) = 0;
+        // storage for the next receive, the received part is handed back through OnReceived():
+        virtual StringSpan ReceiveBuffer(std::size_t size) = 0;
         virtual void OnReceived(StringSpan data) = 0;
         virtual void OnDisconnected(const Error&) = 0;
 
@@ -80,19 +83,50 @@ namespace Hermes
         virtual void OnAccepted(std::unique_ptr<IServerSocket>&&) = 0;
     };
 
+    // how the wait between the connect attempts of a client grows, starting at NetworkConfiguration::m_retryDelayInSeconds
+    struct ReconnectPolicy
+    {
+        double m_waitTimeFactor = 1.0; // below 1: the wait time stays the same
+        double m_maxWaitTimeInSeconds = 0.0; // below the initial wait time: the wait time stays the same
+        double m_jitter = 0.0; // 0..1, the share of the wait time taken off at random
+
+        friend bool operator==(const ReconnectPolicy& lhs, const ReconnectPolicy& rhs)
+        {
+            return lhs.m_waitTimeFactor == rhs.m_waitTimeFactor
+                && lhs.m_maxWaitTimeInSeconds == rhs.m_maxWaitTimeInSeconds
+                && lhs.m_jitter == rhs.m_jitter;
+        }
+
+        template<class S>
+        friend S& operator<<(S& s, const ReconnectPolicy& policy)
+        {
+            s << "{m_waitTimeFactor=" << policy.m_waitTimeFactor
+                << ",m_maxWaitTimeInSeconds=" << policy.m_maxWaitTimeInSeconds
+                << ",m_jitter=" << policy.m_jitter
+                << '}';
+            return s;
+        }
+    };
+
     struct NetworkConfiguration
     {
         std::string m_hostName;
         uint16_t m_port = 0U;
         double m_retryDelayInSeconds = 10.0;
         double m_checkAlivePeriodInSeconds = 60.0;
+        unsigned m_sendQueueHighWaterMark = 0U; // in bytes, 0: no warning
+        ReconnectPolicy m_reconnectPolicy; // for client sockets only
+        SocketOptions m_socketOptions;
 
         friend bool operator==(const NetworkConfiguration& lhs, const NetworkConfiguration& rhs)
         {
             return lhs.m_hostName == rhs.m_hostName
                 && lhs.m_port == rhs.m_port
                 && lhs.m_retryDelayInSeconds == rhs.m_retryDelayInSeconds
-                && lhs.m_checkAlivePeriodInSeconds == rhs.m_checkAlivePeriodInSeconds;
+                && lhs.m_checkAlivePeriodInSeconds == rhs.m_checkAlivePeriodInSeconds
+                && lhs.m_sendQueueHighWaterMark == rhs.m_sendQueueHighWaterMark
+                && lhs.m_reconnectPolicy == rhs.m_reconnectPolicy
+                && lhs.m_socketOptions == rhs.m_socketOptions;
         }
         friend bool operator!=(const NetworkConfiguration& lhs, const NetworkConfiguration& rhs)
         {
@@ -106,14 +140,27 @@ namespace Hermes
                 << ",m_port=" << config.m_port
                 << ",m_retryDelayInSeconds=" << config.m_retryDelayInSeconds
                 << ",m_checkAlivePeriodInSeconds=" << config.m_checkAlivePeriodInSeconds
+                << ",m_sendQueueHighWaterMark=" << config.m_sendQueueHighWaterMark
+                << ",m_reconnectPolicy=" << config.m_reconnectPolicy
+                << ",m_socketOptions=" << config.m_socketOptions
                 << '}';
             return s;
         }
     };
 
+    // for the transport of the configuration, see SocketOptions::m_transport
     std::unique_ptr<IClientSocket> CreateClientSocket(unsigned sessionId,
         const NetworkConfiguration&, IAsioService& service);
 
+    // listens with the transport of the configuration passed to StartListening()
     std::unique_ptr<IAcceptor> CreateAcceptor(IAsioService& service, IAcceptorCallback&);
+
+    // the transports: TCP and unix domain sockets with asio, ETransport::eIN_PROCESS with pipes in memory
+    std::unique_ptr<IClientSocket> CreateAsioClientSocket(unsigned sessionId,
+        const NetworkConfiguration&, IAsioService& service);
+    std::unique_ptr<IAcceptor> CreateAsioAcceptor(IAsioService& service, IAcceptorCallback&);
+    std::unique_ptr<IClientSocket> CreatePipeClientSocket(unsigned sessionId,
+        const NetworkConfiguration&, IAsioService& service);
+    std::unique_ptr<IAcceptor> CreatePipeAcceptor(IAsioService& service, IAcceptorCallback&);
 }
 
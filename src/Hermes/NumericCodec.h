@@ -0,0 +1,78 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include <HermesData.hpp>
+#include <HermesStringView.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+namespace Hermes
+{
+    // The numbers in attribute values, written and read with std::to_chars and std::from_chars,
+    // so neither the global locale nor a stringstream is involved.
+    namespace NumericCodec
+    {
+        // enough for any double with 3 decimals
+        constexpr std::size_t cMAX_SIZE = 512U;
+
+        // Writes to pBuffer, which must have room for cMAX_SIZE chars, and returns the end of the number
+        inline char* Format(char* pBuffer, int value)
+        {
+            return std::to_chars(pBuffer, pBuffer + cMAX_SIZE, value).ptr;
+        }
+
+        inline char* Format(char* pBuffer, unsigned value)
+        {
+            return std::to_chars(pBuffer, pBuffer + cMAX_SIZE, value).ptr;
+        }
+
+        inline char* Format(char* pBuffer, unsigned short value)
+        {
+            return std::to_chars(pBuffer, pBuffer + cMAX_SIZE, value).ptr;
+        }
+
+        // The standard asks for 3 decimals
+        inline char* Format(char* pBuffer, double value)
+        {
+            return std::to_chars(pBuffer, pBuffer + cMAX_SIZE, value, std::chars_format::fixed, 3).ptr;
+        }
+
+        // Accepts a decimal number (for double also in exponent notation) that fits into T,
+        // optionally with a leading + and surrounding whitespace. Leaves value alone otherwise.
+        template<class T>
+        bool Parse(StringView text, T& value)
+        {
+            auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+            const char* p = text.data();
+            const char* pEnd = p + text.size();
+            while (p < pEnd && isSpace(*p))
+            {
+                ++p;
+            }
+            while (pEnd > p && isSpace(pEnd[-1]))
+            {
+                --pEnd;
+            }
+            if (pEnd - p > 1 && *p == '+' && p[1] != '-')
+            {
+                ++p;
+            }
+
+            T result{};
+            auto parseResult = std::from_chars(p, pEnd, result);
+            if (p == pEnd || parseResult.ec != std::errc() || parseResult.ptr != pEnd)
+                return false;
+            value = result;
+            return true;
+        }
+
+        inline Error MalformedNumberError(StringView attributeName, StringView text)
+        {
+            return{EErrorCode::ePEER_ERROR, "malformed number in attribute " + std::string(attributeName.data(), attributeName.size())
+                + ": \"" + std::string(text.data(), text.size()) + "\""};
+        }
+    }
+}
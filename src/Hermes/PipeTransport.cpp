@@ -0,0 +1,495 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#include "stdafx.h"
+
+#include "Network.h"
+
+#include "IService.h"
+#include "ReconnectBackoff.h"
+
+#include <HermesData.hpp>
+
+#include <array>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+
+// The in-process transport: a client connects to the acceptor of the same process listening on the configured port,
+// and what one end sends is posted to the executor of the other end. The peers cannot go away unnoticed, so there
+// are neither check alive messages nor allowed hosts, and nothing is queued but the posted handlers.
+namespace Hermes
+{
+    namespace
+    {
+        // what the ConnectionInfo of a pipe end shows as host name
+        const char* const cPIPE_HOST_NAME = "in-process";
+        const std::size_t cCLIENT_END = 0U;
+        const std::size_t cSERVER_END = 1U;
+    }
+
+    struct PipeEnd;
+
+    // The two ends of a connection. An end is taken off when closed; whatever is posted to it meanwhile is dropped.
+    struct Pipe
+    {
+        std::mutex m_mutex;
+        std::array<PipeEnd*, 2U> m_pEnds{{nullptr, nullptr}};
+
+        PipeEnd* End(std::size_t index)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_pEnds[index];
+        }
+
+        void SetEnd(std::size_t index, PipeEnd* pEnd)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pEnds[index] = pEnd;
+        }
+
+        // calls f(end) on the executor of the end, unless the end is gone by then
+        template<class F>
+        void PostTo(std::size_t index, const std::shared_ptr<Pipe>& spThis, F&& f);
+    };
+    using PipeSp = std::shared_ptr<Pipe>;
+
+    // One end of a pipe, used on the executor of its service only
+    struct PipeEnd
+    {
+        unsigned m_sessionId;
+        IAsioService& m_service;
+        NetworkConfiguration m_configuration;
+        ConnectionInfo m_connectionInfo;
+        std::size_t m_index;
+        PipeSp m_spPipe;
+        std::weak_ptr<void> m_wpOwner;
+        ISocketCallback* m_pCallback{nullptr};
+        std::function<void()> m_onRefused; // client end only: the acceptor has not taken the pipe
+        std::string m_received; // before connected
+        bool m_connected{false};
+        bool m_peerClosed{false};
+        bool m_closed{false};
+
+        PipeEnd(unsigned sessionId, const NetworkConfiguration& configuration, IAsioService& service, std::size_t index) :
+            m_sessionId(sessionId),
+            m_service(service),
+            m_configuration(configuration),
+            m_connectionInfo("", configuration.m_port, cPIPE_HOST_NAME),
+            m_index(index)
+        {}
+
+        PipeEnd(const PipeEnd&) = delete;
+        PipeEnd& operator=(const PipeEnd&) = delete;
+
+        ~PipeEnd()
+        {
+            Close_();
+        }
+
+        void Send(StringView message)
+        {
+            if (m_closed)
+                return m_service.Log(m_sessionId, "Already closed on Send: ", message);
+
+            m_service.Trace(ETraceType::eSENT, m_sessionId, message);
+            PostToPeer_([data = std::string(message.data(), message.size())](PipeEnd& peer) { peer.OnReceived_(data); });
+        }
+
+        void OnConnected_()
+        {
+            if (m_closed)
+                return;
+
+            auto spOwner = m_wpOwner.lock();
+            if (!spOwner)
+                return;
+
+            m_connected = true;
+            m_service.Inform(m_sessionId, "OnConnected ", m_connectionInfo);
+            m_pCallback->OnConnected(m_connectionInfo);
+            if (!m_received.empty())
+            {
+                std::string received;
+                received.swap(m_received);
+                Deliver_(received);
+            }
+            if (m_peerClosed)
+            {
+                Disconnect_();
+            }
+        }
+
+        void OnPeerClosed_()
+        {
+            if (m_closed)
+                return;
+
+            if (m_connected)
+                return Disconnect_();
+
+            if (m_onRefused)
+            {
+                m_spPipe->SetEnd(m_index, nullptr);
+                m_spPipe.reset();
+                return m_onRefused();
+            }
+            m_peerClosed = true;
+        }
+
+        ISocketCallback* Close_()
+        {
+            if (m_closed)
+                return nullptr;
+            m_closed = true;
+            m_service.Log(m_sessionId, "Close pipe");
+
+            if (m_spPipe)
+            {
+                PostToPeer_([](PipeEnd& peer) { peer.OnPeerClosed_(); });
+                m_spPipe->SetEnd(m_index, nullptr);
+            }
+
+            auto* pCallback = m_pCallback;
+            m_pCallback = nullptr;
+            return pCallback;
+        }
+
+    private:
+        template<class F>
+        void PostToPeer_(F&& f)
+        {
+            if (m_spPipe)
+            {
+                m_spPipe->PostTo(1U - m_index, m_spPipe, std::forward<F>(f));
+            }
+        }
+
+        void OnReceived_(const std::string& data)
+        {
+            if (m_closed)
+                return;
+
+            if (!m_connected)
+            {
+                m_received += data;
+                return;
+            }
+            auto spOwner = m_wpOwner.lock();
+            if (!spOwner)
+                return;
+            Deliver_(data);
+        }
+
+        void Deliver_(StringView data)
+        {
+            m_service.Trace(ETraceType::eRECEIVED, m_sessionId, data);
+            StringSpan buffer = m_pCallback->ReceiveBuffer(data.size());
+            std::memcpy(buffer.data(), data.data(), data.size());
+            m_pCallback->OnReceived(buffer);
+        }
+
+        void Disconnect_()
+        {
+            auto* pCallback = Close_();
+            if (!pCallback)
+                return;
+
+            m_service.Inform(m_sessionId, "Disconnected");
+            pCallback->OnDisconnected(Error());
+        }
+    };
+
+    template<class F>
+    void Pipe::PostTo(std::size_t index, const std::shared_ptr<Pipe>& spThis, F&& f)
+    {
+        // under the mutex, so that the end and with it its service stay alive while posting
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PipeEnd* pEnd = m_pEnds[index];
+        if (!pEnd)
+            return;
+
+        pEnd->m_service.Post([spThis, index, f = std::forward<F>(f)]()
+        {
+            if (auto* pEnd = spThis->End(index))
+            {
+                f(*pEnd);
+            }
+        });
+    }
+
+    // The state of an acceptor the clients of other services post to
+    struct PipeListener
+    {
+        IAsioService& m_service;
+        IAcceptorCallback& m_callback;
+        // on the executor of m_service only:
+        Optional<NetworkConfiguration> m_optionalConfiguration;
+        unsigned m_sessionId = 1U;
+
+        PipeListener(IAsioService& service, IAcceptorCallback& callback) :
+            m_service(service),
+            m_callback(callback)
+        {}
+
+        void Accept(uint16_t port, const PipeSp& spPipe);
+    };
+    using PipeListenerSp = std::shared_ptr<PipeListener>;
+
+    // the listening acceptors by port, shared by all services
+    struct PipeListeners
+    {
+        std::mutex m_mutex;
+        std::map<uint16_t, PipeListenerSp> m_listeners;
+
+        static PipeListeners& Shared()
+        {
+            static PipeListeners sListeners;
+            return sListeners;
+        }
+    };
+
+    struct PipeServerSocket : IServerSocket
+    {
+        PipeEnd m_end;
+
+        PipeServerSocket(unsigned sessionId, const NetworkConfiguration& configuration, IAsioService& service) :
+            m_end(sessionId, configuration, service, cSERVER_END)
+        {}
+
+        // implementation of IServerSocket:
+        unsigned SessionId() const override
+        {
+            return m_end.m_sessionId;
+        }
+
+        const ConnectionInfo& GetConnectionInfo() const override
+        {
+            return m_end.m_connectionInfo;
+        }
+
+        const NetworkConfiguration& GetConfiguration() const override
+        {
+            return m_end.m_configuration;
+        }
+
+        void Connect(std::weak_ptr<void> wpOwner, ISocketCallback& callback) override
+        {
+            m_end.m_wpOwner = std::move(wpOwner);
+            m_end.m_pCallback = &callback;
+            m_end.m_service.Post([spPipe = m_end.m_spPipe]()
+            {
+                if (auto* pEnd = spPipe->End(cSERVER_END))
+                {
+                    pEnd->OnConnected_();
+                }
+            });
+        }
+
+        void Send(StringView message) override
+        {
+            m_end.Send(message);
+        }
+
+        void Close() override
+        {
+            m_end.Close_();
+        }
+    };
+
+    void PipeListener::Accept(uint16_t port, const PipeSp& spPipe)
+    {
+        if (!m_optionalConfiguration || m_optionalConfiguration->m_port != port)
+        {
+            // no longer listening on that port
+            spPipe->PostTo(cCLIENT_END, spPipe, [](PipeEnd& client) { client.OnPeerClosed_(); });
+            return;
+        }
+
+        auto upSocket = std::make_unique<PipeServerSocket>(m_sessionId, *m_optionalConfiguration, m_service);
+        m_sessionId = m_sessionId == std::numeric_limits<unsigned>::max() ? 1U : m_sessionId + 1U;
+        {
+            std::lock_guard<std::mutex> lock(spPipe->m_mutex);
+            if (!spPipe->m_pEnds[cCLIENT_END])
+                return; // the client has given up meanwhile
+            spPipe->m_pEnds[cSERVER_END] = &upSocket->m_end;
+        }
+        upSocket->m_end.m_spPipe = spPipe;
+        spPipe->PostTo(cCLIENT_END, spPipe, [](PipeEnd& client) { client.OnConnected_(); });
+
+        m_service.Inform(upSocket->m_end.m_sessionId, "OnAccepted ", upSocket->m_end.m_connectionInfo);
+        m_callback.OnAccepted(std::move(upSocket));
+    }
+
+    struct PipeClientSocket : IClientSocket
+    {
+        PipeEnd m_end;
+        ReconnectBackoff m_backoff;
+        TimerWheel::Timer m_retryTimer{[this]() { Connect_(); }};
+
+        PipeClientSocket(unsigned sessionId, const NetworkConfiguration& configuration, IAsioService& service) :
+            m_end(sessionId, configuration, service, cCLIENT_END),
+            m_backoff(configuration)
+        {
+            m_end.m_onRefused = [this]() { RetryLater_(); };
+        }
+
+        ~PipeClientSocket()
+        {
+            Close();
+        }
+
+        // implementation of IClientSocket:
+        unsigned SessionId() const override
+        {
+            return m_end.m_sessionId;
+        }
+
+        const ConnectionInfo& GetConnectionInfo() const override
+        {
+            return m_end.m_connectionInfo;
+        }
+
+        const NetworkConfiguration& GetConfiguration() const override
+        {
+            return m_end.m_configuration;
+        }
+
+        void Connect(std::weak_ptr<void> wpOwner, ISocketCallback& callback) override
+        {
+            assert(!m_end.m_pCallback);
+            m_end.m_wpOwner = std::move(wpOwner);
+            m_end.m_pCallback = &callback;
+            Connect_();
+        }
+
+        void Send(StringView message) override
+        {
+            m_end.Send(message);
+        }
+
+        void Close() override
+        {
+            m_retryTimer.Cancel();
+            m_end.Close_();
+        }
+
+    private:
+        void Connect_()
+        {
+            if (m_end.m_closed)
+                return;
+
+            uint16_t port = m_end.m_configuration.m_port;
+            ++m_end.m_connectionInfo.m_connectAttempts;
+            m_end.m_service.Log(m_end.m_sessionId, "Connect_ in-process to port=", port,
+                ", attempt ", m_end.m_connectionInfo.m_connectAttempts);
+
+            auto spPipe = std::make_shared<Pipe>();
+            spPipe->m_pEnds[cCLIENT_END] = &m_end;
+            {
+                // under the mutex, so that the acceptor and with it its service stay alive while posting
+                auto& listeners = PipeListeners::Shared();
+                std::lock_guard<std::mutex> lock(listeners.m_mutex);
+                auto itListener = listeners.m_listeners.find(port);
+                if (itListener != listeners.m_listeners.end())
+                {
+                    m_end.m_spPipe = spPipe;
+                    auto& spListener = itListener->second;
+                    spListener->m_service.Post([spListener, port, spPipe]() { spListener->Accept(port, spPipe); });
+                    return;
+                }
+            }
+            m_end.m_service.Alarm(m_end.m_sessionId, EErrorCode::eNETWORK_ERROR, "Unable to connect, nobody listening in-process on port ", port);
+            RetryLater_();
+        }
+
+        void RetryLater_()
+        {
+            if (m_end.m_closed)
+                return;
+
+            auto waitTime = m_backoff.NextWaitTimeInSeconds();
+            m_end.m_service.Log(m_end.m_sessionId, "Retrying in ", waitTime, " seconds");
+            m_end.m_service.GetTimerWheel().Schedule(m_retryTimer, waitTime);
+        }
+    };
+
+    struct PipeAcceptor : IAcceptor
+    {
+        IAsioService& m_service;
+        PipeListenerSp m_spListener;
+        TimerWheel::Timer m_retryTimer{[this]() { Listen_(); }};
+
+        PipeAcceptor(IAsioService& service, IAcceptorCallback& callback) :
+            m_service(service),
+            m_spListener(std::make_shared<PipeListener>(service, callback))
+        {}
+
+        ~PipeAcceptor()
+        {
+            StopListening();
+        }
+
+        // implementation of IAcceptor:
+        void StartListening(const NetworkConfiguration& configuration) override
+        {
+            auto& optionalConfiguration = m_spListener->m_optionalConfiguration;
+            m_service.Log(m_spListener->m_sessionId, "Start Listening in-process(", configuration, "), currentConfig=", optionalConfiguration);
+
+            if (optionalConfiguration && *optionalConfiguration == configuration)
+                return;
+
+            StopListening();
+            optionalConfiguration = configuration;
+            Listen_();
+        }
+
+        void StopListening() override
+        {
+            m_retryTimer.Cancel();
+            auto& optionalConfiguration = m_spListener->m_optionalConfiguration;
+            if (!optionalConfiguration)
+                return;
+
+            auto& listeners = PipeListeners::Shared();
+            std::lock_guard<std::mutex> lock(listeners.m_mutex);
+            auto itListener = listeners.m_listeners.find(optionalConfiguration->m_port);
+            if (itListener != listeners.m_listeners.end() && itListener->second == m_spListener)
+            {
+                listeners.m_listeners.erase(itListener);
+            }
+            optionalConfiguration.reset();
+        }
+
+    private:
+        void Listen_()
+        {
+            const auto& optionalConfiguration = m_spListener->m_optionalConfiguration;
+            if (!optionalConfiguration)
+                return;
+
+            uint16_t port = optionalConfiguration->m_port;
+            {
+                auto& listeners = PipeListeners::Shared();
+                std::lock_guard<std::mutex> lock(listeners.m_mutex);
+                if (listeners.m_listeners.emplace(port, m_spListener).second)
+                    return;
+            }
+            m_service.Alarm(m_spListener->m_sessionId, EErrorCode::eNETWORK_ERROR, "Unable to listen, port ", port,
+                " already taken in-process");
+            m_service.GetTimerWheel().Schedule(m_retryTimer, optionalConfiguration->m_retryDelayInSeconds);
+        }
+    };
+}
+
+std::unique_ptr<Hermes::IClientSocket> Hermes::CreatePipeClientSocket(unsigned sessionId,
+    const NetworkConfiguration& configuration, IAsioService& service)
+{
+    return std::make_unique<PipeClientSocket>(sessionId, configuration, service);
+}
+
+std::unique_ptr<Hermes::IAcceptor> Hermes::CreatePipeAcceptor(IAsioService& service, IAcceptorCallback& callback)
+{
+    return std::make_unique<PipeAcceptor>(service, callback);
+}
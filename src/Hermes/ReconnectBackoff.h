@@ -0,0 +1,65 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include "Network.h"
+
+#include <algorithm>
+#include <random>
+
+namespace Hermes
+{
+    // The waits between the connect attempts of a client: starting at m_retryDelayInSeconds, each one is
+    // m_waitTimeFactor times the previous one, up to m_maxWaitTimeInSeconds. The jitter takes a random share off each wait,
+    // so that the clients of a restarted server do not come back all at the same time.
+    class ReconnectBackoff
+    {
+    public:
+        explicit ReconnectBackoff(const NetworkConfiguration& configuration, unsigned seed = std::random_device()()) :
+            ReconnectBackoff(configuration.m_retryDelayInSeconds, configuration.m_reconnectPolicy, seed)
+        {}
+
+        ReconnectBackoff(double waitTimeInSeconds, const ReconnectPolicy& policy, unsigned seed = std::random_device()()) :
+            m_initialWaitTime(std::max(waitTimeInSeconds, 0.0)),
+            m_waitTime(m_initialWaitTime),
+            m_factor(std::max(policy.m_waitTimeFactor, 1.0)),
+            m_maxWaitTime(std::max(policy.m_maxWaitTimeInSeconds, m_waitTime)),
+            m_jitter(std::min(std::max(policy.m_jitter, 0.0), 1.0)),
+            m_random(seed)
+        {}
+
+        double NextWaitTimeInSeconds()
+        {
+            double waitTime = m_waitTime;
+            m_waitTime = std::min(m_waitTime * m_factor, m_maxWaitTime);
+            if (m_jitter == 0.0)
+                return waitTime;
+
+            return waitTime * (1.0 - m_jitter * std::uniform_real_distribution<double>(0.0, 1.0)(m_random));
+        }
+
+        // the next wait is the first one again
+        void Restart()
+        {
+            m_waitTime = m_initialWaitTime;
+        }
+
+    private:
+        double m_initialWaitTime;
+        double m_waitTime;
+        double m_factor;
+        double m_maxWaitTime;
+        double m_jitter;
+        std::minstd_rand m_random;
+    };
+
+    // the ReconnectPolicy of UpstreamSettings or VerticalClientSettings
+    template<class SettingsT>
+    ReconnectPolicy ToReconnectPolicy(const SettingsT& settings)
+    {
+        ReconnectPolicy policy;
+        policy.m_waitTimeFactor = settings.m_reconnectWaitTimeFactor;
+        policy.m_maxWaitTimeInSeconds = settings.m_maxReconnectWaitTimeInSeconds;
+        policy.m_jitter = settings.m_reconnectJitter;
+        return policy;
+    }
+}
@@ -1,26 +1,28 @@
 #pragma once
 
+#include "XmlWriter.h"
+
 #include <HermesStringView.hpp>
 
-#include <pugixml.hpp>
+#include <string>
 
 namespace Hermes
 {
+    // Writes the <Hermes Timestamp="..."> envelope around the data element of a message
     class SenderEnvelope
     {
     public:
-        SenderEnvelope(StringView tag);
+        // starts the data element in xml, for its attributes and children to be written through DataWriter()
+        SenderEnvelope(std::string& xml, StringView tag, EXmlFormat format);
         SenderEnvelope(const SenderEnvelope&) = delete;
         SenderEnvelope& operator=(const SenderEnvelope&) = delete;
         ~SenderEnvelope() = default;
 
-        std::string ToXmlString() const;
-        pugi::xml_node& DataNode() { return m_dataNode; }
+        XmlWriter& DataWriter() { return m_writer; }
+        // closes the data element and the envelope
+        void Finish();
 
     private:
-        pugi::xml_document m_domDocument;
-        pugi::xml_node m_dataNode;
+        XmlWriter m_writer;
     };
-
-
- }
+}
@@ -18,11 +18,12 @@ limitations under the License.
 
 #include <boost/asio.hpp>
 
-#include <HermesSerialization.h>
+#include <HermesSerialization.hpp>
 #include <HermesDataConversion.hpp>
 
 #include "MessageDispatcher.h"
-#include "Service.h"
+
+#include <cstring>
 
 
 void HermesSerializeServiceDescription(const HermesServiceDescriptionData* pData, HermesSerializationCallback callback)
@@ -125,65 +126,337 @@ void HermesSerializeSendHermesCapabilities(const HermesSendHermesCapabilitiesDat
 {
     callback.m_pCall(callback.m_pData, Hermes::ToC(Hermes::Serialize(Hermes::ToCpp(*pData))));
 }
+
 namespace
 {
-    template<class T, class CallbackT>
-    void Add_(Hermes::MessageDispatcher& dispatcher, CallbackT callback)
+    // the xml is written into storage of the calling thread first, which is kept for the next message
+    template<class CT>
+    size_t SerializeToBuffer_(const CT& data, char* pBuffer, size_t bufferSize)
     {
-        if (!callback.m_pCall)
-            return;
+        thread_local std::string xml;
+        Hermes::Serialize(data, xml);
+        if (xml.size() <= bufferSize)
+        {
+            std::memcpy(pBuffer, xml.data(), xml.size());
+        }
+        return xml.size();
+    }
+}
+
+size_t HermesSerializeServiceDescriptionToBuffer(const HermesServiceDescriptionData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeBoardAvailableToBuffer(const HermesBoardAvailableData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeRevokeBoardAvailableToBuffer(const HermesRevokeBoardAvailableData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeMachineReadyToBuffer(const HermesMachineReadyData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeRevokeMachineReadyToBuffer(const HermesRevokeMachineReadyData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeStartTransportToBuffer(const HermesStartTransportData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeStopTransportToBuffer(const HermesStopTransportData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeTransportFinishedToBuffer(const HermesTransportFinishedData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeBoardForecastToBuffer(const HermesBoardForecastData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeQueryBoardInfoToBuffer(const HermesQueryBoardInfoData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeSendBoardInfoToBuffer(const HermesSendBoardInfoData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeNotificationToBuffer(const HermesNotificationData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeCheckAliveToBuffer(const HermesCheckAliveData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeGetConfigurationToBuffer(const HermesGetConfigurationData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeSetConfigurationToBuffer(const HermesSetConfigurationData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeCurrentConfigurationToBuffer(const HermesCurrentConfigurationData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeSupervisoryServiceDescriptionToBuffer(const HermesSupervisoryServiceDescriptionData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeBoardArrivedToBuffer(const HermesBoardArrivedData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeBoardDepartedToBuffer(const HermesBoardDepartedData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeQueryWorkOrderInfoToBuffer(const HermesQueryWorkOrderInfoData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeSendWorkOrderInfoToBuffer(const HermesSendWorkOrderInfoData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeReplyWorkOrderInfoToBuffer(const HermesReplyWorkOrderInfoData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeCommandToBuffer(const HermesCommandData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeQueryHermesCapabilitiesToBuffer(const HermesQueryHermesCapabilitiesData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+size_t HermesSerializeSendHermesCapabilitiesToBuffer(const HermesSendHermesCapabilitiesData* pData, char* pBuffer, size_t bufferSize)
+{
+    return SerializeToBuffer_(*pData, pBuffer, bufferSize);
+}
+namespace
+{
+    using AllMessageTypes = Hermes::MessageTypes<Hermes::ServiceDescriptionData, Hermes::BoardAvailableData,
+        Hermes::RevokeBoardAvailableData, Hermes::MachineReadyData, Hermes::RevokeMachineReadyData,
+        Hermes::StartTransportData, Hermes::StopTransportData, Hermes::TransportFinishedData, Hermes::BoardForecastData,
+        Hermes::QueryBoardInfoData, Hermes::SendBoardInfoData, Hermes::CheckAliveData, Hermes::NotificationData,
+        Hermes::GetConfigurationData, Hermes::SetConfigurationData, Hermes::CurrentConfigurationData,
+        Hermes::SupervisoryServiceDescriptionData, Hermes::BoardArrivedData, Hermes::BoardDepartedData,
+        Hermes::QueryWorkOrderInfoData, Hermes::SendWorkOrderInfoData, Hermes::ReplyWorkOrderInfoData,
+        Hermes::CommandData, Hermes::QueryHermesCapabilitiesData, Hermes::SendHermesCapabilitiesData>;
 
-        dispatcher.Add<T>([callback](const auto& data)
+    // calls whichever of the callbacks is set
+    struct DeserializationHandler
+    {
+        const HermesDeserializationCallbacks& m_callbacks;
+
+        void On(const Hermes::ServiceDescriptionData& data) { Call_(m_callbacks.m_serviceDescriptionCallback, data); }
+        void On(const Hermes::BoardAvailableData& data) { Call_(m_callbacks.m_boardAvailableCallback, data); }
+        void On(const Hermes::RevokeBoardAvailableData& data) { Call_(m_callbacks.m_revokeBoardAvailableCallback, data); }
+        void On(const Hermes::MachineReadyData& data) { Call_(m_callbacks.m_machineReadyCallback, data); }
+        void On(const Hermes::RevokeMachineReadyData& data) { Call_(m_callbacks.m_revokeMachineReadyCallback, data); }
+        void On(const Hermes::StartTransportData& data) { Call_(m_callbacks.m_startTransportCallback, data); }
+        void On(const Hermes::StopTransportData& data) { Call_(m_callbacks.m_stopTransportCallback, data); }
+        void On(const Hermes::TransportFinishedData& data) { Call_(m_callbacks.m_transportFinishedCallback, data); }
+        void On(const Hermes::BoardForecastData& data) { Call_(m_callbacks.m_boardForecastCallback, data); }
+        void On(const Hermes::QueryBoardInfoData& data) { Call_(m_callbacks.m_queryBoardInfoCallback, data); }
+        void On(const Hermes::SendBoardInfoData& data) { Call_(m_callbacks.m_sendBoardInfoCallback, data); }
+        void On(const Hermes::CheckAliveData& data) { Call_(m_callbacks.m_checkAliveCallback, data); }
+        void On(const Hermes::NotificationData& data) { Call_(m_callbacks.m_notificationCallback, data); }
+        void On(const Hermes::GetConfigurationData& data) { Call_(m_callbacks.m_getConfigurationCallback, data); }
+        void On(const Hermes::SetConfigurationData& data) { Call_(m_callbacks.m_setConfigurationCallback, data); }
+        void On(const Hermes::CurrentConfigurationData& data) { Call_(m_callbacks.m_currentConfigurationCallback, data); }
+        void On(const Hermes::SupervisoryServiceDescriptionData& data) { Call_(m_callbacks.m_supervisoryServiceDescriptionCallback, data); }
+        void On(const Hermes::BoardArrivedData& data) { Call_(m_callbacks.m_boardArrivedCallback, data); }
+        void On(const Hermes::BoardDepartedData& data) { Call_(m_callbacks.m_boardDepartedCallback, data); }
+        void On(const Hermes::QueryWorkOrderInfoData& data) { Call_(m_callbacks.m_queryWorkOrderInfoCallback, data); }
+        void On(const Hermes::SendWorkOrderInfoData& data) { Call_(m_callbacks.m_sendWorkOrderInfoCallback, data); }
+        void On(const Hermes::ReplyWorkOrderInfoData& data) { Call_(m_callbacks.m_replyWorkOrderInfoCallback, data); }
+        void On(const Hermes::CommandData& data) { Call_(m_callbacks.m_commandCallback, data); }
+        void On(const Hermes::QueryHermesCapabilitiesData& data) { Call_(m_callbacks.m_queryHermesCapabilitiesCallback, data); }
+        void On(const Hermes::SendHermesCapabilitiesData& data) { Call_(m_callbacks.m_sendHermesCapabilitiesCallback, data); }
+
+        template<class T, class CallbackT>
+        static void Call_(const CallbackT& callback, const T& data)
         {
+            if (!callback.m_pCall)
+                return;
+
             Hermes::Converter2C<T> converter(data);
             callback.m_pCall(callback.m_pData, converter.CPointer());
-        });
+        }
+    };
+}
+
+// Dispatching messages needs no I/O, and with no trace callback to pass on to, nothing of a Service either:
+namespace
+{
+    struct DeserializationService : Hermes::IAsioService
+    {
+        Hermes::TimerWheel m_timerWheel{[](Hermes::TimerWheel::TimePoint) {}};
+
+        void Post(std::function<void()>&& f) override { f(); }
+        void Trace(Hermes::ETraceType, unsigned, Hermes::StringView) override {}
+        bool IsTraced(Hermes::ETraceType) const override { return false; }
+        Hermes::BackgroundTrace* GetBackgroundTrace() override { return nullptr; }
+        boost::asio::any_io_executor GetExecutor() override { return{}; }
+        Hermes::TimerWheel& GetTimerWheel() override { return m_timerWheel; }
+        Hermes::IoUring* GetIoUring() override { return nullptr; }
+        bool Stopped() const override { return false; }
+        std::shared_ptr<void> KeepAlive() override { return{}; }
+        void Register(Hermes::AsioSocket&) override {}
+        void Unregister(Hermes::AsioSocket&) override {}
+    };
+}
+
+struct HermesDeserializer
+{
+    explicit HermesDeserializer(EHermesXmlParserMode parserMode) :
+        m_dispatcher(0U, m_service, Hermes::ToCpp(parserMode))
+    {}
+
+    // copies into the storage of the dispatcher, which is kept from call to call
+    template<class HandlerT>
+    Hermes::Error Deserialize(Hermes::StringView xml, HandlerT& handler)
+    {
+        m_dispatcher.Reset();
+        auto buffer = m_dispatcher.ReceiveBuffer(xml.size());
+        if (!xml.empty())
+        {
+            std::memcpy(buffer.data(), xml.data(), xml.size());
+        }
+        return m_dispatcher.Dispatch<AllMessageTypes>(buffer, handler);
+    }
+
+    template<class HandlerT>
+    Hermes::Error DeserializeInPlace(Hermes::StringSpan xml, HandlerT& handler)
+    {
+        m_dispatcher.Reset();
+        return m_dispatcher.Dispatch<AllMessageTypes>(xml, handler);
+    }
+
+private:
+    DeserializationService m_service;
+    Hermes::MessageDispatcher m_dispatcher;
+};
+
+namespace
+{
+    void ReportError_(const Hermes::Error& error, const HermesDeserializationCallbacks& callbacks)
+    {
+        if (!error)
+            return;
+
+        if (!callbacks.m_deserializationErrorCallback.m_pCall)
+            return;
+
+        const Hermes::Converter2C<Hermes::Error> converter(error);
+        callbacks.m_deserializationErrorCallback.m_pCall(callbacks.m_deserializationErrorCallback.m_pData,
+            converter.CPointer());
     }
 }
 
 void HermesDeserialize(HermesStringView stringView, const HermesDeserializationCallbacks* pCallbacks)
 {
-    HermesTraceCallback traceCallback{};
-    Hermes::Service service{traceCallback};
-    Hermes::MessageDispatcher dispatcher{0U, service};
-
-    Add_<Hermes::ServiceDescriptionData>(dispatcher, pCallbacks->m_serviceDescriptionCallback);
-    Add_<Hermes::BoardAvailableData>(dispatcher, pCallbacks->m_boardAvailableCallback);
-    Add_<Hermes::RevokeBoardAvailableData>(dispatcher, pCallbacks->m_revokeBoardAvailableCallback);
-    Add_<Hermes::MachineReadyData>(dispatcher, pCallbacks->m_machineReadyCallback);
-    Add_<Hermes::RevokeMachineReadyData>(dispatcher, pCallbacks->m_revokeMachineReadyCallback);
-    Add_<Hermes::StartTransportData>(dispatcher, pCallbacks->m_startTransportCallback);
-    Add_<Hermes::StopTransportData>(dispatcher, pCallbacks->m_stopTransportCallback);
-    Add_<Hermes::TransportFinishedData>(dispatcher, pCallbacks->m_transportFinishedCallback);
-    Add_<Hermes::BoardForecastData>(dispatcher, pCallbacks->m_boardForecastCallback);
-    Add_<Hermes::QueryBoardInfoData>(dispatcher, pCallbacks->m_queryBoardInfoCallback);
-    Add_<Hermes::SendBoardInfoData>(dispatcher, pCallbacks->m_sendBoardInfoCallback);
-    Add_<Hermes::CheckAliveData>(dispatcher, pCallbacks->m_checkAliveCallback);
-    Add_<Hermes::NotificationData>(dispatcher, pCallbacks->m_notificationCallback);
-    Add_<Hermes::GetConfigurationData>(dispatcher, pCallbacks->m_getConfigurationCallback);
-    Add_<Hermes::SetConfigurationData>(dispatcher, pCallbacks->m_setConfigurationCallback);
-    Add_<Hermes::CurrentConfigurationData>(dispatcher, pCallbacks->m_currentConfigurationCallback);
-    Add_<Hermes::SupervisoryServiceDescriptionData>(dispatcher, pCallbacks->m_supervisoryServiceDescriptionCallback);
-    Add_<Hermes::BoardArrivedData>(dispatcher, pCallbacks->m_boardArrivedCallback);
-    Add_<Hermes::BoardDepartedData>(dispatcher, pCallbacks->m_boardDepartedCallback);
-    Add_<Hermes::QueryWorkOrderInfoData>(dispatcher, pCallbacks->m_queryWorkOrderInfoCallback);
-    Add_<Hermes::SendWorkOrderInfoData>(dispatcher, pCallbacks->m_sendWorkOrderInfoCallback);
-    Add_<Hermes::ReplyWorkOrderInfoData>(dispatcher, pCallbacks->m_replyWorkOrderInfoCallback);
-    Add_<Hermes::CommandData>(dispatcher, pCallbacks->m_commandCallback);
-    Add_<Hermes::QueryHermesCapabilitiesData>(dispatcher, pCallbacks->m_queryHermesCapabilitiesCallback);
-    Add_<Hermes::SendHermesCapabilitiesData>(dispatcher, pCallbacks->m_sendHermesCapabilitiesCallback);
-
-    std::string xmlParseString{Hermes::ToCpp(stringView)};
-    auto error = dispatcher.Dispatch(xmlParseString);
-    if (!error)
-        return;
-    
-    if (!pCallbacks->m_deserializationErrorCallback.m_pCall)
-        return;
-
-    const Hermes::Converter2C<Hermes::Error> converter(error);
-    pCallbacks->m_deserializationErrorCallback.m_pCall(pCallbacks->m_deserializationErrorCallback.m_pData, 
-        converter.CPointer());
+    HermesDeserializeWithParser(stringView, eHERMES_XML_PARSER_MODE_DOM, pCallbacks);
 }
 
+void HermesDeserializeWithParser(HermesStringView stringView, EHermesXmlParserMode parserMode,
+    const HermesDeserializationCallbacks* pCallbacks)
+{
+    HermesDeserializer deserializer{parserMode};
+    DeserializationHandler handler{*pCallbacks};
+    ReportError_(deserializer.Deserialize(Hermes::ToCpp(stringView), handler), *pCallbacks);
+}
+
+HermesDeserializer* CreateHermesDeserializer(EHermesXmlParserMode parserMode)
+{
+    return new HermesDeserializer(parserMode);
+}
+
+void HermesDeserializeWith(HermesDeserializer* pDeserializer, HermesStringView stringView,
+    const HermesDeserializationCallbacks* pCallbacks)
+{
+    DeserializationHandler handler{*pCallbacks};
+    ReportError_(pDeserializer->Deserialize(Hermes::ToCpp(stringView), handler), *pCallbacks);
+}
 
+void HermesDeserializeInPlaceWith(HermesDeserializer* pDeserializer, char* pXml, size_t size,
+    const HermesDeserializationCallbacks* pCallbacks)
+{
+    DeserializationHandler handler{*pCallbacks};
+    ReportError_(pDeserializer->DeserializeInPlace(Hermes::StringSpan{pXml, size}, handler), *pCallbacks);
+}
+
+void DeleteHermesDeserializer(HermesDeserializer* pDeserializer)
+{
+    delete pDeserializer;
+}
+
+#ifdef HERMES_CPP_ABI
+namespace
+{
+    // hands the data over to the C++ callback as it is
+    struct CppDeserializationHandler
+    {
+        Hermes::IDeserializationCallback& m_callback;
+
+        template<class DataT>
+        void On(DataT&& data) { m_callback.On(std::move(data)); }
+    };
+}
+
+std::string Hermes::SerializeHermes(const ServiceDescriptionData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const BoardAvailableData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const RevokeBoardAvailableData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const MachineReadyData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const RevokeMachineReadyData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const StartTransportData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const StopTransportData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const TransportFinishedData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const BoardForecastData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const QueryBoardInfoData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const SendBoardInfoData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const NotificationData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const CheckAliveData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const GetConfigurationData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const SetConfigurationData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const CurrentConfigurationData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const SupervisoryServiceDescriptionData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const BoardArrivedData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const BoardDepartedData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const QueryWorkOrderInfoData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const SendWorkOrderInfoData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const ReplyWorkOrderInfoData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const CommandData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const QueryHermesCapabilitiesData& data) { return Serialize(data); }
+std::string Hermes::SerializeHermes(const SendHermesCapabilitiesData& data) { return Serialize(data); }
+
+void Hermes::DeserializeHermes(StringView xml, EXmlParserMode parserMode, IDeserializationCallback& callback)
+{
+    HermesDeserializer deserializer{ToC(parserMode)};
+    CppDeserializationHandler handler{callback};
+    deserializer.Deserialize(xml, handler);
+}
+
+void Hermes::DeserializeHermes(HermesDeserializer* pDeserializer, StringView xml, IDeserializationCallback& callback)
+{
+    CppDeserializationHandler handler{callback};
+    pDeserializer->Deserialize(xml, handler);
+}
+
+void Hermes::DeserializeHermesInPlace(HermesDeserializer* pDeserializer, char* pXml, std::size_t size, IDeserializationCallback& callback)
+{
+    CppDeserializationHandler handler{callback};
+    pDeserializer->DeserializeInPlace(StringSpan{pXml, size}, handler);
+}
+#endif
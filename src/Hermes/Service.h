@@ -18,11 +18,19 @@ limitations under the License.
 
 #include <HermesDataConversion.hpp>
 #include "ApiCallback.h"
+#include "AsioSocket.h"
 #include "IService.h"
+#include "ServicePool.h"
 
 #include <boost/asio.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace asio = boost::asio;
 
@@ -55,26 +63,61 @@ namespace Hermes
         }
     };
 
-    struct Service : IAsioService
+    // Runs either on an io_context of its own, carried out by the thread calling Run(),
+    // or on a strand of the io_context of a service pool, which is shared with other services.
+    struct Service : IAsioService, std::enable_shared_from_this<Service>
     {
-        asio::io_context m_asioService;
+        std::unique_ptr<asio::io_context> m_upAsioService; // unless on a service pool
+        asio::io_context& m_asioService;
+        asio::any_io_executor m_executor;
         asio::executor_work_guard<asio::io_context::executor_type> m_asioWork{asio::make_work_guard(m_asioService) };
+        asio::steady_timer m_timerWheelTick{m_executor};
+        TimerWheel m_timerWheel{[this](TimerWheel::TimePoint time) { RequestTimerWheelTick_(time); }};
         TraceCallbackHolder m_traceCallback;
+        std::atomic<unsigned> m_tracedTypes{TracedTypes_(TraceFilter())}; // one bit per ETraceType
+        std::unique_ptr<BackgroundTrace> m_upBackgroundTrace; // destroyed first, so that it can still use m_traceCallback
+        std::atomic<BackgroundTrace*> m_pBackgroundTrace{nullptr};
+        std::atomic<bool> m_stopped{false};
+        std::mutex m_mutex;
+        std::condition_variable m_stoppedCondition; // for Run() on a service pool
+        std::vector<AsioSocket*> m_sockets;
+        std::unique_ptr<IoUring> m_upIoUring; // once asked for
+        bool m_ioUringCreated{false};
 
         explicit Service(HermesTraceCallback traceCallback) :
-            m_traceCallback(traceCallback)
+            Service(nullptr, traceCallback)
         {}
 
         explicit Service(ITraceCallback& traceCallback) :
+            Service(nullptr, traceCallback)
+        {
+        }
+
+        // without a pool, the service gets an io_context of its own; on a pool, it must be owned by a std::shared_ptr
+        Service(HermesServicePool* pPool, const TraceCallbackHolder& traceCallback) :
+            m_upAsioService(pPool ? nullptr : std::make_unique<asio::io_context>()),
+            m_asioService(pPool ? pPool->m_asioService : *m_upAsioService),
+            m_executor(pPool ? asio::any_io_executor(asio::make_strand(m_asioService)) : asio::any_io_executor(m_asioService.get_executor())),
             m_traceCallback(traceCallback)
         {
         }
 
         ~Service()
-        {}
+        {
+            CloseSockets_(); // e.g. those lingering after Close()
+            m_pBackgroundTrace.store(nullptr);
+            m_upBackgroundTrace.reset();
+        }
 
         void Run()
         {
+            if (!m_upAsioService)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_stoppedCondition.wait(lock, [this]() { return Stopped(); });
+                return;
+            }
+
             try
             {
                 m_asioService.run();
@@ -86,25 +129,192 @@ namespace Hermes
             
         }
 
+        // from then on, the handlers of the service are dropped
         void Stop()
         {
-            m_asioService.stop();
+            m_stopped.store(true);
+            if (m_upAsioService)
+            {
+                m_asioService.stop();
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stoppedCondition.notify_all();
+        }
+
+        // Stops the service and deletes its owner, who has it as m_service.
+        // On a service pool, the owner is deleted on the strand, so that none of its handlers can run meanwhile.
+        // The handlers still pending keep the service alive, but are dropped; neither they nor the service trace any more.
+        // Called from a thread of the pool, e.g. from a callback of another service, the deletion is only posted:
+        // waiting for it there could block the very thread which is to carry it out.
+        template<class OwnerT>
+        static void Delete(OwnerT* pOwner)
+        {
+            Service& service = pOwner->m_service;
+            service.Stop();
+            if (service.m_upAsioService)
+            {
+                delete pOwner;
+                return;
+            }
+
+            auto deleteOwner = [spService = service.shared_from_this(), pOwner]()
+            {
+                delete pOwner;
+                spService->Detach_();
+            };
+            if (service.m_asioService.get_executor().running_in_this_thread())
+            {
+                asio::dispatch(service.m_executor, std::move(deleteOwner));
+                return;
+            }
+
+            std::promise<void> deleted;
+            auto deletedFuture = deleted.get_future();
+            asio::dispatch(service.m_executor, [deleteOwner = std::move(deleteOwner), &deleted]()
+            {
+                deleteOwner();
+                deleted.set_value();
+            });
+            deletedFuture.wait();
+        }
+
+        void SetTraceFilter(const TraceFilter& filter)
+        {
+            m_tracedTypes.store(TracedTypes_(filter), std::memory_order_relaxed);
+        }
+
+        void StartBackgroundTrace(const BackgroundTraceSettings& settings)
+        {
+            auto upBackgroundTrace = std::make_unique<BackgroundTrace>(settings, *m_traceCallback);
+            BackgroundTrace* pExpected = nullptr;
+            if (!m_pBackgroundTrace.compare_exchange_strong(pExpected, upBackgroundTrace.get()))
+            {
+                Warn(0U, "Background trace already started");
+                return;
+            }
+            m_upBackgroundTrace = std::move(upBackgroundTrace);
+        }
+
+        boost::asio::io_context& GetUnderlyingService()
+        {
+            return m_asioService;
         }
 
         //============== IAsioService ==========================
         void Post(std::function<void()>&& f) override
         {
-            asio::post(m_asioService, std::move(f));
+            asio::post(m_executor, Bind(std::move(f)));
         }
 
         void Trace(ETraceType type, unsigned sessionId, StringView trace) override
         {
+            if (!IsTraced(type))
+                return;
+            if (auto pBackgroundTrace = GetBackgroundTrace())
+                return pBackgroundTrace->Record(type, sessionId, trace);
             m_traceCallback->OnTrace(sessionId, type, trace);
         }
 
-        boost::asio::io_context& GetUnderlyingService() override
+        bool IsTraced(ETraceType type) const override
         {
-            return m_asioService;
+            return (m_tracedTypes.load(std::memory_order_relaxed) >> static_cast<unsigned>(type)) & 1U;
+        }
+
+        BackgroundTrace* GetBackgroundTrace() override
+        {
+            return m_pBackgroundTrace.load(std::memory_order_acquire);
+        }
+
+        asio::any_io_executor GetExecutor() override
+        {
+            return m_executor;
+        }
+
+        TimerWheel& GetTimerWheel() override
+        {
+            return m_timerWheel;
+        }
+
+        IoUring* GetIoUring() override
+        {
+            if (!m_ioUringCreated)
+            {
+                m_ioUringCreated = true;
+                std::string error;
+                m_upIoUring = IoUring::Create(*this, error);
+                if (!m_upIoUring)
+                {
+                    Warn(0U, "No io_uring, falling back to asio: ", error);
+                }
+            }
+            return m_upIoUring.get();
+        }
+
+        bool Stopped() const override
+        {
+            return m_stopped.load(std::memory_order_relaxed);
+        }
+
+        std::shared_ptr<void> KeepAlive() override
+        {
+            if (m_upAsioService)
+                return nullptr;
+            return shared_from_this();
+        }
+
+        void Register(AsioSocket& socket) override
+        {
+            m_sockets.push_back(&socket);
+        }
+
+        void Unregister(AsioSocket& socket) override
+        {
+            m_sockets.erase(std::remove(m_sockets.begin(), m_sockets.end(), &socket), m_sockets.end());
+        }
+
+    private:
+        void RequestTimerWheelTick_(TimerWheel::TimePoint time)
+        {
+            m_timerWheelTick.expires_at(time);
+            m_timerWheelTick.async_wait(Bind([this](const boost::system::error_code& ec)
+            {
+                if (ec)
+                    return;
+                m_timerWheel.Tick();
+            }));
+        }
+
+        // the owner is gone, and with it the trace callback
+        void Detach_()
+        {
+            CloseSockets_();
+            // its wait for completions would keep the service alive otherwise
+            m_upIoUring.reset();
+            m_tracedTypes.store(0U);
+            m_pBackgroundTrace.store(nullptr);
+            m_upBackgroundTrace.reset();
+        }
+
+        void CloseSockets_()
+        {
+            // released at the end, as the sockets going with them unregister themselves
+            std::vector<std::shared_ptr<void>> released;
+            for (auto* pSocket : m_sockets)
+            {
+                released.push_back(pSocket->Abort());
+            }
+        }
+
+        static unsigned TracedTypes_(const TraceFilter& filter)
+        {
+            unsigned tracedTypes = 0U;
+            for (unsigned type = 0U; type < size(ETraceType()); ++type)
+            {
+                tracedTypes |= filter.IsTraced(static_cast<ETraceType>(type)) ? 1U << type : 0U;
+            }
+            return tracedTypes;
         }
     };
 }
@@ -0,0 +1,57 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#include "stdafx.h"
+
+#include "ServicePool.h"
+
+#include <algorithm>
+
+namespace asio = boost::asio;
+
+HermesServicePool::HermesServicePool(const HermesServicePoolSettings& settings) :
+    m_asioService(static_cast<int>(std::max(settings.m_threadCount, 1U)))
+{
+    auto threadStartCallback = settings.m_threadStartCallback;
+    for (uint32_t index = 0U; index < std::max(settings.m_threadCount, 1U); ++index)
+    {
+        m_threads.emplace_back([this, threadStartCallback, index]()
+        {
+            if (threadStartCallback.m_pCall)
+            {
+                threadStartCallback.m_pCall(threadStartCallback.m_pData, index);
+            }
+            for (;;)
+            {
+                try
+                {
+                    m_asioService.run();
+                    return;
+                }
+                catch (...)
+                {
+                    // a failing handler must not cost the pool one of its threads;
+                    // those of the services have already reported it, see ServiceHandler
+                }
+            }
+        });
+    }
+}
+
+HermesServicePool::~HermesServicePool()
+{
+    m_asioWork.reset();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+//===================== implementation of public C functions =====================
+HermesServicePool* CreateHermesServicePool(const HermesServicePoolSettings* pSettings)
+{
+    return new HermesServicePool(*pSettings);
+}
+
+void DeleteHermesServicePool(HermesServicePool* pPool)
+{
+    delete pPool;
+}
@@ -0,0 +1,22 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include <Hermes.h>
+
+#include <boost/asio.hpp>
+
+#include <thread>
+#include <vector>
+
+// The threads shared by the services created on the pool; each of these runs on a strand of m_asioService, see Service
+struct HermesServicePool
+{
+    boost::asio::io_context m_asioService;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_asioWork{boost::asio::make_work_guard(m_asioService)};
+    std::vector<std::thread> m_threads;
+
+    explicit HermesServicePool(const HermesServicePoolSettings&);
+    HermesServicePool(const HermesServicePool&) = delete;
+    HermesServicePool& operator=(const HermesServicePool&) = delete;
+    ~HermesServicePool(); // waits for the handlers left behind by the deleted services
+};
@@ -0,0 +1,230 @@
+#include "stdafx.h"
+
+#include "MessageFields.h"
+#include "MessageSerialization.h"
+#include "NumericCodec.h"
+#include "XmlReader.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+// Reading the messages straight from an XmlReader, driven by the Fields<> tables.
+// The results are the same as those of the pugixml based Deserialize(), including the errors:
+// there, all readers update one running error, so the last one set wins. Here, this is the error of the field
+// listed last of those that have one, where nested elements contribute their own (recursively found) error.
+namespace
+{
+    using namespace Hermes;
+
+    bool NameEquals_(StringView name, const char* expected)
+    {
+        return std::strncmp(name.data(), expected, name.size()) == 0 && expected[name.size()] == '\0';
+    }
+
+    // false for malformed numbers
+    bool ReadValue_(StringView value, std::string& data)
+    {
+        data.assign(value.data(), value.size());
+        return true;
+    }
+
+    template<class T>
+    std::enable_if_t<std::is_arithmetic<T>::value, bool> ReadValue_(StringView value, T& data)
+    {
+        return NumericCodec::Parse(value, data);
+    }
+
+    template<class E>
+    std::enable_if_t<std::is_enum<E>::value, bool> ReadValue_(StringView value, E& data)
+    {
+        int i = 0;
+        if (!NumericCodec::Parse(value, i))
+            return false;
+        data = (0 <= i && i < static_cast<int>(size(E()))) ? static_cast<E>(i) : E{};
+        return true;
+    }
+
+    struct ElementState_
+    {
+        std::uint64_t m_seen = 0U; // only the first attribute or child with a given name counts
+        std::size_t m_errorIndex = 0U;
+        Error m_error;
+
+        bool TestAndSet(std::size_t index)
+        {
+            std::uint64_t bit = std::uint64_t(1U) << index;
+            if (m_seen & bit)
+                return false;
+            m_seen |= bit;
+            return true;
+        }
+
+        void SetError(std::size_t index, Error&& error)
+        {
+            if (m_error && index < m_errorIndex)
+                return;
+            m_error = std::move(error);
+            m_errorIndex = index;
+        }
+    };
+
+    template<class T>
+    void ReadElement_(XmlReader&, Error&, T&);
+
+    template<class T>
+    void ReadList_(XmlReader& reader, Error& error, std::vector<T>& data)
+    {
+        for (auto token = reader.Next(); token == XmlReader::EToken::eSTART_ELEMENT; token = reader.Next())
+        {
+            if (!NameEquals_(reader.Name(), ListTraits<std::vector<T>>::cITEM))
+            {
+                reader.SkipElement();
+                continue;
+            }
+            data.emplace_back();
+            Error itemError;
+            ReadElement_(reader, itemError, data.back());
+            if (itemError)
+            {
+                error = std::move(itemError);
+            }
+        }
+    }
+
+    // the name has already been matched to field I by the FieldIndex
+    template<std::size_t I, class T>
+    bool ReadAttributeField_(const XmlReader::Attribute& attribute, ElementState_& state, T& data)
+    {
+        if constexpr (!FieldTraits<T, I>::cATTRIBUTE)
+            return false;
+        else
+        {
+            if (!state.TestAndSet(I))
+                return false;
+            if (!ReadValue_(attribute.m_value, FieldTraits<T, I>::Emplace(data)))
+            {
+                state.SetError(I, NumericCodec::MalformedNumberError(attribute.m_name, attribute.m_value));
+            }
+            return true;
+        }
+    }
+
+    template<std::size_t I, class T>
+    bool ReadChildField_(XmlReader& reader, ElementState_& state, T& data)
+    {
+        if constexpr (FieldTraits<T, I>::cATTRIBUTE)
+            return false;
+        else
+        {
+            if (!state.TestAndSet(I))
+                return false;
+            auto& value = FieldTraits<T, I>::Emplace(data);
+            Error error;
+            if constexpr (FieldTraits<T, I>::cLIST)
+            {
+                ReadList_(reader, error, value);
+            }
+            else
+            {
+                ReadElement_(reader, error, value);
+            }
+            if (error)
+            {
+                state.SetError(I, std::move(error));
+            }
+            return true;
+        }
+    }
+
+    template<std::size_t I, class T>
+    void CheckRequiredField_(ElementState_& state, const T&)
+    {
+        using Traits = FieldTraits<T, I>;
+        if (!Traits::IsRequired() || (state.m_seen & (std::uint64_t(1U) << I)))
+            return;
+        state.SetError(I, Error{EErrorCode::ePEER_ERROR,
+            std::string(Traits::cATTRIBUTE ? "missing attribute " : "missing element ") + Traits::cFIELD.m_name});
+    }
+
+    template<class T, std::size_t... Is>
+    void ReadElement_(XmlReader& reader, Error& error, T& data, std::index_sequence<Is...>)
+    {
+        ElementState_ state;
+        for (const auto& attribute : reader.Attributes())
+        {
+            std::size_t index = FieldIndex<T>::Find(attribute.m_name);
+            ((Is == index && ReadAttributeField_<Is>(attribute, state, data)) || ...);
+        }
+
+        for (auto token = reader.Next(); token == XmlReader::EToken::eSTART_ELEMENT; token = reader.Next())
+        {
+            std::size_t index = FieldIndex<T>::Find(reader.Name());
+            if (!((Is == index && ReadChildField_<Is>(reader, state, data)) || ...))
+            {
+                reader.SkipElement();
+            }
+        }
+
+        (CheckRequiredField_<Is>(state, data), ...);
+        if (state.m_error)
+        {
+            error = std::move(state.m_error);
+        }
+    }
+
+    // reads the element just started, up to and including its end tag
+    template<class T>
+    void ReadElement_(XmlReader& reader, Error& error, T& data)
+    {
+        constexpr std::size_t cSIZE = FieldCount<T>();
+        static_assert(cSIZE <= 64U, "ElementState_ has one bit per field");
+        ReadElement_(reader, error, data, std::make_index_sequence<cSIZE>());
+    }
+
+    template<class DataT>
+    Error ReadMessage_(XmlReader& reader, DataT& data)
+    {
+        Error error;
+        ReadElement_(reader, error, data);
+        return error;
+    }
+}
+
+Hermes::Error Hermes::Deserialize(XmlReader& reader, ServiceDescriptionData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, BoardAvailableData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, RevokeBoardAvailableData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, MachineReadyData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, RevokeMachineReadyData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, StartTransportData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, TransportFinishedData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, StopTransportData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, NotificationData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, CheckAliveData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, GetConfigurationData& data) { return ReadMessage_(reader, data); }
+
+Hermes::Error Hermes::Deserialize(XmlReader& reader, SetConfigurationData& data)
+{
+    // errors are ignored, as by the pugixml based Deserialize()
+    ReadMessage_(reader, data);
+    return{};
+}
+
+Hermes::Error Hermes::Deserialize(XmlReader& reader, CurrentConfigurationData& data)
+{
+    ReadMessage_(reader, data);
+    return{};
+}
+
+Hermes::Error Hermes::Deserialize(XmlReader& reader, BoardForecastData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, QueryBoardInfoData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, SendBoardInfoData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, SupervisoryServiceDescriptionData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, BoardArrivedData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, BoardDepartedData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, QueryWorkOrderInfoData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, SendWorkOrderInfoData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, ReplyWorkOrderInfoData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, QueryHermesCapabilitiesData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, SendHermesCapabilitiesData& data) { return ReadMessage_(reader, data); }
+Hermes::Error Hermes::Deserialize(XmlReader& reader, CommandData& data) { return ReadMessage_(reader, data); }
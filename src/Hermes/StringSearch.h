@@ -0,0 +1,144 @@
+/***********************************************************************
+Copyright 2018 ASM Assembly Systems GmbH & Co. KG
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+************************************************************************/
+
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+// Vectorized searches for characters and short strings, as needed for framing the incoming byte stream.
+// The instruction set is chosen at compile time: AVX2 if enabled (/arch:AVX2, -mavx2), SSE2 on every x86-64 build,
+// plain C++ otherwise.
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define HERMES_SEARCH_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HERMES_SEARCH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Hermes
+{
+    namespace Search
+    {
+        const std::size_t cNPOS = static_cast<std::size_t>(-1);
+
+        inline unsigned LowestBit_(unsigned mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        }
+
+        // index of the first occurence of c in [pData, pData + size), or cNPOS
+        inline std::size_t FindChar(const char* pData, std::size_t size, char c)
+        {
+            std::size_t i = 0U;
+#if defined(HERMES_SEARCH_AVX2)
+            const __m256i pattern = _mm256_set1_epi8(c);
+            for (; i + 32U <= size; i += 32U)
+            {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i));
+                const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+                if (mask)
+                    return i + LowestBit_(mask);
+            }
+#elif defined(HERMES_SEARCH_SSE2)
+            const __m128i pattern = _mm_set1_epi8(c);
+            for (; i + 16U <= size; i += 16U)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+                const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+                if (mask)
+                    return i + LowestBit_(mask);
+            }
+#endif
+            for (; i < size; ++i)
+            {
+                if (pData[i] == c)
+                    return i;
+            }
+            return cNPOS;
+        }
+
+        // index of the first occurence of the needle in [pData, pData + size), or cNPOS.
+        // Candidates are found by comparing the first and the last character of the needle for a whole block at once,
+        // only those get compared in full.
+        inline std::size_t FindString(const char* pData, std::size_t size, const char* pNeedle, std::size_t needleSize)
+        {
+            if (!needleSize)
+                return 0U;
+            if (size < needleSize)
+                return cNPOS;
+
+            const std::size_t last = needleSize - 1U;
+            const std::size_t candidates = size - last;
+            std::size_t i = 0U;
+#if defined(HERMES_SEARCH_AVX2)
+            const __m256i first = _mm256_set1_epi8(pNeedle[0]);
+            const __m256i final = _mm256_set1_epi8(pNeedle[last]);
+            for (; i + 32U <= candidates; i += 32U)
+            {
+                const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i));
+                const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i + last));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, final))));
+                while (mask)
+                {
+                    const std::size_t candidate = i + LowestBit_(mask);
+                    if (std::memcmp(pData + candidate + 1U, pNeedle + 1U, last) == 0)
+                        return candidate;
+                    mask &= mask - 1U;
+                }
+            }
+#elif defined(HERMES_SEARCH_SSE2)
+            const __m128i first = _mm_set1_epi8(pNeedle[0]);
+            const __m128i final = _mm_set1_epi8(pNeedle[last]);
+            for (; i + 16U <= candidates; i += 16U)
+            {
+                const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+                const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i + last));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, final))));
+                while (mask)
+                {
+                    const std::size_t candidate = i + LowestBit_(mask);
+                    if (std::memcmp(pData + candidate + 1U, pNeedle + 1U, last) == 0)
+                        return candidate;
+                    mask &= mask - 1U;
+                }
+            }
+#endif
+            for (; i < candidates; ++i)
+            {
+                if (pData[i] == pNeedle[0] && pData[i + last] == pNeedle[last]
+                    && std::memcmp(pData + i + 1U, pNeedle + 1U, last) == 0)
+                    return i;
+            }
+            return cNPOS;
+        }
+    }
+}
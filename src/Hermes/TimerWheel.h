@@ -0,0 +1,238 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+namespace Hermes
+{
+    // The timers of a service on a wheel of cSLOT_COUNT slots, each cTICK long. Scheduling and cancelling are O(1)
+    // and do not touch the operating system; a timer due more than one turn ahead waits in its slot for the turns left.
+    // The wheel only asks for a tick (e.g. of an asio timer) when a slot holding timers comes around, so a lone
+    // long timer wakes its service once a turn rather than once a tick.
+    // Not thread safe: it is used from the executor of its service only.
+    class TimerWheel
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+        using Clock = std::function<TimePoint()>;
+        // called when the wheel wants Tick() to be called at the given time, instead of any time asked for before
+        using TickRequest = std::function<void(TimePoint)>;
+
+        static constexpr std::chrono::milliseconds cTICK{50};
+        static constexpr std::size_t cSLOT_COUNT = 256U; // a turn of 12.8 seconds
+
+        class Timer;
+
+        explicit TimerWheel(TickRequest tickRequest, Clock clock = &std::chrono::steady_clock::now) :
+            m_tickRequest(std::move(tickRequest)),
+            m_clock(std::move(clock)),
+            m_origin(m_clock())
+        {
+            for (auto& slot : m_slots)
+            {
+                slot.m_pPrev = slot.m_pNext = &slot;
+            }
+        }
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        // the timers still scheduled are just left alone, they may well outlive the wheel
+        ~TimerWheel();
+
+        // (re)schedules the timer to go off after the given time, rounded up to the next tick
+        void Schedule(Timer&, double seconds);
+
+        // lets the timers due go off
+        void Tick();
+
+        std::size_t Size() const { return m_size; }
+
+    private:
+        struct Link
+        {
+            Link* m_pPrev = nullptr;
+            Link* m_pNext = nullptr; // nullptr: not linked
+        };
+
+        static void Unlink_(Link& link)
+        {
+            link.m_pPrev->m_pNext = link.m_pNext;
+            link.m_pNext->m_pPrev = link.m_pPrev;
+            link.m_pPrev = link.m_pNext = nullptr;
+        }
+
+        static void LinkBefore_(Link& link, Link& next)
+        {
+            link.m_pNext = &next;
+            link.m_pPrev = next.m_pPrev;
+            next.m_pPrev->m_pNext = &link;
+            next.m_pPrev = &link;
+        }
+
+        // the ticks since m_origin up to the given time, rounded down
+        std::uint64_t TicksAt_(TimePoint time) const
+        {
+            return time <= m_origin ? 0U : static_cast<std::uint64_t>((time - m_origin) / cTICK);
+        }
+
+        // the ticks from m_tick to the next slot holding timers, cSLOT_COUNT for the slot of m_tick itself
+        std::uint64_t TicksToNextSlot_() const
+        {
+            for (std::uint64_t ticks = 1U; ticks < cSLOT_COUNT; ++ticks)
+            {
+                const Link& slot = m_slots[(m_tick + ticks) % cSLOT_COUNT];
+                if (slot.m_pNext != &slot)
+                    return ticks;
+            }
+            return cSLOT_COUNT;
+        }
+
+        void RequestTick_(std::uint64_t tick)
+        {
+            if (m_ticking || (m_requestedTick && m_requestedTick <= tick))
+                return;
+            m_requestedTick = tick;
+            m_tickRequest(m_origin + cTICK * tick);
+        }
+
+        void Expire_(Link& slot);
+
+        TickRequest m_tickRequest;
+        Clock m_clock;
+        TimePoint m_origin; // of tick 0
+        std::uint64_t m_tick = 0U; // the last one done
+        std::uint64_t m_requestedTick = 0U; // 0: none
+        std::size_t m_size = 0U;
+        bool m_ticking = false;
+        std::array<Link, cSLOT_COUNT> m_slots;
+    };
+
+    // Owned by whoever wants to be called back; cancelled when destroyed, so the callback may well capture its owner.
+    class TimerWheel::Timer : private TimerWheel::Link
+    {
+    public:
+        explicit Timer(std::function<void()>&& callback) :
+            m_callback(std::move(callback))
+        {}
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        ~Timer()
+        {
+            Cancel();
+        }
+
+        bool Scheduled() const { return m_pNext != nullptr; }
+
+        void Cancel()
+        {
+            if (!m_pNext)
+                return;
+            Unlink_(*this);
+            --m_pWheel->m_size;
+        }
+
+    private:
+        friend class TimerWheel;
+
+        TimerWheel* m_pWheel = nullptr;
+        std::uint64_t m_turns = 0U; // the times the wheel passes the slot before the timer goes off
+        std::function<void()> m_callback;
+    };
+
+    inline TimerWheel::~TimerWheel()
+    {
+        for (auto& slot : m_slots)
+        {
+            while (slot.m_pNext != &slot)
+            {
+                Unlink_(*slot.m_pNext);
+            }
+        }
+    }
+
+    inline void TimerWheel::Schedule(Timer& timer, double seconds)
+    {
+        timer.Cancel();
+
+        if (!m_size && !m_ticking)
+        {
+            // the wheel has stood still, so it starts over from now
+            m_origin = m_clock() - cTICK * m_tick;
+            m_requestedTick = 0U;
+        }
+        auto delay = std::chrono::duration<double>(seconds > 0.0 ? seconds : 0.0);
+        auto dueTick = static_cast<std::uint64_t>(std::ceil((m_clock() - m_origin + delay) / cTICK));
+        std::uint64_t ticks = dueTick > m_tick ? dueTick - m_tick : 1U;
+
+        timer.m_pWheel = this;
+        timer.m_turns = (ticks - 1U) / cSLOT_COUNT;
+        LinkBefore_(timer, m_slots[(m_tick + ticks) % cSLOT_COUNT]);
+        ++m_size;
+        // the tick at which the wheel passes the slot first
+        RequestTick_(m_tick + (ticks - 1U) % cSLOT_COUNT + 1U);
+    }
+
+    inline void TimerWheel::Tick()
+    {
+        // the timers of the callbacks neither restart the wheel nor ask for ticks while it turns
+        m_ticking = true;
+        std::uint64_t dueTick = TicksAt_(m_clock());
+        if (dueTick >= m_requestedTick)
+        {
+            m_requestedTick = 0U;
+        }
+        while (m_tick < dueTick && m_size)
+        {
+            // the empty slots in between are skipped
+            std::uint64_t tick = m_tick + TicksToNextSlot_();
+            if (tick > dueTick)
+            {
+                m_tick = dueTick;
+                break;
+            }
+            m_tick = tick;
+            Expire_(m_slots[m_tick % cSLOT_COUNT]);
+        }
+        m_ticking = false;
+        if (m_size)
+        {
+            RequestTick_(m_tick + TicksToNextSlot_());
+        }
+    }
+
+    inline void TimerWheel::Expire_(Link& slot)
+    {
+        if (slot.m_pNext == &slot)
+            return;
+
+        // taken off the slot first, so that the timers scheduled by the callbacks are not mixed up with these
+        Link pending;
+        pending.m_pNext = slot.m_pNext;
+        pending.m_pPrev = slot.m_pPrev;
+        pending.m_pNext->m_pPrev = &pending;
+        pending.m_pPrev->m_pNext = &pending;
+        slot.m_pPrev = slot.m_pNext = &slot;
+
+        while (pending.m_pNext != &pending)
+        {
+            // a callback may cancel or delete any timer, including the pending ones
+            auto& timer = static_cast<Timer&>(*pending.m_pNext);
+            Unlink_(timer);
+            if (timer.m_turns)
+            {
+                --timer.m_turns;
+                LinkBefore_(timer, slot);
+                continue;
+            }
+            --m_size;
+            timer.m_callback();
+        }
+    }
+}
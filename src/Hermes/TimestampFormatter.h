@@ -0,0 +1,177 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <functional>
+
+namespace Hermes
+{
+    // Formats the Timestamp of the Hermes envelope, YYYY-MM-DDTHH:MM:SS.mmm in local time.
+    // Asking the time zone for the local time is expensive (localtime_r takes a global lock), so its offset to UTC
+    // is only asked for once per second and cached in one atomic, which keeps the formatter lock-free for all threads.
+    // Likewise, each thread caches the date and time part of its last timestamp, so mostly the milliseconds change.
+    class TimestampFormatter
+    {
+    public:
+        using Clock = std::function<std::chrono::system_clock::time_point()>;
+        // the offset of local time to UTC at the given time since the epoch
+        using UtcOffset = std::function<std::chrono::seconds(std::chrono::seconds)>;
+
+        static constexpr std::size_t cSIZE = 23U;
+        using Timestamp = std::array<char, cSIZE>;
+
+        // the system clock in the local time zone
+        TimestampFormatter() :
+            TimestampFormatter([]() { return std::chrono::system_clock::now(); }, &LocalUtcOffset)
+        {}
+
+        TimestampFormatter(Clock clock, UtcOffset utcOffset) :
+            m_clock(std::move(clock)),
+            m_utcOffset(std::move(utcOffset))
+        {}
+
+        TimestampFormatter(const TimestampFormatter&) = delete;
+        TimestampFormatter& operator=(const TimestampFormatter&) = delete;
+
+        // the formatter used for the messages
+        static const TimestampFormatter& Local()
+        {
+            static const TimestampFormatter sFormatter;
+            return sFormatter;
+        }
+
+        Timestamp Now() const
+        {
+            return Format(m_clock());
+        }
+
+        // the offset to UTC is cached for the second last asked for, so times are best formatted in ascending order
+        Timestamp Format(std::chrono::system_clock::time_point time) const
+        {
+            auto sinceEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+            std::int64_t second = FloorDivide_(sinceEpoch, 1000);
+            auto milliseconds = static_cast<unsigned>(sinceEpoch - second * 1000);
+            std::int64_t localSecond = second + CachedUtcOffset_(second);
+
+            struct Prefix
+            {
+                std::int64_t m_localSecond = INT64_MIN;
+                char m_text[cPREFIX_SIZE];
+            };
+            static thread_local Prefix tPrefix;
+            if (tPrefix.m_localSecond != localSecond)
+            {
+                FormatPrefix_(localSecond, tPrefix.m_text);
+                tPrefix.m_localSecond = localSecond;
+            }
+
+            Timestamp timestamp;
+            std::memcpy(timestamp.data(), tPrefix.m_text, cPREFIX_SIZE);
+            timestamp[cPREFIX_SIZE] = '.';
+            Write_(timestamp.data() + cPREFIX_SIZE + 1U, milliseconds, 3U);
+            return timestamp;
+        }
+
+        static std::chrono::seconds LocalUtcOffset(std::chrono::seconds sinceEpoch)
+        {
+            std::time_t time = static_cast<std::time_t>(sinceEpoch.count());
+            std::tm local;
+#ifdef _WINDOWS
+            localtime_s(&local, &time);
+#else
+            localtime_r(&time, &local);
+#endif
+            std::int64_t localSecond = DaysFromCivil_(local.tm_year + 1900, static_cast<unsigned>(local.tm_mon + 1),
+                static_cast<unsigned>(local.tm_mday)) * 86400 + local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+            return std::chrono::seconds(localSecond - sinceEpoch.count());
+        }
+
+    private:
+        static constexpr std::size_t cPREFIX_SIZE = 19U; // YYYY-MM-DDTHH:MM:SS
+
+        // the cache holds the second in the upper bits and the offset, biased to be positive, in the lower ones
+        static constexpr unsigned cOFFSET_BITS = 18U; // covers +-36 hours
+        static constexpr std::int64_t cOFFSET_BIAS = std::int64_t(1) << (cOFFSET_BITS - 1U);
+        static constexpr std::uint64_t cEMPTY = ~std::uint64_t(0U);
+
+        std::int64_t CachedUtcOffset_(std::int64_t second) const
+        {
+            std::uint64_t cached = m_cache.load(std::memory_order_relaxed);
+            if (cached != cEMPTY && static_cast<std::int64_t>(cached >> cOFFSET_BITS) == second)
+                return static_cast<std::int64_t>(cached & ((std::uint64_t(1U) << cOFFSET_BITS) - 1U)) - cOFFSET_BIAS;
+
+            std::int64_t offset = m_utcOffset(std::chrono::seconds(second)).count();
+            if (second >= 0 && second < (std::int64_t(1) << (64U - cOFFSET_BITS - 1U)) && offset > -cOFFSET_BIAS && offset < cOFFSET_BIAS)
+            {
+                // racing threads all store what they have found, which is the same for the same second
+                m_cache.store((static_cast<std::uint64_t>(second) << cOFFSET_BITS) | static_cast<std::uint64_t>(offset + cOFFSET_BIAS),
+                    std::memory_order_relaxed);
+            }
+            return offset;
+        }
+
+        static std::int64_t FloorDivide_(std::int64_t value, std::int64_t divisor)
+        {
+            std::int64_t quotient = value / divisor;
+            return (value % divisor < 0) ? quotient - 1 : quotient;
+        }
+
+        // days since 1970-01-01 and back, see http://howardhinnant.github.io/date_algorithms.html
+        static std::int64_t DaysFromCivil_(std::int64_t year, unsigned month, unsigned day)
+        {
+            year -= month <= 2U ? 1 : 0;
+            std::int64_t era = FloorDivide_(year, 400);
+            auto yearOfEra = static_cast<unsigned>(year - era * 400);
+            unsigned dayOfYear = (153U * (month > 2U ? month - 3U : month + 9U) + 2U) / 5U + day - 1U;
+            unsigned dayOfEra = yearOfEra * 365U + yearOfEra / 4U - yearOfEra / 100U + dayOfYear;
+            return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+        }
+
+        static void FormatPrefix_(std::int64_t localSecond, char* pText)
+        {
+            std::int64_t days = FloorDivide_(localSecond, 86400);
+            auto secondOfDay = static_cast<unsigned>(localSecond - days * 86400);
+
+            days += 719468;
+            std::int64_t era = FloorDivide_(days, 146097);
+            auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+            unsigned yearOfEra = (dayOfEra - dayOfEra / 1460U + dayOfEra / 36524U - dayOfEra / 146096U) / 365U;
+            unsigned dayOfYear = dayOfEra - (365U * yearOfEra + yearOfEra / 4U - yearOfEra / 100U);
+            unsigned shiftedMonth = (5U * dayOfYear + 2U) / 153U;
+            unsigned day = dayOfYear - (153U * shiftedMonth + 2U) / 5U + 1U;
+            unsigned month = shiftedMonth < 10U ? shiftedMonth + 3U : shiftedMonth - 9U;
+            auto year = static_cast<unsigned>(static_cast<std::int64_t>(yearOfEra) + era * 400 + (month <= 2U ? 1 : 0));
+
+            Write_(pText, year, 4U);
+            pText[4] = '-';
+            Write_(pText + 5, month, 2U);
+            pText[7] = '-';
+            Write_(pText + 8, day, 2U);
+            pText[10] = 'T';
+            Write_(pText + 11, secondOfDay / 3600U, 2U);
+            pText[13] = ':';
+            Write_(pText + 14, secondOfDay / 60U % 60U, 2U);
+            pText[16] = ':';
+            Write_(pText + 17, secondOfDay % 60U, 2U);
+        }
+
+        // zero padded
+        static void Write_(char* pText, unsigned value, std::size_t digits)
+        {
+            for (std::size_t i = digits; i > 0U; --i)
+            {
+                pText[i - 1U] = static_cast<char>('0' + value % 10U);
+                value /= 10U;
+            }
+        }
+
+        Clock m_clock;
+        UtcOffset m_utcOffset;
+        mutable std::atomic<std::uint64_t> m_cache{cEMPTY};
+    };
+}
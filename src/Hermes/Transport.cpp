@@ -0,0 +1,65 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#include "stdafx.h"
+
+#include "Network.h"
+
+namespace Hermes
+{
+    namespace
+    {
+        std::unique_ptr<IAcceptor> CreateAcceptor_(ETransport transport, IAsioService& service, IAcceptorCallback& callback)
+        {
+            if (transport == ETransport::eIN_PROCESS)
+                return CreatePipeAcceptor(service, callback);
+            return CreateAsioAcceptor(service, callback);
+        }
+    }
+
+    // Creates the acceptor of the transport configured once listening, and anew when the transport changes.
+    struct TransportAcceptor : IAcceptor
+    {
+        IAsioService& m_service;
+        IAcceptorCallback& m_callback;
+        ETransport m_transport = ETransport::eTCP;
+        std::unique_ptr<IAcceptor> m_upAcceptor;
+
+        TransportAcceptor(IAsioService& service, IAcceptorCallback& callback) :
+            m_service(service),
+            m_callback(callback)
+        {}
+
+        // implementation of IAcceptor:
+        void StartListening(const NetworkConfiguration& configuration) override
+        {
+            ETransport transport = configuration.m_socketOptions.m_transport;
+            if (!m_upAcceptor || transport != m_transport)
+            {
+                m_upAcceptor.reset();
+                m_transport = transport;
+                m_upAcceptor = CreateAcceptor_(transport, m_service, m_callback);
+            }
+            m_upAcceptor->StartListening(configuration);
+        }
+
+        void StopListening() override
+        {
+            if (m_upAcceptor)
+            {
+                m_upAcceptor->StopListening();
+            }
+        }
+    };
+}
+
+std::unique_ptr<Hermes::IClientSocket> Hermes::CreateClientSocket(unsigned sessionId,
+    const NetworkConfiguration& configuration, IAsioService& service)
+{
+    if (configuration.m_socketOptions.m_transport == ETransport::eIN_PROCESS)
+        return CreatePipeClientSocket(sessionId, configuration, service);
+    return CreateAsioClientSocket(sessionId, configuration, service);
+}
+
+std::unique_ptr<Hermes::IAcceptor> Hermes::CreateAcceptor(IAsioService& service, IAcceptorCallback& callback)
+{
+    return std::make_unique<TransportAcceptor>(service, callback);
+}
@@ -22,8 +22,10 @@ limitations under the License.
 #include "Service.h"
 #include "UpstreamSession.h"
 #include "HermesChrono.hpp"
+#include "ReconnectBackoff.h"
 
 #include <cassert>
+#include <chrono>
 #include <memory>
 
 #include <Connection/Upstream.hpp>
@@ -147,12 +149,16 @@ struct UpstreamCallbackHolder : CallbackHolder<IUpstreamCallback, UpstreamCallba
 struct HermesUpstream : ISessionCallback
 {
     unsigned m_laneId = 0U;
-    Service m_service;
-    asio::system_timer m_timer{m_service.GetUnderlyingService()};
+    std::shared_ptr<Service> m_spService;
+    Service& m_service{*m_spService};
+    asio::system_timer m_timer{m_service.GetExecutor()};
     UpstreamSettings m_settings;
 
     unsigned m_sessionId{0U};
     unsigned m_connectedSessionId{0U};
+    std::chrono::steady_clock::time_point m_disconnectedAt; // of the last connected session, reset when connected again
+    ReconnectBackoff m_backoff{0.0, ReconnectPolicy()}; // after sessions that closed before the peer described itself
+    bool m_reconnectedAtOnce{false}; // after the previous session, see m_reconnectAtOnceAfterClose
 
     UpstreamCallbackHolder m_callbacks;
 
@@ -160,9 +166,9 @@ struct HermesUpstream : ISessionCallback
 
     bool m_enabled{false};
 
-    HermesUpstream(unsigned laneId, UpstreamCallbackHolder&& callbacks) :
+    HermesUpstream(HermesServicePool* pPool, unsigned laneId, UpstreamCallbackHolder&& callbacks) :
         m_laneId(laneId),
-        m_service(*callbacks),
+        m_spService(std::make_shared<Service>(pPool, *callbacks)),
         m_callbacks{callbacks}
     {
         m_service.Inform(0U, "Created");
@@ -185,6 +191,8 @@ struct HermesUpstream : ISessionCallback
             ESeverity::eINFO, "ConfigurationChanged"));
 
         m_settings = settings;
+        m_backoff = ReconnectBackoff(m_settings.m_reconnectWaitTimeInSeconds, ToReconnectPolicy(m_settings));
+        m_reconnectedAtOnce = false;
         CreateNewSession_();
     }
 
@@ -227,8 +235,15 @@ struct HermesUpstream : ISessionCallback
         if (!pSession)
             return;
 
+        ConnectionInfo connectionInfo(in_data);
+        if (m_disconnectedAt != std::chrono::steady_clock::time_point())
+        {
+            connectionInfo.m_downtimeInSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_disconnectedAt).count();
+            m_disconnectedAt = std::chrono::steady_clock::time_point();
+        }
+
         m_connectedSessionId = pSession->Id();
-        m_callbacks->OnConnected(m_connectedSessionId, state, in_data);
+        m_callbacks->OnConnected(m_connectedSessionId, state, connectionInfo);
     }
 
     void On(unsigned sessionId, EState state, const ServiceDescriptionData& in_data) override
@@ -337,13 +352,31 @@ struct HermesUpstream : ISessionCallback
         if (!pSession)
             return;
 
-        if (pSession->OptionalPeerServiceDescriptionData())
+        if (sessionId == m_connectedSessionId)
         {
+            m_disconnectedAt = std::chrono::steady_clock::now();
+        }
+
+        // A peer closing an established connection cleanly is usually restarting, so we are back as soon as it is.
+        // Not twice in a row though, and not after a peer that closes before describing itself, e.g. one that refuses us.
+        bool established = pSession->OptionalPeerServiceDescriptionData();
+        if (m_settings.m_reconnectAtOnceAfterClose && !in_data && established && !m_reconnectedAtOnce)
+        {
+            m_reconnectedAtOnce = true;
+            DelayCreateNewSession_(0.0);
+        }
+        else if (established)
+        {
+            m_reconnectedAtOnce = false;
+            m_backoff.Restart();
             DelayCreateNewSession_(1.0);
         }
         else
         {
-            DelayCreateNewSession_(m_settings.m_reconnectWaitTimeInSeconds);
+            m_reconnectedAtOnce = false;
+            auto waitTime = m_backoff.NextWaitTimeInSeconds();
+            m_service.Log(sessionId, "Reconnecting in ", waitTime, " seconds");
+            DelayCreateNewSession_(waitTime);
         }
 
         m_upSession.reset();
@@ -390,6 +423,7 @@ struct HermesUpstream : ISessionCallback
             return;
 
         m_connectedSessionId = 0U;
+        m_disconnectedAt = std::chrono::steady_clock::now();
         Error error;
 
         m_callbacks->OnDisconnected(sessionId, EState::eDISCONNECTED, error);
@@ -426,12 +460,12 @@ struct HermesUpstream : ISessionCallback
         m_service.Log(0U, "DelayCreateNewSession_");
 
         m_timer.expires_after(Hermes::GetSeconds(delay));
-        m_timer.async_wait([this](const boost::system::error_code& ec)
+        m_timer.async_wait(m_service.Bind([this](const boost::system::error_code& ec)
         {
             if (ec) // timer cancelled or whatever
                 return;
             CreateNewSession_();
-        });
+        }));
     }
 };
 
@@ -441,7 +475,70 @@ struct HermesUpstream : ISessionCallback
 #ifdef HERMES_CPP_ABI
 HermesUpstream* Hermes::CreateHermesUpstream(uint32_t laneId, IUpstreamCallback& callback)
 {
-    return new HermesUpstream(laneId, UpstreamCallbackHolder{ callback });
+    return new HermesUpstream(nullptr, laneId, UpstreamCallbackHolder{ callback });
+}
+
+HermesUpstream* Hermes::CreateHermesUpstream(HermesServicePool* pPool, uint32_t laneId, IUpstreamCallback& callback)
+{
+    return new HermesUpstream(pPool, laneId, UpstreamCallbackHolder{ callback });
+}
+
+namespace
+{
+    template<class DataT>
+    void PostSignal_(HermesUpstream* pUpstream, unsigned sessionId, DataT&& data)
+    {
+        pUpstream->m_service.Log(sessionId, "SignalHermesUpstream ", SerializationTraits<DataT>::cTAG_VIEW);
+        pUpstream->m_service.Post([pUpstream, sessionId, data = std::move(data)]()
+        {
+            pUpstream->Signal(sessionId, data, Serialize(data));
+        });
+    }
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, ServiceDescriptionData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, MachineReadyData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, RevokeMachineReadyData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, StartTransportData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, StopTransportData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, QueryBoardInfoData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, NotificationData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, CheckAliveData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesUpstream(HermesUpstream* pUpstream, unsigned sessionId, CommandData&& data)
+{
+    PostSignal_(pUpstream, sessionId, std::move(data));
 }
 #else
 #error "HERMES_CPP_ABI should always be defined for building Hermes library"
@@ -451,7 +548,12 @@ HermesUpstream* Hermes::CreateHermesUpstream(uint32_t laneId, IUpstreamCallback&
 
 HermesUpstream* CreateHermesUpstream(uint32_t laneId, const HermesUpstreamCallbacks* pCallbacks)
 {
-    return new HermesUpstream(laneId, UpstreamCallbackHolder{ *pCallbacks });
+    return new HermesUpstream(nullptr, laneId, UpstreamCallbackHolder{ *pCallbacks });
+}
+
+HermesUpstream* CreateHermesUpstreamOnPool(HermesServicePool* pPool, uint32_t laneId, const HermesUpstreamCallbacks* pCallbacks)
+{
+    return new HermesUpstream(pPool, laneId, UpstreamCallbackHolder{ *pCallbacks });
 }
 
 void RunHermesUpstream(HermesUpstream* pUpstream)
@@ -486,6 +588,17 @@ void EnableHermesUpstream(HermesUpstream* pUpstream, const HermesUpstreamSetting
     });
 }
 
+void SetHermesUpstreamTraceFilter(HermesUpstream* pUpstream, const HermesTraceFilter* pFilter)
+{
+    pUpstream->m_service.SetTraceFilter(ToCpp(*pFilter));
+}
+
+void SetHermesUpstreamBackgroundTrace(HermesUpstream* pUpstream, const HermesBackgroundTraceSettings* pSettings)
+{
+    pUpstream->m_service.Log(0U, "SetHermesUpstreamBackgroundTrace");
+    pUpstream->m_service.StartBackgroundTrace(ToCpp(*pSettings));
+}
+
 void SignalHermesUpstreamServiceDescription(HermesUpstream* pUpstream, uint32_t sessionId, const HermesServiceDescriptionData* pData)
 {
     pUpstream->m_service.Log(sessionId, "SignalHermesUpstreamServiceDescription");
@@ -583,6 +696,28 @@ void ResetHermesUpstream(HermesUpstream* pUpstream, const HermesNotificationData
     });
 }
 
+namespace
+{
+    // the messages SignalHermesUpstreamRawXml() recognizes, anything else is sent as a notification
+    using RawXmlMessageTypes = MessageTypes<ServiceDescriptionData, MachineReadyData, RevokeMachineReadyData,
+        StartTransportData, StopTransportData, QueryBoardInfoData, NotificationData, CheckAliveData>;
+
+    struct RawXmlHandler
+    {
+        HermesUpstream* m_pUpstream;
+        unsigned m_sessionId;
+        StringView m_rawXml;
+        bool m_wasDispatched = false;
+
+        template<class DataT>
+        void On(const DataT& data)
+        {
+            m_wasDispatched = true;
+            m_pUpstream->Signal(m_sessionId, data, m_rawXml);
+        }
+    };
+}
+
 void SignalHermesUpstreamRawXml(HermesUpstream* pUpstream, uint32_t sessionId, HermesStringView rawXml)
 {
     pUpstream->m_service.Log(sessionId, "SignalHermesUpstreamRawXml");
@@ -591,18 +726,9 @@ void SignalHermesUpstreamRawXml(HermesUpstream* pUpstream, uint32_t sessionId, H
         MessageDispatcher dispatcher{sessionId, pUpstream->m_service};
         auto parseData = xmlData;
 
-        bool wasDispatched = false;
-        dispatcher.Add<ServiceDescriptionData>([&](const auto& data) { wasDispatched = true; pUpstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<MachineReadyData>([&](const auto& data) { wasDispatched = true; pUpstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<RevokeMachineReadyData>([&](const auto& data) { wasDispatched = true; pUpstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<StartTransportData>([&](const auto& data) { wasDispatched = true; pUpstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<StopTransportData>([&](const auto& data) { wasDispatched = true; pUpstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<QueryBoardInfoData>([&](const auto& data) { wasDispatched = true; pUpstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<NotificationData>([&](const auto& data) { wasDispatched = true; pUpstream->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<CheckAliveData>([&](const auto& data) { wasDispatched = true; pUpstream->Signal(sessionId, data, xmlData); });
-
-        dispatcher.Dispatch(parseData);
-        if (wasDispatched)
+        RawXmlHandler handler{pUpstream, sessionId, xmlData};
+        dispatcher.Dispatch<RawXmlMessageTypes>(parseData, handler);
+        if (handler.m_wasDispatched)
             return;
 
         pUpstream->Signal(sessionId, NotificationData{}, xmlData);
@@ -648,6 +774,5 @@ void DeleteHermesUpstream(HermesUpstream* pUpstream)
 
     pUpstream->m_service.Log(0U, "DeleteHermesUpstream");
 
-    pUpstream->m_service.Stop();
-    delete pUpstream;
+    Service::Delete(pUpstream);
 }
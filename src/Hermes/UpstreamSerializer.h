@@ -57,7 +57,7 @@ namespace Hermes
                 ~ISerializerCallback() = default;
             };
 
-            std::unique_ptr<ISerializer> CreateSerializer(unsigned sessionId, IAsioService&, IClientSocket&);
+            std::unique_ptr<ISerializer> CreateSerializer(unsigned sessionId, IAsioService&, IClientSocket&, EXmlParserMode);
         }
     }
 }
@@ -18,6 +18,7 @@ limitations under the License.
 #include "UpstreamSession.h"
 
 #include "Network.h"
+#include "ReconnectBackoff.h"
 #include "UpstreamSerializer.h"
 #include "UpstreamStateMachine.h"
 #include <HermesData.hpp>
@@ -126,9 +127,12 @@ namespace Hermes
                 socketConfig.m_port = configuration.m_port;
                 socketConfig.m_retryDelayInSeconds = configuration.m_reconnectWaitTimeInSeconds;
                 socketConfig.m_checkAlivePeriodInSeconds = configuration.m_checkAlivePeriodInSeconds;
+                socketConfig.m_sendQueueHighWaterMark = configuration.m_sendQueueHighWaterMark;
+                socketConfig.m_reconnectPolicy = ToReconnectPolicy(configuration);
+                socketConfig.m_socketOptions = configuration.m_socketOptions;
 
                 m_spImpl->m_upSocket = CreateClientSocket(id, socketConfig, service);
-                m_spImpl->m_upSerializer = CreateSerializer(id, service, *m_spImpl->m_upSocket);
+                m_spImpl->m_upSerializer = CreateSerializer(id, service, *m_spImpl->m_upSocket, configuration.m_xmlParserMode);
                 m_spImpl->m_upStateMachine = CreateStateMachine(id, service, *m_spImpl->m_upSerializer, configuration.m_checkState);
             }
 
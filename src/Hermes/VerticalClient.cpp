@@ -22,8 +22,10 @@ limitations under the License.
 #include "Service.h"
 #include "VerticalClientSession.h"
 #include "HermesChrono.hpp"
+#include "ReconnectBackoff.h"
 
 #include <cassert>
+#include <chrono>
 #include <memory>
 
 #include <Connection/VerticalClient.hpp>
@@ -139,12 +141,16 @@ struct VerticalClientCallbackHolder : CallbackHolder<IVerticalClientCallback, Ve
 
 struct HermesVerticalClient : ISessionCallback
 {
-    Service m_service;
-    asio::system_timer m_timer{ m_service.GetUnderlyingService() };
+    std::shared_ptr<Service> m_spService;
+    Service& m_service{ *m_spService };
+    asio::system_timer m_timer{ m_service.GetExecutor() };
     VerticalClientSettings m_settings;
 
     unsigned m_sessionId{ 0U };
     unsigned m_connectedSessionId{ 0U };
+    std::chrono::steady_clock::time_point m_disconnectedAt; // of the last connected session, reset when connected again
+    ReconnectBackoff m_backoff{0.0, ReconnectPolicy()}; // after sessions that closed before the peer described itself
+    bool m_reconnectedAtOnce{false}; // after the previous session, see m_reconnectAtOnceAfterClose
 
     VerticalClientCallbackHolder m_callbacks;
 
@@ -152,8 +158,8 @@ struct HermesVerticalClient : ISessionCallback
 
     bool m_enabled{ false };
 
-    HermesVerticalClient(VerticalClientCallbackHolder&& callbacks) :
-        m_service(*callbacks),
+    HermesVerticalClient(HermesServicePool* pPool, VerticalClientCallbackHolder&& callbacks) :
+        m_spService(std::make_shared<Service>(pPool, *callbacks)),
         m_callbacks { callbacks }
     {
         m_service.Inform(0U, "Created");
@@ -176,6 +182,8 @@ struct HermesVerticalClient : ISessionCallback
             ESeverity::eINFO, "ConfigurationChanged"));
 
         m_settings = settings;
+        m_backoff = ReconnectBackoff(m_settings.m_reconnectWaitTimeInSeconds, ToReconnectPolicy(m_settings));
+        m_reconnectedAtOnce = false;
         CreateNewSession_();
     }
 
@@ -218,8 +226,15 @@ struct HermesVerticalClient : ISessionCallback
         if (!pSession)
             return;
 
+        ConnectionInfo connectionInfo(in_data);
+        if (m_disconnectedAt != std::chrono::steady_clock::time_point())
+        {
+            connectionInfo.m_downtimeInSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_disconnectedAt).count();
+            m_disconnectedAt = std::chrono::steady_clock::time_point();
+        }
+
         m_connectedSessionId = pSession->Id();
-        m_callbacks->OnConnected(m_connectedSessionId, state, in_data);
+        m_callbacks->OnConnected(m_connectedSessionId, state, connectionInfo);
     }
 
     void On(unsigned sessionId, EVerticalState state, const SupervisoryServiceDescriptionData& in_data) override
@@ -317,13 +332,31 @@ struct HermesVerticalClient : ISessionCallback
         if (!pSession)
             return;
 
-        if (pSession->OptionalPeerServiceDescriptionData())
+        if (sessionId == m_connectedSessionId)
+        {
+            m_disconnectedAt = std::chrono::steady_clock::now();
+        }
+
+        // A peer closing an established connection cleanly is usually restarting, so we are back as soon as it is.
+        // Not twice in a row though, and not after a peer that closes before describing itself, e.g. one that refuses us.
+        bool established = pSession->OptionalPeerServiceDescriptionData();
+        if (m_settings.m_reconnectAtOnceAfterClose && !error && established && !m_reconnectedAtOnce)
+        {
+            m_reconnectedAtOnce = true;
+            DelayCreateNewSession_(0.0);
+        }
+        else if (established)
         {
+            m_reconnectedAtOnce = false;
+            m_backoff.Restart();
             DelayCreateNewSession_(1.0);
         }
         else
         {
-            DelayCreateNewSession_(m_settings.m_reconnectWaitTimeInSeconds);
+            m_reconnectedAtOnce = false;
+            auto waitTime = m_backoff.NextWaitTimeInSeconds();
+            m_service.Log(sessionId, "Reconnecting in ", waitTime, " seconds");
+            DelayCreateNewSession_(waitTime);
         }
 
         m_upSession.reset();
@@ -369,6 +402,7 @@ struct HermesVerticalClient : ISessionCallback
             return;
 
         m_connectedSessionId = 0U;
+        m_disconnectedAt = std::chrono::steady_clock::now();
         Error error;
         m_callbacks->OnDisconnected(sessionId, EVerticalState::eDISCONNECTED, error);
     }
@@ -404,24 +438,82 @@ struct HermesVerticalClient : ISessionCallback
         m_service.Log(0U, "DelayCreateNewSession_");
 
         m_timer.expires_after(Hermes::GetSeconds(delay));
-        m_timer.async_wait([this](const boost::system::error_code& ec)
+        m_timer.async_wait(m_service.Bind([this](const boost::system::error_code& ec)
         {
             if (ec) // timer cancelled or whatever
                 return;
             CreateNewSession_();
-        });
+        }));
     }
 };
 
 //===================== implementation of public C functions =====================
 HermesVerticalClient* Hermes::CreateHermesVerticalClient(IVerticalClientCallback& callback)
 {
-    return new HermesVerticalClient(VerticalClientCallbackHolder{ callback });
+    return new HermesVerticalClient(nullptr, VerticalClientCallbackHolder{ callback });
+}
+
+HermesVerticalClient* Hermes::CreateHermesVerticalClient(HermesServicePool* pPool, IVerticalClientCallback& callback)
+{
+    return new HermesVerticalClient(pPool, VerticalClientCallbackHolder{ callback });
+}
+
+namespace
+{
+    template<class DataT>
+    void PostSignal_(HermesVerticalClient* pVerticalClient, unsigned sessionId, DataT&& data)
+    {
+        pVerticalClient->m_service.Log(sessionId, "SignalHermesVerticalClient ", SerializationTraits<DataT>::cTAG_VIEW);
+        pVerticalClient->m_service.Post([pVerticalClient, sessionId, data = std::move(data)]()
+        {
+            pVerticalClient->Signal(sessionId, data, Serialize(data));
+        });
+    }
+}
+
+void Hermes::SignalHermesVerticalClient(HermesVerticalClient* pVerticalClient, unsigned sessionId, SupervisoryServiceDescriptionData&& data)
+{
+    PostSignal_(pVerticalClient, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalClient(HermesVerticalClient* pVerticalClient, unsigned sessionId, GetConfigurationData&& data)
+{
+    PostSignal_(pVerticalClient, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalClient(HermesVerticalClient* pVerticalClient, unsigned sessionId, SetConfigurationData&& data)
+{
+    PostSignal_(pVerticalClient, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalClient(HermesVerticalClient* pVerticalClient, unsigned sessionId, QueryHermesCapabilitiesData&& data)
+{
+    PostSignal_(pVerticalClient, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalClient(HermesVerticalClient* pVerticalClient, unsigned sessionId, SendWorkOrderInfoData&& data)
+{
+    PostSignal_(pVerticalClient, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalClient(HermesVerticalClient* pVerticalClient, unsigned sessionId, NotificationData&& data)
+{
+    PostSignal_(pVerticalClient, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalClient(HermesVerticalClient* pVerticalClient, unsigned sessionId, CheckAliveData&& data)
+{
+    PostSignal_(pVerticalClient, sessionId, std::move(data));
 }
 
 HermesVerticalClient* CreateHermesVerticalClient(const HermesVerticalClientCallbacks* pCallbacks)
 {
-    return new HermesVerticalClient(VerticalClientCallbackHolder{ *pCallbacks });
+    return new HermesVerticalClient(nullptr, VerticalClientCallbackHolder{ *pCallbacks });
+}
+
+HermesVerticalClient* CreateHermesVerticalClientOnPool(HermesServicePool* pPool, const HermesVerticalClientCallbacks* pCallbacks)
+{
+    return new HermesVerticalClient(pPool, VerticalClientCallbackHolder{ *pCallbacks });
 }
 
 void RunHermesVerticalClient(HermesVerticalClient* pVerticalClient)
@@ -456,6 +548,17 @@ void EnableHermesVerticalClient(HermesVerticalClient* pVerticalClient, const Her
     });
 }
 
+void SetHermesVerticalClientTraceFilter(HermesVerticalClient* pVerticalClient, const HermesTraceFilter* pFilter)
+{
+    pVerticalClient->m_service.SetTraceFilter(ToCpp(*pFilter));
+}
+
+void SetHermesVerticalClientBackgroundTrace(HermesVerticalClient* pVerticalClient, const HermesBackgroundTraceSettings* pSettings)
+{
+    pVerticalClient->m_service.Log(0U, "SetHermesVerticalClientBackgroundTrace");
+    pVerticalClient->m_service.StartBackgroundTrace(ToCpp(*pSettings));
+}
+
 void SignalHermesVerticalClientDescription(HermesVerticalClient* pVerticalClient, uint32_t sessionId, const HermesSupervisoryServiceDescriptionData* pData)
 {
     pVerticalClient->m_service.Log(sessionId, "SignalHermesVerticalClientDescription");
@@ -558,8 +661,29 @@ void DeleteHermesVerticalClient(HermesVerticalClient* pVerticalClient)
 
     pVerticalClient->m_service.Log(0U, "DeleteHermesVerticalClient");
 
-    pVerticalClient->m_service.Stop();
-    delete pVerticalClient;
+    Service::Delete(pVerticalClient);
+}
+
+namespace
+{
+    // the messages SignalHermesVerticalClientRawXml() recognizes, anything else is sent as a notification
+    using RawXmlMessageTypes = MessageTypes<SupervisoryServiceDescriptionData, SendWorkOrderInfoData,
+        GetConfigurationData, SetConfigurationData, NotificationData, CheckAliveData>;
+
+    struct RawXmlHandler
+    {
+        HermesVerticalClient* m_pVerticalClient;
+        unsigned m_sessionId;
+        StringView m_rawXml;
+        bool m_wasDispatched = false;
+
+        template<class DataT>
+        void On(const DataT& data)
+        {
+            m_wasDispatched = true;
+            m_pVerticalClient->Signal(m_sessionId, data, m_rawXml);
+        }
+    };
 }
 
 void SignalHermesVerticalClientRawXml(HermesVerticalClient* pVerticalClient, uint32_t sessionId, HermesStringView rawXml)
@@ -570,16 +694,9 @@ void SignalHermesVerticalClientRawXml(HermesVerticalClient* pVerticalClient, uin
         MessageDispatcher dispatcher{ sessionId, pVerticalClient->m_service };
         auto parseData = xmlData;
 
-        bool wasDispatched = false;
-        dispatcher.Add<SupervisoryServiceDescriptionData>([&](const auto& data) { wasDispatched = true; pVerticalClient->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<SendWorkOrderInfoData>([&](const auto& data) { wasDispatched = true; pVerticalClient->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<GetConfigurationData>([&](const auto& data) { wasDispatched = true; pVerticalClient->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<SetConfigurationData>([&](const auto& data) { wasDispatched = true; pVerticalClient->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<NotificationData>([&](const auto& data) { wasDispatched = true; pVerticalClient->Signal(sessionId, data, xmlData); });
-        dispatcher.Add<CheckAliveData>([&](const auto& data) { wasDispatched = true; pVerticalClient->Signal(sessionId, data, xmlData); });
-
-        dispatcher.Dispatch(parseData);
-        if (wasDispatched)
+        RawXmlHandler handler{pVerticalClient, sessionId, xmlData};
+        dispatcher.Dispatch<RawXmlMessageTypes>(parseData, handler);
+        if (handler.m_wasDispatched)
             return;
 
         pVerticalClient->Signal(sessionId, NotificationData{}, xmlData);
@@ -33,22 +33,14 @@ namespace Hermes
                 IAsioService& m_service;
                 IClientSocket& m_socket;
                 ISerializerCallback* m_pCallback = nullptr;
-                MessageDispatcher m_dispatcher{ m_sessionId, m_service };
+                MessageDispatcher m_dispatcher;
 
-                Serializer(unsigned sessionId, IAsioService& service, IClientSocket& socket) :
+                Serializer(unsigned sessionId, IAsioService& service, IClientSocket& socket, EXmlParserMode parserMode) :
                     m_sessionId(sessionId),
                     m_service(service),
-                    m_socket(socket)
+                    m_socket(socket),
+                    m_dispatcher(sessionId, service, parserMode)
                 {
-                    m_dispatcher.Add<SupervisoryServiceDescriptionData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<CheckAliveData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<NotificationData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<CurrentConfigurationData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<BoardArrivedData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<BoardDepartedData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<QueryWorkOrderInfoData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<ReplyWorkOrderInfoData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<SendHermesCapabilitiesData>([this](const auto& data) { m_pCallback->On(data); });
                 }
 
                 // ISocketCallback
@@ -57,9 +49,14 @@ namespace Hermes
                     m_pCallback->OnSocketConnected(connectionInfo);
                 }
 
+                StringSpan ReceiveBuffer(std::size_t size) override
+                {
+                    return m_dispatcher.ReceiveBuffer(size);
+                }
+
                 void OnReceived(StringSpan xmlData) override
                 {
-                    auto error = m_dispatcher.Dispatch(xmlData);
+                    auto error = m_dispatcher.Dispatch<VerticalClientMessageTypes>(xmlData, *m_pCallback);
                     if (!error)
                         return;
 
@@ -96,9 +93,9 @@ namespace Hermes
         }
 
         std::unique_ptr<VerticalClient::ISerializer> VerticalClient::CreateSerializer(unsigned sessionId, IAsioService& service,
-            IClientSocket& socket)
+            IClientSocket& socket, EXmlParserMode parserMode)
         {
-            return std::make_unique<VerticalClient::Serializer>(sessionId, service, socket);
+            return std::make_unique<VerticalClient::Serializer>(sessionId, service, socket, parserMode);
         }
     }
 }
@@ -59,7 +59,7 @@ namespace Hermes
             };
 
             std::unique_ptr<ISerializer> CreateSerializer(unsigned sessionId,
-                IAsioService&, IClientSocket&);
+                IAsioService&, IClientSocket&, EXmlParserMode);
         }
     }
 }
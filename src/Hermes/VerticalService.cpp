@@ -19,10 +19,13 @@ limitations under the License.
 #include <HermesData.hpp>
 
 #include "ApiCallback.h"
+#include "MessageSerialization.h"
 #include "VerticalServiceSession.h"
 #include "Network.h"
 #include "Service.h"
 
+#include <boost/variant.hpp>
+
 #include <algorithm>
 #include <map>
 #include <memory>
@@ -34,6 +37,24 @@ limitations under the License.
 using namespace Hermes;
 using namespace Hermes::Implementation::VerticalService;
 
+namespace
+{
+    // the messages of SignalHermesVerticalServiceMessages(), the tracking data first
+    using VerticalServiceMessage = boost::variant<BoardArrivedData, BoardDepartedData, QueryWorkOrderInfoData,
+        ReplyWorkOrderInfoData, SendHermesCapabilitiesData, CurrentConfigurationData, NotificationData, CheckAliveData>;
+
+    bool IsTrackingData_(const VerticalServiceMessage& message)
+    {
+        return message.which() < 2;
+    }
+
+    template<class CDataT>
+    auto ToCppMessage_(const HermesVerticalServiceMessage& message)
+    {
+        return ToCpp(*static_cast<const CDataT*>(message.m_pData));
+    }
+}
+
 struct VerticalServiceCallbackAdapter : IVerticalServiceCallback
 {
     VerticalServiceCallbackAdapter(const HermesVerticalServiceCallbacks& callbacks) :
@@ -130,7 +151,8 @@ struct VerticalServiceCallbackHolder : CallbackHolder<IVerticalServiceCallback,
 
 struct HermesVerticalService : IAcceptorCallback, ISessionCallback
 {
-    Service m_service;
+    std::shared_ptr<Service> m_spService;
+    Service& m_service{ *m_spService };
     VerticalServiceSettings m_settings;
 
     // we only hold on to the accepting session
@@ -141,8 +163,12 @@ struct HermesVerticalService : IAcceptorCallback, ISessionCallback
 
     bool m_enabled{ false };
 
-    HermesVerticalService(VerticalServiceCallbackHolder&& callbacks) :
-        m_service(*callbacks),
+    // for serializing batches of messages, reused:
+    std::string m_messagesXml;
+    std::string m_messageXml;
+
+    HermesVerticalService(HermesServicePool* pPool, VerticalServiceCallbackHolder&& callbacks) :
+        m_spService(std::make_shared<Service>(pPool, *callbacks)),
         m_callbacks{callbacks}
     {
         m_service.Inform(0U, "Created");
@@ -171,6 +197,8 @@ struct HermesVerticalService : IAcceptorCallback, ISessionCallback
         networkConfiguration.m_port = settings.m_port ? settings.m_port : cCONFIG_PORT;
         networkConfiguration.m_retryDelayInSeconds = settings.m_reconnectWaitTimeInSeconds;
         networkConfiguration.m_checkAlivePeriodInSeconds = settings.m_checkAlivePeriodInSeconds;
+        networkConfiguration.m_sendQueueHighWaterMark = settings.m_sendQueueHighWaterMark;
+        networkConfiguration.m_socketOptions = settings.m_socketOptions;
 
         m_upAcceptor->StartListening(networkConfiguration);
     }
@@ -257,13 +285,61 @@ struct HermesVerticalService : IAcceptorCallback, ISessionCallback
         for (auto& entry : m_sessionMap)
         {
             auto& session = entry.second;
-            if (!session.OptionalPeerServiceDescriptionData() ||
-                !session.OptionalPeerServiceDescriptionData()->m_supportedFeatures.m_optionalFeatureBoardTracking)
+            if (!TracksBoards_(session))
                 continue;
             session.Signal(data);
         }
     }
 
+    static bool TracksBoards_(const Session& session)
+    {
+        return session.OptionalPeerServiceDescriptionData() &&
+            session.OptionalPeerServiceDescriptionData()->m_supportedFeatures.m_optionalFeatureBoardTracking;
+    }
+
+    // all the messages serialized into one buffer, so that the socket writes them at once
+    void SignalMessages_(unsigned sessionId, const std::vector<VerticalServiceMessage>& messages)
+    {
+        m_service.Log(sessionId, "Signal(", messages.size(), " messages)");
+
+        std::size_t dropped = 0U;
+        m_messagesXml.clear();
+        for (const auto& message : messages)
+        {
+            if (sessionId == 0U && !IsTrackingData_(message))
+            {
+                ++dropped;
+                continue;
+            }
+            boost::apply_visitor([this](const auto& data) { Serialize(data, m_messageXml); }, message);
+            m_messagesXml += m_messageXml;
+        }
+        if (dropped)
+        {
+            m_service.Warn(sessionId, "Only BoardArrived and BoardDeparted go to all clients, dropped ", dropped, " messages");
+        }
+        if (m_messagesXml.empty())
+            return;
+
+        if (sessionId != 0U)
+        {
+            auto* pSession = Session_(sessionId);
+            if (!pSession)
+                return m_service.Log(sessionId, "No matching session to signal to");
+
+            pSession->SignalSerialized(m_messagesXml);
+            return;
+        }
+
+        for (auto& entry : m_sessionMap)
+        {
+            auto& session = entry.second;
+            if (!TracksBoards_(session))
+                continue;
+            session.SignalSerialized(m_messagesXml);
+        }
+    }
+
     //================= IAcceptorCallback =========================
     void OnAccepted(std::unique_ptr<IServerSocket>&& upSocket) override
     {
@@ -376,12 +452,98 @@ struct HermesVerticalService : IAcceptorCallback, ISessionCallback
 
 HermesVerticalService* CreateHermesVerticalService(const HermesVerticalServiceCallbacks* pCallbacks)
 {
-    return new HermesVerticalService(VerticalServiceCallbackHolder{*pCallbacks});
+    return new HermesVerticalService(nullptr, VerticalServiceCallbackHolder{*pCallbacks});
+}
+
+HermesVerticalService* CreateHermesVerticalServiceOnPool(HermesServicePool* pPool, const HermesVerticalServiceCallbacks* pCallbacks)
+{
+    return new HermesVerticalService(pPool, VerticalServiceCallbackHolder{*pCallbacks});
 }
 
 HermesVerticalService* Hermes::CreateHermesVerticalService(IVerticalServiceCallback& callbacks)
 {
-    return new HermesVerticalService(VerticalServiceCallbackHolder{ callbacks });
+    return new HermesVerticalService(nullptr, VerticalServiceCallbackHolder{ callbacks });
+}
+
+HermesVerticalService* Hermes::CreateHermesVerticalService(HermesServicePool* pPool, IVerticalServiceCallback& callbacks)
+{
+    return new HermesVerticalService(pPool, VerticalServiceCallbackHolder{ callbacks });
+}
+
+namespace
+{
+    template<class DataT>
+    void PostSignal_(HermesVerticalService* pVerticalService, unsigned sessionId, DataT&& data)
+    {
+        pVerticalService->m_service.Log(sessionId, "SignalHermesVerticalService ", SerializationTraits<DataT>::cTAG_VIEW);
+        pVerticalService->m_service.Post([pVerticalService, sessionId, data = std::move(data)]()
+        {
+            pVerticalService->Signal_(sessionId, data);
+        });
+    }
+
+    // with sessionId == 0, to all clients that have specified FeatureBoardTracking
+    template<class DataT>
+    void PostTrackingData_(HermesVerticalService* pVerticalService, unsigned sessionId, DataT&& data)
+    {
+        pVerticalService->m_service.Log(sessionId, "SignalHermesVerticalService ", SerializationTraits<DataT>::cTAG_VIEW);
+        pVerticalService->m_service.Post([pVerticalService, sessionId, data = std::move(data)]()
+        {
+            if (sessionId == 0U)
+            {
+                pVerticalService->SignalTrackingData_(data);
+            }
+            else
+            {
+                pVerticalService->Signal_(sessionId, data);
+            }
+        });
+    }
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, SupervisoryServiceDescriptionData&& data)
+{
+    PostSignal_(pVerticalService, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, BoardArrivedData&& data)
+{
+    PostTrackingData_(pVerticalService, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, BoardDepartedData&& data)
+{
+    PostTrackingData_(pVerticalService, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, QueryWorkOrderInfoData&& data)
+{
+    PostSignal_(pVerticalService, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, ReplyWorkOrderInfoData&& data)
+{
+    PostSignal_(pVerticalService, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, SendHermesCapabilitiesData&& data)
+{
+    PostSignal_(pVerticalService, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, CurrentConfigurationData&& data)
+{
+    PostSignal_(pVerticalService, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, NotificationData&& data)
+{
+    PostSignal_(pVerticalService, sessionId, std::move(data));
+}
+
+void Hermes::SignalHermesVerticalService(HermesVerticalService* pVerticalService, unsigned sessionId, CheckAliveData&& data)
+{
+    PostSignal_(pVerticalService, sessionId, std::move(data));
 }
 
 void RunHermesVerticalService(HermesVerticalService* pVerticalService)
@@ -413,6 +575,17 @@ void EnableHermesVerticalService(HermesVerticalService* pVerticalService,
     });
 }
 
+void SetHermesVerticalServiceTraceFilter(HermesVerticalService* pVerticalService, const HermesTraceFilter* pFilter)
+{
+    pVerticalService->m_service.SetTraceFilter(ToCpp(*pFilter));
+}
+
+void SetHermesVerticalServiceBackgroundTrace(HermesVerticalService* pVerticalService, const HermesBackgroundTraceSettings* pSettings)
+{
+    pVerticalService->m_service.Log(0U, "SetHermesVerticalServiceBackgroundTrace");
+    pVerticalService->m_service.StartBackgroundTrace(ToCpp(*pSettings));
+}
+
 void SignalHermesVerticalServiceDescription(HermesVerticalService* pVerticalService, uint32_t sessionId,
     const HermesSupervisoryServiceDescriptionData* pData)
 {
@@ -457,6 +630,54 @@ void SignalHermesBoardDeparted(HermesVerticalService* pVerticalService, uint32_t
     });
 }
 
+void SignalHermesVerticalServiceMessages(HermesVerticalService* pVerticalService, uint32_t sessionId,
+    const HermesVerticalServiceMessage* pMessages, uint32_t messageCount)
+{
+    pVerticalService->m_service.Log(sessionId, "SignalHermesVerticalServiceMessages, messageCount=", messageCount);
+
+    // converted here, but posted just once
+    std::vector<VerticalServiceMessage> messages;
+    messages.reserve(messageCount);
+    for (uint32_t i = 0U; i < messageCount; ++i)
+    {
+        const auto& message = pMessages[i];
+        switch (message.m_type)
+        {
+        case eHERMES_VERTICAL_SERVICE_MESSAGE_BOARD_ARRIVED:
+            messages.emplace_back(ToCppMessage_<HermesBoardArrivedData>(message));
+            break;
+        case eHERMES_VERTICAL_SERVICE_MESSAGE_BOARD_DEPARTED:
+            messages.emplace_back(ToCppMessage_<HermesBoardDepartedData>(message));
+            break;
+        case eHERMES_VERTICAL_SERVICE_MESSAGE_QUERY_WORK_ORDER_INFO:
+            messages.emplace_back(ToCppMessage_<HermesQueryWorkOrderInfoData>(message));
+            break;
+        case eHERMES_VERTICAL_SERVICE_MESSAGE_REPLY_WORK_ORDER_INFO:
+            messages.emplace_back(ToCppMessage_<HermesReplyWorkOrderInfoData>(message));
+            break;
+        case eHERMES_VERTICAL_SERVICE_MESSAGE_SEND_HERMES_CAPABILITIES:
+            messages.emplace_back(ToCppMessage_<HermesSendHermesCapabilitiesData>(message));
+            break;
+        case eHERMES_VERTICAL_SERVICE_MESSAGE_CURRENT_CONFIGURATION:
+            messages.emplace_back(ToCppMessage_<HermesCurrentConfigurationData>(message));
+            break;
+        case eHERMES_VERTICAL_SERVICE_MESSAGE_NOTIFICATION:
+            messages.emplace_back(ToCppMessage_<HermesNotificationData>(message));
+            break;
+        case eHERMES_VERTICAL_SERVICE_MESSAGE_CHECK_ALIVE:
+            messages.emplace_back(ToCppMessage_<HermesCheckAliveData>(message));
+            break;
+        default:
+            pVerticalService->m_service.Warn(sessionId, "Unknown message type ", static_cast<int>(message.m_type));
+        }
+    }
+
+    pVerticalService->m_service.Post([pVerticalService, sessionId, messages = std::move(messages)]()
+    {
+        pVerticalService->SignalMessages_(sessionId, messages);
+    });
+}
+
 void SignalHermesSendHermesCapabilities(HermesVerticalService* pVerticalService, uint32_t sessionId,
     const HermesSendHermesCapabilitiesData* pData)
 {
@@ -571,6 +792,5 @@ void DeleteHermesVerticalService(HermesVerticalService* pVerticalService)
 {
     pVerticalService->m_service.Log(0U, "DeleteHermesVerticalService");
 
-    pVerticalService->m_service.Stop();
-    delete pVerticalService;
+    Service::Delete(pVerticalService);
 }
@@ -33,20 +33,14 @@ namespace Hermes
                 IAsioService& m_service;
                 IServerSocket& m_socket;
                 ISerializerCallback* m_pCallback = nullptr;
-                MessageDispatcher m_dispatcher{ m_sessionId, m_service };
+                MessageDispatcher m_dispatcher;
 
-                Serializer(unsigned sessionId, IAsioService& service, IServerSocket& socket) :
+                Serializer(unsigned sessionId, IAsioService& service, IServerSocket& socket, EXmlParserMode parserMode) :
                     m_sessionId(sessionId),
                     m_service(service),
-                    m_socket(socket)
+                    m_socket(socket),
+                    m_dispatcher(sessionId, service, parserMode)
                 {
-                    m_dispatcher.Add<SupervisoryServiceDescriptionData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<CheckAliveData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<NotificationData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<GetConfigurationData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<SetConfigurationData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<SendWorkOrderInfoData>([this](const auto& data) { m_pCallback->On(data); });
-                    m_dispatcher.Add<QueryHermesCapabilitiesData>([this](const auto& data) { m_pCallback->On(data); });
                 }
 
                 // ISocketCallback
@@ -55,9 +49,14 @@ namespace Hermes
                     m_pCallback->OnSocketConnected(connectionInfo);
                 }
 
+                StringSpan ReceiveBuffer(std::size_t size) override
+                {
+                    return m_dispatcher.ReceiveBuffer(size);
+                }
+
                 void OnReceived(StringSpan xmlData) override
                 {
-                    auto error = m_dispatcher.Dispatch(xmlData);
+                    auto error = m_dispatcher.Dispatch<VerticalServiceMessageTypes>(xmlData, *m_pCallback);
                     if (!error)
                         return;
 
@@ -92,9 +91,9 @@ namespace Hermes
                 }
             };
             std::unique_ptr<ISerializer> CreateSerializer(unsigned sessionId, IAsioService& service,
-                IServerSocket& socket)
+                IServerSocket& socket, EXmlParserMode parserMode)
             {
-                return std::make_unique<Serializer>(sessionId, service, socket);
+                return std::make_unique<Serializer>(sessionId, service, socket, parserMode);
             }
         }
 
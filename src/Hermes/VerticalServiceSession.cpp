@@ -186,7 +186,7 @@ namespace Hermes
             {
                 auto sessionId = upSocket->SessionId();
                 m_spImpl = std::make_shared<Impl>(std::move(upSocket), service, configuration);
-                m_spImpl->m_upSerializer = CreateSerializer(sessionId, service, *m_spImpl->m_upSocket);
+                m_spImpl->m_upSerializer = CreateSerializer(sessionId, service, *m_spImpl->m_upSocket, configuration.m_xmlParserMode);
             }
 
             Session::~Session()
@@ -235,6 +235,7 @@ namespace Hermes
             void Session::Signal(const NotificationData& data) { m_spImpl->Signal_(Serialize(data)); }
             void Session::Signal(const CheckAliveData& data) { m_spImpl->Signal_(Serialize(data)); }
             void Session::Signal(const SendHermesCapabilitiesData& data) { m_spImpl->Signal_(Serialize(data)); }
+            void Session::SignalSerialized(StringView xml) { m_spImpl->Signal_(xml); }
 
             void Session::Disconnect()
             {
@@ -55,6 +55,7 @@ namespace Hermes
                 void Signal(const NotificationData&);
                 void Signal(const CheckAliveData&);
                 void Signal(const SendHermesCapabilitiesData&);
+                void SignalSerialized(StringView xml); // one or more messages, as serialized by Serialize()
                 void Disconnect();
 
             private:
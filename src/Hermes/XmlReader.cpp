@@ -0,0 +1,374 @@
+#include "stdafx.h"
+
+#include "XmlReader.h"
+
+#include "StringSearch.h"
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+    bool IsSpace_(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    bool IsNameEnd_(char c)
+    {
+        return IsSpace_(c) || c == '>' || c == '/' || c == '=' || c == '<';
+    }
+
+    char* SkipSpace_(char* p, const char* pEnd)
+    {
+        while (p < pEnd && IsSpace_(*p))
+        {
+            ++p;
+        }
+        return p;
+    }
+
+    bool StartsWith_(const char* p, const char* pEnd, const char* prefix, std::size_t prefixSize)
+    {
+        return static_cast<std::size_t>(pEnd - p) >= prefixSize && std::memcmp(p, prefix, prefixSize) == 0;
+    }
+
+    char* Find_(char* p, const char* pEnd, const char* what, std::size_t whatSize)
+    {
+        std::size_t index = Hermes::Search::FindString(p, static_cast<std::size_t>(pEnd - p), what, whatSize);
+        return index == Hermes::Search::cNPOS ? nullptr : p + index;
+    }
+
+    char* WriteUtf8_(char* pOut, unsigned long code)
+    {
+        if (code < 0x80)
+        {
+            *pOut++ = static_cast<char>(code);
+        }
+        else if (code < 0x800)
+        {
+            *pOut++ = static_cast<char>(0xC0 | (code >> 6));
+            *pOut++ = static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000)
+        {
+            *pOut++ = static_cast<char>(0xE0 | (code >> 12));
+            *pOut++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            *pOut++ = static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            *pOut++ = static_cast<char>(0xF0 | (code >> 18));
+            *pOut++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            *pOut++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            *pOut++ = static_cast<char>(0x80 | (code & 0x3F));
+        }
+        return pOut;
+    }
+
+    // Decodes the entity at p (pointing to '&') into pOut, the way pugixml does: unknown or malformed
+    // references are kept as they are. Returns false in that case.
+    bool DecodeEntity_(char*& p, const char* pEnd, char*& pOut)
+    {
+        struct Entity { const char* m_text; std::size_t m_size; char m_char; };
+        static const Entity cENTITIES[] = {{"&lt;", 4U, '<'}, {"&gt;", 4U, '>'}, {"&amp;", 5U, '&'},
+            {"&apos;", 6U, '\''}, {"&quot;", 6U, '"'}};
+        for (const auto& entity : cENTITIES)
+        {
+            if (StartsWith_(p, pEnd, entity.m_text, entity.m_size))
+            {
+                *pOut++ = entity.m_char;
+                p += entity.m_size;
+                return true;
+            }
+        }
+
+        if (!StartsWith_(p, pEnd, "&#", 2U))
+            return false;
+
+        const char* pDigit = p + 2;
+        bool hex = pDigit < pEnd && *pDigit == 'x';
+        pDigit += hex ? 1 : 0;
+        const char* pFirstDigit = pDigit;
+        unsigned long code = 0U;
+        for (; pDigit < pEnd; ++pDigit)
+        {
+            unsigned digit = static_cast<unsigned>(*pDigit - '0');
+            if (hex && digit >= 10U)
+            {
+                digit = static_cast<unsigned>((*pDigit | ' ') - 'a');
+                digit = digit < 6U ? digit + 10U : 16U;
+            }
+            if (digit >= (hex ? 16U : 10U))
+                break;
+            code = (code * (hex ? 16U : 10U) + digit) & 0x1FFFFFU;
+        }
+        if (pDigit == pFirstDigit || pDigit == pEnd || *pDigit != ';')
+            return false;
+
+        pOut = WriteUtf8_(pOut, code);
+        p = const_cast<char*>(pDigit) + 1;
+        return true;
+    }
+}
+
+namespace Hermes
+{
+    void XmlReader::Reset(StringSpan xml)
+    {
+        m_pBegin = xml.data();
+        m_pPos = m_pBegin;
+        m_pEnd = m_pBegin + xml.size();
+        m_name = StringView{};
+        m_attributes.clear();
+        m_openElements.clear();
+        m_emptyElement = false;
+        m_skippedText = false;
+        m_error = Error{};
+    }
+
+    XmlReader::EToken XmlReader::Next()
+    {
+        if (m_error)
+            return EToken::eERROR;
+
+        if (m_emptyElement)
+        {
+            m_emptyElement = false;
+            return EToken::eEND_ELEMENT;
+        }
+
+        m_skippedText = false;
+        for (;;)
+        {
+            // text content is of no interest:
+            std::size_t index = Search::FindChar(m_pPos, static_cast<std::size_t>(m_pEnd - m_pPos), '<');
+            if (index == Search::cNPOS)
+            {
+                m_pPos = m_pEnd;
+                if (!m_openElements.empty())
+                    return Fail_("Start-end tags mismatch", m_pEnd);
+                return EToken::eEND_OF_DATA;
+            }
+
+            char* p = m_pPos + index;
+            if (!m_skippedText && !m_openElements.empty())
+            {
+                m_skippedText = SkipSpace_(m_pPos, p) != p;
+            }
+            if (p + 1 == m_pEnd)
+                return Fail_("Error parsing start element tag", p + 1);
+
+            switch (p[1])
+            {
+            case '/':
+                return EndElement_(p + 2);
+
+            case '?':
+            {
+                char* pEndOfPi = Find_(p + 2, m_pEnd, "?>", 2U);
+                if (!pEndOfPi)
+                    return Fail_("Error parsing document declaration/processing instruction", m_pEnd);
+                m_pPos = pEndOfPi + 2;
+                break;
+            }
+
+            case '!':
+            {
+                char* pEndOfTag = nullptr;
+                if (StartsWith_(p, m_pEnd, "<!--", 4U))
+                {
+                    pEndOfTag = Find_(p + 4, m_pEnd, "-->", 3U);
+                    if (!pEndOfTag)
+                        return Fail_("Error parsing comment", m_pEnd);
+                    m_pPos = pEndOfTag + 3;
+                }
+                else if (StartsWith_(p, m_pEnd, "<![CDATA[", 9U))
+                {
+                    pEndOfTag = Find_(p + 9, m_pEnd, "]]>", 3U);
+                    if (!pEndOfTag)
+                        return Fail_("Error parsing CDATA section", m_pEnd);
+                    m_pPos = pEndOfTag + 3;
+                    m_skippedText = true;
+                }
+                else if (StartsWith_(p, m_pEnd, "<!DOCTYPE", 9U))
+                {
+                    pEndOfTag = Find_(p + 9, m_pEnd, ">", 1U);
+                    if (!pEndOfTag)
+                        return Fail_("Error parsing document type declaration", m_pEnd);
+                    m_pPos = pEndOfTag + 1;
+                }
+                else
+                    return Fail_("Unrecognized tag", p + 1);
+                break;
+            }
+
+            default:
+                return StartElement_(p + 1);
+            }
+        }
+    }
+
+    XmlReader::EToken XmlReader::SkipElement()
+    {
+        std::size_t depth = m_openElements.size();
+        if (m_emptyElement)
+            return Next();
+
+        for (;;)
+        {
+            auto token = Next();
+            if (token == EToken::eEND_ELEMENT && m_openElements.size() < depth)
+                return token;
+            if (token == EToken::eERROR || token == EToken::eEND_OF_DATA)
+                return token;
+        }
+    }
+
+    Error XmlReader::Finish()
+    {
+        for (auto token = Next(); token != EToken::eEND_OF_DATA; token = Next())
+        {
+            if (token == EToken::eERROR)
+                return m_error;
+        }
+        return{};
+    }
+
+    XmlReader::EToken XmlReader::Fail_(const char* description, const char* pWhere)
+    {
+        m_error = Error{EErrorCode::eCLIENT_ERROR,
+            std::string(description) + " at offset " + std::to_string(pWhere - m_pBegin)};
+        return EToken::eERROR;
+    }
+
+    XmlReader::EToken XmlReader::StartElement_(char* p)
+    {
+        char* pName = p;
+        while (p < m_pEnd && !IsNameEnd_(*p))
+        {
+            ++p;
+        }
+        if (p == pName || p == m_pEnd)
+            return Fail_("Error parsing start element tag", p);
+        m_name = StringView{pName, static_cast<std::size_t>(p - pName)};
+        m_attributes.clear();
+
+        for (;;)
+        {
+            char* pAfterValue = p;
+            p = SkipSpace_(p, m_pEnd);
+            if (p == m_pEnd)
+                return Fail_("Error parsing start element tag", p);
+
+            if (*p == '>')
+            {
+                pName[m_name.size()] = '\0'; // the tag is done with, so this is free
+                m_pPos = p + 1;
+                m_openElements.push_back(m_name);
+                return EToken::eSTART_ELEMENT;
+            }
+            if (*p == '/')
+            {
+                if (p + 1 == m_pEnd || p[1] != '>')
+                    return Fail_("Error parsing start element tag", p + 1);
+                pName[m_name.size()] = '\0';
+                m_pPos = p + 2;
+                m_emptyElement = true;
+                return EToken::eSTART_ELEMENT;
+            }
+            // attributes must be separated by whitespace:
+            if (p == pAfterValue && !m_attributes.empty())
+                return Fail_("Error parsing element attribute", p);
+
+            char* pAttributeName = p;
+            while (p < m_pEnd && !IsNameEnd_(*p))
+            {
+                ++p;
+            }
+            if (p == pAttributeName)
+                return Fail_("Error parsing element attribute", p);
+            StringView attributeName{pAttributeName, static_cast<std::size_t>(p - pAttributeName)};
+
+            p = SkipSpace_(p, m_pEnd);
+            if (p == m_pEnd || *p != '=')
+                return Fail_("Error parsing element attribute", p);
+            p = SkipSpace_(p + 1, m_pEnd);
+            if (p == m_pEnd || (*p != '"' && *p != '\''))
+                return Fail_("Error parsing element attribute", p);
+
+            StringView value;
+            char quote = *p++;
+            if (!ParseAttributeValue_(p, quote, value))
+                return EToken::eERROR;
+            m_attributes.push_back(Attribute{attributeName, value});
+        }
+    }
+
+    XmlReader::EToken XmlReader::EndElement_(char* p)
+    {
+        char* pName = p;
+        while (p < m_pEnd && !IsNameEnd_(*p))
+        {
+            ++p;
+        }
+        StringView name{pName, static_cast<std::size_t>(p - pName)};
+        if (m_openElements.empty() || m_openElements.back() != name)
+            return Fail_("Start-end tags mismatch", pName);
+
+        p = SkipSpace_(p, m_pEnd);
+        if (p == m_pEnd || *p != '>')
+            return Fail_("Error parsing end element tag", p);
+
+        m_pPos = p + 1;
+        m_openElements.pop_back();
+        return EToken::eEND_ELEMENT;
+    }
+
+    bool XmlReader::ParseAttributeValue_(char*& p, char quote, StringView& value)
+    {
+        // unescaping only ever shrinks the value, so it is written to where it came from:
+        char* pValue = p;
+        char* pOut = p;
+        for (;;)
+        {
+            if (p == m_pEnd)
+            {
+                Fail_("Error parsing element attribute", p);
+                return false;
+            }
+
+            char c = *p;
+            if (c == quote)
+                break;
+
+            switch (c)
+            {
+            case '&':
+                if (DecodeEntity_(p, m_pEnd, pOut))
+                    continue;
+                *pOut++ = *p++;
+                break;
+
+            case '\r':
+                *pOut++ = ' ';
+                p += (p + 1 < m_pEnd && p[1] == '\n') ? 2 : 1;
+                break;
+
+            case '\t':
+            case '\n':
+                *pOut++ = ' ';
+                ++p;
+                break;
+
+            default:
+                *pOut++ = *p++;
+            }
+        }
+
+        value = StringView{pValue, static_cast<std::size_t>(pOut - pValue)};
+        *pOut = '\0'; // at most overwrites the closing quote
+        ++p;
+        return true;
+    }
+}
@@ -0,0 +1,64 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include "StringSpan.h"
+
+#include <HermesData.hpp>
+
+#include <vector>
+
+namespace Hermes
+{
+    // Pull parser for the received messages, as an alternative to loading them into a pugixml document.
+    // The message is decoded in place, with the same conventions as pugi::parse_default: attribute values get
+    // unescaped, their whitespace converted to blanks and, like the element names, they are zero terminated.
+    // So the buffer must not change while names and values are in use.
+    // Text, comments, processing instructions and the like are skipped.
+    class XmlReader
+    {
+    public:
+        enum class EToken
+        {
+            eSTART_ELEMENT,
+            eEND_ELEMENT,
+            eEND_OF_DATA,
+            eERROR
+        };
+
+        struct Attribute
+        {
+            StringView m_name;
+            StringView m_value;
+        };
+
+        void Reset(StringSpan xml);
+
+        EToken Next();
+        // skips the rest of the element that has just been started, including its end tag
+        EToken SkipElement();
+        // checks that the rest of the message is well formed
+        Error Finish();
+
+        // the element and its attributes, valid after Next() has returned eSTART_ELEMENT
+        StringView Name() const { return m_name; }
+        const std::vector<Attribute>& Attributes() const { return m_attributes; }
+        // whether the last call of Next() has passed text or CDATA inside an element, which pugixml would keep as a node
+        bool SkippedText() const { return m_skippedText; }
+
+    private:
+        EToken Fail_(const char* description, const char* pWhere);
+        EToken StartElement_(char* p);
+        EToken EndElement_(char* p);
+        bool ParseAttributeValue_(char*& p, char quote, StringView& value);
+
+        char* m_pBegin = nullptr;
+        char* m_pPos = nullptr;
+        char* m_pEnd = nullptr;
+        StringView m_name;
+        std::vector<Attribute> m_attributes;
+        std::vector<StringView> m_openElements;
+        bool m_emptyElement = false; // <Name/>: the end is reported on the next call
+        bool m_skippedText = false;
+        Error m_error;
+    };
+}
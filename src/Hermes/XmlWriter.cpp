@@ -0,0 +1,144 @@
+#include "stdafx.h"
+
+#include "XmlWriter.h"
+
+#include "NumericCodec.h"
+
+#include <cassert>
+
+namespace
+{
+    // the characters pugixml escapes in attribute values (enclosed in double quotes)
+    bool NeedsEscape_(unsigned char c)
+    {
+        return c < 32U || c == '&' || c == '<' || c == '"';
+    }
+}
+
+namespace Hermes
+{
+    XmlWriter::XmlWriter(std::string& xml, EXmlFormat format) :
+        m_xml(xml),
+        m_format(format)
+    {
+        m_xml.clear();
+    }
+
+    void XmlWriter::StartElement(StringView name)
+    {
+        assert(m_depth < cMAX_DEPTH);
+        CloseStartTag_();
+        Indent_();
+        m_xml += '<';
+        m_xml.append(name.data(), name.size());
+        m_openElements[m_depth++] = name;
+        m_startTagOpen = true;
+    }
+
+    void XmlWriter::Attribute(StringView name, StringView value)
+    {
+        assert(m_startTagOpen);
+        m_xml += ' ';
+        m_xml.append(name.data(), name.size());
+        m_xml += "=\"";
+        AppendEscaped_(value);
+        m_xml += '"';
+    }
+
+    void XmlWriter::Attribute(StringView name, int value)
+    {
+        char buffer[NumericCodec::cMAX_SIZE];
+        Attribute(name, StringView{buffer, static_cast<std::size_t>(NumericCodec::Format(buffer, value) - buffer)});
+    }
+
+    void XmlWriter::Attribute(StringView name, unsigned value)
+    {
+        char buffer[NumericCodec::cMAX_SIZE];
+        Attribute(name, StringView{buffer, static_cast<std::size_t>(NumericCodec::Format(buffer, value) - buffer)});
+    }
+
+    void XmlWriter::Attribute(StringView name, double value)
+    {
+        char buffer[NumericCodec::cMAX_SIZE];
+        Attribute(name, StringView{buffer, static_cast<std::size_t>(NumericCodec::Format(buffer, value) - buffer)});
+    }
+
+    void XmlWriter::EndElement()
+    {
+        assert(m_depth > 0U);
+        StringView name = m_openElements[--m_depth];
+        if (m_startTagOpen)
+        {
+            m_xml += m_format == EXmlFormat::eINDENTED ? " />\n" : "/>";
+            m_startTagOpen = false;
+            return;
+        }
+
+        Indent_();
+        m_xml += "</";
+        m_xml.append(name.data(), name.size());
+        m_xml += '>';
+        if (m_format == EXmlFormat::eINDENTED)
+        {
+            m_xml += '\n';
+        }
+    }
+
+    void XmlWriter::CloseStartTag_()
+    {
+        if (!m_startTagOpen)
+            return;
+        m_xml += '>';
+        if (m_format == EXmlFormat::eINDENTED)
+        {
+            m_xml += '\n';
+        }
+        m_startTagOpen = false;
+    }
+
+    void XmlWriter::Indent_()
+    {
+        if (m_format == EXmlFormat::eINDENTED)
+        {
+            m_xml.append(m_depth, ' ');
+        }
+    }
+
+    void XmlWriter::AppendEscaped_(StringView value)
+    {
+        const char* p = value.data();
+        const char* pEnd = p + value.size();
+        while (p < pEnd)
+        {
+            const char* pPlain = p;
+            while (p < pEnd && !NeedsEscape_(static_cast<unsigned char>(*p)))
+            {
+                ++p;
+            }
+            m_xml.append(pPlain, static_cast<std::size_t>(p - pPlain));
+            if (p == pEnd)
+                return;
+
+            unsigned char c = static_cast<unsigned char>(*p++);
+            switch (c)
+            {
+            case '\0':
+                return; // pugixml takes the value as a C string
+            case '&':
+                m_xml += "&amp;";
+                break;
+            case '<':
+                m_xml += "&lt;";
+                break;
+            case '"':
+                m_xml += "&quot;";
+                break;
+            default:
+            {
+                const char reference[] = {'&', '#', static_cast<char>('0' + c / 10U), static_cast<char>('0' + c % 10U), ';'};
+                m_xml.append(reference, sizeof(reference));
+            }
+            }
+        }
+    }
+}
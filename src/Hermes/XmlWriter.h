@@ -0,0 +1,52 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include <HermesStringView.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace Hermes
+{
+    enum class EXmlFormat
+    {
+        eINDENTED, // what pugi::xml_document::save() writes with format_indent and an indent of one blank
+        eCOMPACT // the same without any whitespace between the tags, as with format_raw
+    };
+
+    // Writes xml straight into a string, element by element, as an alternative to building a pugixml document
+    // and saving it. Attribute values are escaped the way pugixml does it.
+    // The string is owned by the caller, so that its capacity can be reused from message to message.
+    class XmlWriter
+    {
+    public:
+        // clears xml
+        XmlWriter(std::string& xml, EXmlFormat format);
+        XmlWriter(const XmlWriter&) = delete;
+        XmlWriter& operator=(const XmlWriter&) = delete;
+
+        // names must be valid xml names and stay alive until the element is ended
+        void StartElement(StringView name);
+        // only valid right after StartElement() or another Attribute()
+        void Attribute(StringView name, StringView value);
+        void Attribute(StringView name, int value);
+        void Attribute(StringView name, unsigned value);
+        void Attribute(StringView name, double value); // with 3 decimals, as the standard asks for
+        void EndElement();
+
+        std::size_t Size() const { return m_xml.size(); }
+
+    private:
+        void CloseStartTag_();
+        void Indent_();
+        void AppendEscaped_(StringView value);
+
+        static constexpr std::size_t cMAX_DEPTH = 8U; // the Hermes messages have 4 levels at most
+        std::string& m_xml;
+        EXmlFormat m_format;
+        std::array<StringView, cMAX_DEPTH> m_openElements;
+        std::size_t m_depth = 0U;
+        bool m_startTagOpen = false;
+    };
+}
@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include "HermesDataConversion.hpp"
+#include "ServicePool.hpp"
 
 #include <functional>
 #include <memory>
@@ -46,6 +47,7 @@ namespace Hermes
     {
     public:
         explicit ConfigurationService(IConfigurationServiceCallback& callback);
+        ConfigurationService(ServicePool&, IConfigurationServiceCallback& callback);
         ConfigurationService(const ConfigurationService&) = delete;
         ConfigurationService& operator=(const ConfigurationService&) = delete;
         ~ConfigurationService() { ::DeleteHermesConfigurationService(m_pImpl); }
@@ -53,10 +55,14 @@ namespace Hermes
         void Run();
         template<class F> void Post(F&&);
         void Enable(const ConfigurationServiceSettings&);
+        void SetTraceFilter(const TraceFilter&);
+        void SetBackgroundTrace(const BackgroundTraceSettings&); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
         void Disable(const NotificationData&);
         void Stop();
 
     private:
+        ConfigurationService(HermesServicePool*, IConfigurationServiceCallback& callback);
+
         HermesConfigurationService* m_pImpl = nullptr;
         IConfigurationServiceCallback& m_callback;
     };
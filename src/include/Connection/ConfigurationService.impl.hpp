@@ -24,6 +24,16 @@ namespace Hermes
 {
     //======================== ConfigurationService implementation =================================
     inline ConfigurationService::ConfigurationService(IConfigurationServiceCallback& callback) :
+        ConfigurationService(nullptr, callback)
+    {
+    }
+
+    inline ConfigurationService::ConfigurationService(ServicePool& pool, IConfigurationServiceCallback& callback) :
+        ConfigurationService(pool.Handle(), callback)
+    {
+    }
+
+    inline ConfigurationService::ConfigurationService(HermesServicePool* pPool, IConfigurationServiceCallback& callback) :
         m_callback(callback)
     {
         HermesConfigurationServiceCallbacks callbacks{};
@@ -70,7 +80,7 @@ namespace Hermes
                 static_cast<ConfigurationService*>(pVoid)->m_callback.OnTrace(sessionId, ToCpp(type), ToCpp(trace));
             };
 
-        m_pImpl = ::CreateHermesConfigurationService(&callbacks);
+        m_pImpl = pPool ? ::CreateHermesConfigurationServiceOnPool(pPool, &callbacks) : ::CreateHermesConfigurationService(&callbacks);
     }
 
     inline void ConfigurationService::Run()
@@ -96,6 +106,18 @@ namespace Hermes
         ::EnableHermesConfigurationService(m_pImpl, converter.CPointer());
     }
 
+    inline void ConfigurationService::SetTraceFilter(const TraceFilter& data)
+    {
+        const Converter2C<TraceFilter> converter(data);
+        ::SetHermesConfigurationServiceTraceFilter(m_pImpl, converter.CPointer());
+    }
+
+    inline void ConfigurationService::SetBackgroundTrace(const BackgroundTraceSettings& data)
+    {
+        const Converter2C<BackgroundTraceSettings> converter(data);
+        ::SetHermesConfigurationServiceBackgroundTrace(m_pImpl, converter.CPointer());
+    }
+
     inline void ConfigurationService::Disable(const NotificationData& data)
     {
         const Converter2C<NotificationData> converter(data);
@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include "HermesDataConversion.hpp"
+#include "ServicePool.hpp"
 
 #include <functional>
 #include <memory>
@@ -57,6 +58,7 @@ namespace Hermes
     {
     public:
         explicit Downstream(unsigned laneId, IDownstreamCallback&);
+        Downstream(ServicePool&, unsigned laneId, IDownstreamCallback&);
         Downstream(const Downstream&) = delete;
         Downstream& operator=(const Downstream&) = delete;
         ~Downstream() { ::DeleteHermesDownstream(m_pImpl); }
@@ -64,6 +66,8 @@ namespace Hermes
         void Run();
         template<class F> void Post(F&&);
         void Enable(const DownstreamSettings&);
+        void SetTraceFilter(const TraceFilter&);
+        void SetBackgroundTrace(const BackgroundTraceSettings&); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
         void Signal(unsigned sessionId, const ServiceDescriptionData&);
         void Signal(unsigned sessionId, const BoardAvailableData&);
@@ -74,6 +78,18 @@ namespace Hermes
         void Signal(unsigned sessionId, const NotificationData&);
         void Signal(unsigned sessionId, const CheckAliveData&);
         void Signal(unsigned sessionId, const CommandData&);
+#ifdef HERMES_CPP_ABI
+        // moved all the way into the work item for the service thread, skipping the conversion to and from C:
+        void Signal(unsigned sessionId, ServiceDescriptionData&&);
+        void Signal(unsigned sessionId, BoardAvailableData&&);
+        void Signal(unsigned sessionId, RevokeBoardAvailableData&&);
+        void Signal(unsigned sessionId, TransportFinishedData&&);
+        void Signal(unsigned sessionId, BoardForecastData&&);
+        void Signal(unsigned sessionId, SendBoardInfoData&&);
+        void Signal(unsigned sessionId, NotificationData&&);
+        void Signal(unsigned sessionId, CheckAliveData&&);
+        void Signal(unsigned sessionId, CommandData&&);
+#endif
         void Reset(const NotificationData&);
 
         // raw XML for testing
@@ -120,8 +136,18 @@ namespace Hermes
 
 #ifdef HERMES_CPP_ABI
     HERMESPROTOCOL_API HermesDownstream* CreateHermesDownstream(uint32_t laneId, IDownstreamCallback& callback);
+    HERMESPROTOCOL_API HermesDownstream* CreateHermesDownstream(HermesServicePool*, uint32_t laneId, IDownstreamCallback& callback);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, ServiceDescriptionData&&);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, BoardAvailableData&&);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, RevokeBoardAvailableData&&);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, TransportFinishedData&&);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, BoardForecastData&&);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, SendBoardInfoData&&);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, NotificationData&&);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, CheckAliveData&&);
+    HERMESPROTOCOL_API void SignalHermesDownstream(HermesDownstream*, unsigned sessionId, CommandData&&);
 #else
-    inline static HermesDownstream* CreateHermesDownstream(uint32_t laneId, IDownstreamCallback& callback)
+    inline static HermesDownstream* CreateHermesDownstream(HermesServicePool* pPool, uint32_t laneId, IDownstreamCallback& callback)
     {
         HermesDownstreamCallbacks callbacks{};
 
@@ -216,8 +242,13 @@ namespace Hermes
                 static_cast<IDownstreamCallback*>(pCallback)->OnTrace(sessionId, ToCpp(type), ToCpp(trace));
             };
 
-        return ::CreateHermesDownstream(laneId, &callbacks);
+        return pPool ? ::CreateHermesDownstreamOnPool(pPool, laneId, &callbacks) : ::CreateHermesDownstream(laneId, &callbacks);
 
     }
+
+    inline static HermesDownstream* CreateHermesDownstream(uint32_t laneId, IDownstreamCallback& callback)
+    {
+        return CreateHermesDownstream(nullptr, laneId, callback);
+    }
 #endif
 }
\ No newline at end of file
@@ -28,6 +28,11 @@ namespace Hermes
         m_pImpl = Hermes::CreateHermesDownstream(laneId, callback);
     }
 
+    inline Downstream::Downstream(ServicePool& pool, unsigned laneId, IDownstreamCallback& callback)
+    {
+        m_pImpl = Hermes::CreateHermesDownstream(pool.Handle(), laneId, callback);
+    }
+
     inline void Downstream::Run()
     {
         ::RunHermesDownstream(m_pImpl);
@@ -51,6 +56,18 @@ namespace Hermes
         ::EnableHermesDownstream(m_pImpl, converter.CPointer());
     }
 
+    inline void Downstream::SetTraceFilter(const TraceFilter& data)
+    {
+        const Converter2C<TraceFilter> converter(data);
+        ::SetHermesDownstreamTraceFilter(m_pImpl, converter.CPointer());
+    }
+
+    inline void Downstream::SetBackgroundTrace(const BackgroundTraceSettings& data)
+    {
+        const Converter2C<BackgroundTraceSettings> converter(data);
+        ::SetHermesDownstreamBackgroundTrace(m_pImpl, converter.CPointer());
+    }
+
     inline void Downstream::Signal(unsigned sessionId, const ServiceDescriptionData& data)
     {
         const Converter2C<ServiceDescriptionData> converter(data);
@@ -105,6 +122,53 @@ namespace Hermes
         ::SignalHermesDownstreamCommand(m_pImpl, sessionId, converter.CPointer());
     }
 
+#ifdef HERMES_CPP_ABI
+    inline void Downstream::Signal(unsigned sessionId, ServiceDescriptionData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Downstream::Signal(unsigned sessionId, BoardAvailableData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Downstream::Signal(unsigned sessionId, RevokeBoardAvailableData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Downstream::Signal(unsigned sessionId, TransportFinishedData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Downstream::Signal(unsigned sessionId, BoardForecastData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Downstream::Signal(unsigned sessionId, SendBoardInfoData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Downstream::Signal(unsigned sessionId, NotificationData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Downstream::Signal(unsigned sessionId, CheckAliveData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Downstream::Signal(unsigned sessionId, CommandData&& data)
+    {
+        Hermes::SignalHermesDownstream(m_pImpl, sessionId, std::move(data));
+    }
+#endif
+
     inline void Downstream::Reset(const NotificationData& data)
     {
         const Converter2C<NotificationData> converter(data);
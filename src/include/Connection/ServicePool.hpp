@@ -0,0 +1,45 @@
+// Copyright (c) ASM Assembly Systems GmbH & Co. KG
+#pragma once
+
+#include "Hermes.h"
+
+#include <functional>
+#include <utility>
+
+namespace Hermes
+{
+    //======================= ServicePool interface =====================================
+    // The threads shared by the Downstream, Upstream etc. created on it, which it must outlive.
+    class ServicePool
+    {
+    public:
+        // threadStart is called on each of the threads before it starts working, e.g. for pinning it to a CPU
+        explicit ServicePool(unsigned threadCount, std::function<void(unsigned threadIndex)> threadStart = {});
+        ServicePool(const ServicePool&) = delete;
+        ServicePool& operator=(const ServicePool&) = delete;
+        ~ServicePool() { ::DeleteHermesServicePool(m_pImpl); }
+
+        HermesServicePool* Handle() const { return m_pImpl; }
+
+    private:
+        std::function<void(unsigned)> m_threadStart;
+        HermesServicePool* m_pImpl = nullptr;
+    };
+
+    //======================== ServicePool implementation =================================
+    inline ServicePool::ServicePool(unsigned threadCount, std::function<void(unsigned threadIndex)> threadStart) :
+        m_threadStart(std::move(threadStart))
+    {
+        HermesServicePoolSettings settings{};
+        settings.m_threadCount = threadCount;
+        if (m_threadStart)
+        {
+            settings.m_threadStartCallback.m_pData = this;
+            settings.m_threadStartCallback.m_pCall = [](void* pVoid, uint32_t threadIndex)
+                {
+                    static_cast<ServicePool*>(pVoid)->m_threadStart(threadIndex);
+                };
+        }
+        m_pImpl = ::CreateHermesServicePool(&settings);
+    }
+}
@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include "HermesDataConversion.hpp"
+#include "ServicePool.hpp"
 
 #include <functional>
 #include <memory>
@@ -56,6 +57,7 @@ namespace Hermes
     {
     public:
         explicit Upstream(unsigned laneId, IUpstreamCallback&);
+        Upstream(ServicePool&, unsigned laneId, IUpstreamCallback&);
         Upstream(const Upstream&) = delete;
         Upstream& operator=(const Upstream&) = delete;
         ~Upstream() { ::DeleteHermesUpstream(m_pImpl); }
@@ -63,6 +65,8 @@ namespace Hermes
         void Run();
         template<class F> void Post(F&&);
         void Enable(const UpstreamSettings&);
+        void SetTraceFilter(const TraceFilter&);
+        void SetBackgroundTrace(const BackgroundTraceSettings&); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
         void Signal(unsigned sessionId, const ServiceDescriptionData&);
         void Signal(unsigned sessionId, const MachineReadyData&);
@@ -73,6 +77,18 @@ namespace Hermes
         void Signal(unsigned sessionId, const NotificationData&);
         void Signal(unsigned sessionId, const CheckAliveData&);
         void Signal(unsigned sessionId, const CommandData&);
+#ifdef HERMES_CPP_ABI
+        // moved all the way into the work item for the service thread, skipping the conversion to and from C:
+        void Signal(unsigned sessionId, ServiceDescriptionData&&);
+        void Signal(unsigned sessionId, MachineReadyData&&);
+        void Signal(unsigned sessionId, RevokeMachineReadyData&&);
+        void Signal(unsigned sessionId, StartTransportData&&);
+        void Signal(unsigned sessionId, StopTransportData&&);
+        void Signal(unsigned sessionId, QueryBoardInfoData&&);
+        void Signal(unsigned sessionId, NotificationData&&);
+        void Signal(unsigned sessionId, CheckAliveData&&);
+        void Signal(unsigned sessionId, CommandData&&);
+#endif
         void Reset(const NotificationData&);
 
         // raw XML for testing
@@ -120,8 +136,18 @@ namespace Hermes
 
 #ifdef HERMES_CPP_ABI
     HERMESPROTOCOL_API HermesUpstream* CreateHermesUpstream(uint32_t laneId, IUpstreamCallback& callback);
+    HERMESPROTOCOL_API HermesUpstream* CreateHermesUpstream(HermesServicePool*, uint32_t laneId, IUpstreamCallback& callback);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, ServiceDescriptionData&&);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, MachineReadyData&&);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, RevokeMachineReadyData&&);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, StartTransportData&&);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, StopTransportData&&);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, QueryBoardInfoData&&);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, NotificationData&&);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, CheckAliveData&&);
+    HERMESPROTOCOL_API void SignalHermesUpstream(HermesUpstream*, unsigned sessionId, CommandData&&);
 #else
-    inline static HermesUpstream* CreateHermesUpstream(uint32_t laneId, IUpstreamCallback& callback)
+    inline static HermesUpstream* CreateHermesUpstream(HermesServicePool* pPool, uint32_t laneId, IUpstreamCallback& callback)
     {
         HermesUpstreamCallbacks callbacks{};
 
@@ -216,7 +242,12 @@ namespace Hermes
                 static_cast<IUpstreamCallback*>(pCallback)->OnTrace(sessionId, ToCpp(type), ToCpp(trace));
             };
 
-        return ::CreateHermesUpstream(laneId, &callbacks);
+        return pPool ? ::CreateHermesUpstreamOnPool(pPool, laneId, &callbacks) : ::CreateHermesUpstream(laneId, &callbacks);
+    }
+
+    inline static HermesUpstream* CreateHermesUpstream(uint32_t laneId, IUpstreamCallback& callback)
+    {
+        return CreateHermesUpstream(nullptr, laneId, callback);
     }
 #endif
 
@@ -28,6 +28,11 @@ namespace Hermes
         m_pImpl = Hermes::CreateHermesUpstream(laneId, callback);
     }
 
+    inline Upstream::Upstream(ServicePool& pool, unsigned laneId, IUpstreamCallback& callback)
+    {
+        m_pImpl = Hermes::CreateHermesUpstream(pool.Handle(), laneId, callback);
+    }
+
     inline void Upstream::Run()
     {
         ::RunHermesUpstream(m_pImpl);
@@ -39,6 +44,18 @@ namespace Hermes
         ::EnableHermesUpstream(m_pImpl, converter.CPointer());
     }
 
+    inline void Upstream::SetTraceFilter(const TraceFilter& data)
+    {
+        const Converter2C<TraceFilter> converter(data);
+        ::SetHermesUpstreamTraceFilter(m_pImpl, converter.CPointer());
+    }
+
+    inline void Upstream::SetBackgroundTrace(const BackgroundTraceSettings& data)
+    {
+        const Converter2C<BackgroundTraceSettings> converter(data);
+        ::SetHermesUpstreamBackgroundTrace(m_pImpl, converter.CPointer());
+    }
+
     template<class F> void Upstream::Post(F&& f)
     {
         HermesVoidCallback callback;
@@ -93,6 +110,53 @@ namespace Hermes
         ::SignalHermesUpstreamNotification(m_pImpl, sessionId, converter.CPointer());
     }
 
+#ifdef HERMES_CPP_ABI
+    inline void Upstream::Signal(unsigned sessionId, ServiceDescriptionData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Upstream::Signal(unsigned sessionId, MachineReadyData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Upstream::Signal(unsigned sessionId, RevokeMachineReadyData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Upstream::Signal(unsigned sessionId, StartTransportData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Upstream::Signal(unsigned sessionId, StopTransportData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Upstream::Signal(unsigned sessionId, QueryBoardInfoData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Upstream::Signal(unsigned sessionId, NotificationData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Upstream::Signal(unsigned sessionId, CheckAliveData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void Upstream::Signal(unsigned sessionId, CommandData&& data)
+    {
+        Hermes::SignalHermesUpstream(m_pImpl, sessionId, std::move(data));
+    }
+#endif
+
     inline void Upstream::Reset(const NotificationData& data)
     {
         const Converter2C<NotificationData> converter(data);
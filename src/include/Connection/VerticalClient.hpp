@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include "HermesDataConversion.hpp"
+#include "ServicePool.hpp"
 
 #include <functional>
 #include <memory>
@@ -54,6 +55,7 @@ namespace Hermes
     {
     public:
         explicit VerticalClient(IVerticalClientCallback&);
+        VerticalClient(ServicePool&, IVerticalClientCallback&);
         VerticalClient(const VerticalClient&) = delete;
         VerticalClient& operator=(const VerticalClient&) = delete;
         ~VerticalClient() { ::DeleteHermesVerticalClient(m_pImpl); }
@@ -61,6 +63,8 @@ namespace Hermes
         void Run();
         template<class F> void Post(F&&);
         void Enable(const VerticalClientSettings&);
+        void SetTraceFilter(const TraceFilter&);
+        void SetBackgroundTrace(const BackgroundTraceSettings&); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
         void Signal(unsigned sessionId, const SupervisoryServiceDescriptionData&);
         void Signal(unsigned sessionId, const GetConfigurationData&);
@@ -69,6 +73,16 @@ namespace Hermes
         void Signal(unsigned sessionId, const SendWorkOrderInfoData&);
         void Signal(unsigned sessionId, const NotificationData&);
         void Signal(unsigned sessionId, const CheckAliveData&);
+#ifdef HERMES_CPP_ABI
+        // moved all the way into the work item for the service thread, skipping the conversion to and from C:
+        void Signal(unsigned sessionId, SupervisoryServiceDescriptionData&&);
+        void Signal(unsigned sessionId, GetConfigurationData&&);
+        void Signal(unsigned sessionId, SetConfigurationData&&);
+        void Signal(unsigned sessionId, QueryHermesCapabilitiesData&&);
+        void Signal(unsigned sessionId, SendWorkOrderInfoData&&);
+        void Signal(unsigned sessionId, NotificationData&&);
+        void Signal(unsigned sessionId, CheckAliveData&&);
+#endif
         void Reset(const NotificationData&);
 
         // raw XML for testing
@@ -84,8 +98,16 @@ namespace Hermes
 
 #ifdef HERMES_CPP_ABI
     HERMESPROTOCOL_API HermesVerticalClient* CreateHermesVerticalClient(IVerticalClientCallback& callback);
+    HERMESPROTOCOL_API HermesVerticalClient* CreateHermesVerticalClient(HermesServicePool*, IVerticalClientCallback& callback);
+    HERMESPROTOCOL_API void SignalHermesVerticalClient(HermesVerticalClient*, unsigned sessionId, SupervisoryServiceDescriptionData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalClient(HermesVerticalClient*, unsigned sessionId, GetConfigurationData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalClient(HermesVerticalClient*, unsigned sessionId, SetConfigurationData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalClient(HermesVerticalClient*, unsigned sessionId, QueryHermesCapabilitiesData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalClient(HermesVerticalClient*, unsigned sessionId, SendWorkOrderInfoData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalClient(HermesVerticalClient*, unsigned sessionId, NotificationData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalClient(HermesVerticalClient*, unsigned sessionId, CheckAliveData&&);
 #else
-    inline static HermesVerticalClient* CreateHermesVerticalClient(IVerticalClientCallback& callback)
+    inline static HermesVerticalClient* CreateHermesVerticalClient(HermesServicePool* pPool, IVerticalClientCallback& callback)
     {
         HermesVerticalClientCallbacks callbacks{};
 
@@ -174,7 +196,12 @@ namespace Hermes
                 static_cast<IVerticalClientCallback*>(pCallback)->On(sessionId, ToCpp(*pData));
             };
 
-        return ::CreateHermesVerticalClient(&callbacks);
+        return pPool ? ::CreateHermesVerticalClientOnPool(pPool, &callbacks) : ::CreateHermesVerticalClient(&callbacks);
+    }
+
+    inline static HermesVerticalClient* CreateHermesVerticalClient(IVerticalClientCallback& callback)
+    {
+        return CreateHermesVerticalClient(nullptr, callback);
     }
 #endif
     
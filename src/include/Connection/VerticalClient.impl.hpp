@@ -28,6 +28,11 @@ namespace Hermes
         m_pImpl = Hermes::CreateHermesVerticalClient(callback);
     }
 
+    inline VerticalClient::VerticalClient(ServicePool& pool, IVerticalClientCallback& callback)
+    {
+        m_pImpl = Hermes::CreateHermesVerticalClient(pool.Handle(), callback);
+    }
+
     inline void VerticalClient::Run()
     {
         ::RunHermesVerticalClient(m_pImpl);
@@ -51,6 +56,18 @@ namespace Hermes
         ::EnableHermesVerticalClient(m_pImpl, converter.CPointer());
     }
 
+    inline void VerticalClient::SetTraceFilter(const TraceFilter& data)
+    {
+        const Converter2C<TraceFilter> converter(data);
+        ::SetHermesVerticalClientTraceFilter(m_pImpl, converter.CPointer());
+    }
+
+    inline void VerticalClient::SetBackgroundTrace(const BackgroundTraceSettings& data)
+    {
+        const Converter2C<BackgroundTraceSettings> converter(data);
+        ::SetHermesVerticalClientBackgroundTrace(m_pImpl, converter.CPointer());
+    }
+
     inline void VerticalClient::Signal(unsigned sessionId, const SupervisoryServiceDescriptionData& data)
     {
         const Converter2C<SupervisoryServiceDescriptionData> converter(data);
@@ -93,6 +110,43 @@ namespace Hermes
         ::SignalHermesVerticalClientCheckAlive(m_pImpl, sessionId, converter.CPointer());
     }
 
+#ifdef HERMES_CPP_ABI
+    inline void VerticalClient::Signal(unsigned sessionId, SupervisoryServiceDescriptionData&& data)
+    {
+        Hermes::SignalHermesVerticalClient(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalClient::Signal(unsigned sessionId, GetConfigurationData&& data)
+    {
+        Hermes::SignalHermesVerticalClient(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalClient::Signal(unsigned sessionId, SetConfigurationData&& data)
+    {
+        Hermes::SignalHermesVerticalClient(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalClient::Signal(unsigned sessionId, QueryHermesCapabilitiesData&& data)
+    {
+        Hermes::SignalHermesVerticalClient(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalClient::Signal(unsigned sessionId, SendWorkOrderInfoData&& data)
+    {
+        Hermes::SignalHermesVerticalClient(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalClient::Signal(unsigned sessionId, NotificationData&& data)
+    {
+        Hermes::SignalHermesVerticalClient(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalClient::Signal(unsigned sessionId, CheckAliveData&& data)
+    {
+        Hermes::SignalHermesVerticalClient(m_pImpl, sessionId, std::move(data));
+    }
+#endif
+
     inline void VerticalClient::Reset(const NotificationData& data)
     {
         const Converter2C<NotificationData> converter(data);
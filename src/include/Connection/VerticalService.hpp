@@ -19,9 +19,11 @@ limitations under the License.
 #pragma once
 
 #include "HermesDataConversion.hpp"
+#include "ServicePool.hpp"
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace Hermes
 {
@@ -47,11 +49,44 @@ namespace Hermes
         virtual ~IVerticalServiceCallback() = default;
     };
 
+    // messages to be signalled at once, see VerticalService::Signal(unsigned, const VerticalServiceMessages&)
+    class VerticalServiceMessages
+    {
+    public:
+        void Add(const BoardArrivedData& data) { Add_(eHERMES_VERTICAL_SERVICE_MESSAGE_BOARD_ARRIVED, data); }
+        void Add(const BoardDepartedData& data) { Add_(eHERMES_VERTICAL_SERVICE_MESSAGE_BOARD_DEPARTED, data); }
+        void Add(const QueryWorkOrderInfoData& data) { Add_(eHERMES_VERTICAL_SERVICE_MESSAGE_QUERY_WORK_ORDER_INFO, data); }
+        void Add(const ReplyWorkOrderInfoData& data) { Add_(eHERMES_VERTICAL_SERVICE_MESSAGE_REPLY_WORK_ORDER_INFO, data); }
+        void Add(const SendHermesCapabilitiesData& data) { Add_(eHERMES_VERTICAL_SERVICE_MESSAGE_SEND_HERMES_CAPABILITIES, data); }
+        void Add(const CurrentConfigurationData& data) { Add_(eHERMES_VERTICAL_SERVICE_MESSAGE_CURRENT_CONFIGURATION, data); }
+        void Add(const NotificationData& data) { Add_(eHERMES_VERTICAL_SERVICE_MESSAGE_NOTIFICATION, data); }
+        void Add(const CheckAliveData& data) { Add_(eHERMES_VERTICAL_SERVICE_MESSAGE_CHECK_ALIVE, data); }
+
+        std::size_t size() const { return m_messages.size(); }
+        bool empty() const { return m_messages.empty(); }
+        void clear() { m_messages.clear(); m_converters.clear(); }
+
+        const HermesVerticalServiceMessage* CPointer() const { return m_messages.data(); }
+
+    private:
+        std::vector<HermesVerticalServiceMessage> m_messages;
+        std::vector<std::shared_ptr<const void>> m_converters; // what m_messages point into
+
+        template<class DataT>
+        void Add_(EHermesVerticalServiceMessageType type, const DataT& data)
+        {
+            auto spConverter = std::make_shared<const Converter2C<DataT>>(data);
+            m_messages.push_back(HermesVerticalServiceMessage{type, spConverter->CPointer()});
+            m_converters.push_back(std::move(spConverter));
+        }
+    };
+
     //======================= VerticalService interface =====================================  
     class VerticalService
     {
     public:
         explicit VerticalService(IVerticalServiceCallback&);
+        VerticalService(ServicePool&, IVerticalServiceCallback&);
         VerticalService(const VerticalService&) = delete;
         VerticalService& operator=(const VerticalService&) = delete;
         ~VerticalService() { ::DeleteHermesVerticalService(m_pImpl); }
@@ -59,6 +94,8 @@ namespace Hermes
         void Run();
         template<class F> void Post(F&&);
         void Enable(const VerticalServiceSettings&);
+        void SetTraceFilter(const TraceFilter&);
+        void SetBackgroundTrace(const BackgroundTraceSettings&); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
         void Signal(unsigned sessionId, const SupervisoryServiceDescriptionData&);
         void Signal(unsigned sessionId, const BoardArrivedData&); // only to a specific client
@@ -72,6 +109,21 @@ namespace Hermes
         void Signal(unsigned sessionId, const NotificationData&);
         void Signal(unsigned sessionId, const CheckAliveData&);
         void Signal(unsigned sessionId, const CommandData&);
+        void Signal(unsigned sessionId, const VerticalServiceMessages&); // with sessionId == 0, BoardArrived and BoardDeparted only
+#ifdef HERMES_CPP_ABI
+        // moved all the way into the work item for the service thread, skipping the conversion to and from C:
+        void Signal(unsigned sessionId, SupervisoryServiceDescriptionData&&);
+        void Signal(unsigned sessionId, BoardArrivedData&&);
+        void Signal(BoardArrivedData&&);
+        void Signal(unsigned sessionId, BoardDepartedData&&);
+        void Signal(BoardDepartedData&&);
+        void Signal(unsigned sessionId, QueryWorkOrderInfoData&&);
+        void Signal(unsigned sessionId, ReplyWorkOrderInfoData&&);
+        void Signal(unsigned sessionId, SendHermesCapabilitiesData&&);
+        void Signal(unsigned sessionId, CurrentConfigurationData&&);
+        void Signal(unsigned sessionId, NotificationData&&);
+        void Signal(unsigned sessionId, CheckAliveData&&);
+#endif
         void ResetSession(unsigned sessionId, const NotificationData&);
 
         void Disable(const NotificationData&);
@@ -83,8 +135,18 @@ namespace Hermes
 
 #ifdef HERMES_CPP_ABI
     HERMESPROTOCOL_API HermesVerticalService* CreateHermesVerticalService(IVerticalServiceCallback& callbacks);
+    HERMESPROTOCOL_API HermesVerticalService* CreateHermesVerticalService(HermesServicePool*, IVerticalServiceCallback& callbacks);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, SupervisoryServiceDescriptionData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, BoardArrivedData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, BoardDepartedData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, QueryWorkOrderInfoData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, ReplyWorkOrderInfoData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, SendHermesCapabilitiesData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, CurrentConfigurationData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, NotificationData&&);
+    HERMESPROTOCOL_API void SignalHermesVerticalService(HermesVerticalService*, unsigned sessionId, CheckAliveData&&);
 #else
-    inline static HermesVerticalService* CreateHermesVerticalService(IVerticalServiceCallback& callback)
+    inline static HermesVerticalService* CreateHermesVerticalService(HermesServicePool* pPool, IVerticalServiceCallback& callback)
     {
         HermesVerticalServiceCallbacks callbacks{};
 
@@ -159,7 +221,12 @@ namespace Hermes
                 static_cast<IVerticalServiceCallback*>(pCallback)->OnTrace(sessionId, ToCpp(type), ToCpp(trace));
             };
 
-        return ::CreateHermesVerticalService(&callbacks);
+        return pPool ? ::CreateHermesVerticalServiceOnPool(pPool, &callbacks) : ::CreateHermesVerticalService(&callbacks);
+    }
+
+    inline static HermesVerticalService* CreateHermesVerticalService(IVerticalServiceCallback& callback)
+    {
+        return CreateHermesVerticalService(nullptr, callback);
     }
 #endif
 }
\ No newline at end of file
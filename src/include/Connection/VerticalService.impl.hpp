@@ -28,6 +28,11 @@ namespace Hermes
         m_pImpl = Hermes::CreateHermesVerticalService(callback);
     }
 
+    inline VerticalService::VerticalService(ServicePool& pool, IVerticalServiceCallback& callback)
+    {
+        m_pImpl = Hermes::CreateHermesVerticalService(pool.Handle(), callback);
+    }
+
     inline void VerticalService::Run()
     {
         ::RunHermesVerticalService(m_pImpl);
@@ -51,6 +56,18 @@ namespace Hermes
         ::EnableHermesVerticalService(m_pImpl, converter.CPointer());
     }
 
+    inline void VerticalService::SetTraceFilter(const TraceFilter& data)
+    {
+        const Converter2C<TraceFilter> converter(data);
+        ::SetHermesVerticalServiceTraceFilter(m_pImpl, converter.CPointer());
+    }
+
+    inline void VerticalService::SetBackgroundTrace(const BackgroundTraceSettings& data)
+    {
+        const Converter2C<BackgroundTraceSettings> converter(data);
+        ::SetHermesVerticalServiceBackgroundTrace(m_pImpl, converter.CPointer());
+    }
+
     inline void VerticalService::Signal(unsigned sessionId, const SupervisoryServiceDescriptionData& data)
     {
         const Converter2C<SupervisoryServiceDescriptionData> converter(data);
@@ -118,6 +135,68 @@ namespace Hermes
         ::SignalHermesVerticalServiceCheckAlive(m_pImpl, sessionId, converter.CPointer());
     }
 
+    inline void VerticalService::Signal(unsigned sessionId, const VerticalServiceMessages& messages)
+    {
+        ::SignalHermesVerticalServiceMessages(m_pImpl, sessionId, messages.CPointer(), static_cast<uint32_t>(messages.size()));
+    }
+
+#ifdef HERMES_CPP_ABI
+    inline void VerticalService::Signal(unsigned sessionId, SupervisoryServiceDescriptionData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalService::Signal(unsigned sessionId, BoardArrivedData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalService::Signal(BoardArrivedData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, 0U, std::move(data));
+    }
+
+    inline void VerticalService::Signal(unsigned sessionId, BoardDepartedData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalService::Signal(BoardDepartedData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, 0U, std::move(data));
+    }
+
+    inline void VerticalService::Signal(unsigned sessionId, QueryWorkOrderInfoData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalService::Signal(unsigned sessionId, ReplyWorkOrderInfoData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalService::Signal(unsigned sessionId, SendHermesCapabilitiesData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalService::Signal(unsigned sessionId, CurrentConfigurationData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalService::Signal(unsigned sessionId, NotificationData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+
+    inline void VerticalService::Signal(unsigned sessionId, CheckAliveData&& data)
+    {
+        Hermes::SignalHermesVerticalService(m_pImpl, sessionId, std::move(data));
+    }
+#endif
+
     inline void VerticalService::ResetSession(unsigned sessionId, const NotificationData& data)
     {
         const Converter2C<NotificationData> converter(data);
@@ -206,12 +206,34 @@ extern "C" {
         void *m_pData;
     };
 
+    // Instead of each running on a thread of its own, any number of the services below can share a pool of threads.
+    // The calls of one service are still carried out one after the other, those of different services concurrently.
+    // For a service created on a pool, Run... only blocks until Stop... is called, and Delete... waits until no call of it is running.
+    struct HermesThreadStartCallback
+    {
+        void(*m_pCall)(void* /*m_pData*/, uint32_t /*threadIndex*/); // called on each thread of the pool, e.g. for pinning it to a CPU
+        void* m_pData;
+    };
+
+    struct HermesServicePoolSettings
+    {
+        uint32_t m_threadCount; // at least one thread is started
+        HermesThreadStartCallback m_threadStartCallback; // optional
+    };
+
+    struct HermesServicePool; // the opaque handle to the pool of threads
+    HERMESPROTOCOL_API HermesServicePool* CreateHermesServicePool(const HermesServicePoolSettings*);
+    HERMESPROTOCOL_API void DeleteHermesServicePool(HermesServicePool*); // only after all services created on it are deleted
+
     // The calling API
     struct HermesDownstream; // the opaque handle to the downstream service
     HERMESPROTOCOL_API HermesDownstream* CreateHermesDownstream(uint32_t laneId, const HermesDownstreamCallbacks*);
+    HERMESPROTOCOL_API HermesDownstream* CreateHermesDownstreamOnPool(HermesServicePool*, uint32_t laneId, const HermesDownstreamCallbacks*);
     HERMESPROTOCOL_API void RunHermesDownstream(HermesDownstream*); // blocks until ::StopHermesDownstream is called
     HERMESPROTOCOL_API void PostHermesDownstream(HermesDownstream*, HermesVoidCallback);
     HERMESPROTOCOL_API void EnableHermesDownstream(HermesDownstream*, const HermesDownstreamSettings*);
+    HERMESPROTOCOL_API void SetHermesDownstreamTraceFilter(HermesDownstream*, const HermesTraceFilter*); // may be called from any thread
+    HERMESPROTOCOL_API void SetHermesDownstreamBackgroundTrace(HermesDownstream*, const HermesBackgroundTraceSettings*); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
     HERMESPROTOCOL_API void SignalHermesDownstreamServiceDescription(HermesDownstream*, uint32_t sessionId, const HermesServiceDescriptionData*);
     HERMESPROTOCOL_API void SignalHermesBoardAvailable(HermesDownstream*, uint32_t sessionId, const HermesBoardAvailableData*);
@@ -255,9 +277,12 @@ extern "C" {
     // The calling API:
     struct HermesUpstream; // the opaque handle to the upstream service
     HERMESPROTOCOL_API HermesUpstream* CreateHermesUpstream(uint32_t laneId, const HermesUpstreamCallbacks*);
+    HERMESPROTOCOL_API HermesUpstream* CreateHermesUpstreamOnPool(HermesServicePool*, uint32_t laneId, const HermesUpstreamCallbacks*);
     HERMESPROTOCOL_API void RunHermesUpstream(HermesUpstream*);
     HERMESPROTOCOL_API void PostHermesUpstream(HermesUpstream*, HermesVoidCallback);
     HERMESPROTOCOL_API void EnableHermesUpstream(HermesUpstream*, const HermesUpstreamSettings*);
+    HERMESPROTOCOL_API void SetHermesUpstreamTraceFilter(HermesUpstream*, const HermesTraceFilter*); // may be called from any thread
+    HERMESPROTOCOL_API void SetHermesUpstreamBackgroundTrace(HermesUpstream*, const HermesBackgroundTraceSettings*); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
     HERMESPROTOCOL_API void SignalHermesUpstreamServiceDescription(HermesUpstream*, uint32_t sessionId, const HermesServiceDescriptionData*);
     HERMESPROTOCOL_API void SignalHermesMachineReady(HermesUpstream*, uint32_t sessionId, const HermesMachineReadyData*);
@@ -340,9 +365,12 @@ extern "C" {
 
     struct HermesConfigurationService; // the opaque handle to the configuration service
     HERMESPROTOCOL_API HermesConfigurationService* CreateHermesConfigurationService(const HermesConfigurationServiceCallbacks*);
+    HERMESPROTOCOL_API HermesConfigurationService* CreateHermesConfigurationServiceOnPool(HermesServicePool*, const HermesConfigurationServiceCallbacks*);
     HERMESPROTOCOL_API void RunHermesConfigurationService(HermesConfigurationService*); // blocks until StopHermesConfigurationService is called
     HERMESPROTOCOL_API void PostHermesConfigurationService(HermesConfigurationService*, HermesVoidCallback);
     HERMESPROTOCOL_API void EnableHermesConfigurationService(HermesConfigurationService*, const HermesConfigurationServiceSettings*);
+    HERMESPROTOCOL_API void SetHermesConfigurationServiceTraceFilter(HermesConfigurationService*, const HermesTraceFilter*); // may be called from any thread
+    HERMESPROTOCOL_API void SetHermesConfigurationServiceBackgroundTrace(HermesConfigurationService*, const HermesBackgroundTraceSettings*); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
     // the following must be called from within the m_getConfigurationCallback so that the HermesConfigurationService can match them up
     HERMESPROTOCOL_API void SignalHermesCurrentConfiguration(HermesConfigurationService*, uint32_t sessionId, const HermesCurrentConfigurationData*);
@@ -400,9 +428,12 @@ extern "C" {
     // The calling API
     struct HermesVerticalService; // the opaque handle to the supervisor service
     HERMESPROTOCOL_API HermesVerticalService* CreateHermesVerticalService(const HermesVerticalServiceCallbacks*);
+    HERMESPROTOCOL_API HermesVerticalService* CreateHermesVerticalServiceOnPool(HermesServicePool*, const HermesVerticalServiceCallbacks*);
     HERMESPROTOCOL_API void RunHermesVerticalService(HermesVerticalService*); // blocks until ::StopHermesDownstream is called
     HERMESPROTOCOL_API void PostHermesVerticalService(HermesVerticalService*, HermesVoidCallback);
     HERMESPROTOCOL_API void EnableHermesVerticalService(HermesVerticalService*, const HermesVerticalServiceSettings*);
+    HERMESPROTOCOL_API void SetHermesVerticalServiceTraceFilter(HermesVerticalService*, const HermesTraceFilter*); // may be called from any thread
+    HERMESPROTOCOL_API void SetHermesVerticalServiceBackgroundTrace(HermesVerticalService*, const HermesBackgroundTraceSettings*); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
     HERMESPROTOCOL_API void SignalHermesVerticalServiceDescription(HermesVerticalService*, uint32_t sessionId, const HermesSupervisoryServiceDescriptionData*);
     HERMESPROTOCOL_API void SignalHermesQueryWorkOrderInfo(HermesVerticalService*, uint32_t sessionId, const HermesQueryWorkOrderInfoData*);
@@ -416,6 +447,29 @@ extern "C" {
     HERMESPROTOCOL_API void SignalHermesBoardArrived(HermesVerticalService*, uint32_t sessionId, const HermesBoardArrivedData*);
     HERMESPROTOCOL_API void SignalHermesBoardDeparted(HermesVerticalService*, uint32_t sessionId, const HermesBoardDepartedData*);
 
+    // Many messages to a session at once, e.g. to catch up after an outage of the client: they take one hop to the
+    // service thread and go out in the given order with one write. If sessionId == 0, then only the BoardArrived and
+    // BoardDeparted messages are propagated to all clients that have specified FeatureBoardTracking.
+    enum EHermesVerticalServiceMessageType
+    {
+        eHERMES_VERTICAL_SERVICE_MESSAGE_BOARD_ARRIVED,
+        eHERMES_VERTICAL_SERVICE_MESSAGE_BOARD_DEPARTED,
+        eHERMES_VERTICAL_SERVICE_MESSAGE_QUERY_WORK_ORDER_INFO,
+        eHERMES_VERTICAL_SERVICE_MESSAGE_REPLY_WORK_ORDER_INFO,
+        eHERMES_VERTICAL_SERVICE_MESSAGE_SEND_HERMES_CAPABILITIES,
+        eHERMES_VERTICAL_SERVICE_MESSAGE_CURRENT_CONFIGURATION,
+        eHERMES_VERTICAL_SERVICE_MESSAGE_NOTIFICATION,
+        eHERMES_VERTICAL_SERVICE_MESSAGE_CHECK_ALIVE
+    };
+
+    struct HermesVerticalServiceMessage
+    {
+        EHermesVerticalServiceMessageType m_type;
+        const void* m_pData; // the Hermes...Data matching m_type
+    };
+    HERMESPROTOCOL_API void SignalHermesVerticalServiceMessages(HermesVerticalService*, uint32_t sessionId,
+        const HermesVerticalServiceMessage* pMessages, uint32_t messageCount);
+
     HERMESPROTOCOL_API void ResetHermesVerticalServiceSession(HermesVerticalService*, uint32_t sessionId, const HermesNotificationData*);
 
     HERMESPROTOCOL_API void DisableHermesVerticalService(HermesVerticalService*, const HermesNotificationData*);
@@ -472,9 +526,12 @@ extern "C" {
     // The calling API
     struct HermesVerticalClient; // the opaque handle to the supervisor service
     HERMESPROTOCOL_API HermesVerticalClient* CreateHermesVerticalClient(const HermesVerticalClientCallbacks*);
+    HERMESPROTOCOL_API HermesVerticalClient* CreateHermesVerticalClientOnPool(HermesServicePool*, const HermesVerticalClientCallbacks*);
     HERMESPROTOCOL_API void RunHermesVerticalClient(HermesVerticalClient*); // blocks until ::StopHermesDownstream is called
     HERMESPROTOCOL_API void PostHermesVerticalClient(HermesVerticalClient*, HermesVoidCallback);
     HERMESPROTOCOL_API void EnableHermesVerticalClient(HermesVerticalClient*, const HermesVerticalClientSettings*);
+    HERMESPROTOCOL_API void SetHermesVerticalClientTraceFilter(HermesVerticalClient*, const HermesTraceFilter*); // may be called from any thread
+    HERMESPROTOCOL_API void SetHermesVerticalClientBackgroundTrace(HermesVerticalClient*, const HermesBackgroundTraceSettings*); // only the first call takes effect, the trace callback is then called from the background thread instead of the service thread
 
     HERMESPROTOCOL_API void SignalHermesVerticalClientDescription(HermesVerticalClient*, uint32_t sessionId, const HermesSupervisoryServiceDescriptionData*);
     HERMESPROTOCOL_API void SignalHermesSendWorkOrderInfo(HermesVerticalClient*, uint32_t sessionId, const HermesSendWorkOrderInfoData*);
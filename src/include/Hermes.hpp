@@ -23,6 +23,7 @@ limitations under the License.
 #include <memory>
 
 // These are lightweight C++ wrappers around the Hermes C Api: definitions
+#include "Connection/ServicePool.hpp"
 #include "Connection/Downstream.hpp"
 #include "Connection/Upstream.hpp"
 #include "Connection/ConfigurationService.hpp"
@@ -168,6 +168,24 @@ enum EHermesCheckAliveResponseMode
     cHERMES_CHECK_ALIVE_RESPONSE_MODE_ENUM_SIZE = 2
 };
 
+/* Parser for received messages (not part of The Hermes Standard) */
+enum EHermesXmlParserMode
+{
+    eHERMES_XML_PARSER_MODE_DOM,
+    eHERMES_XML_PARSER_MODE_STREAMING,
+    cHERMES_XML_PARSER_MODE_ENUM_SIZE = 2
+};
+
+/* Transport of the connections (not part of The Hermes Standard) */
+enum EHermesTransport
+{
+    eHERMES_TRANSPORT_TCP,
+    eHERMES_TRANSPORT_IN_PROCESS,
+    eHERMES_TRANSPORT_UNIX_DOMAIN,
+    eHERMES_TRANSPORT_IO_URING,
+    cHERMES_TRANSPORT_ENUM_SIZE = 4
+};
+
 /* Error codes (not part of The Hermes Standard) */
 enum EHermesErrorCode
 {
@@ -708,6 +726,19 @@ struct HermesCommandData
     uint16_t m_command;
 };
 
+/* SocketOptions, Options of the TCP sockets (not part of The Hermes Standard) */
+struct HermesSocketOptions
+{
+    unsigned m_noDelay; /* not 0: TCP_NODELAY, so that the small request and response messages are not held back */
+    unsigned m_keepAlive; /* not 0: SO_KEEPALIVE */
+    unsigned m_keepAliveIdleInSeconds; /* before the first keepalive probe, 0: system default */
+    unsigned m_keepAliveIntervalInSeconds; /* between the keepalive probes, 0: system default */
+    unsigned m_sendBufferSize; /* SO_SNDBUF in bytes, 0: system default */
+    unsigned m_receiveBufferSize; /* SO_RCVBUF in bytes, 0: system default */
+    unsigned m_quickAck; /* not 0: TCP_QUICKACK after each receive, Linux only */
+    EHermesTransport m_transport; /* the TCP options above apply to eHERMES_TRANSPORT_TCP and eHERMES_TRANSPORT_IO_URING */
+};
+
 /* UpstreamSettings, Configuration of upstream interface (not part of The Hermes Standard) */
 struct HermesUpstreamSettings
 {
@@ -718,6 +749,13 @@ struct HermesUpstreamSettings
     double m_reconnectWaitTimeInSeconds;
     EHermesCheckAliveResponseMode m_checkAliveResponseMode;
     EHermesCheckState m_checkState;
+    unsigned m_sendQueueHighWaterMark; /* in bytes, 0: no warning */
+    EHermesXmlParserMode m_xmlParserMode; /* parser for received messages */
+    double m_maxReconnectWaitTimeInSeconds; /* the wait time grows up to this, not at all if below m_reconnectWaitTimeInSeconds */
+    double m_reconnectWaitTimeFactor; /* the wait time is multiplied by this after each failed attempt, values below 1 count as 1 */
+    double m_reconnectJitter; /* 0..1, the share of the wait time taken off at random */
+    unsigned m_reconnectAtOnceAfterClose; /* not 0: reconnect without waiting when the peer has closed an established connection cleanly, but not twice in a row */
+    HermesSocketOptions m_socketOptions;
 };
 
 /* DownstreamSettings, Configuration of downstream interface (not part of The Hermes Standard) */
@@ -730,6 +768,9 @@ struct HermesDownstreamSettings
     double m_reconnectWaitTimeInSeconds;
     EHermesCheckAliveResponseMode m_checkAliveResponseMode;
     EHermesCheckState m_checkState;
+    unsigned m_sendQueueHighWaterMark; /* in bytes, 0: no warning */
+    EHermesXmlParserMode m_xmlParserMode; /* parser for received messages */
+    HermesSocketOptions m_socketOptions;
 };
 
 /* ConfigurationServiceSettings, Configuration of configuration service interface (not part of The Hermes Standard) */
@@ -747,6 +788,9 @@ struct HermesVerticalServiceSettings
     double m_reconnectWaitTimeInSeconds;
     double m_checkAlivePeriodInSeconds;
     EHermesCheckAliveResponseMode m_checkAliveResponseMode;
+    unsigned m_sendQueueHighWaterMark; /* in bytes, 0: no warning */
+    EHermesXmlParserMode m_xmlParserMode; /* parser for received messages */
+    HermesSocketOptions m_socketOptions;
 };
 
 /* VerticalClientSettings, Configuration of vertical client interface (not part of The Hermes Standard) */
@@ -758,6 +802,30 @@ struct HermesVerticalClientSettings
     double m_reconnectWaitTimeInSeconds;
     double m_checkAlivePeriodInSeconds;
     EHermesCheckAliveResponseMode m_checkAliveResponseMode;
+    unsigned m_sendQueueHighWaterMark; /* in bytes, 0: no warning */
+    EHermesXmlParserMode m_xmlParserMode; /* parser for received messages */
+    double m_maxReconnectWaitTimeInSeconds; /* the wait time grows up to this, not at all if below m_reconnectWaitTimeInSeconds */
+    double m_reconnectWaitTimeFactor; /* the wait time is multiplied by this after each failed attempt, values below 1 count as 1 */
+    double m_reconnectJitter; /* 0..1, the share of the wait time taken off at random */
+    unsigned m_reconnectAtOnceAfterClose; /* not 0: reconnect without waiting when the peer has closed an established connection cleanly, but not twice in a row */
+    HermesSocketOptions m_socketOptions;
+};
+
+/* TraceFilter, Traces passed on to the trace callback (not part of The Hermes Standard) */
+struct HermesTraceFilter
+{
+    EHermesTraceType m_minimumTraceType; /* eHERMES_TRACE_TYPE_DEBUG, _INFO, _WARNING or _ERROR */
+    unsigned m_traceSent; /* 0: no eHERMES_TRACE_TYPE_SENT traces */
+    unsigned m_traceReceived; /* 0: no eHERMES_TRACE_TYPE_RECEIVED traces */
+};
+
+/* BackgroundTraceSettings, Traces formatted and passed on by a background thread (not part of The Hermes Standard) */
+struct HermesBackgroundTraceSettings
+{
+    unsigned m_bufferSize; /* in bytes, rounded up to a power of 2; traces are dropped when it is full */
+    HermesStringView m_filePath; /* empty: the traces go to the trace callback */
+    unsigned m_maxFileSize; /* in bytes, then the file is renamed to <path>.1 (and <path>.1 to <path>.2 and so on); 0: the file is never rotated */
+    unsigned m_maxFileCount; /* including the current file */
 };
 
 /* Error, Error object (not part of The Hermes Standard) */
@@ -773,6 +841,8 @@ struct HermesConnectionInfo
     HermesStringView m_address;
     uint16_t m_port;
     HermesStringView m_hostName;
+    uint32_t m_connectAttempts; /* the attempts it took to establish the connection, 0 for accepted connections */
+    double m_downtimeInSeconds; /* since the previous connection was lost, 0 for the first connection */
 };
 
 #ifdef __cplusplus
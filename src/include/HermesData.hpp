@@ -346,6 +346,46 @@ S& operator<<(S& s, ECheckAliveResponseMode e)
 }
 inline constexpr std::size_t size(ECheckAliveResponseMode) { return 2; }
 
+//========== Parser for received messages (not part of The Hermes Standard) ==========
+enum class EXmlParserMode
+{
+    eDOM, // parse into a pugixml document first
+    eSTREAMING // decode the message in a single pass without building a document
+};
+template<class S>
+S& operator<<(S& s, EXmlParserMode e)
+{
+   switch(e)
+   {
+        case EXmlParserMode::eDOM: s << "eDOM"; return s;
+        case EXmlParserMode::eSTREAMING: s << "eSTREAMING"; return s;
+        default: s << "INVALID_XML_PARSER_MODE: " << static_cast<int>(e); return s;
+    }
+}
+inline constexpr std::size_t size(EXmlParserMode) { return 2; }
+
+//========== Transport of the connections (not part of The Hermes Standard) ==========
+enum class ETransport
+{
+    eTCP,
+    eIN_PROCESS, // a pipe in memory to a peer in the same process, listening on the same port number
+    eUNIX_DOMAIN, // an AF_UNIX stream socket, named after the port number, for a peer on the same host
+    eIO_URING // TCP with the receives and sends on an io_uring, Linux 6.0 and later, otherwise as eTCP
+};
+template<class S>
+S& operator<<(S& s, ETransport e)
+{
+   switch(e)
+   {
+        case ETransport::eTCP: s << "eTCP"; return s;
+        case ETransport::eIN_PROCESS: s << "eIN_PROCESS"; return s;
+        case ETransport::eUNIX_DOMAIN: s << "eUNIX_DOMAIN"; return s;
+        case ETransport::eIO_URING: s << "eIO_URING"; return s;
+        default: s << "INVALID_TRANSPORT: " << static_cast<int>(e); return s;
+    }
+}
+inline constexpr std::size_t size(ETransport) { return 4; }
+
 //========== Error codes (not part of The Hermes Standard) ==========
 enum class EErrorCode
 {
@@ -1982,6 +2022,47 @@ struct CommandData
     }
 };
 
+//========== Options of the TCP sockets (not part of The Hermes Standard) ==========
+struct SocketOptions
+{
+    bool m_noDelay{true}; // TCP_NODELAY, so that the small request and response messages are not held back
+    bool m_keepAlive{false}; // SO_KEEPALIVE
+    unsigned m_keepAliveIdleInSeconds{0}; // before the first keepalive probe, 0: system default
+    unsigned m_keepAliveIntervalInSeconds{0}; // between the keepalive probes, 0: system default
+    unsigned m_sendBufferSize{0}; // SO_SNDBUF in bytes, 0: system default
+    unsigned m_receiveBufferSize{0}; // SO_RCVBUF in bytes, 0: system default
+    bool m_quickAck{false}; // TCP_QUICKACK after each receive, Linux only
+    ETransport m_transport{ETransport::eTCP}; // the TCP options above apply to eTCP and eIO_URING
+
+    friend bool operator==(const SocketOptions& lhs, const SocketOptions& rhs)
+    {
+        return lhs.m_noDelay == rhs.m_noDelay
+            && lhs.m_keepAlive == rhs.m_keepAlive
+            && lhs.m_keepAliveIdleInSeconds == rhs.m_keepAliveIdleInSeconds
+            && lhs.m_keepAliveIntervalInSeconds == rhs.m_keepAliveIntervalInSeconds
+            && lhs.m_sendBufferSize == rhs.m_sendBufferSize
+            && lhs.m_receiveBufferSize == rhs.m_receiveBufferSize
+            && lhs.m_quickAck == rhs.m_quickAck
+            && lhs.m_transport == rhs.m_transport;
+    }
+    friend bool operator!=(const SocketOptions& lhs, const SocketOptions& rhs) { return !operator==(lhs, rhs); }
+
+    template <class S> friend S& operator<<(S& s, const SocketOptions& data) 
+    {
+        s << '{';
+        s << " NoDelay=" << data.m_noDelay;
+        s << " KeepAlive=" << data.m_keepAlive;
+        s << " KeepAliveIdle=" << data.m_keepAliveIdleInSeconds;
+        s << " KeepAliveInterval=" << data.m_keepAliveIntervalInSeconds;
+        s << " SendBufferSize=" << data.m_sendBufferSize;
+        s << " ReceiveBufferSize=" << data.m_receiveBufferSize;
+        s << " QuickAck=" << data.m_quickAck;
+        s << " Transport=" << data.m_transport;
+        s << " }";
+        return s;
+    }
+};
+
 //========== Configuration of upstream interface (not part of The Hermes Standard) ==========
 struct UpstreamSettings
 {
@@ -1992,6 +2073,13 @@ struct UpstreamSettings
     double m_reconnectWaitTimeInSeconds{10};
     ECheckAliveResponseMode m_checkAliveResponseMode{ECheckAliveResponseMode::eAUTO};
     ECheckState m_checkState{ECheckState::eSEND_AND_RECEIVE};
+    unsigned m_sendQueueHighWaterMark{262144}; // in bytes, 0: no warning
+    EXmlParserMode m_xmlParserMode{EXmlParserMode::eDOM}; // parser for received messages
+    double m_maxReconnectWaitTimeInSeconds{60}; // the wait time grows up to this, not at all if below m_reconnectWaitTimeInSeconds
+    double m_reconnectWaitTimeFactor{1}; // the wait time is multiplied by this after each failed attempt
+    double m_reconnectJitter{0}; // 0..1, the share of the wait time taken off at random, so that clients do not reconnect in lockstep
+    bool m_reconnectAtOnceAfterClose{false}; // reconnect without waiting when the peer has closed an established connection cleanly, but not twice in a row
+    SocketOptions m_socketOptions;
 
     UpstreamSettings() = default;
     UpstreamSettings(StringView machineId,
@@ -2010,7 +2098,14 @@ struct UpstreamSettings
             && lhs.m_checkAlivePeriodInSeconds == rhs.m_checkAlivePeriodInSeconds
             && lhs.m_reconnectWaitTimeInSeconds == rhs.m_reconnectWaitTimeInSeconds
             && lhs.m_checkAliveResponseMode == rhs.m_checkAliveResponseMode
-            && lhs.m_checkState == rhs.m_checkState;
+            && lhs.m_checkState == rhs.m_checkState
+            && lhs.m_sendQueueHighWaterMark == rhs.m_sendQueueHighWaterMark
+            && lhs.m_xmlParserMode == rhs.m_xmlParserMode
+            && lhs.m_maxReconnectWaitTimeInSeconds == rhs.m_maxReconnectWaitTimeInSeconds
+            && lhs.m_reconnectWaitTimeFactor == rhs.m_reconnectWaitTimeFactor
+            && lhs.m_reconnectJitter == rhs.m_reconnectJitter
+            && lhs.m_reconnectAtOnceAfterClose == rhs.m_reconnectAtOnceAfterClose
+            && lhs.m_socketOptions == rhs.m_socketOptions;
     }
     friend bool operator!=(const UpstreamSettings& lhs, const UpstreamSettings& rhs) { return !operator==(lhs, rhs); }
 
@@ -2024,6 +2119,13 @@ struct UpstreamSettings
         s << " ReconnectWaitTime=" << data.m_reconnectWaitTimeInSeconds;
         s << " CheckAliveResponseMode=" << data.m_checkAliveResponseMode;
         s << " CheckState=" << data.m_checkState;
+        s << " SendQueueHighWaterMark=" << data.m_sendQueueHighWaterMark;
+        s << " XmlParserMode=" << data.m_xmlParserMode;
+        s << " MaxReconnectWaitTime=" << data.m_maxReconnectWaitTimeInSeconds;
+        s << " ReconnectWaitTimeFactor=" << data.m_reconnectWaitTimeFactor;
+        s << " ReconnectJitter=" << data.m_reconnectJitter;
+        s << " ReconnectAtOnceAfterClose=" << data.m_reconnectAtOnceAfterClose;
+        s << " SocketOptions=" << data.m_socketOptions;
         s << " }";
         return s;
     }
@@ -2039,6 +2141,9 @@ struct DownstreamSettings
     double m_reconnectWaitTimeInSeconds{10};
     ECheckAliveResponseMode m_checkAliveResponseMode{ECheckAliveResponseMode::eAUTO};
     ECheckState m_checkState{ECheckState::eSEND_AND_RECEIVE};
+    unsigned m_sendQueueHighWaterMark{262144}; // in bytes, 0: no warning
+    EXmlParserMode m_xmlParserMode{EXmlParserMode::eDOM}; // parser for received messages
+    SocketOptions m_socketOptions;
 
     DownstreamSettings() = default;
     DownstreamSettings(StringView machineId,
@@ -2055,7 +2160,10 @@ struct DownstreamSettings
             && lhs.m_checkAlivePeriodInSeconds == rhs.m_checkAlivePeriodInSeconds
             && lhs.m_reconnectWaitTimeInSeconds == rhs.m_reconnectWaitTimeInSeconds
             && lhs.m_checkAliveResponseMode == rhs.m_checkAliveResponseMode
-            && lhs.m_checkState == rhs.m_checkState;
+            && lhs.m_checkState == rhs.m_checkState
+            && lhs.m_sendQueueHighWaterMark == rhs.m_sendQueueHighWaterMark
+            && lhs.m_xmlParserMode == rhs.m_xmlParserMode
+            && lhs.m_socketOptions == rhs.m_socketOptions;
     }
     friend bool operator!=(const DownstreamSettings& lhs, const DownstreamSettings& rhs) { return !operator==(lhs, rhs); }
 
@@ -2069,6 +2177,9 @@ struct DownstreamSettings
         s << " ReconnectWaitTime=" << data.m_reconnectWaitTimeInSeconds;
         s << " CheckAliveResponseMode=" << data.m_checkAliveResponseMode;
         s << " CheckState=" << data.m_checkState;
+        s << " SendQueueHighWaterMark=" << data.m_sendQueueHighWaterMark;
+        s << " XmlParserMode=" << data.m_xmlParserMode;
+        s << " SocketOptions=" << data.m_socketOptions;
         s << " }";
         return s;
     }
@@ -2110,6 +2221,9 @@ struct VerticalServiceSettings
     double m_reconnectWaitTimeInSeconds{10};
     double m_checkAlivePeriodInSeconds{60};
     ECheckAliveResponseMode m_checkAliveResponseMode{ECheckAliveResponseMode::eAUTO};
+    unsigned m_sendQueueHighWaterMark{262144}; // in bytes, 0: no warning
+    EXmlParserMode m_xmlParserMode{EXmlParserMode::eDOM}; // parser for received messages
+    SocketOptions m_socketOptions;
 
     VerticalServiceSettings() = default;
     VerticalServiceSettings(StringView systemId,
@@ -2124,7 +2238,10 @@ struct VerticalServiceSettings
             && lhs.m_port == rhs.m_port
             && lhs.m_reconnectWaitTimeInSeconds == rhs.m_reconnectWaitTimeInSeconds
             && lhs.m_checkAlivePeriodInSeconds == rhs.m_checkAlivePeriodInSeconds
-            && lhs.m_checkAliveResponseMode == rhs.m_checkAliveResponseMode;
+            && lhs.m_checkAliveResponseMode == rhs.m_checkAliveResponseMode
+            && lhs.m_sendQueueHighWaterMark == rhs.m_sendQueueHighWaterMark
+            && lhs.m_xmlParserMode == rhs.m_xmlParserMode
+            && lhs.m_socketOptions == rhs.m_socketOptions;
     }
     friend bool operator!=(const VerticalServiceSettings& lhs, const VerticalServiceSettings& rhs) { return !operator==(lhs, rhs); }
 
@@ -2136,6 +2253,9 @@ struct VerticalServiceSettings
         s << " ReconnectWaitTime=" << data.m_reconnectWaitTimeInSeconds;
         s << " CheckAlivePeriod=" << data.m_checkAlivePeriodInSeconds;
         s << " CheckAliveResponseMode=" << data.m_checkAliveResponseMode;
+        s << " SendQueueHighWaterMark=" << data.m_sendQueueHighWaterMark;
+        s << " XmlParserMode=" << data.m_xmlParserMode;
+        s << " SocketOptions=" << data.m_socketOptions;
         s << " }";
         return s;
     }
@@ -2150,6 +2270,13 @@ struct VerticalClientSettings
     double m_reconnectWaitTimeInSeconds{10};
     double m_checkAlivePeriodInSeconds{60};
     ECheckAliveResponseMode m_checkAliveResponseMode{ECheckAliveResponseMode::eAUTO};
+    unsigned m_sendQueueHighWaterMark{262144}; // in bytes, 0: no warning
+    EXmlParserMode m_xmlParserMode{EXmlParserMode::eDOM}; // parser for received messages
+    double m_maxReconnectWaitTimeInSeconds{60}; // the wait time grows up to this, not at all if below m_reconnectWaitTimeInSeconds
+    double m_reconnectWaitTimeFactor{1}; // the wait time is multiplied by this after each failed attempt
+    double m_reconnectJitter{0}; // 0..1, the share of the wait time taken off at random, so that clients do not reconnect in lockstep
+    bool m_reconnectAtOnceAfterClose{false}; // reconnect without waiting when the peer has closed an established connection cleanly, but not twice in a row
+    SocketOptions m_socketOptions;
 
     VerticalClientSettings() = default;
     VerticalClientSettings(StringView systemId,
@@ -2167,7 +2294,14 @@ struct VerticalClientSettings
             && lhs.m_port == rhs.m_port
             && lhs.m_reconnectWaitTimeInSeconds == rhs.m_reconnectWaitTimeInSeconds
             && lhs.m_checkAlivePeriodInSeconds == rhs.m_checkAlivePeriodInSeconds
-            && lhs.m_checkAliveResponseMode == rhs.m_checkAliveResponseMode;
+            && lhs.m_checkAliveResponseMode == rhs.m_checkAliveResponseMode
+            && lhs.m_sendQueueHighWaterMark == rhs.m_sendQueueHighWaterMark
+            && lhs.m_xmlParserMode == rhs.m_xmlParserMode
+            && lhs.m_maxReconnectWaitTimeInSeconds == rhs.m_maxReconnectWaitTimeInSeconds
+            && lhs.m_reconnectWaitTimeFactor == rhs.m_reconnectWaitTimeFactor
+            && lhs.m_reconnectJitter == rhs.m_reconnectJitter
+            && lhs.m_reconnectAtOnceAfterClose == rhs.m_reconnectAtOnceAfterClose
+            && lhs.m_socketOptions == rhs.m_socketOptions;
     }
     friend bool operator!=(const VerticalClientSettings& lhs, const VerticalClientSettings& rhs) { return !operator==(lhs, rhs); }
 
@@ -2180,6 +2314,90 @@ struct VerticalClientSettings
         s << " ReconnectWaitTime=" << data.m_reconnectWaitTimeInSeconds;
         s << " CheckAlivePeriod=" << data.m_checkAlivePeriodInSeconds;
         s << " CheckAliveResponseMode=" << data.m_checkAliveResponseMode;
+        s << " SendQueueHighWaterMark=" << data.m_sendQueueHighWaterMark;
+        s << " XmlParserMode=" << data.m_xmlParserMode;
+        s << " MaxReconnectWaitTime=" << data.m_maxReconnectWaitTimeInSeconds;
+        s << " ReconnectWaitTimeFactor=" << data.m_reconnectWaitTimeFactor;
+        s << " ReconnectJitter=" << data.m_reconnectJitter;
+        s << " ReconnectAtOnceAfterClose=" << data.m_reconnectAtOnceAfterClose;
+        s << " SocketOptions=" << data.m_socketOptions;
+        s << " }";
+        return s;
+    }
+};
+
+//========== Traces passed on to the trace callback (not part of The Hermes Standard) ==========
+struct TraceFilter
+{
+    ETraceType m_minimumTraceType{ETraceType::eDEBUG}; // eDEBUG, eINFO, eWARNING or eERROR
+    bool m_traceSent{true}; // the eSENT traces
+    bool m_traceReceived{true}; // the eRECEIVED traces
+
+    TraceFilter() = default;
+    explicit TraceFilter(ETraceType minimumTraceType,
+        bool traceSent = true,
+        bool traceReceived = true) :
+        m_minimumTraceType(minimumTraceType),
+        m_traceSent(traceSent),
+        m_traceReceived(traceReceived)
+    {}
+
+    // whether a trace of that type is passed on
+    bool IsTraced(ETraceType type) const
+    {
+        switch (type)
+        {
+        case ETraceType::eSENT: return m_traceSent;
+        case ETraceType::eRECEIVED: return m_traceReceived;
+        default: return type >= m_minimumTraceType;
+        }
+    }
+
+    friend bool operator==(const TraceFilter& lhs, const TraceFilter& rhs)
+    {
+        return lhs.m_minimumTraceType == rhs.m_minimumTraceType
+            && lhs.m_traceSent == rhs.m_traceSent
+            && lhs.m_traceReceived == rhs.m_traceReceived;
+    }
+    friend bool operator!=(const TraceFilter& lhs, const TraceFilter& rhs) { return !operator==(lhs, rhs); }
+
+    template <class S> friend S& operator<<(S& s, const TraceFilter& data) 
+    {
+        s << '{';
+        s << " MinimumTraceType=" << data.m_minimumTraceType;
+        s << " TraceSent=" << data.m_traceSent;
+        s << " TraceReceived=" << data.m_traceReceived;
+        s << " }";
+        return s;
+    }
+};
+
+//========== Traces formatted and passed on by a background thread (not part of The Hermes Standard) ==========
+struct BackgroundTraceSettings
+{
+    unsigned m_bufferSize{1048576}; // in bytes, rounded up to a power of 2; traces are dropped when it is full
+    Optional<std::string> m_optionalFilePath; // none: the traces go to the trace callback
+    unsigned m_maxFileSize{10485760}; // in bytes, then the file is renamed to <path>.1 (and <path>.1 to <path>.2 and so on); 0: the file is never rotated
+    unsigned m_maxFileCount{5}; // including the current file
+
+    BackgroundTraceSettings() = default;
+
+    friend bool operator==(const BackgroundTraceSettings& lhs, const BackgroundTraceSettings& rhs)
+    {
+        return lhs.m_bufferSize == rhs.m_bufferSize
+            && lhs.m_optionalFilePath == rhs.m_optionalFilePath
+            && lhs.m_maxFileSize == rhs.m_maxFileSize
+            && lhs.m_maxFileCount == rhs.m_maxFileCount;
+    }
+    friend bool operator!=(const BackgroundTraceSettings& lhs, const BackgroundTraceSettings& rhs) { return !operator==(lhs, rhs); }
+
+    template <class S> friend S& operator<<(S& s, const BackgroundTraceSettings& data) 
+    {
+        s << '{';
+        s << " BufferSize=" << data.m_bufferSize;
+        if (data.m_optionalFilePath) { s << " FilePath=" << *data.m_optionalFilePath; }
+        s << " MaxFileSize=" << data.m_maxFileSize;
+        s << " MaxFileCount=" << data.m_maxFileCount;
         s << " }";
         return s;
     }
@@ -2223,6 +2441,8 @@ struct ConnectionInfo
     std::string m_address;
     uint16_t m_port{0};
     std::string m_hostName;
+    unsigned m_connectAttempts{0}; // the attempts it took to establish the connection, 0 for accepted connections
+    double m_downtimeInSeconds{0}; // since the previous connection was lost, 0 for the first connection
 
     ConnectionInfo() = default;
     ConnectionInfo(StringView address,
@@ -2237,7 +2457,9 @@ struct ConnectionInfo
     {
         return lhs.m_address == rhs.m_address
             && lhs.m_port == rhs.m_port
-            && lhs.m_hostName == rhs.m_hostName;
+            && lhs.m_hostName == rhs.m_hostName
+            && lhs.m_connectAttempts == rhs.m_connectAttempts
+            && lhs.m_downtimeInSeconds == rhs.m_downtimeInSeconds;
     }
     friend bool operator!=(const ConnectionInfo& lhs, const ConnectionInfo& rhs) { return !operator==(lhs, rhs); }
 
@@ -2247,6 +2469,8 @@ struct ConnectionInfo
         s << " Address=" << data.m_address;
         s << " Port=" << data.m_port;
         s << " HostName=" << data.m_hostName;
+        s << " ConnectAttempts=" << data.m_connectAttempts;
+        s << " Downtime=" << data.m_downtimeInSeconds;
         s << " }";
         return s;
     }
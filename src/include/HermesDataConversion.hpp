@@ -225,6 +225,16 @@ namespace Hermes
     inline void CppToC(ECheckAliveResponseMode data, EHermesCheckAliveResponseMode& result) { result = static_cast<EHermesCheckAliveResponseMode>(data); }
     inline void CToCpp(EHermesCheckAliveResponseMode data, ECheckAliveResponseMode& result) { result = static_cast<ECheckAliveResponseMode>(data); }
 
+    static_assert(size(EXmlParserMode()) == cHERMES_XML_PARSER_MODE_ENUM_SIZE, "enum mismatch");
+    inline void CppToC(EXmlParserMode data, EHermesXmlParserMode& result) { result = static_cast<EHermesXmlParserMode>(data); }
+    inline void CToCpp(EHermesXmlParserMode data, EXmlParserMode& result) { result = static_cast<EXmlParserMode>(data); }
+    inline EHermesXmlParserMode ToC(EXmlParserMode data) { return static_cast<EHermesXmlParserMode>(data); }
+    inline EXmlParserMode ToCpp(EHermesXmlParserMode data) { return static_cast<EXmlParserMode>(data); }
+
+    static_assert(size(ETransport()) == cHERMES_TRANSPORT_ENUM_SIZE, "enum mismatch");
+    inline void CppToC(ETransport data, EHermesTransport& result) { result = static_cast<EHermesTransport>(data); }
+    inline void CToCpp(EHermesTransport data, ETransport& result) { result = static_cast<ETransport>(data); }
+
     static_assert(size(EBoardArrivedTransfer()) == cHERMES_BOARD_ARRIVED_TRANSFER_ENUM_SIZE, "enum mismatch");
     inline void CppToC(EBoardArrivedTransfer data, EHermesBoardArrivedTransfer& result) { result = static_cast<EHermesBoardArrivedTransfer>(data); }
     inline void CToCpp(EHermesBoardArrivedTransfer data, EBoardArrivedTransfer& result) { result = static_cast<EBoardArrivedTransfer>(data); }
@@ -242,6 +252,31 @@ namespace Hermes
     inline EVerticalState ToCpp(EHermesVerticalState data) { return static_cast<EVerticalState>(data); }
 
 
+    // SocketOptions
+    inline void CppToC(const SocketOptions& data, HermesSocketOptions& result)
+    {
+        result.m_noDelay = data.m_noDelay ? 1U : 0U;
+        result.m_keepAlive = data.m_keepAlive ? 1U : 0U;
+        CppToC(data.m_keepAliveIdleInSeconds, result.m_keepAliveIdleInSeconds);
+        CppToC(data.m_keepAliveIntervalInSeconds, result.m_keepAliveIntervalInSeconds);
+        CppToC(data.m_sendBufferSize, result.m_sendBufferSize);
+        CppToC(data.m_receiveBufferSize, result.m_receiveBufferSize);
+        result.m_quickAck = data.m_quickAck ? 1U : 0U;
+        CppToC(data.m_transport, result.m_transport);
+    }
+
+    inline void CToCpp(const HermesSocketOptions& data, SocketOptions& result)
+    {
+        result.m_noDelay = data.m_noDelay != 0U;
+        result.m_keepAlive = data.m_keepAlive != 0U;
+        CToCpp(data.m_keepAliveIdleInSeconds, result.m_keepAliveIdleInSeconds);
+        CToCpp(data.m_keepAliveIntervalInSeconds, result.m_keepAliveIntervalInSeconds);
+        CToCpp(data.m_sendBufferSize, result.m_sendBufferSize);
+        CToCpp(data.m_receiveBufferSize, result.m_receiveBufferSize);
+        result.m_quickAck = data.m_quickAck != 0U;
+        CToCpp(data.m_transport, result.m_transport);
+    }
+
     // UpstreamConfiguration
     inline void CppToC(const UpstreamConfiguration& data, HermesUpstreamConfiguration& result)
     {
@@ -361,6 +396,8 @@ namespace Hermes
             CppToC(data.m_address, m_data.m_address);
             CppToC(data.m_port, m_data.m_port);
             CppToC(data.m_hostName, m_data.m_hostName);
+            CppToC(data.m_connectAttempts, m_data.m_connectAttempts);
+            CppToC(data.m_downtimeInSeconds, m_data.m_downtimeInSeconds);
         }
     };
     inline ConnectionInfo ToCpp(const HermesConnectionInfo& data)
@@ -369,6 +406,8 @@ namespace Hermes
         CToCpp(data.m_address, result.m_address);
         CToCpp(data.m_port, result.m_port);
         CToCpp(data.m_hostName, result.m_hostName);
+        CToCpp(data.m_connectAttempts, result.m_connectAttempts);
+        CToCpp(data.m_downtimeInSeconds, result.m_downtimeInSeconds);
         return result;
     }
 
@@ -1286,6 +1325,13 @@ namespace Hermes
             CppToC(data.m_reconnectWaitTimeInSeconds, m_data.m_reconnectWaitTimeInSeconds);
             CppToC(data.m_checkAliveResponseMode, m_data.m_checkAliveResponseMode);
             CppToC(data.m_checkState, m_data.m_checkState);
+            CppToC(data.m_sendQueueHighWaterMark, m_data.m_sendQueueHighWaterMark);
+            CppToC(data.m_xmlParserMode, m_data.m_xmlParserMode);
+            CppToC(data.m_maxReconnectWaitTimeInSeconds, m_data.m_maxReconnectWaitTimeInSeconds);
+            CppToC(data.m_reconnectWaitTimeFactor, m_data.m_reconnectWaitTimeFactor);
+            CppToC(data.m_reconnectJitter, m_data.m_reconnectJitter);
+            m_data.m_reconnectAtOnceAfterClose = data.m_reconnectAtOnceAfterClose ? 1U : 0U;
+            CppToC(data.m_socketOptions, m_data.m_socketOptions);
         }
     };
     inline UpstreamSettings ToCpp(const HermesUpstreamSettings& data)
@@ -1298,6 +1344,13 @@ namespace Hermes
         CToCpp(data.m_reconnectWaitTimeInSeconds, result.m_reconnectWaitTimeInSeconds);
         CToCpp(data.m_checkAliveResponseMode, result.m_checkAliveResponseMode);
         CToCpp(data.m_checkState, result.m_checkState);
+        CToCpp(data.m_sendQueueHighWaterMark, result.m_sendQueueHighWaterMark);
+        CToCpp(data.m_xmlParserMode, result.m_xmlParserMode);
+        CToCpp(data.m_maxReconnectWaitTimeInSeconds, result.m_maxReconnectWaitTimeInSeconds);
+        CToCpp(data.m_reconnectWaitTimeFactor, result.m_reconnectWaitTimeFactor);
+        CToCpp(data.m_reconnectJitter, result.m_reconnectJitter);
+        result.m_reconnectAtOnceAfterClose = data.m_reconnectAtOnceAfterClose != 0U;
+        CToCpp(data.m_socketOptions, result.m_socketOptions);
         return result;
     }
 
@@ -1314,6 +1367,9 @@ namespace Hermes
             CppToC(data.m_reconnectWaitTimeInSeconds, m_data.m_reconnectWaitTimeInSeconds);
             CppToC(data.m_checkAliveResponseMode, m_data.m_checkAliveResponseMode);
             CppToC(data.m_checkState, m_data.m_checkState);
+            CppToC(data.m_sendQueueHighWaterMark, m_data.m_sendQueueHighWaterMark);
+            CppToC(data.m_xmlParserMode, m_data.m_xmlParserMode);
+            CppToC(data.m_socketOptions, m_data.m_socketOptions);
         }
     };
     inline DownstreamSettings ToCpp(const HermesDownstreamSettings& data)
@@ -1326,6 +1382,9 @@ namespace Hermes
         CToCpp(data.m_reconnectWaitTimeInSeconds, result.m_reconnectWaitTimeInSeconds);
         CToCpp(data.m_checkAliveResponseMode, result.m_checkAliveResponseMode);
         CToCpp(data.m_checkState, result.m_checkState);
+        CToCpp(data.m_sendQueueHighWaterMark, result.m_sendQueueHighWaterMark);
+        CToCpp(data.m_xmlParserMode, result.m_xmlParserMode);
+        CToCpp(data.m_socketOptions, result.m_socketOptions);
         return result;
     }
 
@@ -1358,6 +1417,9 @@ namespace Hermes
             CppToC(data.m_reconnectWaitTimeInSeconds, m_data.m_reconnectWaitTimeInSeconds);
             CppToC(data.m_checkAlivePeriodInSeconds, m_data.m_checkAlivePeriodInSeconds);
             CppToC(data.m_checkAliveResponseMode, m_data.m_checkAliveResponseMode);
+            CppToC(data.m_sendQueueHighWaterMark, m_data.m_sendQueueHighWaterMark);
+            CppToC(data.m_xmlParserMode, m_data.m_xmlParserMode);
+            CppToC(data.m_socketOptions, m_data.m_socketOptions);
         }
     };
     inline VerticalServiceSettings ToCpp(const HermesVerticalServiceSettings& data)
@@ -1368,6 +1430,9 @@ namespace Hermes
         CToCpp(data.m_reconnectWaitTimeInSeconds, result.m_reconnectWaitTimeInSeconds);
         CToCpp(data.m_checkAlivePeriodInSeconds, result.m_checkAlivePeriodInSeconds);
         CToCpp(data.m_checkAliveResponseMode, result.m_checkAliveResponseMode);
+        CToCpp(data.m_sendQueueHighWaterMark, result.m_sendQueueHighWaterMark);
+        CToCpp(data.m_xmlParserMode, result.m_xmlParserMode);
+        CToCpp(data.m_socketOptions, result.m_socketOptions);
         return result;
     }
 
@@ -1383,6 +1448,13 @@ namespace Hermes
             CppToC(data.m_reconnectWaitTimeInSeconds, m_data.m_reconnectWaitTimeInSeconds);
             CppToC(data.m_checkAlivePeriodInSeconds, m_data.m_checkAlivePeriodInSeconds);
             CppToC(data.m_checkAliveResponseMode, m_data.m_checkAliveResponseMode);
+            CppToC(data.m_sendQueueHighWaterMark, m_data.m_sendQueueHighWaterMark);
+            CppToC(data.m_xmlParserMode, m_data.m_xmlParserMode);
+            CppToC(data.m_maxReconnectWaitTimeInSeconds, m_data.m_maxReconnectWaitTimeInSeconds);
+            CppToC(data.m_reconnectWaitTimeFactor, m_data.m_reconnectWaitTimeFactor);
+            CppToC(data.m_reconnectJitter, m_data.m_reconnectJitter);
+            m_data.m_reconnectAtOnceAfterClose = data.m_reconnectAtOnceAfterClose ? 1U : 0U;
+            CppToC(data.m_socketOptions, m_data.m_socketOptions);
         }
     };
     inline VerticalClientSettings ToCpp(const HermesVerticalClientSettings& data)
@@ -1394,6 +1466,55 @@ namespace Hermes
         CToCpp(data.m_reconnectWaitTimeInSeconds, result.m_reconnectWaitTimeInSeconds);
         CToCpp(data.m_checkAlivePeriodInSeconds, result.m_checkAlivePeriodInSeconds);
         CToCpp(data.m_checkAliveResponseMode, result.m_checkAliveResponseMode);
+        CToCpp(data.m_sendQueueHighWaterMark, result.m_sendQueueHighWaterMark);
+        CToCpp(data.m_xmlParserMode, result.m_xmlParserMode);
+        CToCpp(data.m_maxReconnectWaitTimeInSeconds, result.m_maxReconnectWaitTimeInSeconds);
+        CToCpp(data.m_reconnectWaitTimeFactor, result.m_reconnectWaitTimeFactor);
+        CToCpp(data.m_reconnectJitter, result.m_reconnectJitter);
+        result.m_reconnectAtOnceAfterClose = data.m_reconnectAtOnceAfterClose != 0U;
+        CToCpp(data.m_socketOptions, result.m_socketOptions);
+        return result;
+    }
+
+    // TraceFilter
+    template<>
+    struct Converter2C<TraceFilter> : ConverterBase<HermesTraceFilter>
+    {
+        Converter2C(const TraceFilter& data)
+        {
+            m_data.m_minimumTraceType = ToC(data.m_minimumTraceType);
+            m_data.m_traceSent = data.m_traceSent ? 1U : 0U;
+            m_data.m_traceReceived = data.m_traceReceived ? 1U : 0U;
+        }
+    };
+    inline TraceFilter ToCpp(const HermesTraceFilter& data)
+    {
+        TraceFilter result;
+        result.m_minimumTraceType = ToCpp(data.m_minimumTraceType);
+        result.m_traceSent = data.m_traceSent != 0U;
+        result.m_traceReceived = data.m_traceReceived != 0U;
+        return result;
+    }
+
+    // BackgroundTraceSettings
+    template<>
+    struct Converter2C<BackgroundTraceSettings> : ConverterBase<HermesBackgroundTraceSettings>
+    {
+        Converter2C(const BackgroundTraceSettings& data)
+        {
+            CppToC(data.m_bufferSize, m_data.m_bufferSize);
+            CppToC(data.m_optionalFilePath, m_data.m_filePath);
+            CppToC(data.m_maxFileSize, m_data.m_maxFileSize);
+            CppToC(data.m_maxFileCount, m_data.m_maxFileCount);
+        }
+    };
+    inline BackgroundTraceSettings ToCpp(const HermesBackgroundTraceSettings& data)
+    {
+        BackgroundTraceSettings result;
+        CToCpp(data.m_bufferSize, result.m_bufferSize);
+        CToCpp(data.m_filePath, result.m_optionalFilePath);
+        CToCpp(data.m_maxFileSize, result.m_maxFileSize);
+        CToCpp(data.m_maxFileCount, result.m_maxFileCount);
         return result;
     }
 
@@ -16,10 +16,12 @@ limitations under the License.
 
 // Copyright (c) ASM Assembly Systems GmbH & Co. KG
 //
-// in order to avoid dependencies on boost and >= C++11, we roll out our own stripped down optional class
+// in order to avoid dependencies on boost and >= C++17, we roll out our own stripped down optional class
 #pragma once
 
 #include <cassert>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace Hermes
@@ -30,56 +32,143 @@ namespace Hermes
     public:
         Optional() : m_hasValue(false) {}
 
-        Optional(const T& value) : m_hasValue(true), m_value(value) {}
+        Optional(const T& value) : m_hasValue(false) { Construct_(value); }
+        Optional(T&& value) : m_hasValue(false) { Construct_(std::move(value)); }
         template<class U1, class U2>
-        Optional(const U1& u1, const U2& u2) : m_hasValue(true), m_value(u1, u2) {}
+        Optional(U1&& u1, U2&& u2) : m_hasValue(false) { Construct_(std::forward<U1>(u1), std::forward<U2>(u2)); }
 
-        // for the time being, avoid C++11 and its variadic templates for better compatibility. Up to two params should do for Hermes ...
-        Optional& emplace() { m_value = T(); m_hasValue = true; return *this; }
-        template<class U>
-        Optional& emplace(const U& u) { m_value = T(u); m_hasValue = true; return *this; }
-        template<class U1, class U2>
-        Optional& emplace(const U1& u1, const U2& u2) { m_value = T(u1, u2); m_hasValue = true; return *this; }
+        Optional(const Optional& rhs) : m_hasValue(false)
+        {
+            if (rhs.m_hasValue)
+            {
+                Construct_(*rhs);
+            }
+        }
+        Optional(Optional&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) : m_hasValue(false)
+        {
+            if (rhs.m_hasValue)
+            {
+                Construct_(std::move(*rhs));
+            }
+        }
+
+        ~Optional() { reset(); }
+
+        Optional& operator=(const Optional& rhs)
+        {
+            if (!rhs.m_hasValue)
+            {
+                reset();
+            }
+            else if (m_hasValue)
+            {
+                **this = *rhs;
+            }
+            else
+            {
+                Construct_(*rhs);
+            }
+            return *this;
+        }
+        Optional& operator=(Optional&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value
+            && std::is_nothrow_move_assignable<T>::value)
+        {
+            if (!rhs.m_hasValue)
+            {
+                reset();
+            }
+            else if (m_hasValue)
+            {
+                **this = std::move(*rhs);
+            }
+            else
+            {
+                Construct_(std::move(*rhs));
+            }
+            return *this;
+        }
 
         Optional& operator=(const T& value)
         {
-            m_hasValue = true;
-            m_value = value;
+            if (m_hasValue)
+            {
+                **this = value;
+            }
+            else
+            {
+                Construct_(value);
+            }
+            return *this;
+        }
+        Optional& operator=(T&& value)
+        {
+            if (m_hasValue)
+            {
+                **this = std::move(value);
+            }
+            else
+            {
+                Construct_(std::move(value));
+            }
             return *this;
         }
 
-        const T* operator->() const { assert(m_hasValue);  return &m_value; }
-        T* operator->() { assert(m_hasValue);  return &m_value; }
+        // constructs the value anew from the arguments, destroying any previous one
+        template<class... Args>
+        Optional& emplace(Args&&... args)
+        {
+            reset();
+            Construct_(std::forward<Args>(args)...);
+            return *this;
+        }
+
+        const T* operator->() const { assert(m_hasValue);  return Pointer_(); }
+        T* operator->() { assert(m_hasValue);  return Pointer_(); }
 
-        const T& operator*() const { assert(m_hasValue);  return m_value; }
-        T& operator*() { assert(m_hasValue);  return m_value; }
+        const T& operator*() const { assert(m_hasValue);  return *Pointer_(); }
+        T& operator*() { assert(m_hasValue);  return *Pointer_(); }
 
         typedef bool Optional::*UnspecifiedBoolType;
         operator UnspecifiedBoolType() const { return m_hasValue ? &Optional::m_hasValue : 0; }
         bool operator!() const { return !m_hasValue; }
         bool has_value() const { return m_hasValue; }
         
-        const T& value_or(const T& other) const { return m_hasValue ? m_value : other; }
-        T& value_or(T& other) { return m_hasValue ? m_value : other; }
+        const T& value_or(const T& other) const { return m_hasValue ? **this : other; }
+        T& value_or(T& other) { return m_hasValue ? **this : other; }
 
         void swap(Optional& rhs)
         {
-            using std::swap;
-            swap(m_hasValue, rhs.m_hasValue);
-            swap(m_value, rhs.m_value);
+            if (m_hasValue && rhs.m_hasValue)
+            {
+                using std::swap;
+                swap(**this, *rhs);
+            }
+            else if (m_hasValue)
+            {
+                rhs.Construct_(std::move(**this));
+                reset();
+            }
+            else if (rhs.m_hasValue)
+            {
+                Construct_(std::move(*rhs));
+                rhs.reset();
+            }
         }
         friend void swap(Optional& lhs, Optional& rhs) { lhs.swap(rhs); }
 
         void reset() 
         { 
+            if (!m_hasValue)
+                return;
+
+            Pointer_()->~T();
             m_hasValue = false;
-            m_value = T();
         }
 
         friend bool operator==(const Optional& lhs, const Optional& rhs)
         {
             if (lhs.m_hasValue && rhs.m_hasValue)
-                return lhs.m_value == rhs.m_value;
+                return *lhs == *rhs;
             
             return lhs.m_hasValue == rhs.m_hasValue;
         }
@@ -90,7 +179,7 @@ namespace Hermes
         {
             if (o.m_hasValue)
             {
-                s << o.m_value;
+                s << *o;
             }
             else
             {
@@ -100,8 +189,18 @@ namespace Hermes
         }
 
     private:
+        template<class... Args>
+        void Construct_(Args&&... args)
+        {
+            assert(!m_hasValue);
+            ::new (static_cast<void*>(m_storage)) T(std::forward<Args>(args)...);
+            m_hasValue = true;
+        }
+
+        T* Pointer_() { return reinterpret_cast<T*>(m_storage); }
+        const T* Pointer_() const { return reinterpret_cast<const T*>(m_storage); }
 
         bool m_hasValue;
-        T m_value;
+        alignas(T) unsigned char m_storage[sizeof(T)]; // holds a T if m_hasValue
     };
 }
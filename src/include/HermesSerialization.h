@@ -59,6 +59,35 @@ extern "C" {
     HERMESPROTOCOL_API void HermesSerializeQueryHermesCapabilities(const HermesQueryHermesCapabilitiesData*, HermesSerializationCallback);
     HERMESPROTOCOL_API void HermesSerializeSendHermesCapabilities(const HermesSendHermesCapabilitiesData*, HermesSerializationCallback);
 
+    // The same into a buffer of the caller, straight from the C data: returns the size of the xml, which is only written
+    // if it fits into bufferSize. No terminating zero is written. Once the storage of the calling thread has grown to
+    // the size of the messages, nothing gets allocated.
+    HERMESPROTOCOL_API size_t HermesSerializeServiceDescriptionToBuffer(const HermesServiceDescriptionData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeBoardAvailableToBuffer(const HermesBoardAvailableData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeRevokeBoardAvailableToBuffer(const HermesRevokeBoardAvailableData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeMachineReadyToBuffer(const HermesMachineReadyData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeRevokeMachineReadyToBuffer(const HermesRevokeMachineReadyData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeStartTransportToBuffer(const HermesStartTransportData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeStopTransportToBuffer(const HermesStopTransportData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeTransportFinishedToBuffer(const HermesTransportFinishedData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeBoardForecastToBuffer(const HermesBoardForecastData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeQueryBoardInfoToBuffer(const HermesQueryBoardInfoData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeSendBoardInfoToBuffer(const HermesSendBoardInfoData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeNotificationToBuffer(const HermesNotificationData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeCheckAliveToBuffer(const HermesCheckAliveData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeGetConfigurationToBuffer(const HermesGetConfigurationData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeSetConfigurationToBuffer(const HermesSetConfigurationData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeCurrentConfigurationToBuffer(const HermesCurrentConfigurationData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeSupervisoryServiceDescriptionToBuffer(const HermesSupervisoryServiceDescriptionData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeBoardArrivedToBuffer(const HermesBoardArrivedData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeBoardDepartedToBuffer(const HermesBoardDepartedData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeQueryWorkOrderInfoToBuffer(const HermesQueryWorkOrderInfoData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeSendWorkOrderInfoToBuffer(const HermesSendWorkOrderInfoData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeReplyWorkOrderInfoToBuffer(const HermesReplyWorkOrderInfoData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeCommandToBuffer(const HermesCommandData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeQueryHermesCapabilitiesToBuffer(const HermesQueryHermesCapabilitiesData*, char* pBuffer, size_t bufferSize);
+    HERMESPROTOCOL_API size_t HermesSerializeSendHermesCapabilitiesToBuffer(const HermesSendHermesCapabilitiesData*, char* pBuffer, size_t bufferSize);
+
     // Deserialize (just for unit testing)
     struct HermesDeserializationErrorCallback
     {
@@ -223,6 +252,17 @@ extern "C" {
         HermesDeserializedSendHermesCapabilitiesCallback m_sendHermesCapabilitiesCallback;
     };
     HERMESPROTOCOL_API void HermesDeserialize(HermesStringView, const HermesDeserializationCallbacks*);
+    // the same with a choice of parser, see EHermesXmlParserMode
+    HERMESPROTOCOL_API void HermesDeserializeWithParser(HermesStringView, EHermesXmlParserMode, const HermesDeserializationCallbacks*);
+
+    // For deserializing many messages: the handle keeps its dispatch tables and parse storage from call to call.
+    // A handle must not be used by more than one thread at a time, but each thread may have its own.
+    struct HermesDeserializer; // the opaque handle to the deserializer
+    HERMESPROTOCOL_API HermesDeserializer* CreateHermesDeserializer(EHermesXmlParserMode);
+    HERMESPROTOCOL_API void HermesDeserializeWith(HermesDeserializer*, HermesStringView, const HermesDeserializationCallbacks*);
+    // the same, but parses the caller's buffer in place, which makes its content undefined afterwards
+    HERMESPROTOCOL_API void HermesDeserializeInPlaceWith(HermesDeserializer*, char* pXml, size_t size, const HermesDeserializationCallbacks*);
+    HERMESPROTOCOL_API void DeleteHermesDeserializer(HermesDeserializer*);
 
 #ifdef __cplusplus
 }
@@ -23,6 +23,104 @@ limitations under the License.
 namespace Hermes
 {
 
+#ifdef HERMES_CPP_ABI
+    // Built with the same compiler as the library, the data goes to and from its serializer as it is,
+    // instead of being converted to C and back:
+    struct IDeserializationCallback
+    {
+        virtual void On(ServiceDescriptionData&&) {}
+        virtual void On(BoardAvailableData&&) {}
+        virtual void On(RevokeBoardAvailableData&&) {}
+        virtual void On(MachineReadyData&&) {}
+        virtual void On(RevokeMachineReadyData&&) {}
+        virtual void On(StartTransportData&&) {}
+        virtual void On(StopTransportData&&) {}
+        virtual void On(TransportFinishedData&&) {}
+        virtual void On(BoardForecastData&&) {}
+        virtual void On(QueryBoardInfoData&&) {}
+        virtual void On(SendBoardInfoData&&) {}
+        virtual void On(NotificationData&&) {}
+        virtual void On(CheckAliveData&&) {}
+        virtual void On(GetConfigurationData&&) {}
+        virtual void On(SetConfigurationData&&) {}
+        virtual void On(CurrentConfigurationData&&) {}
+        virtual void On(SupervisoryServiceDescriptionData&&) {}
+        virtual void On(BoardArrivedData&&) {}
+        virtual void On(BoardDepartedData&&) {}
+        virtual void On(QueryWorkOrderInfoData&&) {}
+        virtual void On(SendWorkOrderInfoData&&) {}
+        virtual void On(ReplyWorkOrderInfoData&&) {}
+        virtual void On(CommandData&&) {}
+        virtual void On(QueryHermesCapabilitiesData&&) {}
+        virtual void On(SendHermesCapabilitiesData&&) {}
+
+        virtual ~IDeserializationCallback() = default;
+    };
+
+    HERMESPROTOCOL_API std::string SerializeHermes(const ServiceDescriptionData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const BoardAvailableData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const RevokeBoardAvailableData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const MachineReadyData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const RevokeMachineReadyData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const StartTransportData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const StopTransportData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const TransportFinishedData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const BoardForecastData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const QueryBoardInfoData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const SendBoardInfoData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const NotificationData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const CheckAliveData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const GetConfigurationData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const SetConfigurationData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const CurrentConfigurationData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const SupervisoryServiceDescriptionData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const BoardArrivedData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const BoardDepartedData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const QueryWorkOrderInfoData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const SendWorkOrderInfoData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const ReplyWorkOrderInfoData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const CommandData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const QueryHermesCapabilitiesData&);
+    HERMESPROTOCOL_API std::string SerializeHermes(const SendHermesCapabilitiesData&);
+    HERMESPROTOCOL_API void DeserializeHermes(StringView xml, EXmlParserMode, IDeserializationCallback&);
+    HERMESPROTOCOL_API void DeserializeHermes(HermesDeserializer*, StringView xml, IDeserializationCallback&);
+    HERMESPROTOCOL_API void DeserializeHermesInPlace(HermesDeserializer*, char* pXml, std::size_t size, IDeserializationCallback&);
+
+    inline std::string ToXml(const ServiceDescriptionData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const BoardAvailableData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const RevokeBoardAvailableData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const MachineReadyData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const RevokeMachineReadyData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const StartTransportData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const StopTransportData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const TransportFinishedData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const BoardForecastData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const QueryBoardInfoData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const SendBoardInfoData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const NotificationData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const CheckAliveData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const GetConfigurationData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const SetConfigurationData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const CurrentConfigurationData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const SupervisoryServiceDescriptionData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const BoardArrivedData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const BoardDepartedData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const QueryWorkOrderInfoData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const SendWorkOrderInfoData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const ReplyWorkOrderInfoData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const CommandData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const QueryHermesCapabilitiesData& data) { return SerializeHermes(data); }
+    inline std::string ToXml(const SendHermesCapabilitiesData& data) { return SerializeHermes(data); }
+
+    template<class DataT>
+    struct DeserializationCallback_ : IDeserializationCallback
+    {
+        using IDeserializationCallback::On;
+        void On(DataT&& data) override { m_optionalData = std::move(data); }
+
+        Optional<DataT> m_optionalData;
+    };
+#else
     template<class DataT, class SerializationFunctionT>
     std::string SerializeToXml_(const DataT& data, SerializationFunctionT serializationFunction)
     {
@@ -62,7 +160,7 @@ namespace Hermes
     inline std::string ToXml(const CommandData& data) { return SerializeToXml_(data, &::HermesSerializeCommand); }
     inline std::string ToXml(const QueryHermesCapabilitiesData& data) { return SerializeToXml_(data, &::HermesSerializeQueryHermesCapabilities); }
     inline std::string ToXml(const SendHermesCapabilitiesData& data) { return SerializeToXml_(data, &::HermesSerializeSendHermesCapabilities); }
-
+#endif
 
     template<class DataT>
     void SetDeserializationCallback_(Optional<DataT>& optionalData, HermesDeserializationCallbacks& callbacks);
@@ -296,14 +394,69 @@ namespace Hermes
     }
     
     template<class DataT>
-    Optional<DataT> FromXml(StringView xml)
+    Optional<DataT> FromXml(StringView xml, EXmlParserMode parserMode = EXmlParserMode::eDOM)
     {
+#ifdef HERMES_CPP_ABI
+        DeserializationCallback_<DataT> callback;
+        DeserializeHermes(xml, parserMode, callback);
+        return std::move(callback.m_optionalData);
+#else
         Optional<DataT> optionalData; 
         HermesDeserializationCallbacks callbacks{};
         SetDeserializationCallback_(optionalData, callbacks);
-        ::HermesDeserialize(ToC(xml), &callbacks);
+        ::HermesDeserializeWithParser(ToC(xml), ToC(parserMode), &callbacks);
         return optionalData;
+#endif
     }
 
+    // Reuses its dispatch tables and parse storage for every message, see ::CreateHermesDeserializer.
+    // Not to be shared between threads, but each thread may have its own.
+    class Deserializer
+    {
+    public:
+        explicit Deserializer(EXmlParserMode parserMode = EXmlParserMode::eDOM) :
+            m_pImpl(::CreateHermesDeserializer(ToC(parserMode)))
+        {}
+        Deserializer(const Deserializer&) = delete;
+        Deserializer& operator=(const Deserializer&) = delete;
+        ~Deserializer() { ::DeleteHermesDeserializer(m_pImpl); }
+
+        template<class DataT>
+        Optional<DataT> FromXml(StringView xml)
+        {
+#ifdef HERMES_CPP_ABI
+            DeserializationCallback_<DataT> callback;
+            DeserializeHermes(m_pImpl, xml, callback);
+            return std::move(callback.m_optionalData);
+#else
+            Optional<DataT> optionalData;
+            HermesDeserializationCallbacks callbacks{};
+            SetDeserializationCallback_(optionalData, callbacks);
+            ::HermesDeserializeWith(m_pImpl, ToC(xml), &callbacks);
+            return optionalData;
+#endif
+        }
+
+        // parses xml in place, leaving its content undefined
+        template<class DataT>
+        Optional<DataT> FromXmlInPlace(char* pXml, std::size_t size)
+        {
+#ifdef HERMES_CPP_ABI
+            DeserializationCallback_<DataT> callback;
+            DeserializeHermesInPlace(m_pImpl, pXml, size, callback);
+            return std::move(callback.m_optionalData);
+#else
+            Optional<DataT> optionalData;
+            HermesDeserializationCallbacks callbacks{};
+            SetDeserializationCallback_(optionalData, callbacks);
+            ::HermesDeserializeInPlaceWith(m_pImpl, pXml, size, &callbacks);
+            return optionalData;
+#endif
+        }
+
+    private:
+        HermesDeserializer* m_pImpl;
+    };
+
 }
 
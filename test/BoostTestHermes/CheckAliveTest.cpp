@@ -136,3 +136,47 @@ BOOST_AUTO_TEST_CASE(ApplicationCheckAliveResponseTest)
 
 }
 
+
+BOOST_AUTO_TEST_CASE(PeriodicCheckAliveTest)
+{
+    TestCaseScope scope("PeriodicCheckAliveTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+    UpstreamSink  upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+    // only the upstream sends CheckAlive periodically
+    DownstreamSettings downstreamSettings{upstreamMachineId, 50125};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    downstream.Enable(downstreamSettings);
+
+    Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50125);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0.2;
+    upstream.Enable(upstreamSettings);
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+    downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+    // the periodic CheckAlive (without id) goes out a period after the last message sent, not earlier:
+    for (int i = 0; i < 3; ++i)
+    {
+        auto sentAt = std::chrono::steady_clock::now();
+        upstream.Signal(upstreamSink.m_sessionId, CheckAliveData{ECheckAliveType::ePONG, std::to_string(i)});
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_checkAliveData.m_optionalId == std::to_string(i); });
+        WaitFor(downstreamSink, [&]() { return !downstreamSink.m_checkAliveData.m_optionalId; });
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - sentAt;
+        BOOST_TEST(elapsed.count() >= 0.2);
+    }
+}
@@ -19,6 +19,15 @@ limitations under the License.
 #include "Runner.h"
 #include "Sinks.h"
 
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 using namespace Hermes;
 
 BOOST_AUTO_TEST_CASE(DownstreamPostTest)
@@ -257,3 +266,677 @@ BOOST_AUTO_TEST_CASE(DownstreamHostNotAlloweHostTest)
     }
 }
 
+
+BOOST_AUTO_TEST_CASE(DownstreamLargeMessageTest)
+{
+    TestCaseScope scope("DownstreamLargeMessageTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+    UpstreamSink  upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+    DownstreamSettings downstreamSettings{upstreamMachineId, 50101};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    downstream.Enable(downstreamSettings);
+
+    Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50101);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upstream.Enable(upstreamSettings);
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+    downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+    // a message close to the maximum size needs many receive calls and makes the receive window grow:
+    BoardAvailableData largeData{"0e4c18f9-5f69-4dbe-9b1c-e705bf7d680f", "123456", EBoardQuality::eGOOD,
+        EFlippedBoard::eTOP_SIDE_IS_UP};
+    for (uint16_t i{0}; i < 1777; ++i)
+    {
+        largeData.m_optionalSubBoards.emplace_back();
+        largeData.m_optionalSubBoards.back().m_pos = i + 1;
+        largeData.m_optionalSubBoards.back().m_optionalBc = std::to_string(i);
+    }
+    downstream.Signal(downstreamSink.m_sessionId, largeData);
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eBOARD_AVAILABLE; });
+    BOOST_TEST(upstreamSink.m_boardAvailableData == largeData);
+
+    // ... and small messages following it must still be framed correctly:
+    downstream.Signal(downstreamSink.m_sessionId, RevokeBoardAvailableData());
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+    BoardAvailableData smallData{"SmallBoardId", "SmallCreatedBy", EBoardQuality::eGOOD, EFlippedBoard::eTOP_SIDE_IS_UP};
+    downstream.Signal(downstreamSink.m_sessionId, smallData);
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eBOARD_AVAILABLE; });
+    BOOST_TEST(upstreamSink.m_boardAvailableData == smallData);
+}
+
+BOOST_AUTO_TEST_CASE(DownstreamMaxMessageSizeTest)
+{
+    TestCaseScope scope("DownstreamMaxMessageSizeTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+    UpstreamSink  upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+    DownstreamSettings downstreamSettings{upstreamMachineId, 50101};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    downstream.Enable(downstreamSettings);
+
+    Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50101);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upstream.Enable(upstreamSettings);
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+
+    // a notification of the given size as raw xml, which the upstream sends in a single write:
+    auto notificationXml = [](std::size_t size, char c)
+    {
+        const std::string start = "<Hermes><Notification NotificationCode=\"1\" Severity=\"3\" Description=\"";
+        const std::string end = "\"/></Hermes>";
+        return start + std::string(size - start.size() - end.size(), c) + end;
+    };
+
+    // messages of the maximum size pass, also once the receive window has grown to that size:
+    for (char c : {'a', 'b', 'c', 'd'})
+    {
+        upstream.Signal(upstreamSink.m_sessionId, notificationXml(cMAX_MESSAGE_SIZE, c));
+        WaitFor(downstreamSink, [&]()
+        {
+            const auto& description = downstreamSink.m_notificationData.m_description;
+            return !description.empty() && description.front() == c;
+        });
+    }
+
+    // ... but a single byte more is too much, however it gets chunked on its way:
+    upstream.Signal(upstreamSink.m_sessionId, notificationXml(cMAX_MESSAGE_SIZE + 1U, 'e'));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eDISCONNECTED; });
+    BOOST_TEST(downstreamSink.m_notificationData.m_description.front() == 'd');
+}
+
+BOOST_AUTO_TEST_CASE(DownstreamSendBurstTest)
+{
+    TestCaseScope scope("DownstreamSendBurstTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+    UpstreamSink  upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+    // a small high water mark, so that the burst below exceeds it:
+    DownstreamSettings downstreamSettings{upstreamMachineId, 50101};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    downstreamSettings.m_sendQueueHighWaterMark = 65536;
+    downstream.Enable(downstreamSettings);
+
+    Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50101);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upstream.Enable(upstreamSettings);
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+    downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+    // keep the upstream side from reading, so that the messages below pile up in the send queue:
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool blocked = true;
+    upstream.Post([&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (blocked)
+            cv.wait(lock);
+    });
+
+    std::string description(32000U, 'x');
+    NotificationData notification(ENotificationCode::eUNSPECIFIC, ESeverity::eINFO, description);
+    for (auto i = 0; i < 200; ++i)
+    {
+        notification.m_description = description + std::to_string(i);
+        downstream.Signal(downstreamSink.m_sessionId, notification);
+    }
+
+    // the downstream side stays responsive meanwhile:
+    bool posted = false;
+    downstream.Post([&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        posted = true;
+        cv.notify_all();
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!posted)
+            cv.wait(lock);
+        blocked = false;
+        cv.notify_all();
+    }
+
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_notificationData == notification; });
+
+    // the connection is still usable afterwards:
+    upstream.Signal(upstreamSink.m_sessionId, MachineReadyData());
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eMACHINE_READY; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eMACHINE_READY; });
+}
+
+BOOST_AUTO_TEST_CASE(DownstreamCloseWithFullQueueTest)
+{
+    TestCaseScope scope("DownstreamCloseWithFullQueueTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+    UpstreamSink  upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+    DownstreamSettings downstreamSettings{upstreamMachineId, 50101};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    downstream.Enable(downstreamSettings);
+
+    Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50101);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upstream.Enable(upstreamSettings);
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+    downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+    // keep the upstream side from reading, so that the messages below pile up in the send queue:
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool blocked = true;
+    upstream.Post([&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (blocked)
+            cv.wait(lock);
+    });
+
+    NotificationData notification(ENotificationCode::eUNSPECIFIC, ESeverity::eINFO, std::string(32000U, 'x'));
+    for (auto i = 0; i < 200; ++i)
+    {
+        downstream.Signal(downstreamSink.m_sessionId, notification);
+    }
+
+    // the notification of the disable goes to the end of the queue, and closing waits for all of it to be sent:
+    NotificationData disableNotification(ENotificationCode::eMACHINE_SHUTDOWN, ESeverity::eINFO, "Disabled with a full queue");
+    downstream.Disable(disableNotification);
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eDISCONNECTED; });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        blocked = false;
+        cv.notify_all();
+    }
+
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_notificationData == disableNotification; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eDISCONNECTED; });
+}
+
+BOOST_AUTO_TEST_CASE(DownstreamSteadyStateParseTest)
+{
+    TestCaseScope scope("DownstreamSteadyStateParseTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+    UpstreamSink  upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+    DownstreamSettings downstreamSettings{upstreamMachineId, 50101};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    downstream.Enable(downstreamSettings);
+
+    Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50101);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upstream.Enable(upstreamSettings);
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+    downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+    auto exchange = [&]()
+    {
+        upstream.Signal(upstreamSink.m_sessionId, MachineReadyData());
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eMACHINE_READY; });
+        upstream.Signal(upstreamSink.m_sessionId, RevokeMachineReadyData());
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    };
+
+    // the dispatcher parses every message into the same document:
+    for (auto i = 0; i < 100; ++i)
+    {
+        exchange();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DownstreamStreamingParserTest)
+{
+    TestCaseScope scope("DownstreamStreamingParserTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+    UpstreamSink  upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+    DownstreamSettings downstreamSettings{upstreamMachineId, 50101};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    downstreamSettings.m_xmlParserMode = Hermes::EXmlParserMode::eSTREAMING;
+    downstream.Enable(downstreamSettings);
+
+    Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50101);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upstreamSettings.m_xmlParserMode = Hermes::EXmlParserMode::eSTREAMING;
+    upstream.Enable(upstreamSettings);
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+    downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        upstream.Signal(upstreamSink.m_sessionId, MachineReadyData());
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eMACHINE_READY; });
+        upstream.Signal(upstreamSink.m_sessionId, RevokeMachineReadyData());
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    }
+}
+
+namespace
+{
+    struct TraceCountingDownstreamSink : DownstreamSink
+    {
+        std::array<unsigned, 6U> m_traceCounts{};
+
+        std::vector<std::string> m_sentTraces;
+
+        void OnTrace(unsigned sessionId, ETraceType type, StringView trace) override
+        {
+            {
+                ChangeLock lock(this);
+                ++m_traceCounts.at(static_cast<std::size_t>(type));
+                if (type == ETraceType::eSENT)
+                {
+                    m_sentTraces.emplace_back(trace);
+                }
+            }
+            DownstreamSink::OnTrace(sessionId, type, trace);
+        }
+
+        unsigned Count(ETraceType type)
+        {
+            std::lock_guard<Mutex> lock(m_mutex);
+            return m_traceCounts.at(static_cast<std::size_t>(type));
+        }
+
+        void ResetCounts()
+        {
+            std::lock_guard<Mutex> lock(m_mutex);
+            m_traceCounts.fill(0U);
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(DownstreamTraceFilterTest)
+{
+    TestCaseScope scope("DownstreamTraceFilterTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    TraceCountingDownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+    UpstreamSink  upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+    DownstreamSettings downstreamSettings{upstreamMachineId, 50101};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    downstream.Enable(downstreamSettings);
+
+    Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50101);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upstream.Enable(upstreamSettings);
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+    downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+    auto exchange = [&]()
+    {
+        upstream.Signal(upstreamSink.m_sessionId, MachineReadyData());
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eMACHINE_READY; });
+        downstream.Signal(downstreamSink.m_sessionId, BoardAvailableData());
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eAVAILABLE_AND_READY; });
+        upstream.Signal(upstreamSink.m_sessionId, RevokeMachineReadyData());
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eBOARD_AVAILABLE; });
+        downstream.Signal(downstreamSink.m_sessionId, RevokeBoardAvailableData());
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+    };
+
+    // by default, everything is traced:
+    downstreamSink.ResetCounts();
+    exchange();
+    BOOST_TEST(downstreamSink.Count(ETraceType::eDEBUG) > 0U);
+    BOOST_TEST(downstreamSink.Count(ETraceType::eSENT) == 2U);
+    BOOST_TEST(downstreamSink.Count(ETraceType::eRECEIVED) > 0U);
+
+    downstream.SetTraceFilter(TraceFilter(ETraceType::eWARNING, false, true));
+    downstreamSink.ResetCounts();
+    exchange();
+    BOOST_TEST(downstreamSink.Count(ETraceType::eDEBUG) == 0U);
+    BOOST_TEST(downstreamSink.Count(ETraceType::eINFO) == 0U);
+    BOOST_TEST(downstreamSink.Count(ETraceType::eSENT) == 0U);
+    BOOST_TEST(downstreamSink.Count(ETraceType::eRECEIVED) > 0U);
+
+    downstream.SetTraceFilter(TraceFilter(ETraceType::eINFO, true, false));
+    downstreamSink.ResetCounts();
+    exchange();
+    BOOST_TEST(downstreamSink.Count(ETraceType::eDEBUG) == 0U);
+    BOOST_TEST(downstreamSink.Count(ETraceType::eSENT) == 2U);
+    BOOST_TEST(downstreamSink.Count(ETraceType::eRECEIVED) == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(DownstreamBackgroundTraceTest)
+{
+    TestCaseScope scope("DownstreamBackgroundTraceTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+    auto filePath = (std::filesystem::temp_directory_path() / "DownstreamBackgroundTraceTest.log").string();
+    for (auto index : {"", ".1", ".2", ".3"})
+    {
+        std::filesystem::remove(filePath + index);
+    }
+
+    TraceCountingDownstreamSink downstreamSink;
+    UpstreamSink  upstreamSink;
+    {
+        Hermes::Downstream downstream(1U, downstreamSink);
+        BackgroundTraceSettings backgroundTraceSettings;
+        backgroundTraceSettings.m_bufferSize = 65536U;
+        downstream.SetBackgroundTrace(backgroundTraceSettings);
+        Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+        Hermes::Upstream upstream(1U, upstreamSink);
+        backgroundTraceSettings.m_optionalFilePath = filePath;
+        backgroundTraceSettings.m_maxFileSize = 4096U;
+        backgroundTraceSettings.m_maxFileCount = 3U;
+        upstream.SetBackgroundTrace(backgroundTraceSettings);
+        Runner<Hermes::Upstream> upstreamRunner(upstream);
+
+        DownstreamSettings downstreamSettings{upstreamMachineId, 50101};
+        downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+        downstream.Enable(downstreamSettings);
+
+        Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", 50101);
+        upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+        upstream.Enable(upstreamSettings);
+
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+        downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+        downstreamSink.ResetCounts();
+        for (auto i = 0; i < 20; ++i)
+        {
+            upstream.Signal(upstreamSink.m_sessionId, MachineReadyData());
+            WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eMACHINE_READY; });
+            downstream.Signal(downstreamSink.m_sessionId, BoardAvailableData());
+            WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eAVAILABLE_AND_READY; });
+            upstream.Signal(upstreamSink.m_sessionId, RevokeMachineReadyData());
+            WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eBOARD_AVAILABLE; });
+            downstream.Signal(downstreamSink.m_sessionId, RevokeBoardAvailableData());
+            WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+        }
+
+        // the downstream traces arrive at the callback, in order:
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_traceCounts[static_cast<std::size_t>(ETraceType::eSENT)] == 40U; });
+        std::lock_guard<Mutex> lock(downstreamSink.m_mutex);
+        BOOST_TEST(downstreamSink.m_traceCounts[static_cast<std::size_t>(ETraceType::eDEBUG)] > 0U);
+        BOOST_TEST(downstreamSink.m_traceCounts[static_cast<std::size_t>(ETraceType::eWARNING)] == 0U); // nothing dropped
+        const auto& sentTraces = downstreamSink.m_sentTraces;
+        BOOST_TEST(sentTraces.at(sentTraces.size() - 2U).find("<BoardAvailable") != std::string::npos);
+        BOOST_TEST(sentTraces.back().find("<RevokeBoardAvailable") != std::string::npos);
+    }
+
+    // the upstream traces went to the files, which were rotated:
+    BOOST_TEST(std::filesystem::exists(filePath));
+    BOOST_TEST(std::filesystem::exists(filePath + ".1"));
+    BOOST_TEST(std::filesystem::exists(filePath + ".2"));
+    BOOST_TEST(!std::filesystem::exists(filePath + ".3"));
+    BOOST_TEST(std::filesystem::file_size(filePath + ".1") < 4096U + 1024U);
+
+    std::ifstream file(filePath + ".1");
+    std::string line;
+    unsigned sentCount = 0U;
+    unsigned receivedCount = 0U;
+    while (std::getline(file, line))
+    {
+        // the traces of messages run over several lines
+        sentCount += line.find(" eSENT 1: <Hermes Timestamp=") == 23U ? 1U : 0U;
+        receivedCount += line.find(" eRECEIVED 1: <Hermes Timestamp=") == 23U ? 1U : 0U;
+    }
+    BOOST_TEST(sentCount > 0U);
+    BOOST_TEST(receivedCount > 0U);
+}
+
+BOOST_AUTO_TEST_CASE(DownstreamBackgroundTraceUnlimitedFileTest)
+{
+    TestCaseScope scope("DownstreamBackgroundTraceUnlimitedFileTest");
+
+    auto filePath = (std::filesystem::temp_directory_path() / "DownstreamBackgroundTraceUnlimitedFileTest.log").string();
+    for (auto index : {"", ".1"})
+    {
+        std::filesystem::remove(filePath + index);
+    }
+
+    DownstreamSink downstreamSink;
+    {
+        Hermes::Downstream downstream(1U, downstreamSink);
+        BackgroundTraceSettings backgroundTraceSettings;
+        backgroundTraceSettings.m_optionalFilePath = filePath;
+        backgroundTraceSettings.m_maxFileSize = 0U; // as from a zero-initialized HermesBackgroundTraceSettings
+        backgroundTraceSettings.m_maxFileCount = 0U;
+        downstream.SetBackgroundTrace(backgroundTraceSettings);
+        Runner<Hermes::Downstream> downstreamRunner(downstream);
+        downstream.Enable(DownstreamSettings{"DownstreamMachineId", 50101});
+        downstream.Disable(NotificationData(ENotificationCode::eMACHINE_SHUTDOWN, ESeverity::eINFO, "Disabled"));
+    }
+
+    // all the traces in the one file:
+    BOOST_TEST(std::filesystem::exists(filePath));
+    BOOST_TEST(std::filesystem::file_size(filePath) > 0U);
+    BOOST_TEST(!std::filesystem::exists(filePath + ".1"));
+}
+
+BOOST_AUTO_TEST_CASE(ServicePoolTest)
+{
+    TestCaseScope scope("ServicePoolTest");
+
+    std::string upstreamMachineId{"UpstreamMachineId"};
+    std::string downstreamMachineId{"DownstreamMachineId"};
+
+    std::atomic<unsigned> startedThreadCount{0U};
+    Hermes::ServicePool pool(2U, [&](unsigned) { ++startedThreadCount; });
+
+    // several pairs of endpoints on the same threads, none of them with a thread of its own:
+    constexpr unsigned cPAIR_COUNT = 3U;
+    std::array<DownstreamSink, cPAIR_COUNT> downstreamSinks;
+    std::array<UpstreamSink, cPAIR_COUNT> upstreamSinks;
+    std::vector<std::unique_ptr<Hermes::Downstream>> downstreams;
+    std::vector<std::unique_ptr<Hermes::Upstream>> upstreams;
+    for (unsigned i = 0U; i < cPAIR_COUNT; ++i)
+    {
+        downstreams.emplace_back(std::make_unique<Hermes::Downstream>(pool, 1U, downstreamSinks[i]));
+        upstreams.emplace_back(std::make_unique<Hermes::Upstream>(pool, 1U, upstreamSinks[i]));
+
+        DownstreamSettings downstreamSettings{upstreamMachineId, static_cast<uint16_t>(50111 + i)};
+        downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+        downstreams[i]->Enable(downstreamSettings);
+
+        Hermes::UpstreamSettings upstreamSettings(downstreamMachineId, "127.0.0.1", static_cast<uint16_t>(50111 + i));
+        upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+        upstreams[i]->Enable(upstreamSettings);
+    }
+
+    for (unsigned i = 0U; i < cPAIR_COUNT; ++i)
+    {
+        auto& downstreamSink = downstreamSinks[i];
+        auto& upstreamSink = upstreamSinks[i];
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        upstreams[i]->Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(downstreamMachineId, 1U));
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+        downstreams[i]->Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(upstreamMachineId, 1U));
+
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+        upstreams[i]->Signal(upstreamSink.m_sessionId, MachineReadyData());
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eMACHINE_READY; });
+        downstreams[i]->Signal(downstreamSink.m_sessionId, BoardAvailableData());
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eAVAILABLE_AND_READY; });
+    }
+    BOOST_TEST(startedThreadCount == 2U);
+
+    // Run() still returns on Stop(), which disconnects as before:
+    {
+        Runner<Hermes::Upstream> upstreamRunner(*upstreams[0]);
+    }
+    WaitFor(downstreamSinks[0], [&]() { return downstreamSinks[0].m_state == EState::eDISCONNECTED; });
+
+    // deleting a connected endpoint leaves the others on the pool alone:
+    upstreams[1].reset();
+    WaitFor(downstreamSinks[1], [&]() { return downstreamSinks[1].m_state == EState::eDISCONNECTED; });
+
+    auto& downstreamSink = downstreamSinks[2];
+    auto& upstreamSink = upstreamSinks[2];
+    upstreams[2]->Signal(upstreamSink.m_sessionId, StartTransportData("BoardId"));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eTRANSPORTING; });
+}
+
+BOOST_AUTO_TEST_CASE(ServicePoolDeleteFromCallbackTest)
+{
+    TestCaseScope scope("ServicePoolDeleteFromCallbackTest");
+
+    // with a single thread, waiting in the callback for the deletion on the other strand would never end:
+    Hermes::ServicePool pool(1U);
+
+    DownstreamSink downstreamSink;
+    UpstreamSink upstreamSink;
+    auto upDownstream = std::make_unique<Hermes::Downstream>(pool, 1U, downstreamSink);
+    Hermes::Upstream upstream(pool, 1U, upstreamSink);
+
+    DownstreamSettings downstreamSettings{"UpstreamMachineId", 50121};
+    downstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upDownstream->Enable(downstreamSettings);
+    Hermes::UpstreamSettings upstreamSettings("DownstreamMachineId", "127.0.0.1", 50121);
+    upstreamSettings.m_checkAlivePeriodInSeconds = 0;
+    upstream.Enable(upstreamSettings);
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+
+    bool deleted = false;
+    upstream.Post([&]()
+    {
+        upDownstream.reset();
+        UpstreamSink::ChangeLock lock(&upstreamSink);
+        deleted = true;
+    });
+    WaitFor(upstreamSink, [&]() { return deleted; });
+
+    // the pool thread is free again, and carries out the deletion, which disconnects:
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_CONNECTED || upstreamSink.m_state == EState::eDISCONNECTED; });
+}
+
+BOOST_AUTO_TEST_CASE(ServicePoolThrowingCallbackTest)
+{
+    TestCaseScope scope("ServicePoolThrowingCallbackTest");
+
+    Hermes::ServicePool pool(1U);
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(pool, 1U, downstreamSink);
+
+    // the exception is traced as an error of the downstream, the only thread of the pool carries on:
+    downstream.Post([]() { throw std::runtime_error("Thrown by callback"); });
+    bool called = false;
+    downstream.Post([&]()
+    {
+        DownstreamSink::ChangeLock lock(&downstreamSink);
+        called = true;
+    });
+    WaitFor(downstreamSink, [&]() { return called; });
+}
@@ -315,6 +315,16 @@ BOOST_FUSION_ADAPT_STRUCT(Hermes::ReplyWorkOrderInfoData,
 BOOST_FUSION_ADAPT_STRUCT(Hermes::CommandData,
     m_command
 )
+BOOST_FUSION_ADAPT_STRUCT(Hermes::SocketOptions,
+    m_noDelay,
+    m_keepAlive,
+    m_keepAliveIdleInSeconds,
+    m_keepAliveIntervalInSeconds,
+    m_sendBufferSize,
+    m_receiveBufferSize,
+    m_quickAck,
+    m_transport
+)
 BOOST_FUSION_ADAPT_STRUCT(Hermes::UpstreamSettings,
     m_machineId,
     m_hostAddress,
@@ -322,7 +332,14 @@ BOOST_FUSION_ADAPT_STRUCT(Hermes::UpstreamSettings,
     m_checkAlivePeriodInSeconds,
     m_reconnectWaitTimeInSeconds,
     m_checkAliveResponseMode,
-    m_checkState
+    m_checkState,
+    m_sendQueueHighWaterMark,
+    m_xmlParserMode,
+    m_maxReconnectWaitTimeInSeconds,
+    m_reconnectWaitTimeFactor,
+    m_reconnectJitter,
+    m_reconnectAtOnceAfterClose,
+    m_socketOptions
 )
 BOOST_FUSION_ADAPT_STRUCT(Hermes::DownstreamSettings,
     m_machineId,
@@ -331,7 +348,10 @@ BOOST_FUSION_ADAPT_STRUCT(Hermes::DownstreamSettings,
     m_checkAlivePeriodInSeconds,
     m_reconnectWaitTimeInSeconds,
     m_checkAliveResponseMode,
-    m_checkState
+    m_checkState,
+    m_sendQueueHighWaterMark,
+    m_xmlParserMode,
+    m_socketOptions
 )
 BOOST_FUSION_ADAPT_STRUCT(Hermes::ConfigurationServiceSettings,
     m_port,
@@ -6,6 +6,34 @@
 
 #include <boost/test/data/test_case.hpp>
 
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // counts the instances alive
+    struct Counted
+    {
+        static int s_instances;
+        std::string m_text;
+
+        Counted() { ++s_instances; }
+        Counted(const std::string& text, std::size_t count) : m_text(count, text.at(0)) { ++s_instances; }
+        Counted(const Counted& rhs) : m_text(rhs.m_text) { ++s_instances; }
+        Counted(Counted&& rhs) : m_text(std::move(rhs.m_text)) { ++s_instances; }
+        Counted& operator=(const Counted&) = default;
+        Counted& operator=(Counted&&) = default;
+        ~Counted() { --s_instances; }
+
+        friend bool operator==(const Counted& lhs, const Counted& rhs) { return lhs.m_text == rhs.m_text; }
+        template<class S>
+        friend S& operator<<(S& s, const Counted& counted) { return s << counted.m_text; }
+    };
+    int Counted::s_instances = 0;
+}
+
 BOOST_AUTO_TEST_SUITE(DataTestSuite);
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(HermesDataEqualityTest, T, HermesDataTypes)
@@ -35,7 +63,91 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(HermesCApiTest, T, HermesDataTypes)
     }
 }
 
+BOOST_AUTO_TEST_CASE(OptionalTest)
+{
+    {
+        Hermes::Optional<Counted> empty;
+        BOOST_TEST(!empty);
+        BOOST_TEST(Counted::s_instances == 0);
+
+        Hermes::Optional<Counted> optional;
+        optional.emplace("x", 3U);
+        BOOST_TEST(optional.has_value());
+        BOOST_TEST(optional->m_text == "xxx");
+        BOOST_TEST(Counted::s_instances == 1);
+
+        auto copy = optional;
+        BOOST_TEST(copy->m_text == "xxx");
+        BOOST_TEST(Counted::s_instances == 2);
+
+        auto moved = std::move(optional);
+        BOOST_TEST(moved->m_text == "xxx");
+        BOOST_TEST(optional->m_text.empty()); // moved from, but still there
+        BOOST_TEST(Counted::s_instances == 3);
+
+        optional = empty;
+        BOOST_TEST(!optional);
+        BOOST_TEST(Counted::s_instances == 2);
+
+        swap(optional, moved);
+        BOOST_TEST(!moved);
+        BOOST_TEST(optional->m_text == "xxx");
+        BOOST_TEST(Counted::s_instances == 2);
+
+        copy.reset();
+        BOOST_TEST(!copy);
+        BOOST_TEST(Counted::s_instances == 1);
+        BOOST_TEST(copy != optional);
+        BOOST_TEST(copy == empty);
+    }
+    BOOST_TEST(Counted::s_instances == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
+// Not a test as such, but the size and the cost of copying, moving and default constructing the messages
+// with the most optional fields.
+// Run with --log_level=message to see the results.
+using OptionalBenchmarkTypes = boost::mpl::vector4<Hermes::BoardAvailableData, Hermes::MachineReadyData,
+    Hermes::BoardForecastData, Hermes::SendBoardInfoData>;
+BOOST_AUTO_TEST_CASE_TEMPLATE(OptionalBenchmark, DataT, OptionalBenchmarkTypes)
+{
+    const auto samples = GenerateSamples<DataT>();
+    const unsigned cREPETITIONS = 100U;
+    std::vector<DataT> copies;
+    copies.reserve(samples.size() * cREPETITIONS);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0U; i < cREPETITIONS; ++i)
+    {
+        copies.insert(copies.end(), samples.begin(), samples.end());
+    }
+    std::chrono::duration<double, std::nano> copyDuration = std::chrono::steady_clock::now() - start;
+
+    std::vector<DataT> moved;
+    moved.reserve(copies.size());
+    start = std::chrono::steady_clock::now();
+    for (auto& data : copies)
+    {
+        moved.push_back(std::move(data));
+    }
+    std::chrono::duration<double, std::nano> moveDuration = std::chrono::steady_clock::now() - start;
+    BOOST_TEST(moved.back() == samples.back());
+
+    // where all the optional fields are empty:
+    std::vector<DataT> defaults;
+    defaults.reserve(moved.size());
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0U; i < moved.size(); ++i)
+    {
+        defaults.emplace_back();
+    }
+    std::chrono::duration<double, std::nano> defaultDuration = std::chrono::steady_clock::now() - start;
+
+    BOOST_TEST_MESSAGE(typeid(DataT).name() << ": " << sizeof(DataT) << " bytes, "
+        << copyDuration.count() / copies.size() << " ns per copy, " << moveDuration.count() / moved.size() << " ns per move, "
+        << defaultDuration.count() / defaults.size() << " ns per default construction");
+}
+
 
 
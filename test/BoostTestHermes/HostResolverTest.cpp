@@ -0,0 +1,59 @@
+/***********************************************************************
+Copyright ASM Assembly Systems GmbH & Co. KG
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+************************************************************************/
+
+#include "stdafx.h"
+
+#include <src/Hermes/HostResolver.h>
+
+#include <string>
+
+using namespace Hermes;
+
+namespace
+{
+    ResolvedHost ResolvedHost_(const char* address, const char* hostName)
+    {
+        return{boost::asio::ip::tcp::endpoint(boost::asio::ip::make_address_v4(address), 0U), hostName};
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestResolveCache)
+{
+    std::chrono::steady_clock::time_point now;
+    ResolveCache cache([&now]() { return now; });
+
+    ResolvedHost resolvedHost;
+    BOOST_TEST(!cache.Find("line1", resolvedHost));
+
+    cache.Insert("line1", ResolvedHost_("10.0.0.1", "line1.example.com"));
+    BOOST_TEST(cache.Find("line1", resolvedHost));
+    BOOST_TEST(resolvedHost.m_endpoint.address().to_string() == "10.0.0.1");
+    BOOST_TEST(resolvedHost.m_hostName == "line1.example.com");
+    BOOST_TEST(!cache.Find("line2", resolvedHost));
+
+    // an entry is only kept for its time to live:
+    now += ResolveCache::cTIME_TO_LIVE - std::chrono::seconds(1);
+    cache.Insert("line2", ResolvedHost_("10.0.0.2", "line2"));
+    BOOST_TEST(cache.Find("line1", resolvedHost));
+    now += std::chrono::seconds(1);
+    BOOST_TEST(!cache.Find("line1", resolvedHost));
+    BOOST_TEST(cache.Find("line2", resolvedHost));
+
+    // a name resolved again replaces the outdated entry:
+    cache.Insert("line1", ResolvedHost_("10.0.0.3", "line1"));
+    BOOST_TEST(cache.Find("line1", resolvedHost));
+    BOOST_TEST(resolvedHost.m_endpoint.address().to_string() == "10.0.0.3");
+}
@@ -0,0 +1,135 @@
+/***********************************************************************
+Copyright ASM Assembly Systems GmbH & Co. KG
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+************************************************************************/
+
+#include "stdafx.h"
+
+#include <src/Hermes/MessageFramer.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace Hermes;
+
+namespace
+{
+    std::string MakeMessage_(std::size_t size)
+    {
+        std::string message = "<Hermes Timestamp=\"2018-01-01T00:00:00\"><Notification Description=\"";
+        const std::string end = "\"/></Hermes>";
+        while (message.size() + end.size() < size)
+        {
+            // sprinkle in the characters the framer is looking for:
+            message += (message.size() % 97U) ? 'x' : '<';
+        }
+        return message + end;
+    }
+
+    // Feeds the stream in chunks the way MessageDispatcher does: the unconsumed rest moves to the front
+    // of the pending data and the next chunk gets appended.
+    std::vector<std::string> Frame_(const std::string& stream, std::size_t chunkSize, bool resume)
+    {
+        std::vector<std::string> messages;
+        MessageFramer framer;
+        std::string pending;
+        for (std::size_t pos = 0U; pos < stream.size(); pos += chunkSize)
+        {
+            pending.append(stream, pos, chunkSize);
+            StringSpan buffer{pending};
+            if (!resume)
+            {
+                framer.Reset();
+            }
+            for (auto message = framer.TakeMessage(buffer); !message.empty(); message = framer.TakeMessage(buffer))
+            {
+                messages.emplace_back(message.data(), message.size());
+            }
+            if (buffer.empty())
+            {
+                pending.clear();
+            }
+            else
+            {
+                pending.erase(0U, static_cast<std::size_t>(buffer.data() - &pending[0]));
+            }
+        }
+        return messages;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(MessageFramerTest)
+{
+    const std::string message1 = "<Hermes><CheckAlive/></Hermes>";
+    const std::string message2 = MakeMessage_(5000U);
+    const std::string message3 = "<Hermes ><Notification NotificationCode=\"1\"/></Hermes >";
+    const std::string stream = "garbage<Herme<" + message1 + "\r\n<Hermit/>" + message2 + message3 + "<Herm";
+
+    for (std::size_t chunkSize : {1U, 2U, 3U, 7U, 8U, 9U, 31U, 32U, 33U, 1024U, 100000U})
+    {
+        auto messages = Frame_(stream, chunkSize, true);
+        BOOST_TEST_REQUIRE(messages.size() == 3U);
+        BOOST_TEST(messages[0] == message1);
+        BOOST_TEST(messages[1] == message2);
+        BOOST_TEST(messages[2] == message3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(MessageFramerIncompleteTest)
+{
+    MessageFramer framer;
+    std::string pending = "xx<Hermes><CheckAlive/></Hermes";
+    StringSpan buffer{pending};
+    BOOST_TEST(framer.TakeMessage(buffer).empty());
+    BOOST_TEST(std::string(buffer.data(), buffer.size()) == "<Hermes><CheckAlive/></Hermes");
+
+    // the rest of the message arrives:
+    pending = std::string(buffer.data(), buffer.size()) + "><Hermes";
+    buffer = StringSpan{pending};
+    auto message = framer.TakeMessage(buffer);
+    BOOST_TEST(std::string(message.data(), message.size()) == "<Hermes><CheckAlive/></Hermes>");
+    BOOST_TEST(std::string(buffer.data(), buffer.size()) == "<Hermes");
+    BOOST_TEST(framer.TakeMessage(buffer).empty());
+
+    pending = "no message here";
+    buffer = StringSpan{pending};
+    framer.Reset();
+    BOOST_TEST(framer.TakeMessage(buffer).empty());
+    BOOST_TEST(buffer.empty());
+}
+
+// Not a test as such, but a benchmark showing that the cost per byte does not grow with the message size
+// when a message trickles in in small chunks. Run with --log_level=message to see the results.
+BOOST_AUTO_TEST_CASE(MessageFramerBenchmark)
+{
+    const std::size_t cCHUNK_SIZE = 1024U;
+    for (std::size_t size : {16U * 1024U, 32U * 1024U, 64U * 1024U})
+    {
+        const std::string message = MakeMessage_(size);
+        for (bool resume : {false, true})
+        {
+            const unsigned cREPETITIONS = 20U;
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned i = 0U; i < cREPETITIONS; ++i)
+            {
+                auto messages = Frame_(message, cCHUNK_SIZE, resume);
+                BOOST_TEST_REQUIRE(messages.size() == 1U);
+            }
+            std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+            BOOST_TEST_MESSAGE((resume ? "resuming" : "rescanning") << " framer, " << size / 1024U << " KB in "
+                << cCHUNK_SIZE << " byte chunks: " << duration.count() / cREPETITIONS / size << " ns/byte");
+        }
+    }
+}
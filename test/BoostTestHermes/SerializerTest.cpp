@@ -21,11 +21,17 @@ limitations under the License.
 
 #include "HermesDataGenerators.h"
 
+#include <src/Hermes/MessageFields.h>
+#include <src/Hermes/NumericCodec.h>
+
 #include <boost/test/data/test_case.hpp>
 
 #include <boost/mpl/vector.hpp>
+#include <boost/mpl/vector/vector30.hpp>
 
+#include <chrono>
 #include <fstream>
+#include <sstream>
 
 using EmptyHermesDataTypes = boost::mpl::vector<
     Hermes::RevokeBoardAvailableData,
@@ -52,6 +58,33 @@ using NonEmptyHermesDataTypes = boost::mpl::vector<
     Hermes::QueryWorkOrderInfoData,
     Hermes::SendWorkOrderInfoData>;
 
+using AllHermesDataTypes = boost::mpl::vector25<
+    Hermes::ServiceDescriptionData,
+    Hermes::BoardAvailableData,
+    Hermes::RevokeBoardAvailableData,
+    Hermes::MachineReadyData,
+    Hermes::RevokeMachineReadyData,
+    Hermes::StartTransportData,
+    Hermes::StopTransportData,
+    Hermes::TransportFinishedData,
+    Hermes::NotificationData,
+    Hermes::CheckAliveData,
+    Hermes::GetConfigurationData,
+    Hermes::SetConfigurationData,
+    Hermes::CurrentConfigurationData,
+    Hermes::BoardForecastData,
+    Hermes::QueryBoardInfoData,
+    Hermes::SendBoardInfoData,
+    Hermes::SupervisoryServiceDescriptionData,
+    Hermes::BoardArrivedData,
+    Hermes::BoardDepartedData,
+    Hermes::QueryWorkOrderInfoData,
+    Hermes::SendWorkOrderInfoData,
+    Hermes::ReplyWorkOrderInfoData,
+    Hermes::CommandData,
+    Hermes::QueryHermesCapabilitiesData,
+    Hermes::SendHermesCapabilitiesData>;
+
 template<class T>
 void ToFile(unsigned counter, const std::string& xml)
 {
@@ -96,6 +129,487 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(TestNonEmptyHermesDataTypes, DataT, NonEmptyHermes
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(TestEmptyHermesDataTypesStreaming, DataT, EmptyHermesDataTypes)
+{
+    DataT data;
+    std::string xml = ToXml(data);
+    auto optionalData = Hermes::FromXml<DataT>(xml, Hermes::EXmlParserMode::eSTREAMING);
+    BOOST_CHECK(optionalData);
+    if (optionalData)
+    {
+        BOOST_TEST(data == *optionalData);
+    }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(TestNonEmptyHermesDataTypesStreaming, DataT, NonEmptyHermesDataTypes)
+{
+    auto samples = GenerateSamples<DataT>();
+    for (const auto& data : samples)
+    {
+        std::string xml = ToXml(data);
+        auto optionalData = Hermes::FromXml<DataT>(xml, Hermes::EXmlParserMode::eSTREAMING);
+        BOOST_CHECK(optionalData);
+        if (optionalData)
+        {
+            BOOST_TEST(data == optionalData);
+        }
+    }
+}
+
+// what a parser makes of a message: the error, if any, and the data
+template<class DataT>
+std::string Parse_(const std::string& xml, Hermes::EXmlParserMode parserMode)
+{
+    Hermes::Optional<DataT> optionalData;
+    Hermes::Error error;
+    HermesDeserializationCallbacks callbacks{};
+    Hermes::SetDeserializationCallback_(optionalData, callbacks);
+    callbacks.m_deserializationErrorCallback.m_pData = &error;
+    callbacks.m_deserializationErrorCallback.m_pCall = [](void* pError, const HermesError* pCError)
+    {
+        *static_cast<Hermes::Error*>(pError) = Hermes::ToCpp(*pCError);
+    };
+    ::HermesDeserializeWithParser(Hermes::ToC(xml), Hermes::ToC(parserMode), &callbacks);
+
+    std::ostringstream stream;
+    stream << error << optionalData;
+    return stream.str();
+}
+
+template<class DataT>
+std::string CheckSameParse_(const std::string& xml)
+{
+    auto domResult = Parse_<DataT>(xml, Hermes::EXmlParserMode::eDOM);
+    BOOST_TEST(domResult == Parse_<DataT>(xml, Hermes::EXmlParserMode::eSTREAMING), xml);
+    return domResult;
+}
+
+BOOST_AUTO_TEST_CASE(TestStreamingParserSameAsDom)
+{
+    // missing data, where the last missing attribute or element is reported:
+    BOOST_TEST(CheckSameParse_<Hermes::StartTransportData>("<Hermes><StartTransport ConveyorSpeed=\"1.5\"/></Hermes>").find("missing attribute BoardId") != std::string::npos);
+    CheckSameParse_<Hermes::BoardAvailableData>("<Hermes><BoardAvailable FailedBoard=\"1\"/></Hermes>");
+    CheckSameParse_<Hermes::BoardAvailableData>("<Hermes><BoardAvailable BoardId=\"b\" BoardIdCreatedBy=\"m\" FailedBoard=\"1\" FlippedBoard=\"0\">"
+        "<SubBoards><SB Pos=\"1\"/><SB Pos=\"2\" St=\"1\"/><SB St=\"2\"/><Other/></SubBoards></BoardAvailable></Hermes>");
+    CheckSameParse_<Hermes::ServiceDescriptionData>("<Hermes><ServiceDescription MachineId=\"m\" LaneId=\"1\" Version=\"1.3\"/></Hermes>");
+    CheckSameParse_<Hermes::ServiceDescriptionData>("<Hermes><ServiceDescription MachineId=\"m\" LaneId=\"1\" Version=\"1.3\">"
+        "<SupportedFeatures><FeatureBoardForecast/><FeatureCommand></FeatureCommand></SupportedFeatures></ServiceDescription></Hermes>");
+    CheckSameParse_<Hermes::SetConfigurationData>("<Hermes><SetConfiguration><UpstreamConfigurations>"
+        "<UpstreamConfiguration UpstreamLaneId=\"1\"/></UpstreamConfigurations></SetConfiguration></Hermes>");
+    CheckSameParse_<Hermes::SendHermesCapabilitiesData>("<Hermes><SendHermesCapabilities><OptionalMessages><MessageCommand/></OptionalMessages>"
+        "<Attributes SubBoards=\"1\" Weight=\"2\"/></SendHermesCapabilities></Hermes>");
+
+    // values:
+    CheckSameParse_<Hermes::NotificationData>("<Hermes><Notification NotificationCode=\" 0x3\" Severity=\"-1\" Description=\"a&lt;b&#x20AC;&#65;&#9;\r\nc\td &unknown; &amp;amp; &#xZ;\"/></Hermes>");
+    CheckSameParse_<Hermes::NotificationData>("<Hermes><Notification NotificationCode=\"99999999999\" Severity=\"2\" Severity=\"3\" Description=''/></Hermes>");
+    CheckSameParse_<Hermes::StartTransportData>("<Hermes><StartTransport BoardId=\"b\" ConveyorSpeed=\"-1.25e2\"/></Hermes>");
+    CheckSameParse_<Hermes::CheckAliveData>("<Hermes><CheckAlive Type=\"2\" Id=\"+077\"/></Hermes>");
+    BOOST_TEST(CheckSameParse_<Hermes::CheckAliveData>("<?xml version=\"1.0\"?><Hermes Timestamp=\"x\">\r\n  <!-- <CheckAlive/> -->\r\n"
+        "  <CheckAlive Type=\"1\"/>\r\n</Hermes>").find("ePING") != std::string::npos);
+
+    // messages without or with unknown data:
+    CheckSameParse_<Hermes::CheckAliveData>("<Hermes></Hermes>");
+    CheckSameParse_<Hermes::CheckAliveData>("<Hermes><Unknown/><CheckAlive/></Hermes>");
+    CheckSameParse_<Hermes::CheckAliveData>("<Hermes>text<CheckAlive/></Hermes>");
+}
+
+BOOST_AUTO_TEST_CASE(TestStreamingParserMalformedXml)
+{
+    // the parsers may stop at different offsets, but must agree on the error:
+    for (std::string xml : {
+        "<Hermes><CheckAlive></Hermes>",
+        "<Hermes><CheckAlive></CheckAliv></Hermes>",
+        "<Hermes><CheckAlive Type=\"1\"Id=\"2\"/></Hermes>",
+        "<Hermes><CheckAlive Type=\"1/></Hermes>",
+        "<Hermes><CheckAlive Type=1/></Hermes>",
+        "<Hermes><CheckAlive/><!-- </Hermes>"})
+    {
+        auto domResult = Parse_<Hermes::CheckAliveData>(xml, Hermes::EXmlParserMode::eDOM);
+        auto streamingResult = Parse_<Hermes::CheckAliveData>(xml, Hermes::EXmlParserMode::eSTREAMING);
+        BOOST_TEST(domResult.find("eCLIENT_ERROR") != std::string::npos, xml);
+        BOOST_TEST(domResult.substr(0U, domResult.find(" at offset")) == streamingResult.substr(0U, streamingResult.find(" at offset")), xml);
+    }
+}
+
+template<class T>
+std::string Format_(T value)
+{
+    char buffer[Hermes::NumericCodec::cMAX_SIZE];
+    return std::string(buffer, Hermes::NumericCodec::Format(buffer, value));
+}
+
+template<class T>
+bool Parses_(const char* text, T expected)
+{
+    T value{};
+    return Hermes::NumericCodec::Parse(text, value) && value == expected;
+}
+
+template<class T>
+bool Rejects_(const char* text)
+{
+    T value{42};
+    return !Hermes::NumericCodec::Parse(text, value) && value == T{42};
+}
+
+BOOST_AUTO_TEST_CASE(TestNumericCodec)
+{
+    BOOST_TEST(Format_(-2147483647 - 1) == "-2147483648");
+    BOOST_TEST(Format_(4294967295U) == "4294967295");
+    BOOST_TEST(Format_(static_cast<unsigned short>(65535U)) == "65535");
+    BOOST_TEST(Format_(12.3456) == "12.346");
+    BOOST_TEST(Format_(-0.5) == "-0.500");
+    BOOST_TEST(Format_(1e20) == "100000000000000000000.000");
+    BOOST_TEST(Format_(-1.7976931348623157e308).size() == 314U); // sign, 309 digits, point and 3 decimals
+
+    BOOST_TEST(Parses_(" 12 ", 12));
+    BOOST_TEST(Parses_("+12", 12));
+    BOOST_TEST(Parses_("-2147483648", -2147483647 - 1));
+    BOOST_TEST(Parses_("4294967295", 4294967295U));
+    BOOST_TEST(Parses_("65535", static_cast<unsigned short>(65535U)));
+    BOOST_TEST(Parses_("1.5", 1.5));
+    BOOST_TEST(Parses_("-1.25e2", -125.0));
+    BOOST_TEST(Parses_("\t3\r\n", 3.0));
+
+    BOOST_TEST(Rejects_<int>(""));
+    BOOST_TEST(Rejects_<int>(" "));
+    BOOST_TEST(Rejects_<int>("+"));
+    BOOST_TEST(Rejects_<int>("+-1"));
+    BOOST_TEST(Rejects_<int>("0x3"));
+    BOOST_TEST(Rejects_<int>("1.5"));
+    BOOST_TEST(Rejects_<int>("2147483648"));
+    BOOST_TEST(Rejects_<unsigned>("-1"));
+    BOOST_TEST(Rejects_<unsigned short>("65536"));
+    BOOST_TEST(Rejects_<double>("1,5"));
+    BOOST_TEST(Rejects_<double>("abc"));
+    BOOST_TEST(Rejects_<double>("1.5mm"));
+}
+
+BOOST_AUTO_TEST_CASE(TestMalformedNumbers)
+{
+    for (auto mode : {Hermes::EXmlParserMode::eDOM, Hermes::EXmlParserMode::eSTREAMING})
+    {
+        auto result = Parse_<Hermes::StartTransportData>("<Hermes><StartTransport BoardId=\"b\" ConveyorSpeed=\"fast\"/></Hermes>", mode);
+        BOOST_TEST(result.find("ePEER_ERROR") != std::string::npos, result);
+        BOOST_TEST(result.find("malformed number in attribute ConveyorSpeed: \"fast\"") != std::string::npos, result);
+
+        // a missing attribute listed later still wins, as before:
+        result = Parse_<Hermes::NotificationData>("<Hermes><Notification NotificationCode=\"x\" Severity=\"1\"/></Hermes>", mode);
+        BOOST_TEST(result.find("missing attribute Description") != std::string::npos, result);
+
+    }
+}
+
+// the timestamp varies, so it is put into the expected text
+std::string WithTimestampOf_(const std::string& xml, const std::string& expected)
+{
+    const std::string cATTRIBUTE = "Timestamp=\"";
+    auto begin = xml.find(cATTRIBUTE);
+    BOOST_TEST_REQUIRE(begin != std::string::npos);
+    begin += cATTRIBUTE.size();
+    auto timestamp = xml.substr(begin, xml.find('"', begin) - begin);
+
+    std::string result = expected;
+    result.replace(result.find("%T"), 2U, timestamp);
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(TestSerializedXmlFormat)
+{
+    // byte for byte what pugixml used to write with format_indent:
+    Hermes::BoardAvailableData boardAvailable{"b<1>&\"'", "M\t1\r\n", Hermes::EBoardQuality::eGOOD, Hermes::EFlippedBoard::eBOTTOM_SIDE_IS_UP};
+    boardAvailable.m_optionalLengthInMM = 12.3456;
+    boardAvailable.m_optionalSubBoards.emplace_back(1U, Hermes::ESubBoardState::eGOOD);
+    boardAvailable.m_optionalSubBoards.back().m_optionalBc = "x";
+    boardAvailable.m_optionalSubBoards.emplace_back(2U, Hermes::ESubBoardState::eFAILED);
+    auto xml = Hermes::ToXml(boardAvailable);
+    BOOST_TEST(xml == WithTimestampOf_(xml, "<Hermes Timestamp=\"%T\">\n"
+        " <BoardAvailable BoardId=\"b&lt;1>&amp;&quot;'\" BoardIdCreatedBy=\"M&#09;1&#13;&#10;\" FailedBoard=\"1\" FlippedBoard=\"2\" Length=\"12.346\">\n"
+        "  <SubBoards>\n"
+        "   <SB Pos=\"1\" Bc=\"x\" St=\"1\" />\n"
+        "   <SB Pos=\"2\" St=\"2\" />\n"
+        "  </SubBoards>\n"
+        " </BoardAvailable>\n"
+        "</Hermes>\n"));
+
+    xml = Hermes::ToXml(Hermes::RevokeMachineReadyData{});
+    BOOST_TEST(xml == WithTimestampOf_(xml, "<Hermes Timestamp=\"%T\">\n <RevokeMachineReady />\n</Hermes>\n"));
+
+    xml = Hermes::ToXml(Hermes::SetConfigurationData{"m"});
+    BOOST_TEST(xml == WithTimestampOf_(xml, "<Hermes Timestamp=\"%T\">\n"
+        " <SetConfiguration MachineId=\"m\">\n"
+        "  <UpstreamConfigurations />\n"
+        "  <DownstreamConfigurations />\n"
+        " </SetConfiguration>\n"
+        "</Hermes>\n"));
+}
+
+template<class T, std::size_t... Is>
+void CheckFieldIndex_(std::index_sequence<Is...>)
+{
+    // every field name is found, as itself, and nothing else:
+    using Index = Hermes::FieldIndex<T>;
+    const char* names[] = {std::get<Is>(Hermes::Fields<T>::cFIELDS).m_name..., nullptr};
+    for (std::size_t i = 0U; i < sizeof...(Is); ++i)
+    {
+        const char* name = names[i];
+        BOOST_TEST(Index::Find(name) == i, name);
+        BOOST_TEST(Index::Find(Hermes::StringView(name)) == i, name);
+        BOOST_TEST(Index::Find((std::string(name) + "x").c_str()) == Index::cNONE, name);
+        BOOST_TEST(Index::Find(Hermes::StringView(name, std::strlen(name) - 1U)) == Index::cNONE, name);
+    }
+    BOOST_TEST(Index::Find("") == Index::cNONE);
+    BOOST_TEST(Index::Find("Unknown") == Index::cNONE);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(TestFieldIndex, DataT, AllHermesDataTypes)
+{
+    CheckFieldIndex_<DataT>(std::make_index_sequence<Hermes::FieldCount<DataT>()>());
+    CheckFieldIndex_<Hermes::Attributes>(std::make_index_sequence<Hermes::FieldCount<Hermes::Attributes>()>());
+}
+
+template<class T>
+std::vector<T> BenchmarkSamples_(std::true_type)
+{
+    return GenerateSamples<T>();
+}
+
+template<class T>
+std::vector<T> BenchmarkSamples_(std::false_type)
+{
+    return{T()};
+}
+
+// Not a test as such, but a comparison of the parsers for every message type.
+// Run with --log_level=message to see the results.
+BOOST_AUTO_TEST_CASE_TEMPLATE(StreamingParserBenchmark, DataT, AllHermesDataTypes)
+{
+    // FromXml() sets up a fresh dispatcher each time, so pass many messages at once to make up for that:
+    const unsigned cMESSAGES_PER_CALL = 100U;
+    std::vector<std::string> inputs;
+    for (const auto& data : BenchmarkSamples_<DataT>(std::integral_constant<bool, boost::fusion::traits::is_sequence<DataT>::value>()))
+    {
+        std::string message = Hermes::ToXml(data);
+        inputs.emplace_back();
+        for (unsigned i = 0U; i < cMESSAGES_PER_CALL; ++i)
+        {
+            inputs.back() += message;
+        }
+    }
+
+    double nanoseconds[2];
+    for (auto parserMode : {Hermes::EXmlParserMode::eDOM, Hermes::EXmlParserMode::eSTREAMING})
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& input : inputs)
+        {
+            BOOST_TEST_REQUIRE(Hermes::FromXml<DataT>(input, parserMode));
+        }
+        std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+        nanoseconds[static_cast<int>(parserMode)] = duration.count() / cMESSAGES_PER_CALL / inputs.size();
+    }
+    BOOST_TEST_MESSAGE(typeid(DataT).name() << ": " << nanoseconds[0] << " ns with pugixml, " << nanoseconds[1]
+        << " ns streaming per message");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(TestDeserializer, DataT, AllHermesDataTypes)
+{
+    for (auto parserMode : {Hermes::EXmlParserMode::eDOM, Hermes::EXmlParserMode::eSTREAMING})
+    {
+        Hermes::Deserializer deserializer{parserMode};
+        for (const auto& data : BenchmarkSamples_<DataT>(std::integral_constant<bool, boost::fusion::traits::is_sequence<DataT>::value>()))
+        {
+            std::string xml = Hermes::ToXml(data);
+            BOOST_TEST(data == deserializer.FromXml<DataT>(xml));
+
+            // an incomplete message is not kept for the next call:
+            BOOST_TEST(!deserializer.FromXml<DataT>(Hermes::StringView(xml).substr(0U, xml.size() / 2U)));
+            BOOST_TEST(data == deserializer.FromXml<DataT>(xml));
+
+            // neither is a malformed one:
+            BOOST_TEST(!deserializer.FromXml<DataT>("<Hermes><CheckAlive></Hermes>"));
+
+            std::string buffer = xml;
+            BOOST_TEST(data == deserializer.FromXmlInPlace<DataT>(&buffer[0], buffer.size()));
+            BOOST_TEST(data == deserializer.FromXml<DataT>(xml));
+        }
+    }
+}
+
+// Not a test as such, but a comparison of the deserializer handle with FromXml() for single messages.
+// Run with --log_level=message to see the results.
+BOOST_AUTO_TEST_CASE_TEMPLATE(DeserializerBenchmark, DataT, AllHermesDataTypes)
+{
+    const unsigned cREPETITIONS = 100U;
+    std::vector<std::string> inputs;
+    for (const auto& data : BenchmarkSamples_<DataT>(std::integral_constant<bool, boost::fusion::traits::is_sequence<DataT>::value>()))
+    {
+        inputs.emplace_back(Hermes::ToXml(data));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0U; i < cREPETITIONS; ++i)
+    {
+        for (const auto& input : inputs)
+        {
+            BOOST_TEST_REQUIRE(Hermes::FromXml<DataT>(input));
+        }
+    }
+    std::chrono::duration<double, std::nano> fromXmlDuration = std::chrono::steady_clock::now() - start;
+
+    Hermes::Deserializer deserializer;
+    std::string buffer;
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0U; i < cREPETITIONS; ++i)
+    {
+        for (const auto& input : inputs)
+        {
+            buffer = input;
+            BOOST_TEST_REQUIRE(deserializer.FromXmlInPlace<DataT>(&buffer[0], buffer.size()));
+        }
+    }
+    std::chrono::duration<double, std::nano> deserializerDuration = std::chrono::steady_clock::now() - start;
+
+    const double messages = static_cast<double>(cREPETITIONS) * inputs.size();
+    BOOST_TEST_MESSAGE(typeid(DataT).name() << ": " << fromXmlDuration.count() / messages << " ns with FromXml(), "
+        << deserializerDuration.count() / messages << " ns with a Deserializer per message");
+}
+
+std::size_t SerializeToBuffer_(const HermesServiceDescriptionData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeServiceDescriptionToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesBoardAvailableData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeBoardAvailableToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesRevokeBoardAvailableData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeRevokeBoardAvailableToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesMachineReadyData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeMachineReadyToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesRevokeMachineReadyData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeRevokeMachineReadyToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesStartTransportData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeStartTransportToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesStopTransportData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeStopTransportToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesTransportFinishedData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeTransportFinishedToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesBoardForecastData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeBoardForecastToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesQueryBoardInfoData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeQueryBoardInfoToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesSendBoardInfoData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeSendBoardInfoToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesNotificationData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeNotificationToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesCheckAliveData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeCheckAliveToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesGetConfigurationData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeGetConfigurationToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesSetConfigurationData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeSetConfigurationToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesCurrentConfigurationData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeCurrentConfigurationToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesSupervisoryServiceDescriptionData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeSupervisoryServiceDescriptionToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesBoardArrivedData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeBoardArrivedToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesBoardDepartedData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeBoardDepartedToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesQueryWorkOrderInfoData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeQueryWorkOrderInfoToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesSendWorkOrderInfoData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeSendWorkOrderInfoToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesReplyWorkOrderInfoData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeReplyWorkOrderInfoToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesCommandData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeCommandToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesQueryHermesCapabilitiesData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeQueryHermesCapabilitiesToBuffer(pData, pBuffer, size); }
+std::size_t SerializeToBuffer_(const HermesSendHermesCapabilitiesData* pData, char* pBuffer, std::size_t size) { return ::HermesSerializeSendHermesCapabilitiesToBuffer(pData, pBuffer, size); }
+
+void Serialize_(const HermesServiceDescriptionData* pData, HermesSerializationCallback callback) { ::HermesSerializeServiceDescription(pData, callback); }
+void Serialize_(const HermesBoardAvailableData* pData, HermesSerializationCallback callback) { ::HermesSerializeBoardAvailable(pData, callback); }
+void Serialize_(const HermesRevokeBoardAvailableData* pData, HermesSerializationCallback callback) { ::HermesSerializeRevokeBoardAvailable(pData, callback); }
+void Serialize_(const HermesMachineReadyData* pData, HermesSerializationCallback callback) { ::HermesSerializeMachineReady(pData, callback); }
+void Serialize_(const HermesRevokeMachineReadyData* pData, HermesSerializationCallback callback) { ::HermesSerializeRevokeMachineReady(pData, callback); }
+void Serialize_(const HermesStartTransportData* pData, HermesSerializationCallback callback) { ::HermesSerializeStartTransport(pData, callback); }
+void Serialize_(const HermesStopTransportData* pData, HermesSerializationCallback callback) { ::HermesSerializeStopTransport(pData, callback); }
+void Serialize_(const HermesTransportFinishedData* pData, HermesSerializationCallback callback) { ::HermesSerializeTransportFinished(pData, callback); }
+void Serialize_(const HermesBoardForecastData* pData, HermesSerializationCallback callback) { ::HermesSerializeBoardForecast(pData, callback); }
+void Serialize_(const HermesQueryBoardInfoData* pData, HermesSerializationCallback callback) { ::HermesSerializeQueryBoardInfo(pData, callback); }
+void Serialize_(const HermesSendBoardInfoData* pData, HermesSerializationCallback callback) { ::HermesSerializeSendBoardInfo(pData, callback); }
+void Serialize_(const HermesNotificationData* pData, HermesSerializationCallback callback) { ::HermesSerializeNotification(pData, callback); }
+void Serialize_(const HermesCheckAliveData* pData, HermesSerializationCallback callback) { ::HermesSerializeCheckAlive(pData, callback); }
+void Serialize_(const HermesGetConfigurationData* pData, HermesSerializationCallback callback) { ::HermesSerializeGetConfiguration(pData, callback); }
+void Serialize_(const HermesSetConfigurationData* pData, HermesSerializationCallback callback) { ::HermesSerializeSetConfiguration(pData, callback); }
+void Serialize_(const HermesCurrentConfigurationData* pData, HermesSerializationCallback callback) { ::HermesSerializeCurrentConfiguration(pData, callback); }
+void Serialize_(const HermesSupervisoryServiceDescriptionData* pData, HermesSerializationCallback callback) { ::HermesSerializeSupervisoryServiceDescription(pData, callback); }
+void Serialize_(const HermesBoardArrivedData* pData, HermesSerializationCallback callback) { ::HermesSerializeBoardArrived(pData, callback); }
+void Serialize_(const HermesBoardDepartedData* pData, HermesSerializationCallback callback) { ::HermesSerializeBoardDeparted(pData, callback); }
+void Serialize_(const HermesQueryWorkOrderInfoData* pData, HermesSerializationCallback callback) { ::HermesSerializeQueryWorkOrderInfo(pData, callback); }
+void Serialize_(const HermesSendWorkOrderInfoData* pData, HermesSerializationCallback callback) { ::HermesSerializeSendWorkOrderInfo(pData, callback); }
+void Serialize_(const HermesReplyWorkOrderInfoData* pData, HermesSerializationCallback callback) { ::HermesSerializeReplyWorkOrderInfo(pData, callback); }
+void Serialize_(const HermesCommandData* pData, HermesSerializationCallback callback) { ::HermesSerializeCommand(pData, callback); }
+void Serialize_(const HermesQueryHermesCapabilitiesData* pData, HermesSerializationCallback callback) { ::HermesSerializeQueryHermesCapabilities(pData, callback); }
+void Serialize_(const HermesSendHermesCapabilitiesData* pData, HermesSerializationCallback callback) { ::HermesSerializeSendHermesCapabilities(pData, callback); }
+
+std::string WithoutTimestamp_(std::string xml)
+{
+    const std::string cATTRIBUTE = "Timestamp=\"";
+    auto begin = xml.find(cATTRIBUTE) + cATTRIBUTE.size();
+    return xml.replace(begin, xml.find('"', begin) - begin, "%T");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(TestSerializeToBuffer, DataT, AllHermesDataTypes)
+{
+    for (const auto& data : BenchmarkSamples_<DataT>(std::integral_constant<bool, boost::fusion::traits::is_sequence<DataT>::value>()))
+    {
+        const Hermes::Converter2C<DataT> converter(data);
+        const auto* pData = converter.CPointer();
+
+        // too small, so nothing is written:
+        char tooSmall[8] = "xxxxxxx";
+        auto size = SerializeToBuffer_(pData, tooSmall, sizeof(tooSmall));
+        BOOST_TEST(size > sizeof(tooSmall));
+        BOOST_TEST(tooSmall == "xxxxxxx");
+        BOOST_TEST(SerializeToBuffer_(pData, nullptr, 0U) == size);
+
+        // the same as serializing the C++ data:
+        std::string xml(size, '\0');
+        BOOST_TEST_REQUIRE(SerializeToBuffer_(pData, &xml[0], xml.size()) == size);
+        BOOST_TEST(WithoutTimestamp_(xml) == WithoutTimestamp_(Hermes::ToXml(data)));
+        BOOST_TEST(data == Hermes::FromXml<DataT>(xml));
+    }
+
+    // without any data, the required fields are written all the same, as through the conversion to C++:
+    using CData = std::remove_const_t<std::remove_pointer_t<decltype(std::declval<Hermes::Converter2C<DataT>>().CPointer())>>;
+    const CData zeroData{};
+    std::string xml(SerializeToBuffer_(&zeroData, nullptr, 0U), '\0');
+    BOOST_TEST_REQUIRE(SerializeToBuffer_(&zeroData, &xml[0], xml.size()) == xml.size());
+    std::string expectedXml;
+    Serialize_(&zeroData, HermesSerializationCallback{[](void* pData, HermesStringView view)
+    {
+        static_cast<std::string*>(pData)->assign(view.m_pData, view.m_size);
+    }, &expectedXml});
+    BOOST_TEST(WithoutTimestamp_(xml) == WithoutTimestamp_(expectedXml));
+    BOOST_TEST(Hermes::FromXml<DataT>(xml));
+}
+
+// Not a test as such, but a comparison of the serialization into a buffer with the one through a callback.
+// Run with --log_level=message to see the results.
+BOOST_AUTO_TEST_CASE_TEMPLATE(SerializeToBufferBenchmark, DataT, AllHermesDataTypes)
+{
+    const unsigned cREPETITIONS = 100U;
+    const auto samples = BenchmarkSamples_<DataT>(std::integral_constant<bool, boost::fusion::traits::is_sequence<DataT>::value>());
+    std::vector<std::unique_ptr<Hermes::Converter2C<DataT>>> converters;
+    for (const auto& data : samples)
+    {
+        converters.push_back(std::make_unique<Hermes::Converter2C<DataT>>(data));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t callbackSize = 0U;
+    for (unsigned i = 0U; i < cREPETITIONS; ++i)
+    {
+        for (const auto& data : samples)
+        {
+            callbackSize += Hermes::ToXml(data).size();
+        }
+    }
+    std::chrono::duration<double, std::nano> callbackDuration = std::chrono::steady_clock::now() - start;
+
+    std::vector<char> buffer(cHERMES_MAX_MESSAGE_SIZE);
+    std::size_t bufferSize = 0U;
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0U; i < cREPETITIONS; ++i)
+    {
+        for (const auto& converter : converters)
+        {
+            bufferSize += SerializeToBuffer_(converter->CPointer(), buffer.data(), buffer.size());
+        }
+    }
+    std::chrono::duration<double, std::nano> bufferDuration = std::chrono::steady_clock::now() - start;
+    BOOST_TEST(bufferSize == callbackSize);
+
+    const double messages = static_cast<double>(cREPETITIONS) * samples.size();
+    BOOST_TEST_MESSAGE(typeid(DataT).name() << ": " << callbackDuration.count() / messages << " ns through ToXml(), "
+        << bufferDuration.count() / messages << " ns into a buffer per message");
+}
+
 template<class T>
 void TestSubBoardsCutoff_(T& data, const uint16_t maxSubBoards)
 {
@@ -0,0 +1,168 @@
+/***********************************************************************
+Copyright ASM Assembly Systems GmbH & Co. KG
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+************************************************************************/
+
+#include "stdafx.h"
+
+#include <src/Hermes/TimerWheel.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Hermes;
+
+namespace
+{
+    // the wheel with a clock of its own, ticking whenever the test advances the clock
+    struct TestWheel
+    {
+        TimerWheel::TimePoint m_now;
+        std::vector<TimerWheel::TimePoint> m_tickRequests;
+        TimerWheel m_wheel{[this](TimerWheel::TimePoint time) { m_tickRequests.push_back(time); }, [this]() { return m_now; }};
+
+        void Advance(std::chrono::milliseconds duration)
+        {
+            m_now += duration;
+            m_wheel.Tick();
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(TestTimerWheel)
+{
+    TestWheel test;
+    std::vector<int> fired;
+    TimerWheel::Timer timer1([&]() { fired.push_back(1); });
+    TimerWheel::Timer timer2([&]() { fired.push_back(2); });
+
+    // no ticks without timers:
+    test.Advance(std::chrono::seconds(1));
+    BOOST_TEST(test.m_tickRequests.empty());
+
+    test.m_wheel.Schedule(timer1, 0.1);
+    test.m_wheel.Schedule(timer2, 0.12); // rounded up to the next tick
+    BOOST_TEST(test.m_wheel.Size() == 2U);
+    BOOST_TEST(test.m_tickRequests.size() == 1U);
+    BOOST_TEST((test.m_tickRequests.back() == test.m_now + 2 * TimerWheel::cTICK));
+
+    test.Advance(std::chrono::milliseconds(99));
+    BOOST_TEST(fired.empty());
+    test.Advance(std::chrono::milliseconds(1));
+    BOOST_TEST((fired == std::vector<int>{1}));
+    test.Advance(std::chrono::milliseconds(50));
+    BOOST_TEST((fired == std::vector<int>{1, 2}));
+    BOOST_TEST(test.m_wheel.Size() == 0U);
+
+    // rescheduling moves the timer, cancelling and deleting take it off:
+    fired.clear();
+    test.m_wheel.Schedule(timer1, 0.1);
+    test.m_wheel.Schedule(timer1, 0.3);
+    test.m_wheel.Schedule(timer2, 0.2);
+    timer2.Cancel();
+    auto upTimer3 = std::make_unique<TimerWheel::Timer>([&]() { fired.push_back(3); });
+    test.m_wheel.Schedule(*upTimer3, 0.2);
+    upTimer3.reset();
+    BOOST_TEST(test.m_wheel.Size() == 1U);
+    test.Advance(std::chrono::milliseconds(250));
+    BOOST_TEST(fired.empty());
+    test.Advance(std::chrono::milliseconds(50));
+    BOOST_TEST((fired == std::vector<int>{1}));
+}
+
+BOOST_AUTO_TEST_CASE(TestTimerWheelTurns)
+{
+    TestWheel test;
+    std::vector<int> fired;
+    TimerWheel::Timer timer1([&]() { fired.push_back(1); });
+    TimerWheel::Timer timer2([&]() { fired.push_back(2); });
+
+    // a minute is several turns of the wheel:
+    test.m_wheel.Schedule(timer1, 60.0);
+    test.m_wheel.Schedule(timer2, 60.0 + TimerWheel::cSLOT_COUNT * 0.05);
+    for (int i = 0; i < 1199; ++i)
+    {
+        test.Advance(TimerWheel::cTICK);
+    }
+    BOOST_TEST(fired.empty());
+    test.Advance(TimerWheel::cTICK);
+    BOOST_TEST((fired == std::vector<int>{1}));
+
+    // a late tick lets all the timers due go off at once:
+    test.Advance(std::chrono::seconds(20));
+    BOOST_TEST((fired == std::vector<int>{1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(TestTimerWheelTickRequests)
+{
+    TestWheel test;
+    std::vector<int> fired;
+    TimerWheel::Timer timer1([&]() { fired.push_back(1); });
+    TimerWheel::Timer timer2([&]() { fired.push_back(2); });
+
+    // a lone timer of a minute asks for a tick once a turn, and the ticks in between are skipped:
+    auto start = test.m_now;
+    test.m_wheel.Schedule(timer1, 60.0);
+    while (fired.empty())
+    {
+        BOOST_TEST_REQUIRE(test.m_tickRequests.size() <= 5U);
+        test.m_now = test.m_tickRequests.back();
+        test.m_wheel.Tick();
+    }
+    BOOST_TEST(test.m_tickRequests.size() == 5U);
+    BOOST_TEST((test.m_now == start + std::chrono::seconds(60)));
+    BOOST_TEST(test.m_wheel.Size() == 0U);
+
+    // a sooner timer asks for a sooner tick, a later one does not ask again:
+    test.m_tickRequests.clear();
+    test.m_wheel.Schedule(timer1, 1.0);
+    test.m_wheel.Schedule(timer2, 0.5);
+    test.m_wheel.Schedule(timer1, 2.0);
+    BOOST_TEST(test.m_tickRequests.size() == 2U);
+    BOOST_TEST((test.m_tickRequests.back() == test.m_now + std::chrono::milliseconds(500)));
+    test.Advance(std::chrono::milliseconds(500));
+    BOOST_TEST((fired == std::vector<int>{1, 2}));
+    BOOST_TEST(test.m_tickRequests.size() == 3U);
+    BOOST_TEST((test.m_tickRequests.back() == test.m_now + std::chrono::milliseconds(1500)));
+}
+
+BOOST_AUTO_TEST_CASE(TestTimerWheelCallbacks)
+{
+    TestWheel test;
+    int count = 0;
+    std::unique_ptr<TimerWheel::Timer> upOther;
+    TimerWheel::Timer periodic([&]()
+    {
+        ++count;
+        test.m_wheel.Schedule(*upOther, 0.05);
+        upOther.reset(); // deleted while it is due in the same tick
+    });
+    upOther = std::make_unique<TimerWheel::Timer>([&]() { count += 100; });
+    test.m_wheel.Schedule(periodic, 0.05);
+    test.m_wheel.Schedule(*upOther, 0.05);
+
+    test.Advance(std::chrono::milliseconds(50));
+    BOOST_TEST(count == 1);
+    BOOST_TEST(test.m_wheel.Size() == 0U);
+
+    // the wheel stood still meanwhile and starts over:
+    test.Advance(std::chrono::seconds(100));
+    auto requests = test.m_tickRequests.size();
+    TimerWheel::Timer timer([&]() { ++count; });
+    test.m_wheel.Schedule(timer, 0.05);
+    BOOST_TEST(test.m_tickRequests.size() == requests + 1U);
+    BOOST_TEST((test.m_tickRequests.back() == test.m_now + TimerWheel::cTICK));
+    test.Advance(std::chrono::milliseconds(50));
+    BOOST_TEST(count == 2);
+}
@@ -0,0 +1,133 @@
+/***********************************************************************
+Copyright ASM Assembly Systems GmbH & Co. KG
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+************************************************************************/
+
+#include "stdafx.h"
+
+#include <src/Hermes/TimestampFormatter.h>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Hermes;
+
+namespace
+{
+    std::string ToString_(const TimestampFormatter::Timestamp& timestamp)
+    {
+        return std::string(timestamp.data(), timestamp.size());
+    }
+
+    // a clock that is set by the test
+    struct FakeClock_
+    {
+        std::chrono::system_clock::time_point m_now;
+        std::chrono::seconds m_utcOffset{0};
+        unsigned m_utcOffsetCalls = 0U;
+
+        TimestampFormatter MakeFormatter()
+        {
+            return TimestampFormatter([this]() { return m_now; },
+                [this](std::chrono::seconds) { ++m_utcOffsetCalls; return m_utcOffset; });
+        }
+
+        void SetMilliseconds(long long sinceEpoch)
+        {
+            m_now = std::chrono::system_clock::time_point(std::chrono::milliseconds(sinceEpoch));
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(TestTimestampFormatterFakeClock)
+{
+    FakeClock_ clock;
+    auto formatter = clock.MakeFormatter();
+
+    clock.SetMilliseconds(1709251199987LL); // 2024-02-29T23:59:59.987 UTC
+    BOOST_TEST(ToString_(formatter.Now()) == "2024-02-29T23:59:59.987");
+    clock.SetMilliseconds(1709251199999LL);
+    BOOST_TEST(ToString_(formatter.Now()) == "2024-02-29T23:59:59.999");
+    BOOST_TEST(clock.m_utcOffsetCalls == 1U); // the same second
+
+    clock.SetMilliseconds(1709251200000LL);
+    BOOST_TEST(ToString_(formatter.Now()) == "2024-03-01T00:00:00.000");
+    BOOST_TEST(clock.m_utcOffsetCalls == 2U);
+
+    // the offset to UTC is asked for again with the next second:
+    clock.m_utcOffset = std::chrono::hours(-5);
+    clock.SetMilliseconds(946684800042LL); // 2000-01-01T00:00:00.042 UTC
+    BOOST_TEST(ToString_(formatter.Now()) == "1999-12-31T19:00:00.042");
+    clock.m_utcOffset = std::chrono::hours(5) + std::chrono::minutes(30);
+    BOOST_TEST(ToString_(formatter.Now()) == "1999-12-31T19:00:00.042");
+    clock.SetMilliseconds(946684801007LL);
+    BOOST_TEST(ToString_(formatter.Now()) == "2000-01-01T05:30:01.007");
+
+    clock.m_utcOffset = std::chrono::seconds(0);
+    clock.SetMilliseconds(-1LL);
+    BOOST_TEST(ToString_(formatter.Now()) == "1969-12-31T23:59:59.999");
+}
+
+BOOST_AUTO_TEST_CASE(TestTimestampFormatterLocalTime)
+{
+    // the same text as the former std::put_time(localtime(...)) formatting:
+    auto now = std::chrono::system_clock::now();
+    TimestampFormatter formatter([now]() { return now; }, &TimestampFormatter::LocalUtcOffset);
+
+    time_t cnow = std::chrono::system_clock::to_time_t(now);
+    tm local_tm;
+#ifdef _WINDOWS
+    localtime_s(&local_tm, &cnow);
+#else
+    localtime_r(&cnow, &local_tm);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&local_tm, "%Y-%m-%dT%H:%M:%S.") << std::setw(3) << std::setfill('0')
+        << std::chrono::duration_cast<std::chrono::milliseconds>(now - std::chrono::time_point_cast<std::chrono::seconds>(now)).count();
+    BOOST_TEST(ToString_(formatter.Now()) == oss.str());
+}
+
+BOOST_AUTO_TEST_CASE(TestTimestampFormatterThreads)
+{
+    const auto& formatter = TimestampFormatter::Local();
+    std::vector<std::thread> threads;
+    std::vector<unsigned> malformedCounts(4U, 0U);
+    for (auto& malformedCount : malformedCounts)
+    {
+        threads.emplace_back([&formatter, &malformedCount]()
+        {
+            for (int i = 0; i < 100000; ++i)
+            {
+                auto timestamp = formatter.Now();
+                for (std::size_t pos = 0U; pos < timestamp.size(); ++pos)
+                {
+                    char expected = pos == 4U || pos == 7U ? '-' : pos == 10U ? 'T' : pos == 13U || pos == 16U ? ':' : pos == 19U ? '.' : '0';
+                    bool ok = expected == '0' ? (timestamp[pos] >= '0' && timestamp[pos] <= '9') : timestamp[pos] == expected;
+                    malformedCount += ok ? 0U : 1U;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (auto malformedCount : malformedCounts)
+    {
+        BOOST_TEST(malformedCount == 0U);
+    }
+}
@@ -0,0 +1,192 @@
+/***********************************************************************
+Copyright ASM Assembly Systems GmbH & Co. KG
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+************************************************************************/
+
+
+#include "stdafx.h"
+
+#include "Runner.h"
+#include "Sinks.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace Hermes;
+
+namespace
+{
+    // connects an upstream and a downstream over the transport, exchanges the service descriptions and a board
+    void TestTransport_(uint16_t port, ETransport transport, const std::function<void(const ConnectionInfo&)>& checkConnectionInfo)
+    {
+        std::string machineId{"MachineId"};
+        SocketOptions socketOptions;
+        socketOptions.m_transport = transport;
+
+        DownstreamSink downstreamSink;
+        Hermes::Downstream downstream(1U, downstreamSink);
+        Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+        // nobody listens at first, so the upstream tries more than once
+        UpstreamSink upstreamSink;
+        Hermes::Upstream upstream(1U, upstreamSink);
+        Runner<Hermes::Upstream> upstreamRunner(upstream);
+        Hermes::UpstreamSettings upstreamSettings(machineId, "localhost", port);
+        upstreamSettings.m_reconnectWaitTimeInSeconds = 0.1;
+        upstreamSettings.m_socketOptions = socketOptions;
+        upstream.Enable(upstreamSettings);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        Hermes::DownstreamSettings downstreamSettings(machineId, port);
+        downstreamSettings.m_socketOptions = socketOptions;
+        downstream.Enable(downstreamSettings);
+
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        BOOST_TEST(upstreamSink.m_connectionInfo.m_connectAttempts >= 2U);
+        checkConnectionInfo(upstreamSink.m_connectionInfo);
+        checkConnectionInfo(downstreamSink.m_connectionInfo);
+
+        upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData("UpstreamMachineId", 1U));
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+        BOOST_TEST(downstreamSink.m_serviceDescription.m_machineId == "UpstreamMachineId");
+        downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData("DownstreamMachineId", 1U));
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+        BOOST_TEST(upstreamSink.m_serviceDescription.m_machineId == "DownstreamMachineId");
+
+        Hermes::BoardAvailableData boardAvailable("BoardId", "DownstreamMachineId", EBoardQuality::eGOOD, EFlippedBoard::eTOP_SIDE_IS_UP);
+        // takes several receives, but the whole message stays well within cMAX_MESSAGE_SIZE, which closes the session
+        boardAvailable.m_optionalProductTypeId = std::string(cMAX_MESSAGE_SIZE - 4096U, 'P');
+        downstream.Signal(downstreamSink.m_sessionId, boardAvailable);
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eBOARD_AVAILABLE; });
+        BOOST_TEST(upstreamSink.m_boardAvailableData == boardAvailable);
+
+        downstream.Disable(NotificationData(ENotificationCode::eMACHINE_SHUTDOWN, ESeverity::eINFO, "Disabled"));
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eDISCONNECTED; });
+    }
+
+    // the notifications per second an upstream gets across to a downstream, sending without waiting for an answer
+    double NotificationsPerSecond_(uint16_t port, ETransport transport)
+    {
+        const unsigned cNOTIFICATIONS = 20000U;
+        std::string machineId{"MachineId"};
+        SocketOptions socketOptions;
+        socketOptions.m_transport = transport;
+
+        DownstreamSink downstreamSink;
+        Hermes::Downstream downstream(1U, downstreamSink);
+        Runner<Hermes::Downstream> downstreamRunner(downstream);
+        Hermes::DownstreamSettings downstreamSettings(machineId, port);
+        downstreamSettings.m_socketOptions = socketOptions;
+        downstream.Enable(downstreamSettings);
+
+        UpstreamSink upstreamSink;
+        Hermes::Upstream upstream(1U, upstreamSink);
+        Runner<Hermes::Upstream> upstreamRunner(upstream);
+        Hermes::UpstreamSettings upstreamSettings(machineId, "127.0.0.1", port);
+        upstreamSettings.m_socketOptions = socketOptions;
+        upstream.Enable(upstreamSettings);
+
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(machineId, 1U));
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+
+        auto start = std::chrono::steady_clock::now();
+        NotificationData notification(ENotificationCode::eUNSPECIFIC, ESeverity::eINFO, "");
+        for (unsigned i = 1U; i <= cNOTIFICATIONS; ++i)
+        {
+            notification.m_description = std::to_string(i);
+            upstream.Signal(upstreamSink.m_sessionId, notification);
+        }
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_notificationData.m_description == notification.m_description; });
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+        return cNOTIFICATIONS / duration.count();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(InProcessTransportTest)
+{
+    TestCaseScope scope("InProcessTransportTest");
+
+    TestTransport_(50126, ETransport::eIN_PROCESS, [](const ConnectionInfo& connectionInfo)
+    {
+        BOOST_TEST(connectionInfo.m_port == 50126U);
+        BOOST_TEST(connectionInfo.m_hostName == "in-process");
+    });
+}
+
+#if !defined(_WIN32)
+BOOST_AUTO_TEST_CASE(UnixDomainTransportTest)
+{
+    TestCaseScope scope("UnixDomainTransportTest");
+
+    // the socket file of a listener that is gone, it refuses connections:
+    const char* pTempDirectory = std::getenv("TMPDIR");
+    const std::string path = std::string(pTempDirectory && *pTempDirectory ? pTempDirectory : "/tmp") + "/hermes-50127.sock";
+    std::remove(path.c_str());
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1U);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    BOOST_TEST_REQUIRE(fd >= 0);
+    BOOST_TEST_REQUIRE(::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+    ::close(fd);
+
+    TestTransport_(50127, ETransport::eUNIX_DOMAIN, [](const ConnectionInfo& connectionInfo)
+    {
+        BOOST_TEST(connectionInfo.m_port == 50127U);
+        const std::string fileName = "/hermes-50127.sock";
+        BOOST_TEST(connectionInfo.m_address.size() > fileName.size());
+        BOOST_TEST(connectionInfo.m_address.compare(connectionInfo.m_address.size() - fileName.size(), fileName.size(), fileName) == 0);
+    });
+
+    // and the downstream has removed its socket file again:
+    struct stat status;
+    BOOST_TEST(::stat(path.c_str(), &status) != 0);
+}
+#endif
+
+// with eIO_URING, falls back to eTCP where the kernel does not support it
+BOOST_AUTO_TEST_CASE(IoUringTransportTest)
+{
+    TestCaseScope scope("IoUringTransportTest");
+
+    TestTransport_(50128, ETransport::eIO_URING, [](const ConnectionInfo& connectionInfo)
+    {
+        BOOST_TEST(connectionInfo.m_port == 50128U);
+        BOOST_TEST(connectionInfo.m_address == "127.0.0.1");
+    });
+}
+
+// Not a test as such, but a benchmark of the throughput with asio and with the io_uring.
+// Run with --log_level=message to see the results.
+BOOST_AUTO_TEST_CASE(TransportThroughputBenchmark)
+{
+    TestCaseScope scope("TransportThroughputBenchmark");
+
+    double tcp = NotificationsPerSecond_(50129, ETransport::eTCP);
+    double ioUring = NotificationsPerSecond_(50130, ETransport::eIO_URING);
+
+    BOOST_TEST_MESSAGE("Notifications per second: " << tcp << " with asio, " << ioUring << " with io_uring");
+}
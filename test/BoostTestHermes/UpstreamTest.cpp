@@ -19,6 +19,12 @@ limitations under the License.
 #include "Runner.h"
 #include "Sinks.h"
 
+#include <src/Hermes/ReconnectBackoff.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
 using namespace Hermes;
 
 
@@ -178,3 +184,230 @@ BOOST_AUTO_TEST_CASE(UpstreamTest)
 
     }
 }
+
+BOOST_AUTO_TEST_CASE(ReconnectBackoffTest)
+{
+    NetworkConfiguration configuration;
+    configuration.m_retryDelayInSeconds = 1.0;
+    configuration.m_reconnectPolicy.m_waitTimeFactor = 2.0;
+    configuration.m_reconnectPolicy.m_maxWaitTimeInSeconds = 5.0;
+
+    ReconnectBackoff backoff(configuration, 1U);
+    for (double expectedWaitTime : {1.0, 2.0, 4.0, 5.0, 5.0})
+    {
+        BOOST_TEST(backoff.NextWaitTimeInSeconds() == expectedWaitTime);
+    }
+    backoff.Restart();
+    BOOST_TEST(backoff.NextWaitTimeInSeconds() == 1.0);
+
+    // the defaults of the C structs (all 0) keep the wait time as it is
+    configuration.m_reconnectPolicy = ReconnectPolicy{0.0, 0.0, 0.0};
+    ReconnectBackoff fixedBackoff(configuration, 1U);
+    for (int i = 0; i < 3; ++i)
+    {
+        BOOST_TEST(fixedBackoff.NextWaitTimeInSeconds() == 1.0);
+    }
+
+    configuration.m_reconnectPolicy = ReconnectPolicy{2.0, 5.0, 0.5};
+    ReconnectBackoff jitteredBackoff(configuration, 1U);
+    for (double maxWaitTime : {1.0, 2.0, 4.0, 5.0, 5.0})
+    {
+        double waitTime = jitteredBackoff.NextWaitTimeInSeconds();
+        BOOST_TEST(waitTime >= maxWaitTime / 2.0);
+        BOOST_TEST(waitTime <= maxWaitTime);
+    }
+}
+
+namespace
+{
+    struct DisconnectCountingUpstreamSink : UpstreamSink
+    {
+        std::vector<std::chrono::steady_clock::time_point> m_disconnectedAt;
+
+        void OnDisconnected(unsigned sessionId, EState state, const Hermes::Error& error) override
+        {
+            {
+                std::lock_guard<Mutex> lock(m_mutex);
+                m_disconnectedAt.push_back(std::chrono::steady_clock::now());
+            }
+            UpstreamSink::OnDisconnected(sessionId, state, error);
+        }
+    };
+}
+
+BOOST_AUTO_TEST_CASE(UpstreamRefusedReconnectTest)
+{
+    TestCaseScope scope("UpstreamRefusedReconnectTest");
+
+    std::string machineId{"MachineId"};
+
+    DownstreamSink downstreamSink;
+    Hermes::Downstream downstream(1U, downstreamSink);
+    Runner<Hermes::Downstream> downstreamRunner(downstream);
+    downstream.Enable(Hermes::DownstreamSettings(machineId, 50132));
+
+    // the downstream is taken by this upstream ...
+    UpstreamSink upstreamSink;
+    Hermes::Upstream upstream(1U, upstreamSink);
+    Runner<Hermes::Upstream> upstreamRunner(upstream);
+    upstream.Enable(Hermes::UpstreamSettings(machineId, "127.0.0.1", 50132));
+    WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+    upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(machineId, 1U));
+    WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+
+    // ... so it keeps refusing this one, closing the connection cleanly each time
+    DisconnectCountingUpstreamSink refusedSink;
+    Hermes::Upstream refused(1U, refusedSink);
+    Runner<Hermes::Upstream> refusedRunner(refused);
+    Hermes::UpstreamSettings refusedSettings(machineId, "127.0.0.1", 50132);
+    refusedSettings.m_reconnectWaitTimeInSeconds = 0.2;
+    refusedSettings.m_reconnectWaitTimeFactor = 2.0;
+    refusedSettings.m_maxReconnectWaitTimeInSeconds = 10.0;
+    refusedSettings.m_reconnectAtOnceAfterClose = true;
+    refused.Enable(refusedSettings);
+
+    // disconnected after 0, 0.2, 0.6 and 1.4 seconds, rather than as often as the round trips allow:
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    std::lock_guard<Mutex> lock(refusedSink.m_mutex);
+    const auto& disconnectedAt = refusedSink.m_disconnectedAt;
+    BOOST_TEST(disconnectedAt.size() >= 2U);
+    BOOST_TEST(disconnectedAt.size() <= 5U);
+    for (std::size_t i = 1U; i < disconnectedAt.size(); ++i)
+    {
+        std::chrono::duration<double> wait = disconnectedAt[i] - disconnectedAt[i - 1U];
+        BOOST_TEST(wait.count() >= 0.15);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(UpstreamReconnectTest)
+{
+    TestCaseScope scope("UpstreamReconnectTest");
+
+    std::string machineId{"MachineId"};
+
+    // nobody listens at first, so the upstream tries more than once
+    {
+        DownstreamSink downstreamSink;
+        Hermes::Downstream downstream(1U, downstreamSink);
+        Runner<Hermes::Downstream> downstreamRunner(downstream);
+
+        UpstreamSink upstreamSink;
+        Hermes::Upstream upstream(1U, upstreamSink);
+        Runner<Hermes::Upstream> upstreamRunner(upstream);
+        Hermes::UpstreamSettings upstreamSettings(machineId, "127.0.0.1", 50121);
+        upstreamSettings.m_reconnectWaitTimeInSeconds = 0.1;
+        upstream.Enable(upstreamSettings);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        downstream.Enable(Hermes::DownstreamSettings(machineId, 50121));
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        BOOST_TEST(upstreamSink.m_connectionInfo.m_connectAttempts >= 2U);
+        BOOST_TEST(upstreamSink.m_connectionInfo.m_downtimeInSeconds == 0.0);
+    }
+
+    // the downstream closes the established connection cleanly, so the upstream does not wait the 10 seconds
+    {
+        DownstreamSink downstreamSink;
+        Hermes::Downstream downstream(1U, downstreamSink);
+        Runner<Hermes::Downstream> downstreamRunner(downstream);
+        downstream.Enable(Hermes::DownstreamSettings(machineId, 50122));
+
+        UpstreamSink upstreamSink;
+        Hermes::Upstream upstream(1U, upstreamSink);
+        Runner<Hermes::Upstream> upstreamRunner(upstream);
+        Hermes::UpstreamSettings upstreamSettings(machineId, "127.0.0.1", 50122);
+        upstreamSettings.m_reconnectAtOnceAfterClose = true;
+        upstream.Enable(upstreamSettings);
+
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        BOOST_TEST(upstreamSink.m_connectionInfo.m_connectAttempts == 1U);
+        auto firstSessionId = upstreamSink.m_sessionId;
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        upstream.Signal(firstSessionId, Hermes::ServiceDescriptionData(machineId, 1U));
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+        downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(machineId, 1U));
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+        auto resetAt = std::chrono::steady_clock::now();
+        downstream.Reset(NotificationData(ENotificationCode::eMACHINE_SHUTDOWN, ESeverity::eINFO, "Restarting"));
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_sessionId != firstSessionId && upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - resetAt;
+        BOOST_TEST(elapsed.count() < 5.0);
+        BOOST_TEST(upstreamSink.m_connectionInfo.m_connectAttempts == 1U);
+        BOOST_TEST(upstreamSink.m_connectionInfo.m_downtimeInSeconds > 0.0);
+        BOOST_TEST(upstreamSink.m_connectionInfo.m_downtimeInSeconds < 5.0);
+    }
+}
+
+namespace
+{
+    // the mean time of a handshake from MachineReady to the end of the transport, in microseconds
+    double HandshakeRoundTripTime_(uint16_t port, const SocketOptions& socketOptions)
+    {
+        const unsigned cHANDSHAKES = 50U;
+        std::string machineId{"MachineId"};
+
+        DownstreamSink downstreamSink;
+        Hermes::Downstream downstream(1U, downstreamSink);
+        Runner<Hermes::Downstream> downstreamRunner(downstream);
+        Hermes::DownstreamSettings downstreamSettings(machineId, port);
+        downstreamSettings.m_socketOptions = socketOptions;
+        downstream.Enable(downstreamSettings);
+
+        UpstreamSink upstreamSink;
+        Hermes::Upstream upstream(1U, upstreamSink);
+        Runner<Hermes::Upstream> upstreamRunner(upstream);
+        Hermes::UpstreamSettings upstreamSettings(machineId, "127.0.0.1", port);
+        upstreamSettings.m_socketOptions = socketOptions;
+        upstream.Enable(upstreamSettings);
+
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eSOCKET_CONNECTED; });
+        upstream.Signal(upstreamSink.m_sessionId, Hermes::ServiceDescriptionData(machineId, 1U));
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eSERVICE_DESCRIPTION_DOWNSTREAM; });
+        downstream.Signal(downstreamSink.m_sessionId, Hermes::ServiceDescriptionData(machineId, 1U));
+        WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+        WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+
+        // each message waits for the answer to the previous one, as the machines do
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0U; i < cHANDSHAKES; ++i)
+        {
+            upstream.Signal(upstreamSink.m_sessionId, MachineReadyData());
+            WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eMACHINE_READY; });
+            downstream.Signal(downstreamSink.m_sessionId, BoardAvailableData());
+            WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eAVAILABLE_AND_READY; });
+            upstream.Signal(upstreamSink.m_sessionId, StartTransportData());
+            WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eTRANSPORTING; });
+            downstream.Signal(downstreamSink.m_sessionId, TransportFinishedData());
+            WaitFor(upstreamSink, [&]() { return upstreamSink.m_state == EState::eTRANSPORT_FINISHED; });
+            upstream.Signal(upstreamSink.m_sessionId, StopTransportData());
+            WaitFor(downstreamSink, [&]() { return downstreamSink.m_state == EState::eNOT_AVAILABLE_NOT_READY; });
+        }
+        std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+        return duration.count() / cHANDSHAKES;
+    }
+}
+
+// Not a test as such, but a benchmark of the handshake with and without TCP_NODELAY, and in-process.
+// Run with --log_level=message to see the results.
+BOOST_AUTO_TEST_CASE(HandshakeBenchmark)
+{
+    TestCaseScope scope("HandshakeBenchmark");
+
+    SocketOptions nagle;
+    nagle.m_noDelay = false;
+    double nagleTime = HandshakeRoundTripTime_(50123, nagle);
+
+    SocketOptions noDelay;
+    noDelay.m_quickAck = true;
+    double noDelayTime = HandshakeRoundTripTime_(50124, noDelay);
+
+    // the lower bound, without any operating system in between
+    SocketOptions inProcess;
+    inProcess.m_transport = ETransport::eIN_PROCESS;
+    double inProcessTime = HandshakeRoundTripTime_(50124, inProcess);
+
+    BOOST_TEST_MESSAGE("Handshake from MachineReady to StopTransport: " << nagleTime << " us with Nagle, "
+        << noDelayTime << " us with TCP_NODELAY and TCP_QUICKACK, " << inProcessTime << " us in-process");
+}
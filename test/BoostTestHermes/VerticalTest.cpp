@@ -354,6 +354,63 @@ BOOST_AUTO_TEST_CASE(VerticalBoardTrackingTest)
     clients.clear(); // desctruction should terminate all client threads
 }
 
+BOOST_AUTO_TEST_CASE(VerticalServiceMessagesTest)
+{
+    TestCaseScope scope("VerticalServiceMessagesTest");
+
+    Service service;
+    service.m_impl.Enable(Hermes::VerticalServiceSettings(service.m_systemId, 50131));
+
+    Client client(1);
+    client.m_impl.Enable(Hermes::VerticalClientSettings(client.m_systemId, "127.0.0.1", 50131));
+    WaitFor(client.m_sink, [&]() { return client.m_sink.m_state == Hermes::EVerticalState::eSOCKET_CONNECTED; });
+    WaitFor(service.m_sink, [&]() { return service.m_sink.m_sessionMap.size() == 1U; });
+    auto& serviceSession = service.m_sink.m_sessionMap.begin()->second;
+
+    Hermes::SupervisoryServiceDescriptionData clientDescription{ client.m_systemId };
+    clientDescription.m_supportedFeatures.m_optionalFeatureBoardTracking = Hermes::FeatureBoardTracking{};
+    client.Signal(clientDescription);
+    WaitFor(service.m_sink, [&]() { return serviceSession.m_state == Hermes::EVerticalState::eSUPERVISORY_SERVICE_DESCRIPTION; });
+    service.Signal(serviceSession.m_sessionId, Hermes::SupervisoryServiceDescriptionData{ service.m_systemId });
+    WaitFor(client.m_sink, [&]() { return client.m_sink.m_state == Hermes::EVerticalState::eCONNECTED; });
+
+    // the backlog after an outage, in one go:
+    const unsigned cBOARD_COUNT = 500U;
+    Hermes::VerticalServiceMessages messages;
+    BoardArrivedData boardArrived;
+    BoardDepartedData boardDeparted;
+    for (auto i = 0U; i < cBOARD_COUNT; ++i)
+    {
+        auto id = std::to_string(i);
+        boardArrived = BoardArrivedData{ "Arrived_" + id, 1, EBoardArrivedTransfer::eINSERTED, "BoardId_" + id, "myself"
+            , EBoardQuality::eGOOD, EFlippedBoard::eTOP_SIDE_IS_UP };
+        boardDeparted = BoardDepartedData{ "Departed_" + id, 1, EBoardDepartedTransfer::eTRANSFERRED, "BoardId_" + id, "myself"
+            , EBoardQuality::eGOOD, EFlippedBoard::eTOP_SIDE_IS_UP };
+        messages.Add(boardArrived);
+        messages.Add(boardDeparted);
+    }
+    NotificationData notification{ ENotificationCode::eUNSPECIFIC, ESeverity::eINFO, "Caught up" };
+    messages.Add(notification);
+    BOOST_TEST(messages.size() == 2U * cBOARD_COUNT + 1U);
+
+    service.m_impl.Signal(serviceSession.m_sessionId, messages);
+    WaitFor(client.m_sink, [&]() { return client.m_sink.m_notificationData == notification; });
+    BOOST_TEST(client.m_sink.m_boardArrivedData == boardArrived);
+    BOOST_TEST(client.m_sink.m_boardDepartedData == boardDeparted);
+
+    // to all the clients tracking boards, the notification does not go along:
+    Hermes::VerticalServiceMessages trackingMessages;
+    boardArrived.m_boardId = "Tracked";
+    boardDeparted.m_boardId = "Tracked";
+    trackingMessages.Add(boardArrived);
+    trackingMessages.Add(NotificationData{ ENotificationCode::eUNSPECIFIC, ESeverity::eINFO, "Dropped" });
+    trackingMessages.Add(boardDeparted);
+    service.m_impl.Signal(0U, trackingMessages);
+    WaitFor(client.m_sink, [&]() { return client.m_sink.m_boardDepartedData == boardDeparted; });
+    BOOST_TEST(client.m_sink.m_boardArrivedData == boardArrived);
+    BOOST_TEST(client.m_sink.m_notificationData == notification);
+}
+
 BOOST_AUTO_TEST_CASE(VerticalCheckAliveTest)
 {
     TestCaseScope scope("VerticalCheckAliveTest");